@@ -0,0 +1,233 @@
+// authd/main.cpp
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+#include "AccountsEditor.hpp"
+#include "AuthServer.hpp"
+#include "AuthSupervisor.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+#include "HashingEngine.hpp"
+#include "HashingWorkerPool.hpp"
+#include "LockoutTable.hpp"
+#include "PasswordFingerprint.hpp"
+#include "ProcessHashing.hpp"
+#include "SharedSessionTable.hpp"
+
+static AuthServer *server = nullptr;
+static AuthSupervisor *supervisor = nullptr;
+
+// SIGINT/SIGTERM завершают цикл сервера, в родительском процессе многопроцессного режима — наблюдение
+static void handleSignal(int)
+{
+    if (server != nullptr)
+    {
+        server->stop();
+    }
+    else if (supervisor != nullptr)
+    {
+        supervisor->stop();
+    }
+}
+
+// Цикл сервера в текущем процессе до сигнала остановки
+static int serve(Authenticator &authenticator, ConfiguratorAccountsEditor &editor, SecurityConfig &config,
+                 const AuthServerOptions &options)
+{
+    // Поток наблюдения за конфигурацией запускается в каждом процессе: fork не копирует потоки
+    config.watch();
+    AuthServer authServer(&authenticator, options, &editor);
+    if (authServer.start() != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Cannot listen on " << options.socketPath << (options.http ? " and HTTP port" : "") << "\n";
+        return 1;
+    }
+
+    server = &authServer;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (options.listenFd < 0)
+    {
+        std::cout << "Listening on " << options.socketPath << "\n";
+        if (options.http)
+        {
+            std::cout << "HTTP on 127.0.0.1:" << authServer.httpPort() << "\n";
+        }
+        if (options.tcp)
+        {
+            std::cout << "TCP on 127.0.0.1:" << authServer.tcpPort() << "\n";
+        }
+    }
+    authServer.run();
+    server = nullptr;
+
+    // Сколько принято соединений, сколько проверок пароля выполнено и сколько не начиналось из-за перегрузки, срока или отключения клиента
+    AuthServerStats stats = authServer.stats();
+    std::cout << "Accepted " << stats.accepted << " connections, verified " << stats.verified << ", overloaded " << stats.overloaded
+              << ", cancelled: deadline " << stats.cancelledDeadline << ", disconnected " << stats.cancelledDisconnected << "\n";
+    return 0;
+}
+
+// authd [--http PORT] [--tcp PORT] [--processes N] [--hash-processes N] [--max-latency-ms MS] [--request-timeout-ms MS]
+//   --http PORT              дополнительно принимать запросы HTTP/1.1 на 127.0.0.1:PORT
+//   --tcp PORT               дополнительно принимать двоичный протокол на 127.0.0.1:PORT
+//   --processes N            N рабочих процессов с общим сокетом под наблюдением родителя (0 — по числу ядер)
+//   --hash-processes N       хешировать в пуле из N процессов (ProcessHashing, 0 — по числу ядер), в многопроцессном
+//                            режиме — в каждом рабочем процессе
+//   --max-latency-ms MS      отклонять попытки входа кодом OVERLOADED, если ожидаемая задержка проверки больше MS
+//   --request-timeout-ms MS  не проверять пароль, если с приема запроса прошло больше MS (DEADLINE_EXCEEDED)
+int main(int argc, char *argv[])
+{
+    AuthServerOptions options;
+    bool multiprocess = false;
+    AuthSupervisorOptions supervisorOptions;
+    bool hashProcesses = false;
+    ProcessHashingOptions hashingOptions;
+    bool usage = argc % 2 == 0;
+    for (int i = 1; i + 1 < argc && !usage; i += 2)
+    {
+        if (std::strcmp(argv[i], "--http") == 0)
+        {
+            options.http = true;
+            options.httpPort = static_cast<uint16_t>(std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--tcp") == 0)
+        {
+            options.tcp = true;
+            options.tcpPort = static_cast<uint16_t>(std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--processes") == 0)
+        {
+            multiprocess = true;
+            supervisorOptions.processes = static_cast<size_t>(std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--hash-processes") == 0)
+        {
+            hashProcesses = true;
+            hashingOptions.workers = static_cast<size_t>(std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--max-latency-ms") == 0)
+        {
+            options.maxPredictedLatencyMs = static_cast<unsigned>(std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--request-timeout-ms") == 0)
+        {
+            options.requestTimeoutMs = static_cast<unsigned>(std::atoi(argv[i + 1]));
+        }
+        else
+        {
+            usage = true;
+        }
+    }
+    if (usage || (multiprocess && ((options.http && options.httpPort == 0) || (options.tcp && options.tcpPort == 0))))
+    {
+        std::cerr << "Usage: authd [--http PORT] [--tcp PORT] [--processes N] [--hash-processes N] [--max-latency-ms MS] "
+                     "[--request-timeout-ms MS]; "
+                     "PORT must be nonzero with --processes\n";
+        return 2;
+    }
+
+    std::cout << "Starting Authentication Daemon...\n";
+
+    // База, конфигурация и хешер создаются один раз и остаются в памяти; в многопроцессном режиме
+    // рабочие процессы получают их, в том числе построенный индекс базы, при fork
+    ConfiguratorDatabase db("./configDb/archive.txt", "./configDb/active_users.txt", "./configDb/tmp_file.txt");
+    db.enableActiveUsersIndex();
+    SecurityConfig config("./configDb/config.txt");
+    std::unique_ptr<HashingInterface> hasher = HashingEngine::create();
+    LockoutTable lockout;
+    if (lockout.open("./configDb/lockout.dat") != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Cannot open ./configDb/lockout.dat\n";
+        return 1;
+    }
+
+    // Смена пароля через сервер; отпечатки в архиве — как в конфигураторе, при наличии файла с перцем
+    PasswordFingerprint fingerprint;
+    bool fingerprints = fingerprint.loadPepper("./configDb/pepper.key") == ConfiguratorErrorCode::SUCCESS;
+
+    // Пул процессов хеширования создается в процессе сервера до запуска его потоков: после этого процессы
+    // хеширования порождает однопоточный порождатель пула, а не многопоточный сервер.
+    // Хеширование идет через пул с приоритетами: проверки при входе — INTERACTIVE, смена пароля — ADMIN
+    auto run = [&]()
+    {
+        std::unique_ptr<ProcessHashing> processHashing;
+        HashingInterface *engine = hasher.get();
+        if (hashProcesses)
+        {
+            processHashing = std::make_unique<ProcessHashing>(hasher.get(), hashingOptions);
+            engine = processHashing.get();
+        }
+        HashingPoolOptions poolOptions;
+        poolOptions.workers = options.workers;
+        HashingWorkerPool pool(engine, poolOptions);
+        PooledHashing interactiveHasher(&pool, HashingPriority::INTERACTIVE);
+        PooledHashing adminHasher(&pool, HashingPriority::ADMIN);
+        Authenticator authenticator(&db, &config, &interactiveHasher, &lockout);
+        ConfiguratorAccountsEditor editor(&db, &config, &adminHasher, fingerprints ? &fingerprint : nullptr);
+        return serve(authenticator, editor, config, options);
+    };
+
+    if (!multiprocess)
+    {
+        int code = run();
+        if (code == 0)
+        {
+            std::cout << "Authentication daemon stopped.\n";
+        }
+        return code;
+    }
+
+    // Каждый процесс проверяет один пароль за раз: параллельность дает число процессов
+    supervisorOptions.socketPath = options.socketPath;
+    AuthSupervisor authSupervisor(supervisorOptions);
+    if (authSupervisor.listen() != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Cannot listen on " << options.socketPath << "\n";
+        return 1;
+    }
+    options.listenFd = authSupervisor.socket();
+    options.reusePort = true;
+    options.workers = 1;
+
+    // Сессии и счетчики частоты в разделяемой памяти: токен, выданный одним процессом, принимается другим,
+    // а предел частоты действует на все процессы вместе
+    SharedSessionTable sessions;
+    if (sessions.open(std::min(options.maxSessions, SharedSessionTable::DEFAULT_CAPACITY)) != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Cannot map the shared session table\n";
+        return 1;
+    }
+    options.rateLimits.shared = true;
+    RateLimiter rateLimiter(options.rateLimits);
+    options.sessionStore = &sessions;
+    options.rateLimiter = &rateLimiter;
+
+    supervisor = &authSupervisor;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::cout << "Listening on " << options.socketPath << " with " << authSupervisor.processes() << " processes\n";
+    if (options.http)
+    {
+        std::cout << "HTTP on 127.0.0.1:" << options.httpPort << "\n";
+    }
+    if (options.tcp)
+    {
+        std::cout << "TCP on 127.0.0.1:" << options.tcpPort << "\n";
+    }
+    authSupervisor.run([&](size_t)
+                       { return run(); });
+    supervisor = nullptr;
+
+    std::cout << "Authentication daemon stopped.\n";
+    return 0;
+}
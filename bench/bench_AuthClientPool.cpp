@@ -0,0 +1,231 @@
+// bench/bench_AuthClientPool.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AuthClient.hpp"
+#include "AuthClientPool.hpp"
+#include "AuthServer.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+
+// Хеширование без вычислений: показывает стоимость соединений и обмена, а не проверки пароля
+class NullHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return password == hashedPassword ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+static const std::string archivePath = "./bench_pool_archive.txt";
+static const std::string activeUsersPath = "./bench_pool_active_users.txt";
+static const std::string tmpPath = "./bench_pool_tmp.txt";
+static const std::string configPath = "./bench_pool_config.txt";
+static const std::string socketPath = "./bench_pool.sock";
+
+// Результат прогона
+struct RunResult
+{
+    double perSecond = 0; // Успешных входов в секунду
+    double p50Us = 0;     // Задержка одного входа
+    double p99Us = 0;
+    uint64_t connections = 0; // Соединений, принятых сервером за прогон
+};
+
+static double percentile(std::vector<double> &values, double share)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(share * values.size()))];
+}
+
+// Закрытая нагрузка: callers потоков по perCaller входов; login выполняет один вход и возвращает успех
+template <typename Login>
+static RunResult closedLoop(unsigned callers, unsigned perCaller, unsigned users, Login login)
+{
+    std::vector<std::vector<double>> latencies(callers);
+    std::atomic<unsigned> succeeded(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned c = 0; c < callers; ++c)
+    {
+        threads.emplace_back([&, c]
+                             {
+                                 for (unsigned i = 0; i < perCaller; ++i)
+                                 {
+                                     auto begin = std::chrono::steady_clock::now();
+                                     succeeded += login("user" + std::to_string((c * perCaller + i) % users));
+                                     std::chrono::duration<double, std::micro> latency = std::chrono::steady_clock::now() - begin;
+                                     latencies[c].push_back(latency.count());
+                                 }
+                             });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::vector<double> all;
+    for (std::vector<double> &values : latencies)
+    {
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    RunResult result;
+    result.perSecond = succeeded / elapsed.count();
+    result.p50Us = percentile(all, 0.50);
+    result.p99Us = percentile(all, 0.99);
+    return result;
+}
+
+// Открытый конвейер: count входов отправляются обратными вызовами без ожидания ответов
+static RunResult asyncBurst(AuthClientPool &pool, unsigned count, unsigned users)
+{
+    std::mutex mutex;
+    std::condition_variable done;
+    unsigned completed = 0;
+    std::atomic<unsigned> succeeded(0);
+    std::vector<double> latencies(count);
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < count; ++i)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        pool.authenticateAsync("user" + std::to_string(i % users), "benchmark_password",
+                               [&, i, begin](ConfiguratorErrorCode code, const AuthProtocol::AuthResponse &response)
+                               {
+                                   std::chrono::duration<double, std::micro> latency = std::chrono::steady_clock::now() - begin;
+                                   latencies[i] = latency.count();
+                                   succeeded += code == ConfiguratorErrorCode::SUCCESS && response.status == UserErrorCode::SUCCESS;
+                                   std::lock_guard<std::mutex> lock(mutex);
+                                   if (++completed == count)
+                                   {
+                                       done.notify_one();
+                                   }
+                               });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]
+              { return completed == count; });
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    RunResult result;
+    result.perSecond = succeeded / elapsed.count();
+    result.p50Us = percentile(latencies, 0.50);
+    result.p99Us = percentile(latencies, 0.99);
+    return result;
+}
+
+static void printResult(const char *mode, const RunResult &result)
+{
+    std::cout << mode << ": " << std::setw(7) << result.perSecond << " logins/s, p50 " << std::setw(7) << result.p50Us << " us, p99 "
+              << std::setw(7) << result.p99Us << " us, server accepted " << result.connections << " connections\n";
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned perCaller = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 2000;
+    const unsigned users = 1000;
+    const unsigned callers = 16;
+
+    {
+        std::ofstream active(activeUsersPath);
+        for (unsigned i = 0; i < users; ++i)
+        {
+            active << "user" << i << " benchmark_password 01.01.2020 1\n";
+        }
+    }
+    std::ofstream(archivePath) << "";
+    std::ofstream(configPath) << "maxFailedAttempts 5\n"
+                              << "passwordExpirationDays 36500\n";
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+    db.enableActiveUsersIndex();
+    SecurityConfig config(configPath);
+    NullHashing hasher;
+    Authenticator authenticator(&db, &config, &hasher);
+
+    AuthServerOptions options;
+    options.socketPath = socketPath;
+    options.workers = 2;
+    options.rateLimits.login = {0, 0};
+    options.rateLimits.source = {0, 0};
+    options.tcp = true;
+    AuthServer server(&authenticator, options);
+    if (server.start() != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Cannot listen on " << socketPath << "\n";
+        return 1;
+    }
+    std::thread loop([&server]
+                     { server.run(); });
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "null hasher, 2 workers, " << callers << " calling threads x " << perCaller << " logins\n";
+    uint64_t accepted = 0;
+    auto acceptedSince = [&server, &accepted]
+    {
+        uint64_t now = server.stats().accepted;
+        uint64_t delta = now - accepted;
+        accepted = now;
+        return delta;
+    };
+
+    // Соединение на каждый вход, как у user_system с сервером
+    RunResult result = closedLoop(callers, perCaller / 4, users, [](const std::string &login)
+                                  {
+                                      AuthClient client;
+                                      AuthProtocol::AuthResponse response;
+                                      return client.connect(socketPath) == ConfiguratorErrorCode::SUCCESS &&
+                                             client.authenticate(login, "benchmark_password", response) == ConfiguratorErrorCode::SUCCESS &&
+                                             response.status == UserErrorCode::SUCCESS;
+                                  });
+    result.connections = acceptedSince();
+    printResult("connect per call  ", result);
+
+    for (bool tcp : {false, true})
+    {
+        AuthClientPoolOptions poolOptions;
+        poolOptions.socketPath = socketPath;
+        poolOptions.tcpPort = tcp ? server.tcpPort() : 0;
+        AuthClientPool pool(poolOptions);
+        result = closedLoop(callers, perCaller, users, [&pool](const std::string &login)
+                            {
+                                AuthProtocol::AuthResponse response;
+                                return pool.authenticate(login, "benchmark_password", response) == ConfiguratorErrorCode::SUCCESS &&
+                                       response.status == UserErrorCode::SUCCESS;
+                            });
+        result.connections = acceptedSince();
+        printResult(tcp ? "pool sync, tcp    " : "pool sync, unix   ", result);
+
+        result = asyncBurst(pool, callers * perCaller, users);
+        result.connections = acceptedSince();
+        printResult(tcp ? "pool async, tcp   " : "pool async, unix  ", result);
+    }
+
+    server.stop();
+    loop.join();
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+    std::remove(configPath.c_str());
+    return 0;
+}
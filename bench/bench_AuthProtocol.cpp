@@ -0,0 +1,162 @@
+// bench/bench_AuthProtocol.cpp
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AuthClient.hpp"
+#include "AuthServer.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+
+// Хеширование постоянной стоимости без вычислений: время запроса — накладные расходы протокола и сервера
+class NullHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return password == hashedPassword ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+static const std::string archivePath = "./bench_protocol_archive.txt";
+static const std::string activeUsersPath = "./bench_protocol_active_users.txt";
+static const std::string tmpPath = "./bench_protocol_tmp.txt";
+static const std::string configPath = "./bench_protocol_config.txt";
+static const std::string socketPath = "./bench_protocol.sock";
+
+// Кодирование и разбор кадра запроса входа в памяти, нс на запрос
+static double nanosPerFrame(unsigned frames)
+{
+    AuthProtocol::Request request;
+    request.login = "user42";
+    request.password = "benchmark_password";
+    std::string buffer;
+    AuthProtocol::Request decoded;
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < frames; ++i)
+    {
+        buffer.clear();
+        request.id = i;
+        AuthProtocol::appendRequest(buffer, request);
+        size_t pos = 0;
+        AuthProtocol::extractRequest(buffer, pos, decoded);
+        checksum += decoded.id + pos;
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (checksum == 0)
+    {
+        std::cout << "";
+    }
+    return elapsed.count() / frames;
+}
+
+// Запросов в секунду: clients соединений, в каждом пачки по depth запросов одним send, затем depth ответов
+static double requestsPerSecond(unsigned clients, unsigned depth, unsigned perClient, unsigned users)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> callers;
+    for (unsigned c = 0; c < clients; ++c)
+    {
+        callers.emplace_back([c, depth, perClient, users]
+                             {
+                                 AuthClient client;
+                                 if (client.connect(socketPath) != ConfiguratorErrorCode::SUCCESS)
+                                 {
+                                     return;
+                                 }
+                                 AuthProtocol::AuthResponse response;
+                                 for (unsigned done = 0; done < perClient; done += depth)
+                                 {
+                                     for (unsigned i = 0; i < depth; ++i)
+                                     {
+                                         AuthProtocol::Request request;
+                                         request.login = "user" + std::to_string((c * perClient + done + i) % users);
+                                         request.password = "benchmark_password";
+                                         client.queueRequest(request);
+                                     }
+                                     client.flushRequests();
+                                     for (unsigned i = 0; i < depth; ++i)
+                                     {
+                                         client.receiveResponse(response);
+                                     }
+                                 }
+                             });
+    }
+    for (std::thread &caller : callers)
+    {
+        caller.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return clients * perClient / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned perClient = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 19200;
+    const unsigned users = 1000;
+
+    {
+        std::ofstream active(activeUsersPath);
+        for (unsigned i = 0; i < users; ++i)
+        {
+            active << "user" << i << " benchmark_password 01.01.2020 1\n";
+        }
+    }
+    std::ofstream(archivePath) << "";
+    std::ofstream(configPath) << "maxFailedAttempts 5\n"
+                              << "passwordExpirationDays 36500\n";
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "encode + decode login frame: " << nanosPerFrame(1000000) << " ns\n";
+
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+    db.enableActiveUsersIndex();
+    SecurityConfig config(configPath);
+    NullHashing hasher;
+    Authenticator authenticator(&db, &config, &hasher);
+    AuthServerOptions options;
+    options.socketPath = socketPath;
+    options.rateLimits.login = {0, 0};
+    options.rateLimits.source = {0, 0};
+    AuthServer server(&authenticator, options);
+    if (server.start() != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Cannot listen on " << socketPath << "\n";
+        return 1;
+    }
+    std::thread loop([&server]
+                     { server.run(); });
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", null hasher, " << perClient
+              << " logins per connection\n";
+    for (unsigned clients : {1u, 4u})
+    {
+        for (unsigned depth : {1u, 8u, 64u})
+        {
+            std::cout << clients << " conn, pipeline depth " << std::setw(2) << depth << ": " << std::setw(9)
+                      << requestsPerSecond(clients, depth, perClient, users) << " logins/s\n";
+        }
+    }
+
+    server.stop();
+    loop.join();
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+    std::remove(configPath.c_str());
+    return 0;
+}
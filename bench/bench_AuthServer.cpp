@@ -0,0 +1,158 @@
+// bench/bench_AuthServer.cpp
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Argon2Hashing.hpp"
+#include "AuthClient.hpp"
+#include "AuthServer.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+
+// Хеширование без вычислений: показывает накладные расходы сервера
+class NullHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return password == hashedPassword ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+static const std::string archivePath = "./bench_authd_archive.txt";
+static const std::string activeUsersPath = "./bench_authd_active_users.txt";
+static const std::string tmpPath = "./bench_authd_tmp.txt";
+static const std::string configPath = "./bench_authd_config.txt";
+static const std::string socketPath = "./bench_authd.sock";
+
+// База из users учетных записей с паролем password, захешированным hasher
+static void prepareFiles(HashingInterface &hasher, unsigned users)
+{
+    std::string hashedPassword;
+    hasher.pwHashMake("benchmark_password", hashedPassword);
+    std::ofstream active(activeUsersPath);
+    std::ofstream archive(archivePath);
+    for (unsigned i = 0; i < users; ++i)
+    {
+        active << "user" << i << " " << hashedPassword << " 01.01.2020 1\n";
+        archive << "user" << i << " " << hashedPassword << "\n";
+    }
+    std::ofstream(configPath) << "maxFailedAttempts 5\n"
+                              << "passwordExpirationDays 36500\n";
+}
+
+// Вход без сервера: каждый запуск user_system заново читает конфигурацию и ищет пользователя в файле
+static double microsPerColdLogin(HashingInterface &hasher, unsigned users, unsigned iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+        SecurityConfig config(configPath);
+        Authenticator authenticator(&db, &config, &hasher);
+        UserData userData;
+        authenticator.findUser("user" + std::to_string(i * 7919u % users), userData);
+        authenticator.verifyPassword("benchmark_password", userData);
+        authenticator.checkPasswordExpiration(userData);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+// Входов в секунду через сервер при clients параллельных соединениях
+static double loginsPerSecond(unsigned users, unsigned clients, unsigned perClient)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> callers;
+    for (unsigned c = 0; c < clients; ++c)
+    {
+        callers.emplace_back([c, users, perClient]
+                             {
+                                 AuthClient client;
+                                 if (client.connect(socketPath) != ConfiguratorErrorCode::SUCCESS)
+                                 {
+                                     return;
+                                 }
+                                 AuthProtocol::AuthResponse response;
+                                 for (unsigned i = 0; i < perClient; ++i)
+                                 {
+                                     client.authenticate("user" + std::to_string((c * perClient + i) % users),
+                                                         "benchmark_password", response);
+                                 }
+                             });
+    }
+    for (std::thread &caller : callers)
+    {
+        caller.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return clients * perClient / elapsed.count();
+}
+
+// Сравнение входа без сервера и через сервер на одном хешере
+static void runScenario(const char *name, HashingInterface &hasher, unsigned users, unsigned coldIterations, unsigned perClient)
+{
+    prepareFiles(hasher, users);
+    double cold = microsPerColdLogin(hasher, users, coldIterations);
+
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+    db.enableActiveUsersIndex();
+    SecurityConfig config(configPath);
+    Authenticator authenticator(&db, &config, &hasher);
+    AuthServerOptions options;
+    options.socketPath = socketPath;
+    options.rateLimits.login = {0, 0};
+    options.rateLimits.source = {0, 0};
+    AuthServer server(&authenticator, options);
+    if (server.start() != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Cannot listen on " << socketPath << "\n";
+        return;
+    }
+    std::thread loop([&server]
+                     { server.run(); });
+
+    std::cout << name << ", " << users << " users: in-process cold login " << std::setw(10) << cold << " us";
+    for (unsigned clients : {1u, 4u, 16u})
+    {
+        std::cout << " | authd " << std::setw(2) << clients << " conn " << std::setw(10)
+                  << loginsPerSecond(users, clients, perClient) << " logins/sec";
+    }
+    std::cout << "\n";
+
+    server.stop();
+    loop.join();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned users = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 10000;
+    unsigned argonIterations = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 10;
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    NullHashing null;
+    runScenario("null hasher", null, users, 100, 2000);
+
+    Argon2Hashing argon2(1, 8192);
+    runScenario("argon2id t=1 m=8MiB", argon2, users, argonIterations, argonIterations);
+
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+    std::remove(configPath.c_str());
+    return 0;
+}
@@ -0,0 +1,139 @@
+// bench/bench_AuthSupervisor.cpp
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Argon2Hashing.hpp"
+#include "AuthClient.hpp"
+#include "AuthServer.hpp"
+#include "AuthSupervisor.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+
+static const std::string archivePath = "./bench_supervisor_archive.txt";
+static const std::string activeUsersPath = "./bench_supervisor_active_users.txt";
+static const std::string tmpPath = "./bench_supervisor_tmp.txt";
+static const std::string configPath = "./bench_supervisor_config.txt";
+static const std::string socketPath = "./bench_supervisor.sock";
+
+static AuthServer *workerServer = nullptr;
+
+// SIGTERM от родителя останавливает сервер рабочего процесса
+static void stopWorkerServer(int)
+{
+    if (workerServer != nullptr)
+    {
+        workerServer->stop();
+    }
+}
+
+// Входов в секунду: processes процессов по одному потоку хеширования, 2 соединения на процесс
+static double loginsPerSecond(Authenticator &authenticator, size_t processes, unsigned perClient, unsigned users)
+{
+    AuthSupervisorOptions options;
+    options.socketPath = socketPath;
+    options.processes = processes;
+    AuthSupervisor supervisor(options);
+    if (supervisor.listen() != ConfiguratorErrorCode::SUCCESS)
+    {
+        return 0;
+    }
+    AuthServerOptions serverOptions;
+    serverOptions.listenFd = supervisor.socket();
+    serverOptions.workers = 1;
+    serverOptions.rateLimits.login = {0, 0};
+    serverOptions.rateLimits.source = {0, 0};
+    std::thread parent([&]
+                       { supervisor.run([&](size_t)
+                                        {
+                                            AuthServer server(&authenticator, serverOptions);
+                                            if (server.start() != ConfiguratorErrorCode::SUCCESS)
+                                            {
+                                                return 1;
+                                            }
+                                            workerServer = &server;
+                                            std::signal(SIGTERM, stopWorkerServer);
+                                            server.run();
+                                            return 0;
+                                        }); });
+
+    unsigned clients = static_cast<unsigned>(2 * processes);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> callers;
+    for (unsigned c = 0; c < clients; ++c)
+    {
+        callers.emplace_back([c, perClient, users]
+                             {
+                                 AuthClient client;
+                                 // Процессы могут еще запускаться: соединение принимает слушающий сокет родителя
+                                 if (client.connect(socketPath) != ConfiguratorErrorCode::SUCCESS)
+                                 {
+                                     return;
+                                 }
+                                 AuthProtocol::AuthResponse response;
+                                 for (unsigned i = 0; i < perClient; ++i)
+                                 {
+                                     client.authenticate("user" + std::to_string((c * perClient + i) % users), "benchmark_password", response);
+                                 }
+                             });
+    }
+    for (std::thread &caller : callers)
+    {
+        caller.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    supervisor.stop();
+    parent.join();
+    return clients * perClient / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned perClient = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 100;
+    const unsigned users = 64;
+
+    Argon2Hashing hasher(1, 8192);
+    std::string hashedPassword;
+    hasher.pwHashMake("benchmark_password", hashedPassword);
+    {
+        std::ofstream active(activeUsersPath);
+        std::ofstream archive(archivePath);
+        for (unsigned i = 0; i < users; ++i)
+        {
+            active << "user" << i << " " << hashedPassword << " 01.01.2020 1\n";
+            archive << "user" << i << " " << hashedPassword << "\n";
+        }
+    }
+    std::ofstream(configPath) << "maxFailedAttempts 5\n"
+                              << "passwordExpirationDays 36500\n";
+
+    // База, конфигурация и хешер создаются до fork и достаются процессам общими страницами
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+    db.enableActiveUsersIndex();
+    SecurityConfig config(configPath);
+    Authenticator authenticator(&db, &config, &hasher);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", argon2id t=1 m=8MiB, " << perClient
+              << " logins per connection, 2 connections per process\n";
+    for (size_t processes = 1; processes <= 4; processes *= 2)
+    {
+        std::cout << processes << " processes: " << std::setw(7) << loginsPerSecond(authenticator, processes, perClient, users)
+                  << " logins/s\n";
+    }
+
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+    std::remove(configPath.c_str());
+    return 0;
+}
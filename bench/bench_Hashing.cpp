@@ -0,0 +1,70 @@
+// bench/bench_Hashing.cpp
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "Argon2Hashing.hpp"
+#include "Argon2Kernels.hpp"
+#include "Hashing.hpp"
+
+// Измерение числа проверок пароля в секунду в одном потоке (то есть на одно ядро)
+static double verifiesPerSecond(HashingInterface &hasher, const std::string &hashedPassword, unsigned iterations)
+{
+    const std::string password = "benchmark_password";
+
+    // Прогрев: первое обращение выделяет память арены
+    hasher.pwHashVerify(password, hashedPassword);
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        if (hasher.pwHashVerify(password, hashedPassword) != ConfiguratorErrorCode::SUCCESS)
+        {
+            std::cerr << "Verification failed\n";
+            std::exit(1);
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return iterations / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned iterations = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 20;
+
+    Hashing sodium;
+
+    // Все хеши создаются с параметрами crypto_pwhash_*_INTERACTIVE (t=2, m=64 МиБ, p=1)
+    std::string hashedPassword;
+    if (sodium.pwHashMake("benchmark_password", hashedPassword) != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Hashing failed\n";
+        return 1;
+    }
+
+    double sodiumRate = verifiesPerSecond(sodium, hashedPassword, iterations);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "argon2id t=2 m=64MiB p=1, " << iterations << " verifies per engine, 1 thread\n";
+    std::cout << "Hashing (libsodium):           " << sodiumRate << " verifies/sec/core\n";
+
+    // Каждая поддерживаемая процессором реализация функции сжатия встроенного Argon2
+    const Argon2Kernel kernels[] = {Argon2Kernel::PORTABLE, Argon2Kernel::SSE41, Argon2Kernel::AVX2, Argon2Kernel::AVX512};
+    for (Argon2Kernel kernel : kernels)
+    {
+        if (!Argon2Kernels::isSupported(kernel))
+        {
+            continue;
+        }
+        Argon2Hashing argon2(2, 65536, kernel);
+        double argon2Rate = verifiesPerSecond(argon2, hashedPassword, iterations);
+        std::cout << "Argon2Hashing (" << std::left << std::setw(8) << Argon2Kernels::name(kernel) << std::right << "):      "
+                  << argon2Rate << " verifies/sec/core (" << argon2Rate / sodiumRate << "x)\n";
+    }
+    std::cout << "Selected at startup: " << Argon2Kernels::name(Argon2Kernels::best()) << "\n";
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+// bench/bench_HashingWorkerPool.cpp
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Argon2Hashing.hpp"
+#include "HashingWorkerPool.hpp"
+
+// Задержки интерактивных проверок на фоне массового хеширования.
+// interactivePriority задает класс интерактивных задач (BULK — пул без приоритетов)
+static void runScenario(const char *name, HashingPriority interactivePriority, std::chrono::microseconds p99Target,
+                        unsigned bulkJobs, unsigned interactiveRequests)
+{
+    Argon2Hashing hasher(1, 8192);
+    std::string hashedPassword;
+    hasher.pwHashMake("interactive_password", hashedPassword);
+
+    HashingPoolOptions options;
+    options.workers = std::max(2u, std::thread::hardware_concurrency());
+    options.interactiveP99Target = p99Target;
+    HashingWorkerPool pool(&hasher, options);
+
+    // Массовое задание ставится в очередь целиком, как при импорте
+    std::vector<std::future<ConfiguratorErrorCode>> bulk;
+    for (unsigned i = 0; i < bulkJobs; ++i)
+    {
+        bulk.push_back(pool.submit(HashingPriority::BULK, [i](HashingInterface &engine)
+                                   {
+                                       std::string out;
+                                       return engine.pwHashMake("bulk_password_" + std::to_string(i), out);
+                                   }));
+    }
+
+    // Интерактивные входы приходят с постоянным интервалом
+    std::vector<double> latencies;
+    for (unsigned i = 0; i < interactiveRequests; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        pool.submitVerify(interactivePriority, "interactive_password", hashedPassword).get();
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        latencies.push_back(elapsed.count());
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    auto bulkStart = std::chrono::steady_clock::now();
+    for (auto &job : bulk)
+    {
+        job.get();
+    }
+    std::chrono::duration<double, std::milli> bulkTail = std::chrono::steady_clock::now() - bulkStart;
+
+    std::sort(latencies.begin(), latencies.end());
+    double p50 = latencies[latencies.size() / 2];
+    double p99 = latencies[(latencies.size() * 99 + 99) / 100 - 1];
+    std::cout << std::left << std::setw(28) << name << std::right
+              << " interactive p50 " << std::setw(8) << p50 << " ms, p99 " << std::setw(8) << p99
+              << " ms, bulk drained " << std::setw(8) << bulkTail.count() << " ms after\n";
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned bulkJobs = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 200;
+    unsigned interactiveRequests = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 50;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "argon2id t=1 m=8MiB, " << bulkJobs << " bulk pwHashMake, " << interactiveRequests
+              << " interactive verifies, " << std::max(2u, std::thread::hardware_concurrency()) << " workers\n";
+
+    runScenario("FIFO (no priorities)", HashingPriority::BULK, std::chrono::microseconds(0), bulkJobs, interactiveRequests);
+    runScenario("priorities", HashingPriority::INTERACTIVE, std::chrono::microseconds(0), bulkJobs, interactiveRequests);
+    runScenario("priorities + p99 throttle", HashingPriority::INTERACTIVE, std::chrono::microseconds(5000), bulkJobs, interactiveRequests);
+    return 0;
+}
@@ -0,0 +1,247 @@
+// bench/bench_HttpEndpoint.cpp
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "AuthClient.hpp"
+#include "AuthServer.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "HttpProtocol.hpp"
+#include "SecurityConfig.hpp"
+
+// Хеширование постоянной стоимости без вычислений: время запроса — накладные расходы протокола и сервера
+class NullHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return password == hashedPassword ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+static const std::string archivePath = "./bench_http_archive.txt";
+static const std::string activeUsersPath = "./bench_http_active_users.txt";
+static const std::string tmpPath = "./bench_http_tmp.txt";
+static const std::string configPath = "./bench_http_config.txt";
+static const std::string socketPath = "./bench_http.sock";
+
+// Задержки запросов всех генераторов нагрузки, мкс, и общее время прогона
+struct Latencies
+{
+    std::vector<double> samples;
+    double elapsedSeconds = 0;
+};
+
+// Генератор нагрузки HTTP: соединение keep-alive, следующий запрос после ответа на предыдущий
+static void httpClient(uint16_t port, unsigned requests, unsigned offset, unsigned users, std::vector<double> &samples)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return;
+    }
+    std::string in;
+    char chunk[4096];
+    for (unsigned i = 0; i < requests; ++i)
+    {
+        std::string body = "{\"login\":\"user" + std::to_string((offset + i) % users) + "\",\"password\":\"benchmark_password\"}";
+        std::string request = "POST /authenticate HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\nContent-Length: " +
+                              std::to_string(body.size()) + "\r\n\r\n" + body;
+        auto start = std::chrono::steady_clock::now();
+        send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+        size_t total = std::string::npos;
+        while (total == std::string::npos || in.size() < total)
+        {
+            ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0)
+            {
+                close(fd);
+                return;
+            }
+            in.append(chunk, static_cast<size_t>(received));
+            size_t headerEnd = in.find("\r\n\r\n");
+            size_t lengthAt = in.find("Content-Length: ");
+            if (headerEnd != std::string::npos && lengthAt < headerEnd)
+            {
+                total = headerEnd + 4 + std::stoul(in.substr(lengthAt + 16));
+            }
+        }
+        in.erase(0, total);
+        std::chrono::duration<double, std::micro> latency = std::chrono::steady_clock::now() - start;
+        samples.push_back(latency.count());
+    }
+    close(fd);
+}
+
+// Тот же поток запросов по двоичному протоколу через блокирующий AuthClient
+static void binaryClient(unsigned requests, unsigned offset, unsigned users, std::vector<double> &samples)
+{
+    AuthClient client;
+    if (client.connect(socketPath) != ConfiguratorErrorCode::SUCCESS)
+    {
+        return;
+    }
+    AuthProtocol::AuthResponse response;
+    for (unsigned i = 0; i < requests; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        client.authenticate("user" + std::to_string((offset + i) % users), "benchmark_password", response);
+        std::chrono::duration<double, std::micro> latency = std::chrono::steady_clock::now() - start;
+        samples.push_back(latency.count());
+    }
+}
+
+// clients генераторов по perClient запросов; задержки всех запросов в одном массиве
+static Latencies runLoad(bool http, uint16_t port, unsigned clients, unsigned perClient, unsigned users)
+{
+    std::vector<std::vector<double>> perThread(clients);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned c = 0; c < clients; ++c)
+    {
+        threads.emplace_back([&, c]
+                             {
+                                 perThread[c].reserve(perClient);
+                                 if (http)
+                                 {
+                                     httpClient(port, perClient, c * perClient, users, perThread[c]);
+                                 }
+                                 else
+                                 {
+                                     binaryClient(perClient, c * perClient, users, perThread[c]);
+                                 }
+                             });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    Latencies result;
+    result.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (const std::vector<double> &samples : perThread)
+    {
+        result.samples.insert(result.samples.end(), samples.begin(), samples.end());
+    }
+    std::sort(result.samples.begin(), result.samples.end());
+    return result;
+}
+
+// Разбор запроса входа, тела JSON и формирование ответа в памяти, нс на запрос
+static double nanosPerHttpRequest(unsigned requests)
+{
+    std::string body = "{\"login\":\"user42\",\"password\":\"benchmark_password\"}";
+    std::string raw = "POST /authenticate HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\nContent-Length: " +
+                      std::to_string(body.size()) + "\r\n\r\n" + body;
+    std::string login;
+    std::string password;
+    std::string response;
+    size_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < requests; ++i)
+    {
+        size_t pos = 0;
+        size_t scanned = 0;
+        HttpProtocol::Request request;
+        HttpProtocol::extractRequest(raw, pos, scanned, request);
+        HttpProtocol::parseCredentials(request.body, login, password);
+        response.clear();
+        HttpProtocol::appendResponse(response, 200, "{\"status\":\"SUCCESS\",\"attemptsLeft\":5}", request.keepAlive);
+        checksum += pos + login.size() + response.size();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (checksum == 0)
+    {
+        std::cout << "";
+    }
+    return elapsed.count() / requests;
+}
+
+static double percentile(const std::vector<double> &sorted, double fraction)
+{
+    return sorted.empty() ? 0 : sorted[std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()))];
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned perClient = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 20000;
+    const unsigned users = 1000;
+
+    {
+        std::ofstream active(activeUsersPath);
+        for (unsigned i = 0; i < users; ++i)
+        {
+            active << "user" << i << " benchmark_password 01.01.2020 1\n";
+        }
+    }
+    std::ofstream(archivePath) << "";
+    std::ofstream(configPath) << "maxFailedAttempts 5\n"
+                              << "passwordExpirationDays 36500\n";
+
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+    db.enableActiveUsersIndex();
+    SecurityConfig config(configPath);
+    NullHashing hasher;
+    Authenticator authenticator(&db, &config, &hasher);
+    AuthServerOptions options;
+    options.socketPath = socketPath;
+    options.rateLimits.login = {0, 0};
+    options.rateLimits.source = {0, 0};
+    options.http = true;
+    AuthServer server(&authenticator, options);
+    if (server.start() != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Cannot listen on " << socketPath << " and 127.0.0.1\n";
+        return 1;
+    }
+    std::thread loop([&server]
+                     { server.run(); });
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "parse HTTP login + JSON body + format response: " << nanosPerHttpRequest(1000000) << " ns\n";
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", null hasher, " << perClient
+              << " logins per connection, one request in flight per connection\n";
+    for (unsigned clients : {1u, 4u})
+    {
+        for (bool http : {false, true})
+        {
+            Latencies result = runLoad(http, server.httpPort(), clients, perClient, users);
+            std::cout << clients << " conn, " << (http ? "HTTP/1.1  " : "binary    ") << ": p50 " << std::setw(6)
+                      << percentile(result.samples, 0.5) << " us, p99 " << std::setw(6) << percentile(result.samples, 0.99)
+                      << " us, " << std::setw(8) << result.samples.size() / result.elapsedSeconds << " logins/s\n";
+        }
+    }
+
+    server.stop();
+    loop.join();
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+    std::remove(configPath.c_str());
+    return 0;
+}
@@ -0,0 +1,158 @@
+// bench/bench_IoBackend.cpp
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "ConfiguratorDatabase.hpp"
+#include "IoBackend.hpp"
+#include "IoUringBackend.hpp"
+#include "ThreadPoolIoBackend.hpp"
+
+static const std::string archivePath = "./bench_io_archive.txt";
+static const std::string activeUsersPath = "./bench_io_active_users.txt";
+static const std::string tmpPath = "./bench_io_tmp.txt";
+static const std::string logPath = "./bench_io_log.txt";
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Поисков в секунду без индекса: каждый поиск читает таблицу целиком (iostream построчно)
+static double syncLookups(ConfiguratorDatabase &db, unsigned lookups, unsigned users)
+{
+    std::string userData;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < lookups; ++i)
+    {
+        db.getActiveUserByLogin("user" + std::to_string(i * 7919 % users), userData);
+    }
+    return lookups / secondsSince(start);
+}
+
+// То же через backend: по batch поисков за одну отправку
+static double asyncLookups(ConfiguratorDatabase &db, IoBackendInterface &backend, unsigned lookups, unsigned users, unsigned batch)
+{
+    db.setIoBackend(&backend);
+    unsigned found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < lookups; i += batch)
+    {
+        for (unsigned j = i; j < i + batch && j < lookups; ++j)
+        {
+            db.getActiveUserAsync("user" + std::to_string(j * 7919 % users), [&found](ConfiguratorErrorCode code, const std::string &)
+                                  { found += code == ConfiguratorErrorCode::SUCCESS; });
+        }
+        backend.submit();
+        while (backend.inFlight() > 0)
+        {
+            backend.complete(true);
+            backend.submit();
+        }
+    }
+    double result = lookups / secondsSince(start);
+    db.setIoBackend(nullptr);
+    return found == lookups ? result : 0;
+}
+
+// Записей журнала в секунду: write и fsync на каждую запись
+static double syncAppends(unsigned records)
+{
+    int fd = open(logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0600);
+    std::string line = "user42 $argon2id$v=19$m=65536,t=3,p=1$placeholder$placeholder\n";
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < records; ++i)
+    {
+        if (write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size()) || fsync(fd) != 0)
+        {
+            close(fd);
+            return 0;
+        }
+    }
+    double result = records / secondsSince(start);
+    close(fd);
+    return result;
+}
+
+// То же через backend: batch записей и один fsync за отправку
+static double batchedAppends(IoBackendInterface &backend, unsigned records, unsigned batch)
+{
+    int fd = open(logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0600);
+    std::string line = "user42 $argon2id$v=19$m=65536,t=3,p=1$placeholder$placeholder\n";
+    unsigned failed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < records; i += batch)
+    {
+        for (unsigned j = i; j < i + batch && j < records; ++j)
+        {
+            backend.write(fd, line.data(), line.size(), -1, [&failed, &line](ssize_t result)
+                          { failed += result != static_cast<ssize_t>(line.size()); });
+        }
+        backend.fsync(fd, [&failed](ssize_t result)
+                      { failed += result != 0; });
+        backend.submit();
+        while (backend.inFlight() > 0)
+        {
+            backend.complete(true);
+        }
+    }
+    double result = records / secondsSince(start);
+    close(fd);
+    return failed == 0 ? result : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned lookups = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 2000;
+    unsigned records = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 2000;
+    const unsigned users = 10000;
+    const unsigned batch = 32;
+
+    {
+        std::ofstream active(activeUsersPath);
+        for (unsigned i = 0; i < users; ++i)
+        {
+            active << "user" << i << " $argon2id$v=19$m=65536,t=3,p=1$placeholder$placeholder 01.01.2020 1\n";
+        }
+        std::ofstream archive(archivePath);
+    }
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+
+    std::vector<std::unique_ptr<IoBackendInterface>> backends;
+    std::unique_ptr<IoUringBackend> ring = std::make_unique<IoUringBackend>(256);
+    if (ring->available())
+    {
+        backends.push_back(std::move(ring));
+    }
+    backends.push_back(std::make_unique<ThreadPoolIoBackend>(2));
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << users << " users without index, " << lookups << " lookups; " << records << " log records; batch " << batch << "\n";
+    std::cout << "lookups/s  iostream: " << std::setw(8) << syncLookups(db, lookups, users) << "\n";
+    for (std::unique_ptr<IoBackendInterface> &backend : backends)
+    {
+        std::cout << "lookups/s  " << std::left << std::setw(9) << backend->name() << std::right << ": " << std::setw(8)
+                  << asyncLookups(db, *backend, lookups, users, batch) << "\n";
+    }
+    std::cout << "appends/s  write+fsync each: " << std::setw(8) << syncAppends(records) << "\n";
+    for (std::unique_ptr<IoBackendInterface> &backend : backends)
+    {
+        std::cout << "appends/s  " << std::left << std::setw(9) << backend->name() << std::right << " batch: " << std::setw(8)
+                  << batchedAppends(*backend, records, batch) << "\n";
+    }
+
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+    std::remove(logPath.c_str());
+    return 0;
+}
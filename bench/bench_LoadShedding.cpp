@@ -0,0 +1,283 @@
+// bench/bench_LoadShedding.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "AuthClient.hpp"
+#include "AuthServer.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+
+// Проверка постоянной длительности: поток исполнителя занят verifyMs, процессор свободен для генератора
+class SleepHashing : public HashingInterface
+{
+    unsigned verifyMs;
+
+public:
+    explicit SleepHashing(unsigned delay) : verifyMs(delay) {}
+
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(verifyMs));
+        return password == hashedPassword ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+static const std::string archivePath = "./bench_shedding_archive.txt";
+static const std::string activeUsersPath = "./bench_shedding_active_users.txt";
+static const std::string tmpPath = "./bench_shedding_tmp.txt";
+static const std::string configPath = "./bench_shedding_config.txt";
+static const std::string socketPath = "./bench_shedding.sock";
+
+static int connectServer()
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    socketPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Результат прогона
+struct RunResult
+{
+    double offered = 0;        // Запросов в секунду по расписанию
+    double succeeded = 0;      // Успешных входов в секунду
+    double shedShare = 0;      // Доля OVERLOADED или DEADLINE_EXCEEDED
+    double successP50Ms = 0;   // Задержка успешных входов от момента по расписанию
+    double successP99Ms = 0;
+    double successMaxMs = 0;
+    double rejectionP99Ms = 0; // Задержка ответа OVERLOADED или DEADLINE_EXCEEDED
+};
+
+static double percentile(std::vector<double> &values, double share)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, static_cast<size_t>(share * values.size()))];
+}
+
+// Открытая нагрузка: connections соединений отправляют запросы по расписанию с общей частотой rate
+// независимо от ответов; задержка считается от момента по расписанию, поэтому отставание генератора
+// тоже входит в задержку
+static RunResult openLoop(double rate, double seconds, unsigned connections, unsigned users)
+{
+    size_t perConnection = static_cast<size_t>(rate * seconds / connections);
+    std::vector<std::vector<double>> latencies(connections);
+    std::vector<std::vector<double>> rejections(connections);
+    auto start = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+    auto scheduled = [&](unsigned connection, size_t i)
+    {
+        return start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                           std::chrono::duration<double>((i * connections + connection) / rate));
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned c = 0; c < connections; ++c)
+    {
+        int fd = connectServer();
+        if (fd < 0)
+        {
+            return RunResult();
+        }
+        threads.emplace_back([&, c, fd]
+                             {
+                                 for (size_t i = 0; i < perConnection; ++i)
+                                 {
+                                     std::this_thread::sleep_until(scheduled(c, i));
+                                     AuthProtocol::Request request;
+                                     request.id = static_cast<uint32_t>(i);
+                                     request.login = "user" + std::to_string((i * connections + c) % users);
+                                     request.password = "benchmark_password";
+                                     std::string frame;
+                                     AuthProtocol::appendRequest(frame, request);
+                                     if (send(fd, frame.data(), frame.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(frame.size()))
+                                     {
+                                         return;
+                                     }
+                                 }
+                             });
+        threads.emplace_back([&, c, fd]
+                             {
+                                 std::string in;
+                                 size_t pos = 0;
+                                 size_t received = 0;
+                                 char chunk[4096];
+                                 while (received < perConnection)
+                                 {
+                                     AuthProtocol::AuthResponse response;
+                                     if (AuthProtocol::extractResponse(in, pos, response) == AuthProtocol::FrameStatus::COMPLETE)
+                                     {
+                                         std::chrono::duration<double, std::milli> latency = std::chrono::steady_clock::now() - scheduled(c, response.requestId);
+                                         (response.status == UserErrorCode::SUCCESS ? latencies[c] : rejections[c]).push_back(latency.count());
+                                         ++received;
+                                         continue;
+                                     }
+                                     in.erase(0, pos);
+                                     pos = 0;
+                                     ssize_t count = recv(fd, chunk, sizeof(chunk), 0);
+                                     if (count <= 0)
+                                     {
+                                         break;
+                                     }
+                                     in.append(chunk, static_cast<size_t>(count));
+                                 }
+                                 close(fd);
+                             });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<double> success;
+    std::vector<double> rejected;
+    for (unsigned c = 0; c < connections; ++c)
+    {
+        success.insert(success.end(), latencies[c].begin(), latencies[c].end());
+        rejected.insert(rejected.end(), rejections[c].begin(), rejections[c].end());
+    }
+    RunResult result;
+    result.offered = rate;
+    result.succeeded = success.size() / seconds;
+    result.shedShare = static_cast<double>(rejected.size()) / std::max<size_t>(1, success.size() + rejected.size());
+    result.successP50Ms = percentile(success, 0.50);
+    result.successP99Ms = percentile(success, 0.99);
+    result.successMaxMs = success.empty() ? 0 : success.back();
+    result.rejectionP99Ms = percentile(rejected, 0.99);
+    return result;
+}
+
+// Пропускная способность сервера: закрытая нагрузка с постоянной очередью
+static double capacity(unsigned connections, unsigned perConnection, unsigned users)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> callers;
+    for (unsigned c = 0; c < connections; ++c)
+    {
+        callers.emplace_back([c, perConnection, users]
+                             {
+                                 AuthClient client;
+                                 if (client.connect(socketPath) != ConfiguratorErrorCode::SUCCESS)
+                                 {
+                                     return;
+                                 }
+                                 AuthProtocol::AuthResponse response;
+                                 for (unsigned i = 0; i < perConnection; ++i)
+                                 {
+                                     client.authenticate("user" + std::to_string((c * perConnection + i) % users), "benchmark_password", response);
+                                 }
+                             });
+    }
+    for (std::thread &caller : callers)
+    {
+        caller.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return connections * perConnection / elapsed.count();
+}
+
+static void printResult(const char *mode, const RunResult &result)
+{
+    std::cout << mode << ": offered " << std::setw(5) << result.offered << "/s, success " << std::setw(5) << result.succeeded
+              << "/s, shed " << std::setw(4) << 100 * result.shedShare << "%, success p50 " << std::setw(6) << result.successP50Ms
+              << " ms, p99 " << std::setw(6) << result.successP99Ms << " ms, max " << std::setw(6) << result.successMaxMs
+              << " ms, rejection p99 " << std::setw(5) << result.rejectionP99Ms << " ms\n";
+}
+
+int main(int argc, char *argv[])
+{
+    double seconds = argc > 1 ? std::atof(argv[1]) : 3;
+    unsigned limitMs = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 100;
+    const unsigned users = 1000;
+    const unsigned verifyMs = 2;
+    const unsigned connections = 8;
+
+    {
+        std::ofstream active(activeUsersPath);
+        for (unsigned i = 0; i < users; ++i)
+        {
+            active << "user" << i << " benchmark_password 01.01.2020 1\n";
+        }
+    }
+    std::ofstream(archivePath) << "";
+    std::ofstream(configPath) << "maxFailedAttempts 5\n"
+                              << "passwordExpirationDays 36500\n";
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+    db.enableActiveUsersIndex();
+    SecurityConfig config(configPath);
+    SleepHashing hasher(verifyMs);
+    Authenticator authenticator(&db, &config, &hasher);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "verify " << verifyMs << " ms (sleep), 2 workers, " << connections << " connections, " << seconds
+              << " s of open-loop load, latency limit and deadline " << limitMs << " ms\n";
+    double serverCapacity = 0;
+    // Без защиты, сброс по ожидаемой задержке, срок запроса того же размера
+    const char *modes[] = {"no shedding ", "shedding    ", "deadline    "};
+    for (int mode = 0; mode < 3; ++mode)
+    {
+        AuthServerOptions options;
+        options.socketPath = socketPath;
+        options.workers = 2;
+        options.rateLimits.login = {0, 0};
+        options.rateLimits.source = {0, 0};
+        options.maxPredictedLatencyMs = mode == 1 ? limitMs : 0;
+        options.requestTimeoutMs = mode == 2 ? limitMs : 0;
+        AuthServer server(&authenticator, options);
+        if (server.start() != ConfiguratorErrorCode::SUCCESS)
+        {
+            std::cerr << "Cannot listen on " << socketPath << "\n";
+            return 1;
+        }
+        std::thread loop([&server]
+                         { server.run(); });
+        if (serverCapacity == 0)
+        {
+            serverCapacity = capacity(connections, 100, users);
+            std::cout << "capacity: " << serverCapacity << " logins/s\n";
+        }
+        for (double load : {1.0 / 2, 3.0})
+        {
+            std::string name = std::string(modes[mode]) + (load < 1 ? "0.5x" : "3x  ");
+            printResult(name.c_str(), openLoop(load * serverCapacity, seconds, connections, users));
+        }
+        server.stop();
+        loop.join();
+        AuthServerStats stats = server.stats();
+        std::cout << modes[mode] << "     verified " << stats.verified << ", overloaded " << stats.overloaded << ", cancelled by deadline "
+                  << stats.cancelledDeadline << "\n";
+    }
+
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+    std::remove(configPath.c_str());
+    return 0;
+}
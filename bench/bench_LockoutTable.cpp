@@ -0,0 +1,104 @@
+// bench/bench_LockoutTable.cpp
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Argon2Hashing.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "LockoutTable.hpp"
+#include "SecurityConfig.hpp"
+
+static const std::string lockoutPath = "./bench_lockout.dat";
+static const std::string configPath = "./bench_lockout_config.txt";
+
+// Среднее время одного вызова verifyPassword в микросекундах
+static double microsPerVerify(const Authenticator &authenticator, const UserData &userData, unsigned iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        authenticator.verifyPassword("wrong_password", userData);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned users = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 50000;
+    unsigned argonIterations = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 5;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::remove(lockoutPath.c_str());
+
+    // Таблица, в которой заблокирована часть из users логинов
+    LockoutTable table;
+    if (table.open(lockoutPath) != ConfiguratorErrorCode::SUCCESS)
+    {
+        std::cerr << "Cannot open " << lockoutPath << "\n";
+        return 1;
+    }
+    std::vector<std::string> logins;
+    for (unsigned i = 0; i < users; ++i)
+    {
+        logins.push_back("user" + std::to_string(i));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string &login : logins)
+    {
+        table.recordFailure(login, 5, 1800, 1000);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "recordFailure (" << users << " logins): " << elapsed.count() / users << " ns/call\n";
+    for (unsigned i = 0; i < users; i += 2)
+    {
+        for (unsigned attempt = 0; attempt < 4; ++attempt)
+        {
+            table.recordFailure(logins[i], 5, 1800, 1000);
+        }
+    }
+
+    int64_t lockedUntil;
+    unsigned locked = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned round = 0; round < 20; ++round)
+    {
+        for (const std::string &login : logins)
+        {
+            locked += table.isLocked(login, 1001, lockedUntil) ? 1 : 0;
+        }
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "isLocked: " << elapsed.count() / (20.0 * users) << " ns/call (" << locked / 20 << " of "
+              << users << " locked)\n";
+
+    // Неверный пароль для заблокированного и незаблокированного логина через Authenticator
+    std::ofstream(configPath) << "lockoutTimeMin 30\n"
+                              << "maxFailedAttempts 1000000\n";
+    SecurityConfig config(configPath);
+    ConfiguratorDatabase db("./bench_lockout_archive.txt", "./bench_lockout_active.txt", "./bench_lockout_tmp.txt");
+    Argon2Hashing argon2;
+    Authenticator authenticator(&db, &config, &argon2, &table);
+
+    UserData userData;
+    argon2.pwHashMake("benchmark_password", userData.passwordHash);
+    userData.login = "open_user";
+    double open = microsPerVerify(authenticator, userData, argonIterations);
+
+    table.recordFailure("locked_user", 1, 1000000000, static_cast<int64_t>(std::time(nullptr)));
+    userData.login = "locked_user";
+    double rejected = microsPerVerify(authenticator, userData, 100000);
+
+    std::cout << "verifyPassword, argon2id t=2 m=64MiB: " << open << " us; locked login rejected in " << rejected << " us\n";
+
+    std::remove(lockoutPath.c_str());
+    std::remove(configPath.c_str());
+    return 0;
+}
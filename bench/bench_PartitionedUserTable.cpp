@@ -0,0 +1,208 @@
+// bench/bench_PartitionedUserTable.cpp
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <pthread.h>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ConfiguratorDatabase.hpp"
+#include "PartitionedUserTable.hpp"
+
+static const std::string archivePath = "./bench_partitioned_archive.txt";
+static const std::string activeUsersPath = "./bench_partitioned_active_users.txt";
+static const std::string tmpPath = "./bench_partitioned_tmp.txt";
+
+// Закрепление потока за ядром, если ядер достаточно
+static void pinToCore(size_t core)
+{
+    unsigned hardware = std::thread::hardware_concurrency();
+    if (hardware > 1)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core % hardware, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+}
+
+// Общая таблица: записи под std::shared_mutex, как у таблицы, которую могут менять при работе
+class SharedUserTable
+{
+    mutable std::shared_mutex mutex;
+    std::unordered_map<std::string, std::string> users;
+
+public:
+    void load(ConfiguratorDatabaseInterface &db)
+    {
+        std::string line;
+        ConfiguratorErrorCode errorCode = db.getFirstActiveUser(line);
+        while (errorCode == ConfiguratorErrorCode::SUCCESS)
+        {
+            users.emplace(line.substr(0, line.find(' ')), line);
+            errorCode = db.getNextActiveUser(line);
+        }
+    }
+
+    size_t lookup(const std::string &login) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = users.find(login);
+        return it != users.end() ? it->second.size() : 0;
+    }
+};
+
+// Логины запросов потока: псевдослучайная последовательность, одинаковая для обеих таблиц
+static std::vector<std::string> requestLogins(size_t thread, unsigned count, unsigned users)
+{
+    std::vector<std::string> logins;
+    unsigned value = static_cast<unsigned>(thread) * 2654435761u + 1;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        value = value * 1103515245u + 12345u;
+        logins.push_back("user" + std::to_string((value >> 8) % users));
+    }
+    return logins;
+}
+
+// Поисков в секунду в общей таблице
+static double sharedThroughput(ConfiguratorDatabase &db, size_t threads, unsigned perThread, unsigned users)
+{
+    SharedUserTable table;
+    table.load(db);
+    std::vector<std::vector<std::string>> logins;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        logins.push_back(requestLogins(t, perThread, users));
+    }
+
+    std::atomic<size_t> sink(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]
+                             {
+                                 pinToCore(t);
+                                 size_t bytes = 0;
+                                 for (const std::string &login : logins[t])
+                                 {
+                                     bytes += table.lookup(login);
+                                 }
+                                 sink += bytes;
+                             });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threads * perThread / elapsed.count();
+}
+
+// Поисков в секунду в разделенной таблице: у каждого потока до window запросов в пути
+static double partitionedThroughput(ConfiguratorDatabase &db, size_t threads, unsigned perThread, unsigned users, size_t window)
+{
+    PartitionedUserTable table(threads);
+    table.load(db);
+    std::vector<std::vector<std::string>> logins;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        logins.push_back(requestLogins(t, perThread, users));
+    }
+
+    std::atomic<size_t> sink(0);
+    std::atomic<size_t> finished(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]
+                             {
+                                 pinToCore(t);
+                                 size_t bytes = 0;
+                                 unsigned completed = 0;
+                                 auto done = [&bytes, &completed](ConfiguratorErrorCode, const std::string *record)
+                                 {
+                                     bytes += record != nullptr ? record->size() : 0;
+                                     ++completed;
+                                 };
+                                 for (const std::string &login : logins[t])
+                                 {
+                                     while (table.inFlight(t) >= window)
+                                     {
+                                         if (table.poll(t) == 0)
+                                         {
+                                             std::this_thread::yield();
+                                         }
+                                     }
+                                     table.lookup(t, login, done);
+                                 }
+                                 while (completed < perThread)
+                                 {
+                                     if (table.poll(t) == 0)
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                 }
+                                 // Поток отвечает на запросы к своему разделу, пока не закончат остальные
+                                 ++finished;
+                                 while (finished < threads)
+                                 {
+                                     if (table.poll(t) == 0)
+                                     {
+                                         std::this_thread::yield();
+                                     }
+                                 }
+                                 sink += bytes;
+                             });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threads * perThread / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned perThread = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 1000000;
+    const unsigned users = 100000;
+    const size_t window = 64;
+
+    {
+        std::ofstream active(activeUsersPath);
+        for (unsigned i = 0; i < users; ++i)
+        {
+            active << "user" << i << " $argon2id$v=19$m=65536,t=3,p=1$placeholder$placeholder 01.01.2020 1\n";
+        }
+        std::ofstream archive(archivePath);
+    }
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", " << users << " users, " << perThread
+              << " lookups per thread, window " << window << "\n";
+    std::cout << "threads  shared (Mlookups/s)  partitioned (Mlookups/s)\n";
+    for (size_t threads = 1; threads <= 8; threads *= 2)
+    {
+        double shared = sharedThroughput(db, threads, perThread, users);
+        double partitioned = partitionedThroughput(db, threads, perThread, users, window);
+        std::cout << std::setw(7) << threads << std::setw(21) << shared / 1e6 << std::setw(26) << partitioned / 1e6 << "\n";
+    }
+
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+    return 0;
+}
@@ -0,0 +1,125 @@
+// bench/bench_ProcessHashing.cpp
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Argon2Hashing.hpp"
+#include "ProcessHashing.hpp"
+
+// Хеширование без вычислений: показывает накладные расходы на передачу запроса
+class NullHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return password == hashedPassword ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+// Резидентная память текущего процесса в МиБ
+static double residentMiB()
+{
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key)
+    {
+        if (key == "VmRSS:")
+        {
+            double kib;
+            status >> kib;
+            return kib / 1024;
+        }
+    }
+    return 0;
+}
+
+// Среднее время одной проверки в микросекундах (один поток)
+static double microsPerVerify(HashingInterface &hasher, const std::string &hashedPassword, unsigned iterations)
+{
+    hasher.pwHashVerify("benchmark_password", hashedPassword);
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        hasher.pwHashVerify("benchmark_password", hashedPassword);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+// Проверок в секунду при threads параллельных вызывающих потоках
+static double verifiesPerSecond(HashingInterface &hasher, const std::string &hashedPassword, unsigned threads, unsigned perThread)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> callers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        callers.emplace_back([&hasher, &hashedPassword, perThread]
+                             {
+                                 for (unsigned i = 0; i < perThread; ++i)
+                                 {
+                                     hasher.pwHashVerify("benchmark_password", hashedPassword);
+                                 }
+                             });
+    }
+    for (std::thread &caller : callers)
+    {
+        caller.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threads * perThread / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned iterations = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 20;
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    // Накладные расходы на обмен с рабочим процессом
+    NullHashing null;
+    {
+        ProcessHashingOptions options;
+        options.workers = 1;
+        ProcessHashing pool(&null, options);
+        double local = microsPerVerify(null, "benchmark_password", 100000);
+        double remote = microsPerVerify(pool, "benchmark_password", 100000);
+        std::cout << "IPC round trip: in-process " << local << " us, worker process " << remote
+                  << " us, added " << remote - local << " us per call\n";
+    }
+
+    // Argon2id с интерактивными параметрами: сначала пул процессов, затем тот же хешер в основном процессе
+    Argon2Hashing argon2;
+    std::string hashedPassword;
+    {
+        ProcessHashingOptions options;
+        options.workers = workers;
+        options.pinWorkers = true;
+        ProcessHashing pool(&argon2, options);
+        pool.pwHashMake("benchmark_password", hashedPassword);
+
+        double latency = microsPerVerify(pool, hashedPassword, iterations) / 1000;
+        double rate = verifiesPerSecond(pool, hashedPassword, workers, iterations);
+        std::cout << "argon2id t=2 m=64MiB, " << workers << " worker process(es):  " << std::setw(8) << latency
+                  << " ms/verify, " << rate << " verifies/sec, front-end RSS " << residentMiB() << " MiB\n";
+    }
+    {
+        double latency = microsPerVerify(argon2, hashedPassword, iterations) / 1000;
+        double rate = verifiesPerSecond(argon2, hashedPassword, workers, iterations);
+        std::cout << "argon2id t=2 m=64MiB, in-process, " << workers << " thread(s): " << std::setw(8) << latency
+                  << " ms/verify, " << rate << " verifies/sec, front-end RSS " << residentMiB() << " MiB\n";
+    }
+    return 0;
+}
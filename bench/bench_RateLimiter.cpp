@@ -0,0 +1,72 @@
+// bench/bench_RateLimiter.cpp
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "RateLimiter.hpp"
+
+// Среднее время allow в нс при обращениях к логинам user<N> в порядке order. Логин собирается
+// в одном буфере, как после разбора запроса сервером: в кеше оказывается только таблица корзин
+static double measure(RateLimiter &limiter, const std::vector<uint32_t> &order, int64_t startMs, size_t &allowed)
+{
+    allowed = 0;
+    std::string login = "user";
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        login.resize(4);
+        login += std::to_string(order[i]);
+        // Время идет вперед: одна миллисекунда на 1000 обращений
+        int64_t nowMs = startMs + static_cast<int64_t>(i / 1000);
+        allowed += limiter.allow(RateLimitKind::LOGIN, login, nowMs) ? 1 : 0;
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / order.size();
+}
+
+int main(int argc, char *argv[])
+{
+    size_t distinct = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1000000;
+    size_t requests = 10000000;
+
+    std::mt19937 random(42);
+    std::vector<uint32_t> order(requests);
+    for (uint32_t &index : order)
+    {
+        index = static_cast<uint32_t>(random() % distinct);
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    const size_t capacities[] = {size_t(1) << 21, size_t(1) << 18};
+    for (size_t capacity : capacities)
+    {
+        RateLimiterOptions options;
+        options.capacity = capacity;
+        RateLimiter limiter(options);
+        size_t allowed;
+        measure(limiter, order, 0, allowed); // Прогрев: заполнение таблицы
+        double ns = measure(limiter, order, static_cast<int64_t>(requests / 1000), allowed);
+        std::cout << distinct << " keys, " << capacity << " buckets (" << capacity * 16 / 1048576 << " MiB): "
+                  << ns << " ns/allow, " << 100.0 * allowed / requests << "% allowed\n";
+    }
+
+    // Один ключ: стоимость без промахов кеша
+    RateLimiter limiter;
+    std::vector<uint32_t> hot(requests, 0);
+    size_t allowed;
+    double ns = measure(limiter, hot, 0, allowed);
+    std::cout << "1 key: " << ns << " ns/allow\n";
+
+    // То же для таблицы в разделяемой памяти (межпроцессные мьютексы вместо спин-блокировок)
+    RateLimiterOptions sharedOptions;
+    sharedOptions.shared = true;
+    RateLimiter sharedLimiter(sharedOptions);
+    ns = measure(sharedLimiter, hot, 0, allowed);
+    std::cout << "1 key, shared: " << ns << " ns/allow\n";
+    return 0;
+}
@@ -0,0 +1,96 @@
+// bench/bench_RequestArena.cpp
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "RequestArena.hpp"
+#include "SecurityConfig.hpp"
+
+static const std::string activeUsersPath = "./bench_arena_active_users.txt";
+static const std::string archivePath = "./bench_arena_archive.txt";
+static const std::string tmpPath = "./bench_arena_tmp.txt";
+static const std::string configPath = "./bench_arena_config.txt";
+
+// Среднее время вызова call в микросекундах
+template <typename Call>
+static double microsPerCall(unsigned iterations, Call call)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        call(i);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned users = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 10000;
+
+    {
+        std::ofstream activeUsers(activeUsersPath);
+        for (unsigned i = 0; i < users; ++i)
+        {
+            activeUsers << "user" << i << " $argon2id$v=19$m=65536,t=2,p=1$c2FsdHNhbHRzYWx0$aGFzaGhhc2hoYXNoaGFzaGhhc2hoYXNoaGFzaA 01.01.2000 1,2\n";
+        }
+    }
+    std::ofstream(archivePath) << "";
+    std::ofstream(configPath) << "maxFailedAttempts 3\npasswordExpirationDays 30\n";
+
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+    SecurityConfig config(configPath);
+    Authenticator authenticator(&db, &config, nullptr);
+    RequestArena arena;
+    UserData userData;
+    std::cout << std::fixed << std::setprecision(2);
+
+    // Поиск чтением файла: логины из второй половины таблицы
+    const unsigned scans = 200;
+    double stream = microsPerCall(scans, [&](unsigned i)
+                                  {
+                                      std::string line;
+                                      db.getActiveUserByLogin("user" + std::to_string(users / 2 + i % (users / 2)), line);
+                                  });
+    double record = microsPerCall(scans, [&](unsigned i)
+                                  {
+                                      std::pmr::string line(arena.resource());
+                                      db.getActiveUserRecord("user" + std::to_string(users / 2 + i % (users / 2)), line);
+                                      arena.reset();
+                                  });
+    std::cout << "file scan, " << users << " users: ifstream/getline " << stream << " us, read/arena " << record << " us\n";
+
+    // Поиск по индексу с разбором записи
+    db.enableActiveUsersIndex();
+    const unsigned lookups = 200000;
+    std::string logins[64];
+    for (unsigned i = 0; i < 64; ++i)
+    {
+        logins[i] = "user" + std::to_string(i * 131 % users);
+    }
+    double heap = microsPerCall(lookups, [&](unsigned i)
+                                {
+                                    UserData fresh;
+                                    authenticator.findUser(logins[i % 64], fresh);
+                                });
+    double reused = microsPerCall(lookups, [&](unsigned i)
+                                  {
+                                      authenticator.findUser(logins[i % 64], userData, arena.resource());
+                                      arena.reset();
+                                  });
+    std::cout << "indexed findUser: new UserData + heap " << heap * 1000 << " ns, reused UserData + arena "
+              << reused * 1000 << " ns\n";
+
+    std::remove(activeUsersPath.c_str());
+    std::remove(archivePath.c_str());
+    std::remove(configPath.c_str());
+    return 0;
+}
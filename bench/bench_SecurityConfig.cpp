@@ -0,0 +1,158 @@
+// bench/bench_SecurityConfig.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "SecurityConfig.hpp"
+#include "SharedSecurityConfig.hpp"
+
+// Прежняя схема для сравнения: поиск в std::map под мьютексом
+class LockedMapConfig
+{
+    mutable std::mutex mutex;
+    const std::string maxFailedAttempts = "maxFailedAttempts";
+    std::map<std::string, unsigned> data = {{"lockoutTimeMin", 30}, {maxFailedAttempts, 5}, {"minPasswordLength", 8}};
+
+public:
+    ConfiguratorErrorCode get_maxFailedAttempts(unsigned &attempts) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = data.find(maxFailedAttempts);
+        if (it == data.end())
+        {
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+        attempts = it->second;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+};
+
+// Среднее время одного чтения в наносекундах при threads параллельных читателях
+template <typename Config>
+static double nanosPerRead(const Config &config, unsigned threads, unsigned perThread)
+{
+    std::atomic<unsigned long> sink(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> readers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        readers.emplace_back([&config, &sink, perThread]
+                             {
+                                 unsigned long sum = 0;
+                                 unsigned val = 0;
+                                 for (unsigned i = 0; i < perThread; ++i)
+                                 {
+                                     config.get_maxFailedAttempts(val);
+                                     sum += val;
+                                 }
+                                 sink += sum;
+                             });
+    }
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / perThread;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned reloads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 100;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned reads = 20000000;
+
+    char directory[] = "/tmp/bench_config_XXXXXX";
+    if (mkdtemp(directory) == nullptr)
+    {
+        return 1;
+    }
+    std::string path = std::string(directory) + "/config.txt";
+    std::ofstream(path) << "maxFailedAttempts 5\nlockoutTimeMin 30\nminPasswordLength 8\n";
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    // Накладные расходы чтения
+    {
+        SecurityConfig config(path);
+        LockedMapConfig locked;
+        std::cout << "get_maxFailedAttempts, " << threads << " reader thread(s): snapshot "
+                  << nanosPerRead(config, threads, reads) << " ns/read, mutex+map "
+                  << nanosPerRead(locked, threads, reads) << " ns/read\n";
+    }
+
+    // Запуск процесса входа: разбор файла против подключения к разделяемой памяти, плюс первое чтение
+    {
+        std::string segmentName = "/bench_config_" + std::to_string(getpid());
+        SecurityConfig publisher(path);
+        publisher.shareVia(segmentName);
+
+        const unsigned startups = 10000;
+        unsigned val = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < startups; ++i)
+        {
+            SecurityConfig config(path);
+            config.get_maxFailedAttempts(val);
+        }
+        std::chrono::duration<double, std::micro> fileStartup = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < startups; ++i)
+        {
+            SharedSecurityConfig config;
+            config.attach(segmentName, path);
+            config.get_maxFailedAttempts(val);
+        }
+        std::chrono::duration<double, std::micro> sharedStartup = std::chrono::steady_clock::now() - start;
+
+        SharedSecurityConfig shared;
+        shared.attach(segmentName, path);
+        std::cout << "startup + first read: file " << fileStartup.count() / startups << " us, shared memory "
+                  << sharedStartup.count() / startups << " us; shared memory read "
+                  << nanosPerRead(shared, threads, reads) << " ns/read\n";
+        shm_unlink(segmentName.c_str());
+    }
+
+    // Задержка перезагрузки: от записи файла другим экземпляром до публикации снимка наблюдателем
+    {
+        SecurityConfig watched(path);
+        watched.watch();
+        SecurityConfig writer(path);
+
+        std::vector<double> latencies;
+        for (unsigned i = 0; i < reloads; ++i)
+        {
+            unsigned long before = watched.snapshotGeneration();
+            auto start = std::chrono::steady_clock::now();
+            writer.set_maxFailedAttempts(6 + i);
+            while (watched.snapshotGeneration() == before)
+            {
+                std::this_thread::yield();
+            }
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+            latencies.push_back(elapsed.count());
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        std::cout << "reload after write (temp+fsync+rename, " << reloads << " times): p50 "
+                  << latencies[latencies.size() / 2] << " us, p99 " << latencies[(latencies.size() * 99 + 99) / 100 - 1]
+                  << " us\n";
+    }
+
+    unlink(path.c_str());
+    rmdir(directory);
+    return 0;
+}
@@ -0,0 +1,80 @@
+// bench/bench_SessionManager.cpp
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SessionManager.hpp"
+
+// Резидентная память текущего процесса в МиБ
+static double residentMiB()
+{
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key)
+    {
+        if (key == "VmRSS:")
+        {
+            double kib;
+            status >> kib;
+            return kib / 1024;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 1000000;
+
+    std::cout << std::fixed << std::setprecision(2);
+    double baseline = residentMiB();
+
+    // Сессии с разным временем бездействия (10–60 минут), как при разных значениях maxInactiveTimeMin
+    SessionManager sessions(0, count);
+    std::vector<std::string> tokens;
+    tokens.reserve(count);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i)
+    {
+        tokens.push_back(sessions.create("user" + std::to_string(i % 100000), 600 + static_cast<int64_t>(i % 3000), 0));
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    double tokensMiB = count * sizeof(std::string) / 1048576.0;
+    std::cout << "create: " << elapsed.count() / count << " ns/session, " << sessions.size() << " sessions, "
+              << (residentMiB() - baseline - tokensMiB) * 1048576 / count << " bytes/session\n";
+
+    // Проверка в случайном порядке с продлением
+    std::mt19937 random(42);
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        order[i] = random() % count;
+    }
+    std::string login;
+    size_t valid = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i : order)
+    {
+        valid += sessions.validate(tokens[i], 300, login) ? 1 : 0;
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "validate: " << elapsed.count() / count << " ns/call (" << valid << " valid)\n";
+
+    // Колесо, продвигаемое раз в секунду, как в цикле authd
+    start = std::chrono::steady_clock::now();
+    int64_t now = 0;
+    while (sessions.size() > 0)
+    {
+        sessions.advance(++now);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "expire all: " << now << " ticks, " << elapsed.count() / 1e6 << " ms total, "
+              << elapsed.count() / count << " ns/session\n";
+    return 0;
+}
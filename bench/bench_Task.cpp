@@ -0,0 +1,177 @@
+// bench/bench_Task.cpp
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Argon2Hashing.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+#include "Task.hpp"
+#include "WorkStealingExecutor.hpp"
+
+static const std::string activeUsersPath = "./bench_task_active_users.txt";
+static const std::string archivePath = "./bench_task_archive.txt";
+static const std::string tmpPath = "./bench_task_tmp.txt";
+static const std::string configPath = "./bench_task_config.txt";
+
+// Учет выделенной памяти: объем на один запрос в полете
+static std::atomic<size_t> allocatedBytes(0);
+
+void *operator new(size_t size)
+{
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void *pointer = std::malloc(size != 0 ? size : 1);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+// Хеширование-заглушка: стоимость самой сопрограммы без хеширования
+class PlainHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = "hash:" + password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return hashedPassword == "hash:" + password ? ConfiguratorErrorCode::SUCCESS
+                                                    : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+// Запуск requests входов сразу; возвращает входов в секунду
+static double inFlightThroughput(Authenticator &authenticator, unsigned requests, size_t hashingWorkers, size_t &bytesPerRequest)
+{
+    std::vector<UserData> results(requests);
+    std::atomic<unsigned> done(0);
+    auto start = std::chrono::steady_clock::now();
+    {
+        WorkStealingOptions databaseOptions;
+        databaseOptions.workers = 1;
+        WorkStealingExecutor database(databaseOptions);
+        WorkStealingOptions hashingOptions;
+        hashingOptions.workers = hashingWorkers;
+        WorkStealingExecutor hashing(hashingOptions);
+        AsyncStages stages{&database, &hashing};
+
+        // Поток базы занят до запуска всех запросов: учитывается только память ожидающих сопрограмм
+        std::atomic<bool> launched(false);
+        database.submit([&launched]
+                        {
+                            while (!launched.load())
+                            {
+                                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                            }
+                        });
+        size_t before = allocatedBytes.load();
+        for (unsigned i = 0; i < requests; ++i)
+        {
+            startTask(authenticator.authenticateAsync("user" + std::to_string(i % 64), "benchmark_password", results[i], stages),
+                      [&done](UserErrorCode)
+                      { ++done; });
+        }
+        bytesPerRequest = (allocatedBytes.load() - before) / requests;
+        launched = true;
+
+        while (done.load() < requests)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return requests / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned requests = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 2000;
+
+    Argon2Hashing argon(1, 8192);
+    std::string hashedPassword;
+    argon.pwHashMake("benchmark_password", hashedPassword);
+    {
+        std::ofstream activeUsers(activeUsersPath);
+        for (unsigned i = 0; i < 64; ++i)
+        {
+            activeUsers << "user" << i << " " << hashedPassword << " 01.01.2000 1\n";
+            activeUsers << "plain" << i << " hash:benchmark_password 01.01.2000 1\n";
+        }
+    }
+    std::ofstream(archivePath) << "";
+    std::ofstream(configPath) << "passwordExpirationDays 36500\nmaxFailedAttempts 1000\n";
+
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+    db.enableActiveUsersIndex();
+    SecurityConfig config(configPath);
+    std::cout << std::fixed << std::setprecision(1);
+
+    // Цена обертки: шаги входа по отдельности и authenticate через syncWait, без хеширования
+    PlainHashing plain;
+    Authenticator plainAuthenticator(&db, &config, &plain);
+    UserData userData;
+    const unsigned calls = 200000;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < calls; ++i)
+    {
+        std::string login = "plain" + std::to_string(i % 64);
+        if (plainAuthenticator.findUser(login, userData) == UserErrorCode::SUCCESS &&
+            plainAuthenticator.checkLockout(userData.login) == UserErrorCode::SUCCESS &&
+            plainAuthenticator.verifyPassword("benchmark_password", userData) == UserErrorCode::SUCCESS)
+        {
+            plainAuthenticator.checkPasswordExpiration(userData);
+        }
+    }
+    std::chrono::duration<double, std::nano> direct = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < calls; ++i)
+    {
+        plainAuthenticator.authenticate("plain" + std::to_string(i % 64), "benchmark_password", userData);
+    }
+    std::chrono::duration<double, std::nano> wrapped = std::chrono::steady_clock::now() - start;
+    std::cout << "login steps, no hashing: direct " << direct.count() / calls << " ns, syncWait(authenticateAsync) "
+              << wrapped.count() / calls << " ns\n";
+
+    // Все запросы в полете сразу на 1 потоке базы и hashing потоках хеширования
+    Authenticator authenticator(&db, &config, &argon);
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", argon2id t=1 m=8MiB, "
+              << requests << " logins in flight\n";
+    for (size_t hashingWorkers = 1; hashingWorkers <= 4; hashingWorkers *= 2)
+    {
+        size_t bytesPerRequest = 0;
+        double rate = inFlightThroughput(authenticator, requests, hashingWorkers, bytesPerRequest);
+        std::cout << "1 database + " << hashingWorkers << " hashing threads: " << rate << " logins/s, "
+                  << bytesPerRequest << " bytes per suspended request\n";
+    }
+
+    std::remove(activeUsersPath.c_str());
+    std::remove(archivePath.c_str());
+    std::remove(tmpPath.c_str());
+    std::remove(configPath.c_str());
+    return 0;
+}
@@ -0,0 +1,119 @@
+// bench/bench_WorkStealingExecutor.cpp
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Argon2Hashing.hpp"
+#include "HashingWorkerPool.hpp"
+#include "WorkStealingExecutor.hpp"
+
+// Дешевый этап запроса (поиск, разбор, проверка срока): несколько микросекунд вычислений
+static unsigned cheapStage(unsigned seed)
+{
+    unsigned value = seed;
+    for (int i = 0; i < 2000; ++i)
+    {
+        value = value * 1103515245u + 12345u;
+    }
+    return value;
+}
+
+// Входов в секунду: этапы запроса — отдельные задачи исполнителя (проверка пароля, затем срок действия)
+static double executorThroughput(HashingInterface &hasher, const std::string &hashedPassword, size_t workers, unsigned requests)
+{
+    std::atomic<unsigned> done(0);
+    std::atomic<unsigned> sink(0);
+    auto start = std::chrono::steady_clock::now();
+    {
+        WorkStealingOptions options;
+        options.workers = workers;
+        WorkStealingExecutor executor(options);
+        for (unsigned i = 0; i < requests; ++i)
+        {
+            sink += cheapStage(i); // Поиск в потоке ввода-вывода
+            executor.submit([&, i]
+                            {
+                                hasher.pwHashVerify("benchmark_password", hashedPassword);
+                                executor.submit([&, i]
+                                                {
+                                                    sink += cheapStage(i);
+                                                    ++done;
+                                                });
+                            });
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return done / elapsed.count();
+}
+
+// То же в пуле с общей очередью: запрос — одна задача
+static double poolThroughput(HashingInterface &hasher, const std::string &hashedPassword, size_t workers, unsigned requests)
+{
+    std::atomic<unsigned> sink(0);
+    auto start = std::chrono::steady_clock::now();
+    {
+        HashingPoolOptions options;
+        options.workers = workers;
+        HashingWorkerPool pool(&hasher, options);
+        std::vector<std::future<ConfiguratorErrorCode>> results;
+        for (unsigned i = 0; i < requests; ++i)
+        {
+            sink += cheapStage(i);
+            results.push_back(pool.submit(HashingPriority::INTERACTIVE, [&, i](HashingInterface &engine)
+                                          {
+                                              ConfiguratorErrorCode code = engine.pwHashVerify("benchmark_password", hashedPassword);
+                                              sink += cheapStage(i);
+                                              return code;
+                                          }));
+        }
+        for (auto &result : results)
+        {
+            result.get();
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return requests / elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned requests = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 200;
+    size_t maxWorkers = argc > 2 ? static_cast<size_t>(std::atoi(argv[2])) : 2 * std::max(1u, std::thread::hardware_concurrency());
+
+    Argon2Hashing hasher(1, 8192);
+    std::string hashedPassword;
+    hasher.pwHashMake("benchmark_password", hashedPassword);
+
+    std::cout << std::fixed << std::setprecision(1) << "hardware threads: " << std::thread::hardware_concurrency()
+              << ", argon2id t=1 m=8MiB, " << requests << " logins\n";
+    for (size_t workers = 1; workers <= maxWorkers; workers *= 2)
+    {
+        double stealing = executorThroughput(hasher, hashedPassword, workers, requests);
+        double pool = poolThroughput(hasher, hashedPassword, workers, requests);
+        // Потоков больше, чем аппаратных: они делят ядра, и число ничего не говорит о масштабировании
+        bool shared = workers > std::thread::hardware_concurrency();
+        std::cout << workers << " workers: work-stealing " << stealing << " logins/s, shared-queue pool " << pool << " logins/s"
+                  << (shared ? " (more workers than hardware threads)" : "") << "\n";
+    }
+
+    // Стоимость постановки задачи из потока ввода-вывода
+    WorkStealingExecutor executor;
+    const unsigned submits = 200000;
+    std::atomic<unsigned> counter(0);
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < submits; ++i)
+    {
+        executor.submit([&counter]
+                        { ++counter; });
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "submit from I/O thread: " << elapsed.count() / submits << " ns/task\n";
+    return 0;
+}
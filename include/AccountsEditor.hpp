@@ -4,6 +4,8 @@
 #include "ConfiguratorDatabaseInterface.hpp"
 #include "HashingInterface.hpp"
 #include "SecurityConfigInterface.hpp"
+#include "PasswordFingerprint.hpp"
+#include "Task.hpp"
 
 #ifndef ACCOUNTS_EDITOR_HPP
 #define ACCOUNTS_EDITOR_HPP
@@ -13,6 +15,7 @@ class ConfiguratorAccountsEditor : public ConfiguratorAccountsEditorInterface
     ConfiguratorDatabaseInterface *db;
     SecurityConfigInterface *config;
     HashingInterface *hasher;
+    PasswordFingerprint *fingerprint; // Отпечатки паролей в архиве (nullptr — выключены)
 
 private:
     // Проверка логина на существование в архиве
@@ -24,19 +27,37 @@ private:
     // Проверка символа из пароля на допустимость
     ConfiguratorErrorCode isValidChar(char c);
 
-    // Проверка пароля на удовлетворение всем требованиям безопасности
-    ConfiguratorErrorCode checkPassword(const std::string &login, const std::string &password);
+    // Проверка, не совпадает ли пароль с одним из прошлых паролей из записи архива
+    ConfiguratorErrorCode checkPasswordReuse(const std::string &login, const std::string &password, std::string userData);
+
+    // Проверка длины и символов пароля по политике безопасности
+    ConfiguratorErrorCode checkPasswordRules(const std::string &password);
+
+    // Проверка пароля на удовлетворение всем требованиям безопасности; начинается и завершается
+    // в потоке исполнителя базы
+    Task<ConfiguratorErrorCode> checkPasswordAsync(const std::string &login, const std::string &password, AsyncStages stages);
+
+    // Формирование записи для БД: хеш пароля и, если отпечатки включены, отпечаток для архива
+    ConfiguratorErrorCode makeArchiveEntry(const std::string &login, const std::string &password, std::string &entry);
 
 public:
-    ConfiguratorAccountsEditor(ConfiguratorDatabaseInterface *database, SecurityConfigInterface *security, HashingInterface *hash);
+    ConfiguratorAccountsEditor(ConfiguratorDatabaseInterface *database, SecurityConfigInterface *security, HashingInterface *hash,
+                               PasswordFingerprint *passwordFingerprint = nullptr);
 
-    // Добавление нового пользователя в БД
+    // Добавление нового пользователя в БД (ожидание createAccountAsync в текущем потоке)
     ConfiguratorErrorCode createAccount(const std::string &login, const std::string &password, const std::vector<UserRole> &roles) override;
 
+    // Сопрограммы добавления пользователя и смены пароля: обращения к базе выполняются
+    // исполнителем stages.database, хеширование — stages.hashing. Аргументы копируются в кадр сопрограммы,
+    // копия пароля затирается при завершении сопрограммы на любом пути
+    Task<ConfiguratorErrorCode> createAccountAsync(std::string login, std::string password, std::vector<UserRole> roles,
+                                                   AsyncStages stages = AsyncStages());
+    Task<ConfiguratorErrorCode> editPasswordAsync(std::string login, std::string newPassword, AsyncStages stages = AsyncStages());
+
     // Удаление пользователя из БД
     ConfiguratorErrorCode deleteAccount(const std::string &login) override;
 
-    // Изменение пароля от учетной записи
+    // Изменение пароля от учетной записи (ожидание editPasswordAsync в текущем потоке)
     ConfiguratorErrorCode editPassword(const std::string &login, const std::string &newPassword) override;
 
     // Изменение списка ролей пользователя
@@ -0,0 +1,81 @@
+// include/Argon2.hpp
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ErrorCode.hpp"
+
+#ifndef ARGON2_HPP
+#define ARGON2_HPP
+
+// Вариант Argon2 (значения совпадают с полем y из RFC 9106)
+enum class Argon2Type
+{
+    ARGON2D = 0,
+    ARGON2I = 1,
+    ARGON2ID = 2
+};
+
+// Реализация функции сжатия (см. Argon2Kernels)
+enum class Argon2Kernel
+{
+    AUTO,
+    PORTABLE,
+    SSE41,
+    AVX2,
+    AVX512
+};
+
+// Блок памяти Argon2 (1 КиБ), выровнен по строке кэша
+struct alignas(64) Argon2Block
+{
+    uint64_t v[128];
+};
+
+// Параметры вычисления Argon2
+struct Argon2Params
+{
+    Argon2Type type = Argon2Type::ARGON2ID;
+    uint32_t timeCost = 2;       // Число проходов t
+    uint32_t memoryKiB = 65536;  // Объем памяти m в КиБ
+    uint32_t lanes = 1;          // Степень параллелизма p
+    const uint8_t *password = nullptr;
+    size_t passwordLength = 0;
+    const uint8_t *salt = nullptr;
+    size_t saltLength = 0;
+    const uint8_t *secret = nullptr; // Необязательный секрет K
+    size_t secretLength = 0;
+    const uint8_t *associatedData = nullptr; // Необязательные связанные данные X
+    size_t associatedDataLength = 0;
+    Argon2Kernel kernel = Argon2Kernel::AUTO; // Реализация функции сжатия
+};
+
+// Встроенная реализация Argon2 версии 0x13 (RFC 9106).
+// Рабочая память берется из арены текущего потока и переиспользуется между вызовами
+class Argon2
+{
+public:
+    static const uint32_t VERSION = 0x13;
+    static const uint32_t SYNC_POINTS = 4; // Число срезов в проходе
+    static const uint32_t MIN_SALT_LENGTH = 8;
+    static const uint32_t MIN_TAG_LENGTH = 4;
+    static const uint32_t MAX_LANES = 0xFFFFFF;
+    static const uint32_t MAX_MEMORY_KIB = 4U * 1024 * 1024; // Ограничение в 4 ГиБ
+
+private:
+    struct Instance;
+
+    // Заполнение одного сегмента (lane, slice) на проходе pass
+    static void fillSegment(const Instance &instance, uint32_t pass, uint32_t lane, uint32_t slice);
+
+    // Вычисление индекса опорного блока в полосе (RFC 9106, раздел 3.4.1.2)
+    static uint32_t indexAlpha(const Instance &instance, uint32_t pass, uint32_t slice, uint32_t index,
+                               uint32_t pseudoRand, bool sameLane);
+
+public:
+    // Вычисление тега длиной tagLength байт; при некорректных параметрах
+    // или неподдерживаемой реализации функции сжатия возвращается HASHING_ERROR
+    static ConfiguratorErrorCode hash(const Argon2Params &params, uint8_t *tag, size_t tagLength);
+};
+
+#endif
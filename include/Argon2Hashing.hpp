@@ -0,0 +1,41 @@
+// include/Argon2Hashing.hpp
+
+#include <string>
+#include <cstdint>
+
+#include "HashingInterface.hpp"
+#include "Argon2.hpp"
+
+#ifndef ARGON2_HASHING_HPP
+#define ARGON2_HASHING_HPP
+
+// Хеширование паролей встроенной реализацией Argon2id.
+// Формат строк совпадает с crypto_pwhash_str из libsodium, поэтому хеши взаимозаменяемы с Hashing
+class Argon2Hashing : public HashingInterface
+{
+public:
+    static const size_t SALT_BYTES = 16; // Длина соли (crypto_pwhash_SALTBYTES)
+    static const size_t HASH_BYTES = 32; // Длина хеша в строке (crypto_pwhash_STRHASHBYTES)
+
+private:
+    uint32_t timeCost;   // Число проходов для новых хешей
+    uint32_t memoryKiB;  // Объем памяти для новых хешей
+    Argon2Kernel kernel; // Реализация функции сжатия
+
+    // Разбор строки формата $argon2id$v=19$m=...,t=...,p=...$соль$хеш
+    static bool parseHashString(const std::string &hashedPassword, Argon2Params &params,
+                                std::string &salt, std::string &hash);
+
+public:
+    // Параметры по умолчанию соответствуют crypto_pwhash_OPSLIMIT/MEMLIMIT_INTERACTIVE,
+    // реализация функции сжатия по умолчанию выбирается по возможностям процессора
+    Argon2Hashing(uint32_t opsLimit = 2, uint32_t memLimitKiB = 65536, Argon2Kernel compressionKernel = Argon2Kernel::AUTO);
+
+    // Метод хеширования пароля
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override;
+
+    // Метод сравнения записанного хеша и хеша данного пароля
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override;
+};
+
+#endif
@@ -0,0 +1,41 @@
+// include/Argon2Kernels.hpp
+
+#include "Argon2.hpp"
+
+#ifndef ARGON2_KERNELS_HPP
+#define ARGON2_KERNELS_HPP
+
+// Реализация функции сжатия G для заполнения блока:
+// next = P(prev ^ ref) ^ prev ^ ref, а при withXor результат дополнительно складывается с next
+using Argon2FillBlock = void (*)(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor);
+
+// Набор реализаций функции сжатия BlaMka; векторная выбирается при запуске по cpuid
+class Argon2Kernels
+{
+public:
+    // Переносимая реализация на 64-битных словах
+    static void fillBlockPortable(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor);
+
+    // Реализация на 128-битных регистрах (SSSE3/SSE4.1)
+    static void fillBlockSse41(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor);
+
+    // Реализация на 256-битных регистрах (AVX2)
+    static void fillBlockAvx2(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor);
+
+    // Реализация на 512-битных регистрах (AVX-512F)
+    static void fillBlockAvx512(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor);
+
+    // Поддерживается ли реализация процессором
+    static bool isSupported(Argon2Kernel kernel);
+
+    // Самая быстрая из поддерживаемых реализаций (определяется один раз)
+    static Argon2Kernel best();
+
+    // Функция для реализации; AUTO соответствует best(), для неподдерживаемой возвращается nullptr
+    static Argon2FillBlock get(Argon2Kernel kernel);
+
+    // Название реализации
+    static const char *name(Argon2Kernel kernel);
+};
+
+#endif
@@ -0,0 +1,68 @@
+// include/AuthClient.hpp
+
+#include <cstdint>
+#include <string>
+
+#include "AuthProtocol.hpp"
+#include "UserRole.hpp"
+
+#ifndef AUTH_CLIENT_HPP
+#define AUTH_CLIENT_HPP
+
+// Клиент сервера аутентификации (authd) по Unix-сокету. Блокирующие методы отправляют запрос и ждут ответа на него;
+// для конвейерной работы запросы накапливаются queueRequest, отправляются одним вызовом flushRequests,
+// а ответы читаются receiveResponse в порядке готовности. Блокирующие методы не смешиваются
+// с неполученными ответами конвейера
+class AuthClient
+{
+    int fd;
+    uint32_t nextRequestId;
+    std::string out; // Запросы, ожидающие отправки
+    std::string in;  // Принятые, но еще не разобранные данные
+    size_t inPos;    // Начало неразобранных данных в in
+
+    // Отправка ровно size байт
+    bool sendAll(const char *data, size_t size);
+
+    // Отправка запроса и прием ответа на него; поля с паролями затираются
+    ConfiguratorErrorCode exchange(AuthProtocol::Request &request, AuthProtocol::AuthResponse &response);
+
+public:
+    AuthClient();
+
+    AuthClient(const AuthClient &) = delete;
+    AuthClient &operator=(const AuthClient &) = delete;
+
+    // Подключение к серверу; ошибка, если сервер не запущен
+    ConfiguratorErrorCode connect(const std::string &socketPath);
+
+    // Запрос аутентификации. Ошибка возвращается при сбое обмена (в том числе когда сервер закрыл
+    // соединение после последней попытки); результат проверки — в response.status
+    ConfiguratorErrorCode authenticate(const std::string &login, const std::string &password, AuthProtocol::AuthResponse &response);
+
+    // Продолжение сессии по токену из успешного ответа authenticate: SUCCESS или SESSION_EXPIRED в response.status
+    ConfiguratorErrorCode resumeSession(const std::string &token, AuthProtocol::AuthResponse &response);
+
+    // Завершение сессии
+    ConfiguratorErrorCode endSession(const std::string &token, AuthProtocol::AuthResponse &response);
+
+    // Смена пароля: проверка текущего пароля и требований к новому; WRONG_PASSWORD, PASSWORD_REJECTED или SUCCESS
+    ConfiguratorErrorCode changePassword(const std::string &login, const std::string &password, const std::string &newPassword,
+                                         AuthProtocol::AuthResponse &response);
+
+    // Проверка роли пользователя сессии: SUCCESS, ROLE_NOT_GRANTED или SESSION_EXPIRED
+    ConfiguratorErrorCode checkRole(const std::string &token, UserRole role, AuthProtocol::AuthResponse &response);
+
+    // Добавление запроса в очередь отправки; request.id получает номер запроса, поля с паролями затираются
+    ConfiguratorErrorCode queueRequest(AuthProtocol::Request &request);
+
+    // Отправка накопленных запросов одним блоком
+    ConfiguratorErrorCode flushRequests();
+
+    // Прием очередного ответа; ответы приходят в порядке готовности, а не отправки
+    ConfiguratorErrorCode receiveResponse(AuthProtocol::AuthResponse &response);
+
+    ~AuthClient();
+};
+
+#endif
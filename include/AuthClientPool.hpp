@@ -0,0 +1,175 @@
+// include/AuthClientPool.hpp
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "AuthProtocol.hpp"
+#include "UserRole.hpp"
+
+#ifndef AUTH_CLIENT_POOL_HPP
+#define AUTH_CLIENT_POOL_HPP
+
+// Параметры пула соединений
+struct AuthClientPoolOptions
+{
+    std::string socketPath = "./configDb/authd.sock"; // Unix-сокет сервера (если tcpPort == 0)
+    std::string tcpHost = "127.0.0.1";                // Адрес двоичного протокола по TCP
+    uint16_t tcpPort = 0;                             // Порт двоичного протокола по TCP (0 — Unix-сокет)
+    size_t maxConnections = 4;                        // Соединений в пуле
+    size_t maxInFlight = 64;                          // Неотвеченных запросов одного соединения (как maxInFlight сервера)
+    unsigned connectTimeoutMs = 1000;                 // Запрос, ждущий соединения дольше, завершается ошибкой
+    unsigned reconnectDelayMs = 50;                   // Пауза между неудачными попытками подключения
+    unsigned deadlineMs = 0;                          // Срок входа и смены пароля для сервера, если в запросе его нет (0 — без срока)
+    unsigned requestTimeoutMs = 10000;                // Запрос без ответа дольше этого срока завершается ошибкой (0 — без срока)
+};
+
+// Счетчики пула с момента создания
+struct AuthClientPoolStats
+{
+    uint64_t requests = 0;        // Принято запросов
+    uint64_t connects = 0;        // Открыто соединений
+    uint64_t connectFailures = 0; // Неудачных попыток подключения
+    uint64_t disconnects = 0;     // Соединений, закрытых сервером или из-за ошибки
+    uint64_t retried = 0;         // Запросов, повторно отправленных после разрыва
+    uint64_t timedOut = 0;        // Запросов, завершенных ошибкой по requestTimeoutMs
+};
+
+// Клиентская библиотека сервера аутентификации (libauthclient): ограниченный пул постоянных соединений
+// по Unix-сокету или TCP. Соединения открываются по мере надобности, до maxConnections; запросы всех
+// вызывающих потоков мультиплексируются по ним конвейером (до maxInFlight неотвеченных в соединении)
+// и сопоставляются с ответами по номеру. Обмен ведет собственный поток пула с циклом epoll.
+// Разорванное соединение (сервер перезапущен или закрыл его после исчерпания попыток) убирается из пула,
+// новое открывается при следующем запросе. Запрос, ни один байт которого не был записан в сокет, один раз
+// повторяется в другом соединении; записанный запрос сервер мог выполнить (вход учитывается в счетчиках
+// неудач и частоты), поэтому он не повторяется и завершается ошибкой. Пока подключиться не удается,
+// запросы ждут до connectTimeoutMs; запрос без ответа дольше requestTimeoutMs завершается ошибкой, поздний
+// ответ отбрасывается. Обратные вызовы выполняются в потоке пула и не должны блокироваться;
+// блокирующие методы из обратного вызова сразу возвращают ошибку
+class AuthClientPool
+{
+public:
+    // Результат запроса: SUCCESS и ответ сервера либо DATABASE_ERROR, если ответа не будет
+    using Callback = std::function<void(ConfiguratorErrorCode code, const AuthProtocol::AuthResponse &response)>;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Запрос, ожидающий отправки или ответа
+    struct Pending
+    {
+        AuthProtocol::Request request;
+        Callback done;
+        Clock::time_point queued;
+        uint64_t frameStart = 0; // Смещение кадра в потоке соединения: запрос не записан, пока written <= frameStart
+        bool retried = false;
+    };
+
+    struct Connection
+    {
+        int fd;
+        std::string out;  // Кадры, ожидающие отправки
+        size_t outOffset; // Отправленная часть out
+        std::string in;   // Принятые, но еще не разобранные данные
+        size_t inPos;
+        bool waitingWritable;
+        uint64_t appended; // Байт кадров, поставленных в соединение
+        uint64_t written;  // Байт, записанных в сокет
+        uint32_t nextRequestId;
+        std::unordered_map<uint32_t, Pending> inFlight;
+    };
+
+    AuthClientPoolOptions options;
+
+    // Очередь вызывающих потоков, под mutex
+    std::mutex mutex;
+    std::vector<Pending> submitted;
+    bool stopping;
+
+    // Поля потока пула
+    int epollFd;
+    int wakeFd;
+    std::deque<Pending> waiting; // Приняты, но еще не распределены по соединениям
+    std::unordered_map<uint64_t, Connection> connections;
+    uint64_t nextConnectionId;
+    Clock::time_point nextConnectAttempt;
+    Clock::time_point nextTimeoutCheck; // Самый ранний срок requestTimeoutMs среди ожидающих запросов
+
+    std::atomic<uint64_t> requestCount;
+    std::atomic<uint64_t> connectCount;
+    std::atomic<uint64_t> connectFailureCount;
+    std::atomic<uint64_t> disconnectCount;
+    std::atomic<uint64_t> retryCount;
+    std::atomic<uint64_t> timeoutCount;
+    std::atomic<size_t> openConnections;
+
+    std::thread ioThread;
+
+    // Основной цикл потока пула
+    void ioLoop();
+
+    // Новое соединение; false, если сервер недоступен
+    bool openConnection();
+
+    // Распределение ожидающих запросов по соединениям
+    void dispatch();
+
+    // Отправка накопленных кадров соединения; false при ошибке
+    bool flushConnection(uint64_t id, Connection &connection);
+
+    // Прием и разбор ответов соединения; false, если соединение закрыто
+    bool readConnection(Connection &connection);
+
+    // Закрытие соединения: незаписанные запросы повторяются, остальные завершаются ошибкой
+    void dropConnection(uint64_t id);
+
+    // Завершение ошибкой запросов, ждущих ответа дольше requestTimeoutMs
+    void expireRequests(Clock::time_point now);
+
+    // Завершение запроса ошибкой
+    static void fail(Pending &pending);
+
+    // Блокирующий запрос через поток пула
+    ConfiguratorErrorCode call(AuthProtocol::Request request, AuthProtocol::AuthResponse &response);
+
+public:
+    explicit AuthClientPool(const AuthClientPoolOptions &poolOptions = AuthClientPoolOptions());
+
+    AuthClientPool(const AuthClientPool &) = delete;
+    AuthClientPool &operator=(const AuthClientPool &) = delete;
+
+    // Постановка запроса; done вызывается ровно один раз в потоке пула. Номер запроса назначает пул,
+    // поля с паролями затираются после ответа
+    void submit(AuthProtocol::Request request, Callback done);
+
+    // Вход с обратным вызовом
+    void authenticateAsync(const std::string &login, const std::string &password, Callback done);
+
+    // Блокирующие запросы; результат проверки — в response.status, ошибка — если ответа не будет
+    ConfiguratorErrorCode authenticate(const std::string &login, const std::string &password, AuthProtocol::AuthResponse &response);
+    ConfiguratorErrorCode changePassword(const std::string &login, const std::string &password, const std::string &newPassword,
+                                         AuthProtocol::AuthResponse &response);
+    ConfiguratorErrorCode checkRole(const std::string &token, UserRole role, AuthProtocol::AuthResponse &response);
+    ConfiguratorErrorCode resumeSession(const std::string &token, AuthProtocol::AuthResponse &response);
+    ConfiguratorErrorCode endSession(const std::string &token, AuthProtocol::AuthResponse &response);
+
+    // Открытых соединений
+    size_t connectionCount() const;
+
+    // Текущие счетчики; вызывается из любого потока
+    AuthClientPoolStats stats() const;
+
+    // Останавливает поток пула; запросы без ответа завершаются ошибкой
+    ~AuthClientPool();
+};
+
+#endif
@@ -0,0 +1,81 @@
+// include/AuthProtocol.hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "ErrorCode.hpp"
+
+#ifndef AUTH_PROTOCOL_HPP
+#define AUTH_PROTOCOL_HPP
+
+// Двоичный протокол сервера аутентификации. Каждое сообщение — кадр: 32-битная длина (порядок байтов узла,
+// сокет локальный) и содержимое. Запрос: 32-битный номер, байт операции и поля с 16-битной длиной:
+// 'A' — вход (логин, пароль); 'P' — смена пароля (логин, пароль, новый пароль); у 'A' и 'P' может быть
+// последнее 32-битное поле — срок запроса в мс от приема сервером;
+// 'R' — проверка роли (токен сессии, 32-битный номер роли); 'S' и 'E' — продолжение и завершение сессии (токен).
+// Ответ: номер запроса, 32-битный код UserErrorCode, 32-битное число оставшихся попыток ввода пароля,
+// 32-битная пауза перед повтором в мс (для OVERLOADED) и поле с токеном сессии (пустое, если сессия не создавалась).
+// Клиент может отправлять запросы, не дожидаясь ответов; ответы приходят по мере готовности,
+// не обязательно в порядке запросов, и сопоставляются с запросами по номеру
+class AuthProtocol
+{
+public:
+    static const size_t MAX_FRAME_BYTES = 4096; // Максимальный размер содержимого кадра
+    static constexpr char OPERATION_AUTHENTICATE = 'A';
+    static constexpr char OPERATION_CHANGE_PASSWORD = 'P';
+    static constexpr char OPERATION_CHECK_ROLE = 'R';
+    static constexpr char OPERATION_RESUME_SESSION = 'S';
+    static constexpr char OPERATION_END_SESSION = 'E';
+
+    // Результат выделения кадра из буфера
+    enum class FrameStatus
+    {
+        COMPLETE,   // Кадр выделен
+        INCOMPLETE, // Данных пока недостаточно
+        TOO_LARGE,  // Длина превышает MAX_FRAME_BYTES, соединение следует закрыть
+        MALFORMED   // Содержимое кадра не разбирается, соединение следует закрыть
+    };
+
+    // Запрос; заполнены поля, используемые операцией
+    struct Request
+    {
+        uint32_t id = 0;
+        char operation = OPERATION_AUTHENTICATE;
+        std::string login;
+        std::string password;
+        std::string newPassword; // OPERATION_CHANGE_PASSWORD
+        std::string token;       // Сессии и OPERATION_CHECK_ROLE
+        uint32_t role = 0;       // OPERATION_CHECK_ROLE, значение UserRole
+        uint32_t deadlineMs = 0; // Вход и смена пароля: срок в мс от приема сервером (0 — не передается)
+    };
+
+    // Ответ на запрос
+    struct AuthResponse
+    {
+        uint32_t requestId = 0;
+        UserErrorCode status = UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+        unsigned attemptsLeft = 0; // Оставшиеся попытки ввода пароля в этом соединении
+        uint32_t retryAfterMs = 0; // При OVERLOADED: через сколько миллисекунд повторить запрос
+        std::string sessionToken;  // Токен сессии после успешного входа
+    };
+
+    // Дописывание кадра с содержимым payload
+    static void appendFrame(std::string &out, std::string_view payload);
+
+    // Выделение кадра из buffer начиная с позиции pos без копирования: payload указывает в buffer.
+    // При COMPLETE pos сдвигается за кадр
+    static FrameStatus extractFrame(std::string_view buffer, size_t &pos, std::string_view &payload);
+
+    // Дописывание кадра запроса; false, если поле длиннее 16-битной длины или кадр превышает лимит
+    static bool appendRequest(std::string &out, const Request &request);
+
+    // Выделение и разбор очередного кадра запроса; при COMPLETE pos сдвигается за кадр
+    static FrameStatus extractRequest(std::string_view buffer, size_t &pos, Request &request);
+
+    static void appendResponse(std::string &out, const AuthResponse &response);
+    static FrameStatus extractResponse(std::string_view buffer, size_t &pos, AuthResponse &response);
+};
+
+#endif
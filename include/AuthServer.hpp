@@ -0,0 +1,214 @@
+// include/AuthServer.hpp
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AccountsEditor.hpp"
+#include "Authenticator.hpp"
+#include "AuthProtocol.hpp"
+#include "CancellationToken.hpp"
+#include "ExecutorInterface.hpp"
+#include "HttpProtocol.hpp"
+#include "LoadShedder.hpp"
+#include "RateLimiter.hpp"
+#include "RequestArena.hpp"
+#include "SessionManager.hpp"
+#include "SessionStoreInterface.hpp"
+#include "WorkStealingExecutor.hpp"
+
+#ifndef AUTH_SERVER_HPP
+#define AUTH_SERVER_HPP
+
+// Параметры сервера аутентификации
+struct AuthServerOptions
+{
+    std::string socketPath = "./configDb/authd.sock"; // Путь к Unix-сокету
+    int listenFd = -1;                                // Готовый слушающий сокет, общий для процессов (-1 — создать по socketPath)
+    size_t workers = 0;                               // Потоков исполнителя проверок (0 — по числу ядер)
+    size_t maxConnections = 1024;                     // Новые соединения сверх лимита закрываются сразу
+    size_t maxInFlight = 64;                          // Запросов одного соединения в исполнителе; остальные ждут в буфере
+    size_t maxSessions = SessionManager::DEFAULT_MAX_SESSIONS; // Сессии сверх лимита не создаются
+    RateLimiterOptions rateLimits;                    // Частота попыток входа по логину и по источнику
+    SessionStoreInterface *sessionStore = nullptr;    // Общие сессии процессов (nullptr — свои сессии сервера, до maxSessions)
+    RateLimiter *rateLimiter = nullptr;               // Общий ограничитель процессов (nullptr — свой по rateLimits)
+    bool http = false;                                // Прием запросов HTTP/1.1 на 127.0.0.1
+    uint16_t httpPort = 0;                            // Порт HTTP (0 — любой свободный, см. AuthServer::httpPort)
+    bool reusePort = false;                           // SO_REUSEPORT для HTTP и TCP: процессы слушают один порт, ядро делит соединения
+    bool tcp = false;                                 // Прием двоичного протокола по TCP на 127.0.0.1
+    uint16_t tcpPort = 0;                             // Порт двоичного протокола (0 — любой свободный, см. AuthServer::tcpPort)
+    unsigned maxPredictedLatencyMs = 0;               // Предел ожидаемой задержки проверки пароля, сверх него — OVERLOADED (0 — без предела)
+    unsigned requestTimeoutMs = 0;                    // Срок входа и смены пароля, в том числе верхний предел срока клиента (0 — без срока)
+};
+
+// Счетчики сервера с момента запуска
+struct AuthServerStats
+{
+    uint64_t accepted = 0;             // Принято соединений
+    uint64_t verified = 0;             // Выполнено проверок пароля
+    uint64_t overloaded = 0;           // Отклонено кодом OVERLOADED
+    uint64_t cancelledDeadline = 0;    // Не проверялось: срок истек в очереди
+    uint64_t cancelledDisconnected = 0; // Не проверялось: клиент отключился
+};
+
+// Сервер аутентификации: один поток с циклом epoll принимает соединения на Unix-сокете, разбирает
+// запросы и ищет пользователя; проверка пароля и затем срока его действия выполняются отдельными
+// задачами в исполнителе с перехватом работы, так что цикл не ждет хеширования.
+// Все кадры, принятые за одно чтение, разбираются подряд; ответы отправляются по готовности, не обязательно
+// в порядке запросов, и накопленные за проход цикла ответы соединения уходят одним вызовом sendmsg.
+// В одном соединении действует то же ограничение числа попыток ввода пароля, что и в консольном приложении,
+// после последней неудачной попытки соединение закрывается.
+// Смена пароля выполняется сопрограммой editPasswordAsync: обращения к базе — в потоке цикла, хеширование — в исполнителе.
+// Успешный вход открывает сессию на maxInactiveTimeMin бездействия; ее токен проверяется без хеширования.
+// Попытки сверх частоты, допустимой для логина или источника (uid подключившегося процесса), отклоняются
+// кодом RATE_LIMITED до поиска пользователя и не занимают исполнитель.
+// Если ожидаемая задержка проверки пароля (очередь исполнителя и среднее время проверки) превышает
+// options.maxPredictedLatencyMs, новые попытки сразу получают OVERLOADED с паузой перед повтором.
+// У входа и смены пароля есть срок (options.requestTimeoutMs и срок из запроса, отсчет от приема данных) и
+// признак отмены, общий с соединением. Они проверяются перед поиском пользователя и перед каждым хешированием:
+// если клиент отключился или срок истек, пока запрос стоял в очереди, хеширование не начинается, а клиенту,
+// если он на связи, отправляется DEADLINE_EXCEEDED. Сэкономленные проверки видны в stats().
+// При options.http тот же цикл принимает соединения HTTP/1.1 с keep-alive: POST /authenticate с телом
+// {"login": ..., "password": ...} и GET /users/{login}/roles с заголовком Authorization: Bearer <токен сессии>.
+// Ответы HTTP идут в порядке запросов, поэтому в исполнителе находится не больше одного запроса соединения.
+// При options.tcp двоичный протокол принимается и по TCP на 127.0.0.1 (для клиентов в контейнерах без общего
+// каталога с сокетом); источник для ограничения частоты — адрес клиента.
+// В многопроцессном режиме (AuthSupervisor) каждый процесс — отдельный AuthServer с общим слушающим сокетом
+// options.listenFd; сессии и счетчики частоты процессы делят через options.sessionStore (SharedSessionTable)
+// и options.rateLimiter (RateLimiterOptions::shared), созданные до fork
+class AuthServer
+{
+    // Состояние соединения
+    struct Connection
+    {
+        int fd;
+        std::string source;          // Источник запросов для ограничения частоты
+        std::string in;              // Принятые, но еще не обработанные данные
+        std::deque<std::string> out; // Кадры ответов, ожидающие отправки
+        size_t outOffset;            // Отправленная часть первого кадра
+        size_t inFlight;             // Запросов соединения в исполнителе
+        bool closeAfterWrite;        // Закрыть после отправки ответов
+        bool waitingWritable;        // Подписка на EPOLLOUT
+        bool flushQueued;            // Соединение в списке отправки текущего прохода цикла
+        unsigned failedAttempts;
+        bool http;                   // Соединение HTTP, а не двоичного протокола
+        bool httpKeepAlive;          // Последний запрос HTTP не просил закрыть соединение
+        size_t httpScanned;          // Просмотренная часть заголовков неполного запроса HTTP
+        CancellationToken cancellation;                // Отменяется при закрытии соединения
+        CancellationToken::Clock::time_point received; // Прием данных, с которых начинается необработанная часть in
+    };
+
+    // Результат проверки из исполнителя
+    struct Completion
+    {
+        uint64_t connection;
+        uint32_t requestId;
+        char operation;
+        UserErrorCode status;
+        std::string login;
+        uint64_t verifyMicros = 0; // Время проверки пароля для оценки нагрузки
+        CancelReason cancelled = CancelReason::NONE; // Почему проверка не выполнялась
+    };
+
+    // Выполнение задач в потоке цикла: этапы сопрограмм, обращающиеся к базе, и передача результатов
+    class LoopExecutor : public ExecutorInterface
+    {
+        AuthServer &server;
+
+    public:
+        explicit LoopExecutor(AuthServer &owner) : server(owner) {}
+        void submit(std::function<void()> task) override;
+    };
+
+    Authenticator *authenticator;
+    ConfiguratorAccountsEditor *editor; // Смена пароля (nullptr — операция недоступна)
+    AuthServerOptions options;
+
+    int listenFd;
+    int httpListenFd;
+    uint16_t boundHttpPort;
+    int tcpListenFd;
+    uint16_t boundTcpPort;
+    int epollFd;
+    int wakeFd; // Пул сообщает о готовых результатах
+    int stopFd; // Запрос остановки (в том числе из обработчика сигнала)
+
+    std::unordered_map<uint64_t, Connection> connections;
+    uint64_t nextConnectionId;
+
+    std::unique_ptr<SessionManager> ownSessions;
+    SessionStoreInterface *sessions; // options.sessionStore или ownSessions
+    std::unique_ptr<RateLimiter> ownRateLimiter;
+    RateLimiter *rateLimiter; // options.rateLimiter или ownRateLimiter
+    LoadShedder loadShedder;
+    RequestArena requestArena; // Временные данные поиска пользователя в потоке цикла
+
+    std::mutex loopMutex;
+    std::vector<std::function<void()>> loopTasks;
+    LoopExecutor loopExecutor;
+    size_t requestsInFlight;         // Запросов в исполнителе, в том числе смен пароля между этапами
+    std::vector<uint64_t> flushList; // Соединения с ответами, накопленными за проход цикла
+
+    // Счетчики для stats(); меняются в потоке цикла
+    std::atomic<uint64_t> acceptedCount;
+    std::atomic<uint64_t> verifiedCount;
+    std::atomic<uint64_t> overloadedCount;
+    std::atomic<uint64_t> cancelledDeadlineCount;
+    std::atomic<uint64_t> cancelledDisconnectedCount;
+
+    // Исполнитель объявлен последним: при уничтожении сервера он дожидается задач до освобождения остальных полей
+    std::unique_ptr<WorkStealingExecutor> executor;
+
+    void acceptConnections(int listener, bool http);
+    void readConnection(uint64_t id);
+    void processRequests(uint64_t id);
+    void processHttpRequests(uint64_t id, Connection &connection, size_t &pos);
+    void processHttpRoles(uint64_t id, const HttpProtocol::Request &request, std::string_view login);
+    void processCredentials(uint64_t id, Connection &connection, AuthProtocol::Request &request);
+    void processRoleCheck(uint64_t id, const AuthProtocol::Request &request);
+    void processSessionRequest(uint64_t id, const AuthProtocol::Request &request);
+    void runLoopTasks();
+    void finishRequest(const Completion &completion);
+    void postCompletion(const Completion &completion);
+    void queueResponse(uint64_t id, const AuthProtocol::AuthResponse &response);
+    void queueHttpResponse(uint64_t id, unsigned statusCode, std::string_view body, unsigned retryAfterSeconds = 0);
+    void queueFrame(uint64_t id, std::string frame);
+    void flushConnections();
+    void flushConnection(uint64_t id);
+    void closeConnection(uint64_t id);
+
+public:
+    AuthServer(Authenticator *auth, const AuthServerOptions &serverOptions = AuthServerOptions(),
+               ConfiguratorAccountsEditor *accountsEditor = nullptr);
+
+    AuthServer(const AuthServer &) = delete;
+    AuthServer &operator=(const AuthServer &) = delete;
+
+    // Создание сокета и запуск исполнителя; существующий файл сокета заменяется
+    ConfiguratorErrorCode start();
+
+    // Порт HTTP после start(); 0, если HTTP не включен
+    uint16_t httpPort() const;
+
+    // Порт двоичного протокола по TCP после start(); 0, если TCP не включен
+    uint16_t tcpPort() const;
+
+    // Цикл обработки событий до вызова stop()
+    void run();
+
+    // Остановка цикла; безопасна в обработчике сигнала
+    void stop();
+
+    // Текущие счетчики; вызывается из любого потока
+    AuthServerStats stats() const;
+
+    ~AuthServer();
+};
+
+#endif
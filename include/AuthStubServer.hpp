@@ -0,0 +1,90 @@
+// include/AuthStubServer.hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "AuthProtocol.hpp"
+
+#ifndef AUTH_STUB_SERVER_HPP
+#define AUTH_STUB_SERVER_HPP
+
+// Заменитель authd для тестов клиентов: тот же двоичный протокол на Unix-сокете (и по TCP на 127.0.0.1,
+// если tcp), но без базы, хеширования и исполнителя. Работает в собственном потоке того же процесса
+// и отвечает на запросы в порядке поступления. По умолчанию знает пользователей из addUser: вход выдает
+// токен сессии, по которому работают проверка роли (разрешены все роли), продолжение и завершение сессии.
+// Обработчик из setHandler заменяет это поведение, например чтобы вернуть нужный код или разорвать соединение
+class AuthStubServer
+{
+public:
+    // Ответ на запрос; false — закрыть соединение без ответа
+    using Handler = std::function<bool(const AuthProtocol::Request &request, AuthProtocol::AuthResponse &response)>;
+
+private:
+    std::string socketPath;
+    bool tcp;
+    uint16_t boundTcpPort;
+    int listenFd;
+    int tcpListenFd;
+    int stopFd;
+
+    std::mutex mutex; // Пользователи, сессии и обработчик
+    std::unordered_map<std::string, std::string> passwords;
+    std::unordered_map<std::string, std::string> sessions; // Токен — логин
+    Handler handler;
+    uint64_t nextToken;
+
+    std::atomic<bool> dropRequested;
+    std::atomic<uint64_t> requestCount;
+    std::atomic<uint64_t> acceptedCount;
+    std::atomic<size_t> maxBatch;
+    std::thread loop;
+
+    // Цикл poll: прием соединений, запросы и закрытие соединений по dropConnections
+    void run();
+
+    // Поведение по умолчанию
+    bool answer(const AuthProtocol::Request &request, AuthProtocol::AuthResponse &response);
+
+public:
+    explicit AuthStubServer(const std::string &path, bool acceptTcp = false);
+
+    AuthStubServer(const AuthStubServer &) = delete;
+    AuthStubServer &operator=(const AuthStubServer &) = delete;
+
+    // Создание сокетов и запуск потока; существующий файл сокета заменяется
+    ConfiguratorErrorCode start();
+
+    // Порт TCP после start(); 0, если TCP не включен
+    uint16_t tcpPort() const;
+
+    // Пользователь для поведения по умолчанию
+    void addUser(const std::string &login, const std::string &password);
+
+    // Замена поведения по умолчанию (пустой обработчик — вернуть его)
+    void setHandler(Handler requestHandler);
+
+    // Закрытие всех открытых соединений, как при перезапуске сервера
+    void dropConnections();
+
+    // Принято запросов
+    uint64_t requests() const;
+
+    // Принято соединений
+    uint64_t acceptedConnections() const;
+
+    // Наибольшее число запросов, разобранных из одного чтения: больше 1, если клиент отправляет конвейером
+    size_t largestBatch() const;
+
+    // Остановка потока и закрытие сокетов; вызывается и деструктором
+    void stop();
+
+    ~AuthStubServer();
+};
+
+#endif
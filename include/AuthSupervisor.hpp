@@ -0,0 +1,67 @@
+// include/AuthSupervisor.hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+#include "ErrorCode.hpp"
+
+#ifndef AUTH_SUPERVISOR_HPP
+#define AUTH_SUPERVISOR_HPP
+
+// Параметры многопроцессного режима
+struct AuthSupervisorOptions
+{
+    std::string socketPath = "./configDb/authd.sock"; // Unix-сокет, общий для всех процессов
+    size_t processes = 0;                             // Рабочих процессов (0 — по числу ядер)
+    unsigned restartDelayMs = 1000;                   // Пауза перед перезапуском процесса, упавшего сразу после запуска
+};
+
+// Родительский процесс сервера аутентификации: создает слушающий Unix-сокет, запускает рабочие процессы
+// fork и перезапускает завершившиеся. Каждый процесс принимает соединения из общего сокета в своем цикле
+// epoll (AuthServerOptions::listenFd); память Argon2 одного процесса недоступна другим. Все, что создано
+// до run() (индекс базы, конфигурация), процессы получают копией при fork: страницы общие, пока процесс
+// их не изменит. Изменяемое общее состояние — только в отображениях MAP_SHARED, созданных до run():
+// таблица блокировок (LockoutTable), сессии (SharedSessionTable) и корзины частоты (RateLimiterOptions::shared).
+// До run() в процессе не должно быть дополнительных потоков
+class AuthSupervisor
+{
+    AuthSupervisorOptions options;
+    int listenFd;
+    int stopFd;
+    std::vector<pid_t> workers; // Процесс каждого номера (0 — не запущен)
+    std::vector<int64_t> startedAt; // Время запуска процесса, мс монотонных часов
+
+    // Запуск процесса с номером index; в дочернем процессе вызывает worker и завершается
+    void spawn(size_t index, const std::function<int(size_t)> &worker);
+
+public:
+    explicit AuthSupervisor(const AuthSupervisorOptions &supervisorOptions = AuthSupervisorOptions());
+
+    AuthSupervisor(const AuthSupervisor &) = delete;
+    AuthSupervisor &operator=(const AuthSupervisor &) = delete;
+
+    // Создание слушающего сокета; существующий файл сокета заменяется
+    ConfiguratorErrorCode listen();
+
+    // Слушающий сокет для рабочих процессов
+    int socket() const;
+
+    // Число рабочих процессов
+    size_t processes() const;
+
+    // Запуск процессов и наблюдение за ними до stop(). worker(номер) выполняется в дочернем процессе,
+    // его результат — код завершения процесса. Процесс, завершившийся не по stop(), запускается заново.
+    // При остановке процессы получают SIGTERM, run() возвращается после их завершения
+    void run(const std::function<int(size_t)> &worker);
+
+    // Остановка; безопасна в обработчике сигнала
+    void stop();
+
+    ~AuthSupervisor();
+};
+
+#endif
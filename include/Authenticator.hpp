@@ -0,0 +1,85 @@
+// include/Authenticator.hpp
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ErrorCode.hpp"
+#include "UserRole.hpp"
+#include "ConfiguratorDatabaseInterface.hpp"
+#include "SecurityConfigInterface.hpp"
+#include "HashingInterface.hpp"
+#include "LockoutTable.hpp"
+#include "Task.hpp"
+
+#ifndef AUTHENTICATOR_HPP
+#define AUTHENTICATOR_HPP
+
+// Данные пользователя. При повторном использовании одного объекта поля сохраняют свою емкость,
+// и разбор очередной записи не выделяет память
+struct UserData
+{
+    std::string login;
+    std::string passwordHash;
+    std::string date;
+    std::vector<UserRole> roles;
+};
+
+// Шаги входа пользователя без ввода-вывода: поиск учетной записи, проверка пароля и срока его действия.
+// Используется консольным приложением и сервером аутентификации
+class Authenticator
+{
+    ConfiguratorDatabaseInterface *db;
+    SecurityConfigInterface *config;
+    HashingInterface *hasher;
+    LockoutTable *lockout; // Счетчики неудачных попыток (nullptr — без блокировки)
+
+    static UserErrorCode parseUserData(std::string_view strUserData, UserData &userData);
+
+    static bool isLeapYear(int year);
+    static unsigned getDaysInMonth(int month, int year);
+    static UserErrorCode parseDate(std::string_view dateStr, unsigned &day, unsigned &month, unsigned &year);
+    static unsigned daysFromEpoch(unsigned day, unsigned month, unsigned year);
+    static UserErrorCode differenceInDays(std::string_view userDateStr, int &difference);
+
+public:
+    Authenticator(ConfiguratorDatabaseInterface *database, SecurityConfigInterface *securityConfig, HashingInterface *hash,
+                  LockoutTable *lockoutTable = nullptr);
+
+    // Поиск активного пользователя и разбор его данных (логин, хеш пароля, дата смены пароля, роли).
+    // Строка из базы размещается в arena (арена запроса); по умолчанию — в общей куче
+    UserErrorCode findUser(const std::string &login, UserData &userData,
+                           std::pmr::memory_resource *arena = std::pmr::get_default_resource());
+
+    // Разбор записи активного пользователя, найденной не через базу (PartitionedUserTable)
+    static UserErrorCode userFromRecord(std::string_view record, UserData &userData);
+
+    // Проверка блокировки логина после неудачных попыток; не требует хеширования
+    UserErrorCode checkLockout(const std::string &login) const;
+
+    // Проверка пароля; вызывается из нескольких потоков, если хешер это допускает.
+    // Для заблокированного логина возвращает ACCOUNT_LOCKED без хеширования; неверный пароль
+    // учитывается в таблице блокировок по параметрам maxFailedAttempts и lockoutTimeMin
+    UserErrorCode verifyPassword(const std::string &password, const UserData &userData) const;
+
+    // Проверка, не истек ли срок действия пароля
+    UserErrorCode checkPasswordExpiration(const UserData &userData) const;
+
+    // Сопрограмма входа: поиск, блокировка, пароль, срок действия. Обращения к базе выполняются
+    // исполнителем stages.database, хеширование — stages.hashing; пока этап ждет исполнителя, поток
+    // свободен. userData заполняется найденной записью и должен существовать до завершения задачи
+    Task<UserErrorCode> authenticateAsync(std::string login, std::string password, UserData &userData,
+                                          AsyncStages stages = AsyncStages());
+
+    // Вход целиком в текущем потоке (ожидание authenticateAsync)
+    UserErrorCode authenticate(const std::string &login, const std::string &password, UserData &userData);
+
+    // Максимальное число попыток ввода пароля
+    UserErrorCode getMaxFailedAttempts(unsigned &attempts) const;
+
+    // Допустимое время бездействия сессии в минутах
+    UserErrorCode getMaxInactiveTimeMin(unsigned &minutes) const;
+};
+
+#endif
@@ -0,0 +1,62 @@
+// include/BatchAuthenticator.hpp
+
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <ostream>
+
+#include "Authenticator.hpp"
+#include "HashingInterface.hpp"
+#include "PartitionedUserTable.hpp"
+
+#ifndef BATCH_AUTHENTICATOR_HPP
+#define BATCH_AUTHENTICATOR_HPP
+
+// Параметры пакетной проверки
+struct BatchAuthOptions
+{
+    size_t workers = 0;     // Потоков проверки паролей (0 — по числу ядер)
+    size_t maxInFlight = 0; // Записей в обработке одновременно (0 — четыре на поток)
+    PartitionedUserTable *userTable = nullptr; // Режим «поток на ядро» по загруженной таблице (nullptr — пул потоков)
+};
+
+// Итоги пакетной проверки
+struct BatchAuthReport
+{
+    size_t records = 0;                     // Обработано записей
+    std::map<UserErrorCode, size_t> counts; // Число записей по результатам
+    double seconds = 0;                     // Время обработки всего входа
+    double throughputPerSecond = 0;         // Записей в секунду
+    double p50Micros = 0;                   // Процентили задержки одной записи
+    double p90Micros = 0;
+    double p99Micros = 0;
+    double maxMicros = 0;
+};
+
+// Пакетная аутентификация без терминала: записи "логин<TAB>пароль" по одной на строку.
+// Поиск пользователя выполняется в вызывающем потоке (база не рассчитана на параллельный доступ),
+// проверка пароля и срока его действия — в пуле потоков. С options.userTable записи раздаются по кругу
+// потокам ядер таблицы (options.workers не используется): поток ищет логин через PartitionedUserTable,
+// то есть у ядра-владельца раздела, и сам проверяет блокировку, пароль и срок. Результаты выводятся в порядке записей
+// строками "логин<TAB>результат<TAB>задержка в мкс"; задержка считается от чтения записи до завершения
+// проверки и включает ожидание в очереди пула
+class BatchAuthenticator
+{
+    Authenticator *authenticator;
+    HashingInterface *hasher;
+    BatchAuthOptions options;
+
+public:
+    BatchAuthenticator(Authenticator *auth, HashingInterface *hash, const BatchAuthOptions &batchOptions = BatchAuthOptions());
+
+    // Обработка всех записей из in с выводом результатов в out
+    BatchAuthReport run(std::istream &in, std::ostream &out);
+
+    // Вывод итогов: число записей по результатам, пропускная способность, процентили задержки
+    static void printReport(const BatchAuthReport &report, std::ostream &out);
+
+    // Краткое имя результата для вывода
+    static const char *resultName(UserErrorCode code);
+};
+
+#endif
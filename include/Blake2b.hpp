@@ -0,0 +1,44 @@
+// include/Blake2b.hpp
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef BLAKE2B_HPP
+#define BLAKE2B_HPP
+
+// Потоковая реализация BLAKE2b (RFC 7693), используемая встроенным Argon2
+class Blake2b
+{
+public:
+    static const size_t BLOCK_BYTES = 128; // Размер блока сжатия
+    static const size_t OUT_BYTES = 64;    // Максимальная длина выхода
+    static const size_t KEY_BYTES = 64;    // Максимальная длина ключа
+
+private:
+    uint64_t h[8];            // Вектор состояния
+    uint64_t t[2];            // Счетчик обработанных байт
+    uint8_t buf[BLOCK_BYTES]; // Буфер для неполного блока
+    size_t bufLength;         // Количество байт в буфере
+    size_t outLength;         // Длина выхода
+
+    // Функция сжатия F
+    void compress(const uint8_t *block, bool last);
+
+public:
+    // Инициализация с заданной длиной выхода и необязательным ключом
+    Blake2b(size_t outLen, const uint8_t *key = nullptr, size_t keyLen = 0);
+
+    // Добавление данных
+    void update(const void *data, size_t length);
+
+    // Получение результата (outLength байт)
+    void final(uint8_t *out);
+
+    // Однократное вычисление хеша
+    static void hash(uint8_t *out, size_t outLen, const void *in, size_t inLen);
+
+    // Хеш-функция переменной длины H' из Argon2 (RFC 9106, раздел 3.3)
+    static void hashLong(uint8_t *out, size_t outLen, const void *in, size_t inLen);
+};
+
+#endif
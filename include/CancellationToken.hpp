@@ -0,0 +1,47 @@
+// include/CancellationToken.hpp
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#ifndef CANCELLATION_TOKEN_HPP
+#define CANCELLATION_TOKEN_HPP
+
+// Причина, по которой запрос больше не нужно выполнять
+enum class CancelReason
+{
+    NONE,         // Запрос нужен
+    DISCONNECTED, // Клиент отключился: ответ некому отправить
+    DEADLINE      // Срок запроса истек: клиент уже не ждет ответа
+};
+
+// Признак отмены запроса: общий для соединения флаг и собственный срок запроса. Копии разделяют флаг,
+// поэтому cancel() в потоке цикла видят задачи, уже стоящие в исполнителе. Проверяется перед каждым
+// дорогим этапом (поиск пользователя, хеширование), чтобы не начинать работу, результат которой никто не получит
+class CancellationToken
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    Clock::time_point deadline;
+
+public:
+    // Новый флаг без срока
+    CancellationToken();
+
+    // Копия с тем же флагом и сроком через timeoutMs от now, если он раньше текущего (0 — срок не меняется)
+    CancellationToken withTimeout(unsigned timeoutMs, Clock::time_point now = Clock::now()) const;
+
+    // Отмена всех копий; вызывается из любого потока
+    void cancel();
+
+    // Причина отмены на момент now; отключение важнее истекшего срока
+    CancelReason reason(Clock::time_point now = Clock::now()) const;
+
+    // Задан ли срок
+    bool hasDeadline() const;
+};
+
+#endif
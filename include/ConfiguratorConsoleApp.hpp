@@ -6,9 +6,11 @@
 //#include "iconfigurator.hpp"
 
 #include "HashingInterface.hpp"
+#include "HashingWorkerPool.hpp"
 #include "ConfiguratorDatabaseInterface.hpp"
 #include "SecurityConfigInterface.hpp"
 #include "AccountsEditorInterface.hpp"
+#include "PasswordFingerprint.hpp"
 
 #ifndef CONFIGURATOR_CONSOLE_APP_HPP
 #define CONFIGURATOR_CONSOLE_APP_HPP
@@ -21,15 +23,22 @@ private:
     const std::string activeUsersPath;
     const std::string archivePath;
     const std::string tmpPath;
+    const std::string pepperPath;
+    // Имя сегмента разделяемой памяти с политикой безопасности
+    const std::string policySegmentName;
 
     ConfiguratorDatabaseInterface *db;
     SecurityConfigInterface *config;
+    HashingInterface *engine;       // Хешер, выполняющий операции в пуле
+    HashingWorkerPool *hashingPool; // Пул хеширования; операции администратора идут с приоритетом ADMIN
     HashingInterface *hasher;
+    PasswordFingerprint *fingerprint;
     ConfiguratorAccountsEditorInterface *editor;
 
     void printMenu() const;
     std::string errorCodeToString(ConfiguratorErrorCode code) const;
     void viewSettings() const;
+    void editSettings();
     ConfiguratorErrorCode setUnsignedConfigValue(const std::string &prompt, std::function<ConfiguratorErrorCode(unsigned)> setter);
     void addUser();
     void updatePassword();
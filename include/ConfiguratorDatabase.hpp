@@ -1,13 +1,22 @@
 // include/ConfiguratorDatabase.hpp
 
+#include <deque>
 #include <string>
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <sys/stat.h>
 
 #include "ConfiguratorDatabaseInterface.hpp"
+#include "IoBackendInterface.hpp"
 
 #ifndef CONFIGURATOR_DATABASE_HPP
 #define CONFIGURATOR_DATABASE_HPP
 
+class DatabaseWriteLock;
+
 // Класс для работы с базой данных конфигурации: управление активными пользователями и архивом
 class ConfiguratorDatabase : public ConfiguratorDatabaseInterface
 {
@@ -18,12 +27,67 @@ class ConfiguratorDatabase : public ConfiguratorDatabaseInterface
     std::fstream activeUsersFile; // Файловый поток, связанный с таблицей активных пользователей
     std::fstream archiveFile;     // Файловый поток, связанный с файлом архива
 
+    // Индекс таблицы активных пользователей в памяти (логин -> строка данных) для долгоживущих процессов.
+    // Перестраивается, когда меняется отметка файла (устройство, inode, размер, время изменения)
+    bool activeUsersIndexEnabled = false;
+    std::unordered_map<std::string, std::string> activeUsersIndex;
+    struct stat activeUsersStamp = {};
+
+    // Перестроение индекса при изменении файла активных пользователей
+    ConfiguratorErrorCode refreshActiveUsersIndex();
+
+    IoBackendInterface *ioBackend = nullptr; // Ввод-вывод методов ...Async
+
+    // Асинхронный поиск, ждущий чтения таблицы активных пользователей
+    struct PendingLookup
+    {
+        std::string login;
+        std::function<void(ConfiguratorErrorCode, const std::string &)> done;
+    };
+    // Поиски, присоединившиеся к начатому чтению таблицы: одно чтение обслуживает все поиски пакета.
+    // Сбрасывается при изменении базы этим объектом, чтобы следующие поиски увидели изменение
+    std::shared_ptr<std::vector<PendingLookup>> activeUsersReaders;
+
+    // Чтение файла целиком через ioBackend: все блоки ставятся сразу и уходят одним пакетом.
+    // Содержимое действительно только во время вызова done
+    void readFileAsync(const std::string &path, std::function<void(ConfiguratorErrorCode, std::string_view)> done);
+
+    // Асинхронное добавление, ждущее своей очереди
+    struct PendingAdd
+    {
+        std::string login;
+        std::string hashedPassword;
+        std::vector<UserRole> roles;
+        std::function<void(ConfiguratorErrorCode)> done;
+    };
+    // Добавления выполняются по одному в порядке вызова; первое в очереди выполняется, пока asyncAddRunning.
+    // Блокировка каталога берется без ожидания и держится до завершения добавления
+    std::deque<PendingAdd> asyncAdds;
+    bool asyncAddRunning = false;
+    std::shared_ptr<DatabaseWriteLock> asyncAddLock;
+
+    // Запуск первого добавления очереди, если ни одно не выполняется
+    void startAsyncAdd();
+
+    // Захват блокировки (с повтором через backend, если базу изменяет другой процесс) и добавление
+    void continueAsyncAdd();
+
+    // Завершение первого добавления и запуск следующего
+    void finishAsyncAdd(ConfiguratorErrorCode code);
+
+    // Ожидание всех асинхронных добавлений в потоке-владельце backend
+    void waitAsyncAdds();
+
 public:
     // Конструктор класса ConfiguratorDatabase для инициализации путей к файлам
     ConfiguratorDatabase(std::string archivePath = "./configDb/archive.txt",
                          std::string activePath = "./configDb/active_users.txt",
                          std::string tmpPath = "./configDb/tmp_file.txt");
 
+    // Включение индекса активных пользователей в памяти: getActiveUserByLogin перестает читать
+    // файл целиком при каждом вызове и проверяет только его отметку (stat). Индекс строится сразу
+    void enableActiveUsersIndex();
+
     // Получение данных первого активного пользователя из файла
     ConfiguratorErrorCode getFirstActiveUser(std::string &userData) override;
 
@@ -33,6 +97,10 @@ public:
     // Получение данных активного пользователя по логину
     ConfiguratorErrorCode getActiveUserByLogin(const std::string &login, std::string &userData) override;
 
+    // Получение данных активного пользователя по логину без обращений к общей куче:
+    // временные данные размещаются распределителем userData
+    ConfiguratorErrorCode getActiveUserRecord(const std::string &login, std::pmr::string &userData) override;
+
     // Получение данных первого пользователя из архива
     ConfiguratorErrorCode getFirstArchiveUser(std::string &userData) override;
 
@@ -42,18 +110,33 @@ public:
     // Получение данных пользователя из архива по логину
     ConfiguratorErrorCode getArchiveUserByLogin(const std::string &login, std::string &userData) override;
 
-    // Добавление нового пользователя в активных пользователей и архив
+    // Добавление нового пользователя в активных пользователей и архив.
+    // hashedPassword может содержать отпечаток ("хеш#отпечаток"), он записывается только в архив
     ConfiguratorErrorCode addUser(const std::string &login, const std::string &hashedPassword, const std::vector<UserRole> &roles) override;
 
     // Удаление пользователя по логину из активных пользователей
     ConfiguratorErrorCode removeUser(const std::string &login) override;
 
-    // Обновление пароля пользователя в активных пользователях и архиве
+    // Обновление пароля пользователя в активных пользователях и архиве (отпечаток — только в архив)
     ConfiguratorErrorCode updatePassword(const std::string &login, const std::string &newHashedPassword, const unsigned &passwordHistoryDepth) override;
 
     // Обновление ролей пользователя в таблице активных пользователей
     ConfiguratorErrorCode updateRoles(const std::string &login, const std::vector<UserRole> &newRoles) override;
 
+    // Асинхронный ввод-вывод для методов ...Async; без него (nullptr) они выполняются синхронно
+    void setIoBackend(IoBackendInterface *backend);
+
+    // Асинхронный поиск активного пользователя. Чтения ставятся в очередь backend и уходят с его submit(),
+    // done вызывается из complete() владельца backend. С включенным индексом или без backend — сразу
+    void getActiveUserAsync(const std::string &login, std::function<void(ConfiguratorErrorCode, const std::string &)> done);
+
+    // Асинхронное добавление пользователя: проверка архива, затем дописывание в таблицу и архив и fsync
+    // обоих файлов одним пакетом. Добавления выполняются по одному; пока добавление выполняется, каталог базы
+    // заблокирован (flock). Если базу изменяет другой процесс, захват повторяется из complete() без ожидания.
+    // Синхронные методы изменения, вызванные в это время, сначала выполняют все поставленные добавления
+    void addUserAsync(const std::string &login, const std::string &hashedPassword, const std::vector<UserRole> &roles,
+                      std::function<void(ConfiguratorErrorCode)> done);
+
     // Деструктор для закрытия файлов перед уничтожением объекта
     ~ConfiguratorDatabase();
 };
@@ -1,5 +1,6 @@
 // include/ConfiguratorDatabaseInterface.hpp
 
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,16 @@ public:
     virtual ConfiguratorErrorCode getNextActiveUser(std::string &userData) = 0;
     virtual ConfiguratorErrorCode getActiveUserByLogin(const std::string &login, std::string &userData) = 0;
 
+    // Поиск активного пользователя с размещением результата распределителем userData (арена запроса).
+    // Реализация по умолчанию копирует результат getActiveUserByLogin
+    virtual ConfiguratorErrorCode getActiveUserRecord(const std::string &login, std::pmr::string &userData)
+    {
+        std::string data;
+        ConfiguratorErrorCode code = getActiveUserByLogin(login, data);
+        userData.assign(data);
+        return code;
+    }
+
     virtual ConfiguratorErrorCode getFirstArchiveUser(std::string &userData) = 0;
     virtual ConfiguratorErrorCode getNextArchiveUser(std::string &userData) = 0;
     virtual ConfiguratorErrorCode getArchiveUserByLogin(const std::string &login, std::string &userData) = 0;
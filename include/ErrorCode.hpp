@@ -15,7 +15,8 @@ enum class ConfiguratorErrorCode
     DATABASE_ERROR,
     END_OF_TABLE,
     HASHING_ERROR,
-    PASSWORDS_DONT_MATCH
+    PASSWORDS_DONT_MATCH,
+    CONFIG_VALUE_OUT_OF_RANGE
 };
 
 enum class UserErrorCode
@@ -26,7 +27,14 @@ enum class UserErrorCode
     LOGIN_NOT_EXISTS,
     GETTING_DATA_FROM_DB_ERROR,
     WRONG_PASSWORD,
-    PASSWORD_HAS_EXPIRED
+    PASSWORD_HAS_EXPIRED,
+    ACCOUNT_LOCKED,
+    SESSION_EXPIRED,
+    RATE_LIMITED,
+    PASSWORD_REJECTED, // Новый пароль не удовлетворяет требованиям безопасности
+    ROLE_NOT_GRANTED,
+    OVERLOADED,       // Сервер перегружен: запрос не принят, его можно повторить позже
+    DEADLINE_EXCEEDED // Срок запроса истек до проверки пароля: проверка не выполнялась
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,17 @@
+// include/ExecutorInterface.hpp
+
+#include <functional>
+
+#ifndef EXECUTOR_INTERFACE_HPP
+#define EXECUTOR_INTERFACE_HPP
+
+class ExecutorInterface
+{
+public:
+    // Постановка задачи; вызывается из любого потока
+    virtual void submit(std::function<void()> task) = 0;
+
+    virtual ~ExecutorInterface() = default;
+};
+
+#endif
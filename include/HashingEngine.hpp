@@ -0,0 +1,23 @@
+// include/HashingEngine.hpp
+
+#include <memory>
+
+#include "HashingInterface.hpp"
+
+#ifndef HASHING_ENGINE_HPP
+#define HASHING_ENGINE_HPP
+
+// Выбор реализации хеширования паролей
+class HashingEngine
+{
+public:
+    // Встроенный Argon2id (Argon2Hashing), если он разрешен (preferBuiltin) и процессор поддерживает
+    // функцию сжатия AVX2 или AVX-512; иначе libsodium (Hashing). Переносимая и SSE4.1-реализации
+    // медленнее libsodium, поэтому без широких векторов встроенная не выбирается
+    static std::unique_ptr<HashingInterface> create(bool preferBuiltin = true);
+
+    // Выберет ли create встроенную реализацию на этом процессоре
+    static bool builtinPreferred();
+};
+
+#endif
@@ -0,0 +1,127 @@
+// include/HashingWorkerPool.hpp
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include "HashingInterface.hpp"
+
+#ifndef HASHING_WORKER_POOL_HPP
+#define HASHING_WORKER_POOL_HPP
+
+// Классы приоритета задач хеширования (меньше значение — выше приоритет)
+enum class HashingPriority
+{
+    INTERACTIVE = 0, // Проверка пароля при входе пользователя
+    ADMIN,           // Единичная операция администратора
+    BULK             // Массовые операции (импорт, сброс паролей)
+};
+
+// Параметры пула
+struct HashingPoolOptions
+{
+    size_t workers = 0;                                // Число потоков (0 — по числу ядер)
+    std::chrono::milliseconds starvationTimeout{500};  // Задача, прождавшая дольше, берется вне очереди приоритетов
+    std::chrono::microseconds interactiveP99Target{0}; // Цель по p99 интерактивных задач (0 — без ограничения массовых)
+    size_t throttledBulkConcurrency = 1;               // Сколько массовых задач может выполняться при ограничении
+    std::chrono::milliseconds throttleRecovery{1000};  // Ограничение снимается после такого периода без интерактивных задач
+    size_t latencyWindow = 256;                        // Число последних интерактивных задач для расчета p99
+};
+
+// Статистика пула
+struct HashingPoolStats
+{
+    size_t completed[3] = {0, 0, 0};             // Выполнено задач по классам приоритета
+    size_t queued[3] = {0, 0, 0};                // Ожидает в очереди по классам приоритета
+    size_t promotedByAging = 0;                  // Задач, взятых вне очереди из-за долгого ожидания
+    std::chrono::microseconds interactiveP99{0}; // p99 задержки интерактивных задач (от постановки до завершения)
+    bool bulkThrottled = false;                  // Ограничены ли сейчас массовые задачи
+};
+
+// Пул потоков для хеширования с классами приоритета.
+// Задача с более высоким приоритетом берется первой; задача, прождавшая дольше starvationTimeout,
+// берется вне очереди (кроме массовых при ограничении). Когда p99 интерактивных задач превышает
+// цель, массовые задачи запускаются только при пустых очередях интерактивных и административных
+// и не более throttledBulkConcurrency одновременно
+class HashingWorkerPool
+{
+    // Задача в очереди; результат передается после учета задачи в статистике
+    struct Task
+    {
+        std::function<ConfiguratorErrorCode(HashingInterface &)> run;
+        std::shared_ptr<std::promise<ConfiguratorErrorCode>> result;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    HashingInterface *hasher;
+    HashingPoolOptions options;
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<Task> queues[3];
+    std::vector<std::thread> workers;
+    bool stopping;
+
+    size_t bulkRunning;
+    size_t completed[3];
+    size_t promotedByAging;
+
+    std::vector<std::chrono::microseconds> interactiveLatencies; // Кольцевой буфер задержек
+    size_t latencyPosition;
+    std::chrono::microseconds interactiveP99;
+    std::chrono::steady_clock::time_point lastInteractive;
+    bool bulkThrottled;
+
+    // Основной цикл потока
+    void workerLoop();
+
+    // Выбор очереди для следующей задачи (-1, если запускать нечего); вызывается под mutex
+    int pickQueue(std::chrono::steady_clock::time_point now);
+
+    // Учет завершенной задачи; вызывается под mutex
+    void recordCompletion(int priority, std::chrono::steady_clock::time_point enqueued,
+                          std::chrono::steady_clock::time_point finished);
+
+public:
+    HashingWorkerPool(HashingInterface *hash, const HashingPoolOptions &poolOptions = HashingPoolOptions());
+
+    HashingWorkerPool(const HashingWorkerPool &) = delete;
+    HashingWorkerPool &operator=(const HashingWorkerPool &) = delete;
+
+    // Постановка задачи в очередь; hasher должен допускать вызовы из нескольких потоков
+    std::future<ConfiguratorErrorCode> submit(HashingPriority priority, std::function<ConfiguratorErrorCode(HashingInterface &)> job);
+
+    // Проверка пароля в пуле
+    std::future<ConfiguratorErrorCode> submitVerify(HashingPriority priority, const std::string &password, const std::string &hashedPassword);
+
+    // Текущая статистика
+    HashingPoolStats stats();
+
+    // Дожидается выполнения задач в очереди и останавливает потоки
+    ~HashingWorkerPool();
+};
+
+// Адаптер HashingInterface: операции выполняются в пуле с заданным приоритетом, вызов ждет результата
+class PooledHashing : public HashingInterface
+{
+    HashingWorkerPool *pool;
+    HashingPriority priority;
+
+public:
+    PooledHashing(HashingWorkerPool *workerPool, HashingPriority taskPriority);
+
+    // Метод хеширования пароля
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override;
+
+    // Метод сравнения записанного хеша и хеша данного пароля
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override;
+};
+
+#endif
@@ -0,0 +1,57 @@
+// include/HttpProtocol.hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "AuthProtocol.hpp"
+#include "UserRole.hpp"
+
+#ifndef HTTP_PROTOCOL_HPP
+#define HTTP_PROTOCOL_HPP
+
+// Минимальный HTTP/1.1 для сервера аутентификации: разбор запросов с Content-Length (без chunked)
+// и ответы с телом JSON. Разбор не копирует данные: поля запроса указывают в буфер соединения
+class HttpProtocol
+{
+public:
+    static const size_t MAX_REQUEST_BYTES = 8192; // Предел заголовков вместе с телом
+
+    // Разобранный запрос; поля действительны, пока не изменен буфер, из которого он выделен
+    struct Request
+    {
+        std::string_view method;
+        std::string_view target;
+        std::string_view body;
+        std::string_view authorization; // Значение заголовка Authorization
+        uint32_t deadlineMs = 0;        // Заголовок X-Deadline-Ms: срок запроса в мс от приема (0 — нет)
+        bool keepAlive = true;          // Соединение остается открытым после ответа
+    };
+
+    // Выделение очередного запроса из buffer начиная с позиции pos. scanned — сколько байт запроса уже
+    // просмотрено в поисках конца заголовков: при повторном вызове после прихода данных поиск продолжается
+    // с этого места. При COMPLETE pos сдвигается за запрос, scanned обнуляется
+    static AuthProtocol::FrameStatus extractRequest(std::string_view buffer, size_t &pos, size_t &scanned, Request &request);
+
+    // Строковые поля login и password из объекта JSON; false, если тело не объект из строковых полей
+    // или одного из полей нет
+    static bool parseCredentials(std::string_view body, std::string &login, std::string &password);
+
+    // Дописывание строки JSON в кавычках с экранированием
+    static void appendJsonString(std::string &out, std::string_view value);
+
+    // Дописывание ответа с телом JSON; буфер расширяется один раз под заголовки и тело.
+    // retryAfterSeconds > 0 добавляет заголовок Retry-After
+    static void appendResponse(std::string &out, unsigned statusCode, std::string_view body, bool keepAlive,
+                               unsigned retryAfterSeconds = 0);
+
+    // Код HTTP для результата проверки
+    static unsigned statusCode(UserErrorCode status);
+
+    // Имя результата проверки и роли для тела ответа
+    static const char *statusName(UserErrorCode status);
+    static const char *roleName(UserRole role);
+};
+
+#endif
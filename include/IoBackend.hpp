@@ -0,0 +1,20 @@
+// include/IoBackend.hpp
+
+#include <cstddef>
+#include <memory>
+
+#include "IoBackendInterface.hpp"
+
+#ifndef IO_BACKEND_HPP
+#define IO_BACKEND_HPP
+
+// Выбор реализации асинхронного ввода-вывода
+class IoBackend
+{
+public:
+    // io_uring на entries операций, если ядро его поддерживает и он разрешен (preferIoUring);
+    // иначе пул из threads потоков с pread/pwrite
+    static std::unique_ptr<IoBackendInterface> create(bool preferIoUring = true, unsigned entries = 256, size_t threads = 2);
+};
+
+#endif
@@ -0,0 +1,47 @@
+// include/IoBackendInterface.hpp
+
+#include <cstddef>
+#include <functional>
+#include <sys/types.h>
+
+#ifndef IO_BACKEND_INTERFACE_HPP
+#define IO_BACKEND_INTERFACE_HPP
+
+// Асинхронный файловый ввод-вывод. Операции ставятся в очередь и уходят на выполнение одним пакетом
+// при submit(); обратные вызовы выполняются в потоке, вызвавшем complete(). Все методы вызываются из
+// одного потока-владельца; буфер операции должен жить до ее завершения
+class IoBackendInterface
+{
+public:
+    // Результат операции: число байт (для fsync — 0) или -errno
+    using Completion = std::function<void(ssize_t)>;
+
+    // Чтение size байт со смещения offset
+    virtual void read(int fd, void *buffer, size_t size, off_t offset, Completion done) = 0;
+
+    // Запись по смещению offset; offset = -1 — текущая позиция (для файла с O_APPEND — дописывание в конец)
+    virtual void write(int fd, const void *data, size_t size, off_t offset, Completion done) = 0;
+
+    // fsync начинается после завершения всех ранее отправленных операций, следующие операции ждут его завершения
+    virtual void fsync(int fd, Completion done) = 0;
+
+    // Отправка поставленных операций одним пакетом; число отправленных
+    virtual size_t submit() = 0;
+
+    // Выполнение обратных вызовов завершившихся операций; при wait ждет хотя бы одного завершения,
+    // если операции в пути. Число выполненных обратных вызовов. Допускает вызов из обратного вызова
+    virtual size_t complete(bool wait) = 0;
+
+    // Дескриптор для epoll: готов к чтению, когда есть завершения
+    virtual int eventFd() const = 0;
+
+    // Операций поставлено или в пути и еще не завершено
+    virtual size_t inFlight() const = 0;
+
+    // Название реализации
+    virtual const char *name() const = 0;
+
+    virtual ~IoBackendInterface() = default;
+};
+
+#endif
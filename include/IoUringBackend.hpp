@@ -0,0 +1,92 @@
+// include/IoUringBackend.hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "IoBackendInterface.hpp"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+#ifndef IO_URING_BACKEND_HPP
+#define IO_URING_BACKEND_HPP
+
+// Ввод-вывод через io_uring (системные вызовы напрямую, без liburing). Операции копятся в очереди
+// владельца и при submit() заполняют кольцо отправки, которое уходит в ядро одним io_uring_enter.
+// Завершения читаются из кольца завершений; eventfd, зарегистрированный в кольце, сообщает о них epoll.
+// В пути не больше операций, чем мест в кольце завершений, так что завершения не теряются
+class IoUringBackend : public IoBackendInterface
+{
+    enum class Operation : uint8_t
+    {
+        READ,
+        WRITE,
+        FSYNC
+    };
+
+    // Операция, еще не помещенная в кольцо
+    struct Request
+    {
+        Operation operation;
+        int fd;
+        void *buffer;
+        size_t size;
+        off_t offset;
+        uint32_t slot; // Номер обратного вызова
+    };
+
+    int ringFd = -1;
+    int completionFd = -1;
+
+    void *sqRing = nullptr;
+    size_t sqRingSize = 0;
+    void *cqRing = nullptr;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned *sqHead = nullptr;
+    unsigned *sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned *sqArray = nullptr;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned cqMask = 0;
+    unsigned cqEntries = 0;
+    io_uring_cqe *cqes = nullptr;
+
+    std::vector<Request> queued;
+    std::vector<Completion> callbacks;
+    std::vector<uint32_t> freeSlots;
+    size_t submitted = 0; // Отправлено в ядро и не завершено
+
+    uint32_t store(Completion done);
+    void enqueue(Operation operation, int fd, void *buffer, size_t size, off_t offset, Completion done);
+    void release();
+
+public:
+    // Кольцо на entries операций; при ошибке available() возвращает false
+    explicit IoUringBackend(unsigned entries = 256);
+
+    IoUringBackend(const IoUringBackend &) = delete;
+    IoUringBackend &operator=(const IoUringBackend &) = delete;
+
+    // Создано ли кольцо и поддерживает ли ядро нужные операции
+    bool available() const;
+
+    void read(int fd, void *buffer, size_t size, off_t offset, Completion done) override;
+    void write(int fd, const void *data, size_t size, off_t offset, Completion done) override;
+    void fsync(int fd, Completion done) override;
+    size_t submit() override;
+    size_t complete(bool wait) override;
+    int eventFd() const override;
+    size_t inFlight() const override;
+    const char *name() const override;
+
+    // Дожидается операций в пути: ядро не должно писать в буферы после уничтожения
+    ~IoUringBackend();
+};
+
+#endif
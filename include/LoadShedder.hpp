@@ -0,0 +1,47 @@
+// include/LoadShedder.hpp
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef LOAD_SHEDDER_HPP
+#define LOAD_SHEDDER_HPP
+
+// Сброс нагрузки перед очередью проверок пароля. Время проверки сглаживается экспоненциальным
+// средним (вес нового замера 1/8); ожидаемая задержка нового запроса — число волн проверок перед ним
+// (запросы в исполнителе, деленные на число потоков) плюс его собственная проверка. Если она больше
+// предела, запрос отклоняется сразу, с подсказкой, через сколько повторить: иначе при перегрузке
+// очередь растет, пока запросы не начнут истекать, и медленно отвечают всем.
+// До первого замера ожидаемая задержка неизвестна и запросы принимаются. Методы вызываются из одного потока
+class LoadShedder
+{
+    uint64_t maxLatencyMicros; // 0 — без ограничения
+    size_t workers;
+    double averageVerifyMicros;
+    bool measured;
+    size_t queued;     // Принятых и не завершенных проверок
+    uint64_t rejected; // Отклоненных запросов
+
+public:
+    LoadShedder(unsigned maxLatencyMs, size_t workerThreads);
+
+    // Ожидаемая задержка новой проверки в микросекундах (0 до первого замера)
+    uint64_t predictedLatencyMicros() const;
+
+    // Допуск новой проверки. false — ожидаемая задержка превышает предел; retryAfterMs — через сколько
+    // миллисекунд очередь, по оценке, уменьшится настолько, что запрос будет принят
+    bool admit(uint32_t &retryAfterMs);
+
+    // Принятая проверка поставлена в исполнитель
+    void started();
+
+    // Проверка завершена; verifyMicros — время самой проверки пароля (0 — не замерялось)
+    void finished(uint64_t verifyMicros);
+
+    // Проверок в исполнителе
+    size_t depth() const;
+
+    // Отклонено запросов с момента создания
+    uint64_t rejectedCount() const;
+};
+
+#endif
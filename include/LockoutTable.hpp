@@ -0,0 +1,103 @@
+// include/LockoutTable.hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ErrorCode.hpp"
+
+#ifndef LOCKOUT_TABLE_HPP
+#define LOCKOUT_TABLE_HPP
+
+// Запись таблицы блокировок. Все поля атомарны без блокировок и годятся для памяти,
+// разделяемой процессами (файл отображается в каждый процесс)
+struct LockoutSlot
+{
+    std::atomic<uint64_t> key;        // Хеш логина (0 — запись свободна)
+    std::atomic<uint32_t> failures;   // Неудачных попыток подряд
+    uint32_t reserved;
+    std::atomic<int64_t> lastFailure; // Время последней неудачной попытки (секунды Unix)
+    std::atomic<int64_t> lockedUntil; // Вход запрещен до этого времени
+};
+
+static_assert(sizeof(LockoutSlot) == 32, "LockoutSlot layout is part of the lockout file format");
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "lockout counters must be lock-free to be shared between processes");
+
+// Заголовок файла таблицы
+struct LockoutFileHeader
+{
+    static const uint32_t MAGIC = 0x4b434f4c; // "LOCK"
+    static const uint32_t VERSION = 2;
+    static const size_t KEY_BYTES = 16;
+
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;                  // Число записей (степень двойки)
+    unsigned char hashKey[KEY_BYTES];   // Случайный ключ хеша логинов, создается вместе с файлом
+    char reserved[32];
+};
+
+static_assert(sizeof(LockoutFileHeader) == 64, "LockoutFileHeader layout is part of the lockout file format");
+
+// Счетчики неудачных попыток входа и сроки блокировки по логинам в отображаемом (mmap) файле:
+// значения переживают перезапуск приложений и видны всем процессам, открывшим файл.
+// Таблица с открытой адресацией; поиск просматривает не более MAX_PROBE записей и не берет
+// блокировок, поэтому проверка заблокированного логина стоит доли микросекунды.
+// Логины хранятся как 64-битные хеши SipHash с ключом из заголовка файла, поэтому подобрать логины,
+// попадающие в окно поиска чужого логина, нельзя. При переполнении окна занимается запись, не менявшаяся
+// дольше окна подсчета, иначе — незаблокированная запись с самой старой неудачей. Если заблокированы
+// все записи окна, логин тоже считается заблокированным: неудача никогда не пропускается
+class LockoutTable
+{
+public:
+    static const size_t DEFAULT_CAPACITY = 131072; // 4 МиБ; при заполнении выше ~60% записи начинают вытесняться
+    static const size_t MAX_PROBE = 32;
+
+private:
+    int fd;
+    void *mapping;
+    size_t mappingSize;
+    LockoutSlot *slots;
+    size_t capacity;
+    unsigned char hashKey[LockoutFileHeader::KEY_BYTES];
+
+    uint64_t keyOf(const std::string &login) const;
+
+    // Поиск записи логина без вставки
+    LockoutSlot *find(uint64_t key) const;
+
+    // Все записи окна поиска ключа заблокированы в момент now; lockedUntil — ближайшее окончание блокировки
+    bool windowLocked(uint64_t key, int64_t now, int64_t &lockedUntil) const;
+
+    // Поиск или занятие записи; staleAfter — через сколько секунд без неудач запись можно занять заново.
+    // nullptr, если все записи окна заблокированы
+    LockoutSlot *findOrInsert(uint64_t key, int64_t now, int64_t staleAfter);
+
+public:
+    LockoutTable();
+
+    LockoutTable(const LockoutTable &) = delete;
+    LockoutTable &operator=(const LockoutTable &) = delete;
+
+    // Открытие или создание файла. Размер существующего файла сохраняется;
+    // файл другого формата создается заново
+    ConfiguratorErrorCode open(const std::string &path, size_t slotCount = DEFAULT_CAPACITY);
+
+    // Заблокирован ли логин в момент now; lockedUntil — время окончания блокировки
+    bool isLocked(const std::string &login, int64_t now, int64_t &lockedUntil) const;
+
+    // Учет неудачной попытки. Счетчик начинается заново, если с прошлой неудачи прошло больше
+    // lockoutSeconds; после maxFailures неудач подряд логин блокируется на lockoutSeconds.
+    // Возвращает true, если логин заблокирован (этой или более ранней попыткой)
+    bool recordFailure(const std::string &login, unsigned maxFailures, int64_t lockoutSeconds, int64_t now);
+
+    // Сброс счетчика после успешного входа
+    void recordSuccess(const std::string &login);
+
+    ~LockoutTable();
+};
+
+#endif
@@ -0,0 +1,45 @@
+// include/MemoryArena.hpp
+
+#include <cstddef>
+
+#ifndef MEMORY_ARENA_HPP
+#define MEMORY_ARENA_HPP
+
+// Переиспользуемая область памяти для рабочих блоков Argon2.
+// Память выделяется через mmap (по возможности на огромных страницах), заранее
+// отображается в физическую память и не освобождается между вызовами хеширования
+class MemoryArena
+{
+    void *base;      // Начало отображенной области
+    size_t capacity; // Размер отображенной области в байтах
+    bool hugePages;  // Используются ли явные (MAP_HUGETLB) огромные страницы
+
+    // Освобождение текущей области
+    void release();
+
+public:
+    MemoryArena();
+
+    MemoryArena(const MemoryArena &) = delete;
+    MemoryArena &operator=(const MemoryArena &) = delete;
+
+    // Получение области размером не менее bytes байт; при нехватке область пересоздается.
+    // Возвращает nullptr, если память выделить не удалось
+    void *reserve(size_t bytes);
+
+    // Затирание первых bytes байт области (не больше ее размера)
+    void wipe(size_t bytes);
+
+    // Текущий размер области
+    size_t size() const;
+
+    // Выделена ли область на явных огромных страницах
+    bool usesHugePages() const;
+
+    // Арена текущего потока (создается при первом обращении, живет до завершения потока)
+    static MemoryArena &threadLocal();
+
+    ~MemoryArena();
+};
+
+#endif
@@ -0,0 +1,82 @@
+// include/PartitionedUserTable.hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ConfiguratorDatabaseInterface.hpp"
+#include "ErrorCode.hpp"
+#include "SpscQueue.hpp"
+
+#ifndef PARTITIONED_USER_TABLE_HPP
+#define PARTITIONED_USER_TABLE_HPP
+
+// Таблица активных пользователей, разделенная между ядрами (режим «поток на ядро»). Запись логина
+// хранится только в разделе ядра owner(login); запрос к чужому логину уходит владельцу сообщением через
+// очередь SpscQueue, отдельную для каждой пары ядер, и ответ возвращается тем же путем. Общих блокировок
+// и изменяемых строк кэша, в которые пишут несколько ядер, на пути запроса нет.
+// Методы с параметром core вызываются только из потока этого ядра; каждый поток регулярно вызывает
+// poll(core), иначе запросы к его разделу не обслуживаются. Разделы заполняются в load() до запуска
+// потоков и дальше не меняются: ответ несет указатель на запись в разделе владельца
+class PartitionedUserTable
+{
+public:
+    // Завершение запроса: код и запись пользователя (nullptr, если логин не найден)
+    using Callback = std::function<void(ConfiguratorErrorCode, const std::string *)>;
+
+    explicit PartitionedUserTable(size_t cores, size_t queueCapacity = 1024);
+
+    // Заполнение разделов из базы; повторный вызов заменяет содержимое. Не вызывается при работающих потоках
+    ConfiguratorErrorCode load(ConfiguratorDatabaseInterface &db);
+
+    // Ядро — владелец раздела с логином
+    size_t owner(std::string_view login) const;
+
+    // Поиск записи из потока ядра core. Свой логин завершается сразу, чужой — в одном из следующих poll(core)
+    void lookup(size_t core, std::string_view login, Callback done);
+
+    // Обработка входящих запросов и ответов ядра core и отправка отложенных сообщений; число обработанных
+    size_t poll(size_t core);
+
+    // Запросов ядра core, ожидающих ответа
+    size_t inFlight(size_t core) const;
+
+    size_t cores() const;
+
+private:
+    // Запрос (reply == false) или ответ владельца; tag — номер ожидающего обратного вызова у запросившего ядра
+    struct Message
+    {
+        uint32_t tag = 0;
+        bool reply = false;
+        ConfiguratorErrorCode code = ConfiguratorErrorCode::SUCCESS;
+        const std::string *record = nullptr;
+        std::string login;
+    };
+
+    // Состояние ядра: меняется только его потоком
+    struct alignas(64) Core
+    {
+        std::unordered_map<std::string, std::string> partition;
+        std::vector<Callback> pending;         // Ожидающие ответа запросы по тегу
+        std::vector<uint32_t> freeTags;        // Свободные теги в pending
+        std::vector<std::deque<Message>> held; // Сообщения, не поместившиеся в очередь к ядру
+        size_t inFlight = 0;
+    };
+
+    size_t coreCount;
+    std::vector<std::unique_ptr<Core>> state;
+    // Очередь от ядра from к ядру to — queues[from * coreCount + to]
+    std::vector<std::unique_ptr<SpscQueue<Message>>> queues;
+
+    void send(size_t from, size_t to, Message &message);
+    ConfiguratorErrorCode find(const Core &core, const std::string &login, const std::string *&record) const;
+};
+
+#endif
@@ -0,0 +1,52 @@
+// include/PasswordFingerprint.hpp
+
+#include <string>
+#include <cstdint>
+
+#include "ErrorCode.hpp"
+
+#ifndef PASSWORD_FINGERPRINT_HPP
+#define PASSWORD_FINGERPRINT_HPP
+
+// Короткий ключевой отпечаток пароля для быстрой проверки повторного использования.
+// Отпечаток = первые 32 бита HMAC-SHA256(перец, логин || 0x00 || пароль), записывается в архиве
+// после хеша через '#': "$argon2id$...$хеш#1a2b3c4d". Перец (секретный ключ) хранится в отдельном
+// файле на сервере и не попадает в базу; без него отпечатки ничего не дают для перебора
+class PasswordFingerprint
+{
+public:
+    static const size_t KEY_BYTES = 32;          // Длина перца (crypto_auth_hmacsha256_KEYBYTES)
+    static const size_t FINGERPRINT_BYTES = 4;   // Длина отпечатка (32 бита)
+    static const char SEPARATOR = '#';           // Разделитель хеша и отпечатка в записи архива
+
+private:
+    uint8_t key[KEY_BYTES]; // Перец
+    bool loaded;            // Перец успешно загружен
+
+public:
+    // Конструктор класса (перец не загружен, отпечатки выключены)
+    PasswordFingerprint();
+
+    // Загрузка перца из файла: 64 шестнадцатеричных символа (пробельные символы в конце допускаются)
+    ConfiguratorErrorCode loadPepper(const std::string &pepperPath);
+
+    // Загружен ли перец
+    bool isEnabled() const;
+
+    // Вычисление отпечатка пароля пользователя (8 шестнадцатеричных символов)
+    ConfiguratorErrorCode compute(const std::string &login, const std::string &password, std::string &fingerprint) const;
+
+    // Формирование записи архива из хеша и отпечатка
+    static std::string attach(const std::string &hashedPassword, const std::string &fingerprint);
+
+    // Разбор записи архива; для записей без отпечатка fingerprint будет пустым
+    static void split(const std::string &entry, std::string &hashedPassword, std::string &fingerprint);
+
+    // Деструктор затирает перец
+    ~PasswordFingerprint();
+
+    PasswordFingerprint(const PasswordFingerprint &) = delete;
+    PasswordFingerprint &operator=(const PasswordFingerprint &) = delete;
+};
+
+#endif
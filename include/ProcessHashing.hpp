@@ -0,0 +1,97 @@
+// include/ProcessHashing.hpp
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+#include "HashingInterface.hpp"
+
+#ifndef PROCESS_HASHING_HPP
+#define PROCESS_HASHING_HPP
+
+// Параметры пула процессов
+struct ProcessHashingOptions
+{
+    size_t workers = 0;      // Число процессов (0 — по числу ядер)
+    bool pinWorkers = false; // Закрепить процесс i за ядром i по модулю числа ядер
+    unsigned timeoutMs = 10000; // Процесс, не ответивший за это время, завершается, запрос получает ошибку (0 — без срока)
+};
+
+// Хеширование в пуле заранее порожденных (fork) процессов.
+// Каждый процесс связан с основным парой сокетов AF_UNIX/SOCK_SEQPACKET: один запрос — одно сообщение.
+// Память и процессорное время Argon2 расходуются в рабочих процессах; если процесс падает
+// или завершается системой (например, при нехватке памяти), он перезапускается, а запрос
+// повторяется в другом процессе. Процесс, не ответивший за options.timeoutMs, считается зависшим: он
+// завершается и перезапускается, а запрос не повторяется. Рабочие процессы, в том числе перезапущенные,
+// порождает отдельный однопроцессный порождатель, созданный конструктором: основной процесс после
+// конструктора fork не вызывает, поэтому перезапуск из многопоточного приложения безопасен и не держит общий
+// mutex. Пул (а значит, и порождатель) следует создавать до запуска потоков приложения
+class ProcessHashing : public HashingInterface
+{
+public:
+    static const size_t MAX_MESSAGE_BYTES = 4096; // Максимальный размер запроса и ответа
+
+private:
+    // Рабочий процесс
+    struct Worker
+    {
+        pid_t pid;  // Идентификатор процесса (-1, если не запущен)
+        int socket; // Сокет основного процесса
+    };
+
+    HashingInterface *hasher; // Хешер, которым пользуются рабочие процессы
+    ProcessHashingOptions options;
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::vector<size_t> idle; // Индексы свободных процессов
+    size_t alive;             // Число запущенных процессов
+    size_t restarts;          // Число перезапусков упавших процессов
+
+    // Записи workers и обмен с порождателем — под spawnMutex; сокет своего процесса вызывающий поток
+    // читает без блокировки
+    std::mutex spawnMutex;
+    std::vector<Worker> workers;
+    pid_t forker; // Процесс-порождатель (-1, если не запущен)
+    int control;  // Сокет обмена с порождателем
+
+    // Запуск рабочего процесса с номером index через порождатель; вызывается без mutex
+    bool spawn(size_t index);
+
+    // Остановка рабочего процесса с номером index; вызывается без mutex
+    void stop(size_t index);
+
+    // Цикл порождателя: запуск рабочих процессов и ожидание их завершения по запросам основного
+    void runForker();
+
+    // Цикл обработки запросов в рабочем процессе
+    void serve(int socket);
+
+    // Выполнение запроса в свободном процессе с одной повторной попыткой при его падении
+    ConfiguratorErrorCode call(char operation, const std::string &password, const std::string &hashIn, std::string &hashOut);
+
+public:
+    ProcessHashing(HashingInterface *hash, const ProcessHashingOptions &processOptions = ProcessHashingOptions());
+
+    ProcessHashing(const ProcessHashing &) = delete;
+    ProcessHashing &operator=(const ProcessHashing &) = delete;
+
+    // Метод хеширования пароля
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override;
+
+    // Метод сравнения записанного хеша и хеша данного пароля
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override;
+
+    // Идентификаторы запущенных рабочих процессов
+    std::vector<pid_t> workerPids();
+
+    // Число перезапусков упавших процессов
+    size_t restartCount();
+
+    // Закрывает сокеты и дожидается завершения рабочих процессов и порождателя
+    ~ProcessHashing();
+};
+
+#endif
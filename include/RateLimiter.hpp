@@ -0,0 +1,106 @@
+// include/RateLimiter.hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <pthread.h>
+#include <string>
+
+#include "MemoryArena.hpp"
+
+#ifndef RATE_LIMITER_HPP
+#define RATE_LIMITER_HPP
+
+// Вид ключа ограничения: логин или источник запроса (пользователь, подключившийся к сокету)
+enum class RateLimitKind
+{
+    LOGIN = 0,
+    SOURCE
+};
+
+// Скорость пополнения и емкость корзины для одного вида ключа
+struct RateLimitPolicy
+{
+    double perSecond; // Попыток в секунду в среднем (0 — без ограничения)
+    double burst;     // Попыток подряд после простоя
+};
+
+// Параметры ограничителя
+struct RateLimiterOptions
+{
+    size_t capacity = size_t(1) << 18;    // Число корзин (16 байт каждая), округляется до степени двойки
+    size_t shards = 64;                   // Число независимых блокировок
+    RateLimitPolicy login = {0.2, 10};    // Один логин: 10 попыток, затем одна в 5 секунд
+    RateLimitPolicy source = {20, 200};   // Один источник: 200 попыток, затем 20 в секунду
+    bool shared = false;                  // Таблица в разделяемой памяти: ограничитель, созданный до fork, общий для процессов
+};
+
+// Ограничение частоты попыток входа корзинами токенов по логину и по источнику.
+// Корзины хранятся в таблице фиксированного размера (память выделяет MemoryArena): множества по 4 корзины занимают
+// ровно одну строку кеша, поэтому проверка читает одну строку. Если в множестве нет места,
+// вытесняется корзина, к которой дольше всех не обращались (приблизительный LRU по всей таблице);
+// вытесненная корзина при следующем обращении начинается полной.
+// Таблица разделена на сегменты со своими спин-блокировками, методы можно вызывать из нескольких потоков.
+// С options.shared таблица и блокировки отображаются MAP_SHARED: процессы, получившие ограничитель при fork,
+// списывают попытки из общих корзин (монотонные часы общие для процессов). Сегменты тогда защищены
+// межпроцессными мьютексами (PTHREAD_PROCESS_SHARED), устойчивыми к завершению владельца (PTHREAD_MUTEX_ROBUST):
+// процесс, убитый под блокировкой, не останавливает остальные. Блокировка держится только
+// на время просмотра строки кеша без системных вызовов
+class RateLimiter
+{
+public:
+    static const size_t WAYS = 4;
+
+private:
+    // Корзина: хеш ключа (0 — свободна), отметка последнего обращения в мс, остаток токенов
+    struct Bucket
+    {
+        uint64_t key;
+        uint32_t stamp;
+        float tokens;
+    };
+
+    struct alignas(64) BucketSet
+    {
+        Bucket buckets[WAYS];
+    };
+
+    struct alignas(64) Shard
+    {
+        std::atomic_flag locked = ATOMIC_FLAG_INIT; // Спин-блокировка ограничителя одного процесса
+        pthread_mutex_t mutex;                      // Блокировка при options.shared
+    };
+
+    static_assert(sizeof(BucketSet) == 64, "a bucket set must fill exactly one cache line");
+
+    RateLimitPolicy policies[2];
+    MemoryArena arena; // Память таблицы: на огромных страницах промах по таблице не добавляет промаха TLB
+    BucketSet *sets;
+    size_t setMask;
+    std::unique_ptr<Shard[]> ownShards;
+    Shard *shards;
+    size_t shardMask;
+    void *sharedMapping; // Таблица и блокировки при options.shared
+    size_t sharedSize;
+
+    static uint64_t keyOf(RateLimitKind kind, const std::string &key);
+
+    // Захват и освобождение сегмента
+    void lock(Shard &shard);
+    void unlock(Shard &shard);
+
+public:
+    RateLimiter(const RateLimiterOptions &options = RateLimiterOptions());
+
+    RateLimiter(const RateLimiter &) = delete;
+    RateLimiter &operator=(const RateLimiter &) = delete;
+
+    // Списание попытки для ключа в момент nowMs (миллисекунды монотонных часов);
+    // false — корзина пуста и попытку нужно отклонить
+    bool allow(RateLimitKind kind, const std::string &key, int64_t nowMs);
+
+    ~RateLimiter();
+};
+
+#endif
@@ -0,0 +1,36 @@
+// include/RequestArena.hpp
+
+#include <cstddef>
+#include <memory_resource>
+
+#ifndef REQUEST_ARENA_HPP
+#define REQUEST_ARENA_HPP
+
+// Арена временных данных одного запроса входа (строки из базы и т. п.).
+// Память выдается последовательно из встроенного буфера и освобождается вся сразу вызовом reset();
+// блоки сверх буфера берутся из пула, который сохраняет их между запросами. После первых запросов
+// обработка запроса не обращается к общей куче. Класс не потокобезопасен: арена принадлежит одному потоку
+class RequestArena
+{
+public:
+    static const size_t INLINE_BYTES = 4096; // Строка пользователя в базе обычно занимает до сотни байт
+
+private:
+    alignas(std::max_align_t) unsigned char buffer[INLINE_BYTES];
+    std::pmr::unsynchronized_pool_resource upstream;
+    std::pmr::monotonic_buffer_resource arena;
+
+public:
+    RequestArena();
+
+    RequestArena(const RequestArena &) = delete;
+    RequestArena &operator=(const RequestArena &) = delete;
+
+    // Распределитель для данных текущего запроса
+    std::pmr::memory_resource *resource();
+
+    // Освобождение всех данных запроса; объекты, размещенные в арене, к этому моменту должны быть уничтожены
+    void reset();
+};
+
+#endif
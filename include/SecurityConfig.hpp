@@ -1,74 +1,114 @@
 // include/SecurityConfig.hpp
 
-#include <string>
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #include "SecurityConfigInterface.hpp"
+#include "SharedSecurityConfig.hpp"
 
 #ifndef SECURITY_CONFIGUR_HPP
 #define SECURITY_CONFIGUR_HPP
-// Класс для работы с конфигурацией безопасности, управляет параметрами безопасности, реализует интерфейс SecurityConfigInterface
+// Класс для работы с конфигурацией безопасности, управляет параметрами безопасности, реализует интерфейс SecurityConfigInterface.
+// Данные хранятся в неизменяемых снимках: запись и перезагрузка публикуют новый снимок атомарной заменой указателя,
+// поэтому методы get_* не ждут писателя и всегда видят конфигурацию целиком (RCU)
 class SecurityConfig : public SecurityConfigInterface
 {
-    // Хранение данных конфигурации в виде пары "ключ-значение"
-    std::map<std::string, unsigned> data;
+    // Неизменяемый снимок конфигурации: параметры схемы хранятся массивом, индексированным SecurityParam
+    struct Snapshot
+    {
+        unsigned fields[SECURITY_PARAM_COUNT] = {}; // Значения параметров
+        bool present[SECURITY_PARAM_COUNT] = {};    // Наличие параметра в файле
+        bool rejected[SECURITY_PARAM_COUNT] = {};   // Значение в файле вне допустимого диапазона
+        bool complete = false;                      // Файл прочитан до конца: отсутствующий параметр имеет значение по умолчанию
+        std::map<std::string, unsigned> unknown;    // Ключи вне схемы, сохраняются при записи как есть
+
+        bool operator==(const Snapshot &other) const;
+
+        // Действующее значение параметра: из файла или по умолчанию из схемы. false, если файл не прочитан
+        // целиком и параметра в нем нет или если значение в файле отклонено
+        bool value(size_t index, unsigned &result) const;
+    };
+
+    // Текущий снимок. Читатель берет ссылку на него, поэтому замененный снимок освобождается,
+    // когда его отпустит последний читатель, успевший загрузить указатель до замены. Ссылку поток
+    // хранит между вызовами get, пока не изменится generation: у каждого потока не больше одного старого снимка
+    std::atomic<std::shared_ptr<const Snapshot>> current;
+
+    // Номер объекта для кеша потока: адрес уничтоженного объекта может достаться новому
+    const uint64_t instanceId;
+
+    // Номер текущего снимка, увеличивается при каждой публикации
+    std::atomic<unsigned long> generation;
+
+    // Сериализует запись и перезагрузку
+    std::mutex writerMutex;
 
     // Пути к файлу конфигурации и временному файлу
     std::string configFilePath;
     std::string tmpFilePath;
 
-    // Константы для параметров безопасности
-    const std::string minPasswordLength = "minPasswordLength";
-    const std::string passwordHistoryDepth = "passwordHistoryDepth";
-    const std::string passwordExpirationDays = "passwordExpirationDays";
-    const std::string maxInactiveTimeMin = "maxInactiveTimeMin";
-    const std::string maxFailedAttempts = "maxFailedAttempts";
-    const std::string lockoutTimeMin = "lockoutTimeMin";
+    // Публикация политики в разделяемую память для других процессов (nullptr — не публикуется)
+    std::unique_ptr<SharedPolicyWriter> sharedWriter;
 
-    // Загрузка данных конфигурации из файла
-    ConfiguratorErrorCode loadFromConfigFile();
+    // Отслеживание изменений файла через inotify
+    int inotifyFd;
+    int stopFd;
+    std::thread watcher;
 
-    // Сохранение данных конфигурации в файл
-    ConfiguratorErrorCode saveToConfigFile() const;
+    // Чтение данных конфигурации из файла. Значения вне допустимого диапазона не загружаются,
+    // при этом возвращается ошибка
+    ConfiguratorErrorCode loadFromConfigFile(Snapshot &snapshot) const;
 
-public:
-    // Конструктор класса SecurityConfig, инициализирует путь к файлу конфигурации и    загружает данные из файла
-    SecurityConfig(std::string configPath = "./configDb/config.txt");
+    // Атомарное сохранение данных конфигурации в файл: запись во временный файл, fsync и rename.
+    // Читатель видит либо старый, либо новый файл целиком
+    ConfiguratorErrorCode saveToConfigFile(const Snapshot &snapshot) const;
+
+    // Публикация нового снимка (вызывается под writerMutex); одинаковые данные не публикуются повторно
+    void publish(std::unique_ptr<Snapshot> snapshot);
 
-    // Установка минимальной длины пароля и сохранение изменений в файл конфигурации
-    ConfiguratorErrorCode set_minPasswordLength(const unsigned length) override;
+    // Запись текущего снимка и отметки файла в разделяемую память (вызывается под writerMutex)
+    void publishShared();
 
-    // Установка глубины истории паролей и сохранение изменений в файл конфигурации
-    ConfiguratorErrorCode set_passwordHistoryDepth(const unsigned depth) override;
-    // Установка срока действия пароля (в днях) и сохранение изменений в файл конфигурации
-    ConfiguratorErrorCode set_passwordExpirationDays(const unsigned days) override;
+    // Цикл потока, отслеживающего изменения файла
+    void watchLoop();
 
-    // Установка максимального времени неактивности пользователя (в минутах) и сохранение изменений в файл конфигурации
-    ConfiguratorErrorCode set_maxInactiveTimeMin(const unsigned minutes) override;
+public:
+    // Конструктор класса SecurityConfig, инициализирует путь к файлу конфигурации и    загружает данные из файла
+    SecurityConfig(std::string configPath = "./configDb/config.txt");
 
-    // Установка максимального числа неудачных попыток входа и сохранение изменений в файл конфигурации
-    ConfiguratorErrorCode set_maxFailedAttempts(const unsigned attempts) override;
+    SecurityConfig(const SecurityConfig &) = delete;
+    SecurityConfig &operator=(const SecurityConfig &) = delete;
 
-    // Установка времени блокировки учетной записи (в минутах) и сохранение изменений в файл конфигурации
-    ConfiguratorErrorCode set_lockoutTimeMin(const unsigned minutes) override;
+    // Перечитывание файла конфигурации и публикация нового снимка.
+    // Если файл не читается или содержит некорректные данные, текущий снимок остается прежним
+    ConfiguratorErrorCode reload();
 
-    // Получение минимальной длины пароля из конфигурации
-    ConfiguratorErrorCode get_minPasswordLength(unsigned &length) const override;
+    // Запуск потока, который перечитывает конфигурацию при каждом изменении файла (inotify).
+    // Отслеживается каталог файла, поэтому замена файла через rename тоже замечается
+    ConfiguratorErrorCode watch();
 
-    // Получение глубины истории паролей из конфигурации
-    ConfiguratorErrorCode get_passwordHistoryDepth(unsigned &depth) const override;
+    // Публикация политики в сегмент разделяемой памяти segmentName при каждом изменении,
+    // чтобы другие процессы читали ее через SharedSecurityConfig без разбора файла
+    ConfiguratorErrorCode shareVia(const std::string &segmentName);
 
-    // Получение срока действия пароля (в днях) из конфигурации
-    ConfiguratorErrorCode get_passwordExpirationDays(unsigned &days) const override;
+    // Номер текущего снимка конфигурации
+    unsigned long snapshotGeneration() const;
 
-    // Получение максимального времени неактивности пользователя (в минутах) из конфигурации
-    ConfiguratorErrorCode get_maxInactiveTimeMin(unsigned &minutes) const override;
+    // Применение нескольких изменений одной атомарной записью файла конфигурации.
+    // При ошибке записи или значении вне допустимого диапазона ни одно изменение не применяется
+    ConfiguratorErrorCode applyChanges(const SecurityConfigChanges &changes) override;
 
-    // Получение максимального числа неудачных попыток входа из конфигурации
-    ConfiguratorErrorCode get_maxFailedAttempts(unsigned &attempts) const override;
+    // Получение значения параметра из текущего снимка (без блокировок). Параметр, которого нет
+    // в прочитанном файле, имеет значение по умолчанию из securitySchema
+    ConfiguratorErrorCode get(SecurityParam param, unsigned &value) const override;
 
-    // Получение времени блокировки пользователя (в минутах) из конфигурации
-    ConfiguratorErrorCode get_lockoutTimeMin(unsigned &minutes) const override;
+    // Останавливает поток отслеживания изменений
+    ~SecurityConfig();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,28 +1,58 @@
 // include/SecurityConfigInterface.hpp
 
+#include <array>
+#include <optional>
+
 #include "ErrorCode.hpp"
+#include "SecurityConfigSchema.hpp"
 
 #ifndef SECURITY_CONFIG_INTERFACE_HPP
 #define SECURITY_CONFIG_INTERFACE_HPP
 
+// Набор изменений параметров безопасности; незаданные параметры остаются без изменений
+struct SecurityConfigChanges
+{
+    std::array<std::optional<unsigned>, SECURITY_PARAM_COUNT> values;
+
+    void set(SecurityParam param, unsigned value)
+    {
+        values[static_cast<size_t>(param)] = value;
+    }
+
+    const std::optional<unsigned> &get(SecurityParam param) const
+    {
+        return values[static_cast<size_t>(param)];
+    }
+};
+
 class SecurityConfigInterface
 {
 public:
-    virtual ConfiguratorErrorCode set_minPasswordLength(const unsigned length) = 0;
-    virtual ConfiguratorErrorCode set_passwordHistoryDepth(const unsigned depth) = 0;
-    virtual ConfiguratorErrorCode set_passwordExpirationDays(const unsigned days) = 0;
-    virtual ConfiguratorErrorCode set_maxInactiveTimeMin(const unsigned minutes) = 0;
-    virtual ConfiguratorErrorCode set_maxFailedAttempts(const unsigned attempts) = 0;
-    virtual ConfiguratorErrorCode set_lockoutTimeMin(const unsigned minutes) = 0;
-
-    virtual ConfiguratorErrorCode get_minPasswordLength(unsigned &length) const = 0;
-    virtual ConfiguratorErrorCode get_passwordHistoryDepth(unsigned &depth) const = 0;
-    virtual ConfiguratorErrorCode get_passwordExpirationDays(unsigned &days) const = 0;
-    virtual ConfiguratorErrorCode get_maxInactiveTimeMin(unsigned &minutes) const = 0;
-    virtual ConfiguratorErrorCode get_maxFailedAttempts(unsigned &attempts) const = 0;
-    virtual ConfiguratorErrorCode get_lockoutTimeMin(unsigned &minutes) const = 0;
+    virtual ConfiguratorErrorCode get(SecurityParam param, unsigned &value) const = 0;
+    virtual ConfiguratorErrorCode applyChanges(const SecurityConfigChanges &changes) = 0;
+
+    ConfiguratorErrorCode set(SecurityParam param, unsigned value)
+    {
+        SecurityConfigChanges changes;
+        changes.set(param, value);
+        return applyChanges(changes);
+    }
+
+    ConfiguratorErrorCode set_minPasswordLength(const unsigned length) { return set(SecurityParam::MIN_PASSWORD_LENGTH, length); }
+    ConfiguratorErrorCode set_passwordHistoryDepth(const unsigned depth) { return set(SecurityParam::PASSWORD_HISTORY_DEPTH, depth); }
+    ConfiguratorErrorCode set_passwordExpirationDays(const unsigned days) { return set(SecurityParam::PASSWORD_EXPIRATION_DAYS, days); }
+    ConfiguratorErrorCode set_maxInactiveTimeMin(const unsigned minutes) { return set(SecurityParam::MAX_INACTIVE_TIME_MIN, minutes); }
+    ConfiguratorErrorCode set_maxFailedAttempts(const unsigned attempts) { return set(SecurityParam::MAX_FAILED_ATTEMPTS, attempts); }
+    ConfiguratorErrorCode set_lockoutTimeMin(const unsigned minutes) { return set(SecurityParam::LOCKOUT_TIME_MIN, minutes); }
+
+    ConfiguratorErrorCode get_minPasswordLength(unsigned &length) const { return get(SecurityParam::MIN_PASSWORD_LENGTH, length); }
+    ConfiguratorErrorCode get_passwordHistoryDepth(unsigned &depth) const { return get(SecurityParam::PASSWORD_HISTORY_DEPTH, depth); }
+    ConfiguratorErrorCode get_passwordExpirationDays(unsigned &days) const { return get(SecurityParam::PASSWORD_EXPIRATION_DAYS, days); }
+    ConfiguratorErrorCode get_maxInactiveTimeMin(unsigned &minutes) const { return get(SecurityParam::MAX_INACTIVE_TIME_MIN, minutes); }
+    ConfiguratorErrorCode get_maxFailedAttempts(unsigned &attempts) const { return get(SecurityParam::MAX_FAILED_ATTEMPTS, attempts); }
+    ConfiguratorErrorCode get_lockoutTimeMin(unsigned &minutes) const { return get(SecurityParam::LOCKOUT_TIME_MIN, minutes); }
 
     virtual ~SecurityConfigInterface() = default;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,93 @@
+// include/SecurityConfigSchema.hpp
+
+#include <cstddef>
+#include <string_view>
+
+#ifndef SECURITY_CONFIG_SCHEMA_HPP
+#define SECURITY_CONFIG_SCHEMA_HPP
+
+// Параметры безопасности. Порядок совпадает с порядком строк в securitySchema
+enum class SecurityParam
+{
+    MIN_PASSWORD_LENGTH,
+    PASSWORD_HISTORY_DEPTH,
+    PASSWORD_EXPIRATION_DAYS,
+    MAX_INACTIVE_TIME_MIN,
+    MAX_FAILED_ATTEMPTS,
+    LOCKOUT_TIME_MIN,
+    COUNT
+};
+
+// Описание параметра: ключ в файле конфигурации, название для конфигуратора,
+// значение по умолчанию и допустимый диапазон (включительно)
+struct SecurityParamInfo
+{
+    SecurityParam param;
+    const char *key;
+    const char *title;
+    unsigned defaultValue;
+    unsigned minValue;
+    unsigned maxValue;
+};
+
+// Схема конфигурации. Новый параметр добавляется значением в SecurityParam и строкой здесь;
+// хранение, разбор, проверка диапазона, запись в файл и меню конфигуратора строятся по этой таблице
+inline constexpr SecurityParamInfo securitySchema[] = {
+    {SecurityParam::MIN_PASSWORD_LENGTH, "minPasswordLength", "Minimum password length", 8, 1, 1024},
+    {SecurityParam::PASSWORD_HISTORY_DEPTH, "passwordHistoryDepth", "Password history depth", 3, 0, 1000},
+    {SecurityParam::PASSWORD_EXPIRATION_DAYS, "passwordExpirationDays", "Password expiration days", 90, 0, 36500},
+    {SecurityParam::MAX_INACTIVE_TIME_MIN, "maxInactiveTimeMin", "Max inactive time (minutes)", 10, 0, 525600},
+    {SecurityParam::MAX_FAILED_ATTEMPTS, "maxFailedAttempts", "Max failed attempts", 5, 1, 1000},
+    {SecurityParam::LOCKOUT_TIME_MIN, "lockoutTimeMin", "Lockout time (minutes)", 30, 0, 525600},
+};
+
+inline constexpr size_t SECURITY_PARAM_COUNT = static_cast<size_t>(SecurityParam::COUNT);
+
+// Проверка схемы при компиляции: строки идут в порядке SecurityParam, значения по умолчанию в диапазоне
+constexpr bool securitySchemaIsValid()
+{
+    if (sizeof(securitySchema) / sizeof(securitySchema[0]) != SECURITY_PARAM_COUNT)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+    {
+        const SecurityParamInfo &info = securitySchema[i];
+        if (static_cast<size_t>(info.param) != i || info.minValue > info.maxValue ||
+            info.defaultValue < info.minValue || info.defaultValue > info.maxValue)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(securitySchemaIsValid(), "securitySchema must list every SecurityParam in order with a default inside its range");
+
+// Описание параметра
+constexpr const SecurityParamInfo &securityParamInfo(SecurityParam param)
+{
+    return securitySchema[static_cast<size_t>(param)];
+}
+
+// Поиск параметра по ключу в файле конфигурации
+constexpr bool findSecurityParam(std::string_view key, SecurityParam &param)
+{
+    for (const SecurityParamInfo &info : securitySchema)
+    {
+        if (key == info.key)
+        {
+            param = info.param;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Проверка, что значение входит в допустимый диапазон параметра
+constexpr bool securityValueInRange(SecurityParam param, unsigned value)
+{
+    return value >= securityParamInfo(param).minValue && value <= securityParamInfo(param).maxValue;
+}
+
+#endif
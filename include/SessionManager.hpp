@@ -0,0 +1,101 @@
+// include/SessionManager.hpp
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SessionStoreInterface.hpp"
+
+#ifndef SESSION_MANAGER_HPP
+#define SESSION_MANAGER_HPP
+
+// Сессии после успешного входа: случайный непрозрачный токен, проверка за O(1) по хеш-таблице
+// и истечение при бездействии через иерархическое колесо таймеров (5 уровней по 64 ячейки,
+// шаг — секунда; уровень L покрывает интервалы до 64^(L+1) секунд).
+// Обращение к сессии только обновляет время активности; колесо переносит сессию на новый срок,
+// когда до нее доходит очередь, поэтому проверка не меняет списков колеса.
+// Число сессий ограничено maxSessions, память под сессии выделяется по мере роста и затем
+// переиспользуется. Класс не потокобезопасен: сервер вызывает его из потока цикла событий.
+// Сессии видны только в своем процессе; для нескольких рабочих процессов — SharedSessionTable
+class SessionManager : public SessionStoreInterface
+{
+public:
+    static constexpr size_t TOKEN_BYTES = 16;
+    static constexpr size_t DEFAULT_MAX_SESSIONS = 1 << 20;
+
+private:
+    static const unsigned WHEEL_BITS = 6;
+    static const size_t WHEEL_SIZE = size_t(1) << WHEEL_BITS;
+    static const unsigned WHEEL_LEVELS = 5;
+    static const uint32_t NONE = UINT32_MAX;
+
+    using Token = std::array<unsigned char, TOKEN_BYTES>;
+
+    // Токен случаен, поэтому его первые байты — готовый хеш
+    struct TokenHash
+    {
+        size_t operator()(const Token &token) const
+        {
+            size_t hash;
+            std::memcpy(&hash, token.data(), sizeof(hash));
+            return hash;
+        }
+    };
+
+    struct Session
+    {
+        Token token;
+        std::string login;
+        int64_t lastActive;  // Время последнего обращения
+        int64_t idleSeconds; // Допустимое время бездействия
+        uint32_t prev;       // Соседи в списке ячейки колеса
+        uint32_t next;
+        uint8_t level;       // Положение в колесе
+        uint8_t slot;
+        bool used;
+    };
+
+    size_t maxSessions;
+    std::vector<Session> sessions;
+    std::vector<uint32_t> freeSessions;
+    std::unordered_map<Token, uint32_t, TokenHash> byToken;
+    uint32_t wheel[WHEEL_LEVELS][WHEEL_SIZE]; // Первая сессия в каждой ячейке
+    int64_t currentTick;                      // Последняя обработанная секунда
+    size_t active;
+
+    // Постановка сессии в колесо по сроку lastActive + idleSeconds
+    void schedule(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+
+    // Перераспределение ячейки уровня level по более низким уровням
+    void cascade(unsigned level);
+
+public:
+    SessionManager(int64_t now, size_t sessionLimit = DEFAULT_MAX_SESSIONS);
+
+    // Создание сессии; пустая строка, если достигнут предел числа сессий или idleSeconds == 0
+    std::string create(const std::string &login, int64_t idleSeconds, int64_t now) override;
+
+    // Проверка токена с продлением сессии; false, если сессии нет или она истекла
+    bool validate(const std::string &token, int64_t now, std::string &login) override;
+
+    // Завершение сессии; false, если сессии нет
+    bool revoke(const std::string &token) override;
+
+    // Удаление сессий, бездействующих дольше допустимого, к моменту now
+    void advance(int64_t now) override;
+
+    // Число действующих сессий
+    size_t size() const override;
+
+    // Представление токена для вывода пользователю и обратное преобразование
+    static std::string tokenToHex(const std::string &token);
+    static bool tokenFromHex(const std::string &hex, std::string &token);
+};
+
+#endif
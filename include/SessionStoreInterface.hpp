@@ -0,0 +1,32 @@
+// include/SessionStoreInterface.hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifndef SESSION_STORE_INTERFACE_HPP
+#define SESSION_STORE_INTERFACE_HPP
+
+// Хранилище сессий сервера: сессии одного процесса (SessionManager) или общие для рабочих процессов (SharedSessionTable)
+class SessionStoreInterface
+{
+public:
+    // Создание сессии; пустая строка, если сессию создать нельзя (предел числа сессий, idleSeconds == 0)
+    virtual std::string create(const std::string &login, int64_t idleSeconds, int64_t now) = 0;
+
+    // Проверка токена с продлением сессии; false, если сессии нет или она истекла
+    virtual bool validate(const std::string &token, int64_t now, std::string &login) = 0;
+
+    // Завершение сессии; false, если сессии нет
+    virtual bool revoke(const std::string &token) = 0;
+
+    // Удаление сессий, бездействующих дольше допустимого, к моменту now
+    virtual void advance(int64_t now) = 0;
+
+    // Число действующих сессий
+    virtual size_t size() const = 0;
+
+    virtual ~SessionStoreInterface() = default;
+};
+
+#endif
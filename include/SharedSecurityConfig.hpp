@@ -0,0 +1,121 @@
+// include/SharedSecurityConfig.hpp
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <sys/stat.h>
+
+#include "SecurityConfigInterface.hpp"
+
+#ifndef SHARED_SECURITY_CONFIG_HPP
+#define SHARED_SECURITY_CONFIG_HPP
+
+// Сегмент разделяемой памяти POSIX с текущей политикой безопасности.
+// Запись защищена seqlock: писатель делает счетчик sequence нечетным на время записи,
+// читатель повторяет копирование, если счетчик был нечетным или изменился за время чтения.
+// Писатель, завершившийся посреди записи, оставляет счетчик нечетным: читатели ждут не дольше
+// SHARED_POLICY_READ_TIMEOUT_MS, а следующий писатель восстанавливает счетчик
+struct SharedPolicySegment
+{
+    static const uint32_t MAGIC = 0x41505331; // "APS1"
+
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint32_t> magic;      // MAGIC после первой записи
+    std::atomic<uint32_t> paramCount; // SECURITY_PARAM_COUNT писателя
+    std::atomic<uint32_t> presentMask; // Бит параметра, для которого в values есть действующее значение
+    std::atomic<uint32_t> values[SECURITY_PARAM_COUNT];
+
+    // Отметка файла конфигурации, из которого получена политика
+    std::atomic<uint64_t> fileDevice;
+    std::atomic<uint64_t> fileInode;
+    std::atomic<uint64_t> fileSize;
+    std::atomic<int64_t> fileMtimeNs;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+              "shared policy segment requires address-free lock-free atomics");
+static_assert(SECURITY_PARAM_COUNT <= 32, "presentMask holds one bit per parameter");
+
+// Предел ожидания читателем конца записи
+const unsigned SHARED_POLICY_READ_TIMEOUT_MS = 20;
+
+class SecurityConfig;
+
+// Согласованная копия политики из сегмента
+struct SharedPolicy
+{
+    unsigned values[SECURITY_PARAM_COUNT];
+    bool present[SECURITY_PARAM_COUNT];
+    struct stat fileStat; // Заполнены st_dev, st_ino, st_size, st_mtim
+};
+
+// Публикация политики в сегмент (конфигуратор)
+class SharedPolicyWriter
+{
+    int fd;
+    SharedPolicySegment *segment;
+
+public:
+    SharedPolicyWriter();
+
+    SharedPolicyWriter(const SharedPolicyWriter &) = delete;
+    SharedPolicyWriter &operator=(const SharedPolicyWriter &) = delete;
+
+    // Создание или открытие сегмента с именем segmentName (например, "/authentication_system_policy")
+    ConfiguratorErrorCode open(const std::string &segmentName);
+
+    // Запись политики; писатели разных процессов сериализуются блокировкой flock на сегменте.
+    // Нечетный счетчик, оставленный завершившимся писателем, восстанавливается
+    ConfiguratorErrorCode write(const SharedPolicy &policy);
+
+    ~SharedPolicyWriter();
+};
+
+// Конфигурация только для чтения поверх сегмента разделяемой памяти (процессы входа пользователей).
+// Открытие сегмента не требует чтения и разбора файла конфигурации, чтение параметра — несколько наносекунд.
+// Если запись в сегмент не завершается (писатель завершился посреди нее), параметры читаются из файла
+class SharedSecurityConfig : public SecurityConfigInterface
+{
+    int fd;
+    const SharedPolicySegment *segment;
+    std::string configPath;
+
+    // Нечетный счетчик, на котором чтение не дождалось конца записи (0 — нет): пока счетчик
+    // не изменится, следующие чтения не ждут и сразу обращаются к файлу
+    mutable std::atomic<uint64_t> stuckSequence;
+
+    // Конфигурация из файла, создается при первом отказе сегмента
+    mutable std::mutex fileConfigMutex;
+    mutable std::unique_ptr<SecurityConfig> fileConfig;
+
+    // Чтение полей под seqlock с ограниченным ожиданием; false, если согласованная копия не получена
+    template <typename Read>
+    bool readConsistent(Read read) const;
+
+public:
+    SharedSecurityConfig();
+
+    SharedSecurityConfig(const SharedSecurityConfig &) = delete;
+    SharedSecurityConfig &operator=(const SharedSecurityConfig &) = delete;
+
+    // Подключение к сегменту. Ошибка возвращается, если сегмента нет, он еще не заполнен,
+    // принадлежит другому владельцу, чем файл конфигурации, или политика в нем получена не из текущей
+    // версии файла path (файл изменен в обход конфигуратора) — тогда следует читать файл
+    ConfiguratorErrorCode attach(const std::string &segmentName, const std::string &path);
+
+    // Согласованная копия всей политики; ошибка, если запись в сегмент не завершается
+    ConfiguratorErrorCode readPolicy(SharedPolicy &policy) const;
+
+    // Получение значения параметра из сегмента: под seqlock читается только нужное поле.
+    // Если запись в сегмент не завершается, значение берется из файла конфигурации
+    ConfiguratorErrorCode get(SecurityParam param, unsigned &value) const override;
+
+    // Сегмент доступен только для чтения; политика изменяется конфигуратором
+    ConfiguratorErrorCode applyChanges(const SecurityConfigChanges &changes) override;
+
+    ~SharedSecurityConfig();
+};
+
+#endif
@@ -0,0 +1,84 @@
+// include/SharedSessionTable.hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <pthread.h>
+#include <string>
+
+#include "ErrorCode.hpp"
+#include "SessionStoreInterface.hpp"
+
+#ifndef SHARED_SESSION_TABLE_HPP
+#define SHARED_SESSION_TABLE_HPP
+
+// Сессии, общие для рабочих процессов authd: таблица в анонимной разделяемой памяти (MAP_SHARED),
+// созданная до fork, поэтому токен, выданный одним процессом, принимается любым другим.
+// Таблица фиксированного размера разбита на группы по GROUP_SLOTS записей; группа выбирается по первым байтам
+// случайного токена и защищена своим мьютексом между процессами (PTHREAD_PROCESS_SHARED). Мьютекс устойчив
+// к завершению владельца (PTHREAD_MUTEX_ROBUST): если процесс завершился, держа его, записи группы
+// сбрасываются. Истекшие сессии освобождаются при обращении к ним, при поиске места для новой сессии
+// и проходом advance не чаще раза в секунду. Логин длиннее MAX_LOGIN байт сессию не получает
+class SharedSessionTable : public SessionStoreInterface
+{
+public:
+    static constexpr size_t TOKEN_BYTES = 16;
+    static constexpr size_t MAX_LOGIN = 63;
+    static constexpr size_t GROUP_SLOTS = 16;
+    static constexpr size_t DEFAULT_CAPACITY = 65536; // ~7 МиБ
+
+private:
+    struct Slot
+    {
+        unsigned char token[TOKEN_BYTES];
+        char login[MAX_LOGIN + 1];
+        int64_t lastActive;  // Время последнего обращения
+        int64_t idleSeconds; // Допустимое время бездействия
+        bool used;
+    };
+
+    struct Group
+    {
+        pthread_mutex_t mutex;
+        Slot slots[GROUP_SLOTS];
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "the session counter is shared between processes");
+
+    void *mapping;
+    size_t mappingSize;
+    std::atomic<uint64_t> *active; // Занятых записей, в разделяемой памяти
+    Group *groups;
+    size_t groupMask;
+    int64_t lastSweep; // Последний проход advance этого процесса
+
+    // Группа токена; token — TOKEN_BYTES байт
+    Group &groupOf(const unsigned char *token) const;
+
+    // Захват мьютекса группы; после завершения владельца записи группы сбрасываются
+    void lock(Group &group);
+
+    // Освобождение записи (под мьютексом группы)
+    void release(Slot &slot);
+
+public:
+    SharedSessionTable();
+
+    SharedSessionTable(const SharedSessionTable &) = delete;
+    SharedSessionTable &operator=(const SharedSessionTable &) = delete;
+
+    // Создание таблицы на slotCount записей (округляется вверх до степени двойки групп); вызывается до fork
+    ConfiguratorErrorCode open(size_t slotCount = DEFAULT_CAPACITY);
+
+    std::string create(const std::string &login, int64_t idleSeconds, int64_t now) override;
+    bool validate(const std::string &token, int64_t now, std::string &login) override;
+    bool revoke(const std::string &token) override;
+    void advance(int64_t now) override;
+
+    // Число занятых записей во всех процессах, включая истекшие, но еще не освобожденные
+    size_t size() const override;
+
+    ~SharedSessionTable();
+};
+
+#endif
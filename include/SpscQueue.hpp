@@ -0,0 +1,80 @@
+// include/SpscQueue.hpp
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+// Ограниченная очередь без блокировок для одного производителя и одного потребителя.
+// Кольцевой буфер с емкостью — степенью двойки. Индекс записи меняет только производитель, индекс чтения —
+// только потребитель; индексы лежат в разных строках кэша, и каждая сторона хранит последнее виденное значение
+// чужого индекса, поэтому при непустой и неполной очереди она не читает строку другой стороны
+template <typename T>
+class SpscQueue
+{
+    const size_t mask;
+    std::unique_ptr<T[]> slots;
+
+    alignas(64) std::atomic<size_t> tail{0}; // Следующая запись (производитель)
+    size_t cachedHead = 0;                   // Последний виденный производителем индекс чтения
+    alignas(64) std::atomic<size_t> head{0}; // Следующее чтение (потребитель)
+    size_t cachedTail = 0;                   // Последний виденный потребителем индекс записи
+
+    static size_t roundUp(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+public:
+    // Емкость округляется вверх до степени двойки
+    explicit SpscQueue(size_t capacity) : mask(roundUp(capacity) - 1), slots(new T[mask + 1]) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // Добавление из потока производителя; false, если очередь заполнена (value не изменяется)
+    bool tryPush(T &value)
+    {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - cachedHead > mask)
+        {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (position - cachedHead > mask)
+            {
+                return false;
+            }
+        }
+        slots[position & mask] = std::move(value);
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Извлечение из потока потребителя; false, если очередь пуста
+    bool tryPop(T &value)
+    {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == cachedTail)
+        {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (position == cachedTail)
+            {
+                return false;
+            }
+        }
+        value = std::move(slots[position & mask]);
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return mask + 1; }
+};
+
+#endif
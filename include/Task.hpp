@@ -0,0 +1,145 @@
+// include/Task.hpp
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "ExecutorInterface.hpp"
+
+#ifndef TASK_HPP
+#define TASK_HPP
+
+// Отложенная сопрограмма с результатом типа T. Начинает выполняться при первом co_await,
+// по завершении передает управление ожидающей сопрограмме (симметричная передача).
+// Пока задача ждет исполнителя, поток, в котором она выполнялась, свободен для других запросов
+template <typename T>
+class Task
+{
+public:
+    struct promise_type
+    {
+        std::optional<T> value;
+        std::exception_ptr exception;
+        std::coroutine_handle<> continuation; // Ожидающая сопрограмма
+
+        // Передача управления ожидающей сопрограмме при завершении
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+            {
+                std::coroutine_handle<> next = handle.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+            void await_resume() const noexcept {}
+        };
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_value(T result) { value.emplace(std::move(result)); }
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Task(std::coroutine_handle<promise_type> coroutine) : handle(coroutine) {}
+
+public:
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    Task &operator=(Task &&) = delete;
+
+    ~Task()
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+    // Ожидание результата из другой сопрограммы
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume()
+    {
+        if (handle.promise().exception)
+        {
+            std::rethrow_exception(handle.promise().exception);
+        }
+        return std::move(*handle.promise().value);
+    }
+};
+
+// Исполнители этапов запроса: ввод-вывод базы и хеширование. nullptr — этап выполняется
+// в текущем потоке, без переключения. База данных не допускает одновременных обращений,
+// поэтому исполнитель базы должен иметь один поток
+struct AsyncStages
+{
+    ExecutorInterface *database = nullptr;
+    ExecutorInterface *hashing = nullptr;
+};
+
+// Продолжение сопрограммы в потоке исполнителя: co_await ResumeOn(executor)
+class ResumeOn
+{
+    ExecutorInterface *executor;
+
+public:
+    explicit ResumeOn(ExecutorInterface *target) : executor(target) {}
+
+    bool await_ready() const noexcept { return executor == nullptr; }
+    // После submit сопрограмма может уже выполняться в другом потоке: поля объекта больше не используются
+    void await_suspend(std::coroutine_handle<> handle) const { executor->submit([handle] { handle.resume(); }); }
+    void await_resume() const noexcept {}
+};
+
+// Сопрограмма без результата, которой никто не ждет: кадр освобождается по завершении
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+// Запуск задачи без ожидания; done(результат) вызывается в потоке, где задача завершилась
+template <typename T, typename Callback>
+DetachedTask startTask(Task<T> task, Callback done)
+{
+    done(co_await task);
+}
+
+// Блокирующее ожидание результата задачи — синхронная обертка над сопрограммой
+template <typename T>
+T syncWait(Task<T> task)
+{
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::optional<T> result;
+    startTask(std::move(task), [&](T value)
+              {
+                  std::lock_guard<std::mutex> lock(mutex);
+                  result.emplace(std::move(value));
+                  finished.notify_one();
+              });
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&result]
+                  { return result.has_value(); });
+    return std::move(*result);
+}
+
+#endif
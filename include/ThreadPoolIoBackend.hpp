@@ -0,0 +1,83 @@
+// include/ThreadPoolIoBackend.hpp
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "IoBackendInterface.hpp"
+
+#ifndef THREAD_POOL_IO_BACKEND_HPP
+#define THREAD_POOL_IO_BACKEND_HPP
+
+// Запасной ввод-вывод, когда io_uring недоступен: потоки выполняют pread/pwrite/fsync. Пакет, собранный
+// до submit(), попадает в общую очередь под одним захватом мьютекса. fsync, как IOSQE_IO_DRAIN в
+// io_uring, начинается только после завершения всех взятых ранее операций, а следующие ждут его.
+// Завершения передаются потоку-владельцу через список под мьютексом и eventfd
+class ThreadPoolIoBackend : public IoBackendInterface
+{
+    enum class Operation : uint8_t
+    {
+        READ,
+        WRITE,
+        FSYNC
+    };
+
+    struct Request
+    {
+        Operation operation;
+        int fd;
+        void *buffer;
+        size_t size;
+        off_t offset;
+        uint32_t slot;
+    };
+
+    // Поля владельца
+    std::vector<Request> queued;
+    std::vector<Completion> callbacks;
+    std::vector<uint32_t> freeSlots;
+    size_t submitted = 0;
+    std::deque<std::pair<uint32_t, ssize_t>> ready; // Завершения, забранные у потоков, но еще не выполненные
+
+    int completionFd;
+
+    // Поля, общие с потоками, под mutex
+    std::mutex mutex;
+    std::condition_variable changed;   // Новые операции, завершение операции или остановка
+    std::condition_variable completed; // Новое завершение для ожидающего владельца
+    std::deque<Request> pending;
+    std::vector<std::pair<uint32_t, ssize_t>> results;
+    size_t running = 0;
+    bool draining = false;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+
+    void enqueue(Operation operation, int fd, void *buffer, size_t size, off_t offset, Completion done);
+    void workerLoop();
+
+public:
+    // threads потоков ввода-вывода (0 — 2)
+    explicit ThreadPoolIoBackend(size_t threads = 2);
+
+    ThreadPoolIoBackend(const ThreadPoolIoBackend &) = delete;
+    ThreadPoolIoBackend &operator=(const ThreadPoolIoBackend &) = delete;
+
+    void read(int fd, void *buffer, size_t size, off_t offset, Completion done) override;
+    void write(int fd, const void *data, size_t size, off_t offset, Completion done) override;
+    void fsync(int fd, Completion done) override;
+    size_t submit() override;
+    size_t complete(bool wait) override;
+    int eventFd() const override;
+    size_t inFlight() const override;
+    const char *name() const override;
+
+    // Выполняет отправленные операции и останавливает потоки; обратные вызовы не выполняются
+    ~ThreadPoolIoBackend();
+};
+
+#endif
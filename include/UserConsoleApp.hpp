@@ -6,18 +6,13 @@
 #include "SecurityConfigInterface.hpp"
 #include "HashingInterface.hpp"
 #include "AccountsEditorInterface.hpp"
+#include "Authenticator.hpp"
+#include "AuthClient.hpp"
+#include "RequestArena.hpp"
 
 #ifndef USER_CONSOLE_APP_HPP
 #define USER_CONSOLE_APP_HPP
 
-struct UserData
-{
-    std::string login;
-    std::string passwordHash;
-    std::string date;
-    std::vector<UserRole> roles;
-};
-
 class UserConsoleApp
 {
 private:
@@ -26,33 +21,45 @@ private:
     const std::string activeUsersPath;
     const std::string archivePath;
     const std::string tmpPath;
+    // Имя сегмента разделяемой памяти с политикой безопасности
+    const std::string policySegmentName;
+    // Сокет сервера аутентификации
+    const std::string authdSocketPath;
+    // Файл счетчиков неудачных попыток входа
+    const std::string lockoutPath;
 
     ConfiguratorDatabaseInterface *db;
     SecurityConfigInterface *config;
     HashingInterface *hasher;
+    LockoutTable *lockout;
+    Authenticator *authenticator;
+    AuthClient *client; // Подключение к серверу аутентификации (nullptr — проверки в этом процессе)
 
     UserData userData;
+    RequestArena requestArena; // Временные данные поиска пользователя
 
     std::string errorCodeToString(UserErrorCode code) const;
 
     UserErrorCode loginEntering(const std::string &prompt, std::string &login);
-    UserErrorCode loginVerification(const std::string &login, std::string &userData);
-
-    UserErrorCode parseUserData(const std::string &userData);
-
     UserErrorCode passwordEntering(const std::string &prompt, std::string &password);
     UserErrorCode passwordVerification();
+    UserErrorCode remoteAuthentication(const std::string &login, std::string &sessionToken);
 
-    UserErrorCode PasswordExpirationCheck();
-    bool isLeapYear(int year);
-    unsigned getDaysInMonth(int month, int year);
-    UserErrorCode parseDate(const std::string &dateStr, unsigned &day, unsigned &month, unsigned &year);
-    unsigned daysFromEpoch(unsigned day, unsigned month, unsigned year);
-    UserErrorCode differenceInDays(const std::string &userDateStr, int &difference);
+    // Создание базы, конфигурации и хешера для проверок в этом процессе;
+    // indexActiveUsers — держать индекс активных пользователей для множества поисков
+    void openLocal(bool indexActiveUsers);
 
 public:
     UserConsoleApp();
     void run();
+
+    // Пакетный режим: записи "логин<TAB>пароль" из файла (или stdin при пути "-"),
+    // результаты по записям — в stdout, итоги — в stderr. perCore — режим «поток на ядро»
+    // по PartitionedUserTable вместо пула потоков. false, если вход или базу не удалось открыть
+    bool runBatch(const std::string &path, bool perCore = false);
+
+    // Повторный вход по токену сессии, выданному authd при успешном входе
+    void runSession(const std::string &hexToken);
     ~UserConsoleApp();
 };
 
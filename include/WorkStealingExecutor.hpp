@@ -0,0 +1,84 @@
+// include/WorkStealingExecutor.hpp
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ExecutorInterface.hpp"
+
+#ifndef WORK_STEALING_EXECUTOR_HPP
+#define WORK_STEALING_EXECUTOR_HPP
+
+// Параметры исполнителя
+struct WorkStealingOptions
+{
+    size_t workers = 0; // Число потоков (0 — по числу ядер)
+};
+
+// Статистика исполнителя
+struct WorkStealingStats
+{
+    size_t executed = 0; // Выполнено задач
+    size_t stolen = 0;   // Из них взято из очереди другого потока
+};
+
+// Исполнитель задач с перехватом работы. У каждого потока своя очередь: задача, поставленная
+// из потока исполнителя (следующий этап запроса), попадает в его очередь и берется им первой (LIFO),
+// задачи извне распределяются по очередям новых задач по кругу и берутся в порядке поступления (FIFO),
+// чтобы при постоянной нагрузке ранние запросы не ждали бесконечно за поздними. Поток без своих задач
+// забирает самую старую задачу случайно выбранного потока, поэтому долгая задача одного потока не задерживает
+// остальные задачи его очереди, пока есть свободные потоки. Свободные потоки спят на условной переменной
+class WorkStealingExecutor : public ExecutorInterface
+{
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;    // Поставленные из задач
+        std::deque<std::function<void()>> injected; // Поставленные извне
+        std::thread thread;
+        uint64_t random; // Состояние генератора для выбора жертвы
+        std::atomic<size_t> executed{0};
+        std::atomic<size_t> stolen{0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<size_t> pending;   // Поставлено и еще не взято
+    std::atomic<size_t> sleeping;  // Потоков в ожидании
+    std::atomic<size_t> nextWorker; // Очередь для следующей задачи извне
+    std::atomic<bool> stopping;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+
+    // Основной цикл потока
+    void workerLoop(size_t index);
+
+    // Задача из своей очереди или перехваченная у другого потока
+    bool takeTask(size_t index, std::function<void()> &task);
+
+public:
+    WorkStealingExecutor(const WorkStealingOptions &options = WorkStealingOptions());
+
+    WorkStealingExecutor(const WorkStealingExecutor &) = delete;
+    WorkStealingExecutor &operator=(const WorkStealingExecutor &) = delete;
+
+    // Постановка задачи; вызывается из любого потока, в том числе из задачи этого исполнителя
+    void submit(std::function<void()> task) override;
+
+    // Число потоков
+    size_t size() const;
+
+    // Текущая статистика
+    WorkStealingStats stats() const;
+
+    // Дожидается выполнения всех задач, включая поставленные во время ожидания, и останавливает потоки
+    ~WorkStealingExecutor() override;
+};
+
+#endif
@@ -0,0 +1,271 @@
+// src/Argon2.cpp
+
+#include <sodium.h>
+#include <cstring>
+
+#include "Argon2.hpp"
+#include "Argon2Kernels.hpp"
+#include "Blake2b.hpp"
+#include "MemoryArena.hpp"
+
+// Длина предварительного хеша H0
+static const size_t PREHASH_LENGTH = 64;
+// Число 64-битных адресов в одном блоке адресов
+static const uint32_t ADDRESSES_IN_BLOCK = 128;
+
+// Состояние одного вычисления: расположение памяти и параметры
+struct Argon2::Instance
+{
+    Argon2Block *memory;
+    Argon2FillBlock fillBlock;
+    Argon2Type type;
+    uint32_t passes;
+    uint32_t memoryBlocks;
+    uint32_t lanes;
+    uint32_t laneLength;
+    uint32_t segmentLength;
+};
+
+static inline void store32(uint8_t *p, uint32_t v)
+{
+    std::memcpy(p, &v, sizeof(v));
+}
+
+// Генерация следующего блока псевдослучайных адресов для независимой от данных адресации
+static void nextAddresses(Argon2FillBlock fillBlock, Argon2Block *addressBlock, Argon2Block *inputBlock,
+                          const Argon2Block *zeroBlock)
+{
+    Argon2Block tmp;
+    inputBlock->v[6]++;
+    fillBlock(zeroBlock, inputBlock, &tmp, false);
+    fillBlock(zeroBlock, &tmp, addressBlock, false);
+}
+
+// Вычисление индекса опорного блока в полосе (RFC 9106, раздел 3.4.1.2)
+uint32_t Argon2::indexAlpha(const Instance &instance, uint32_t pass, uint32_t slice, uint32_t index,
+                            uint32_t pseudoRand, bool sameLane)
+{
+    uint32_t referenceAreaSize;
+    if (pass == 0)
+    {
+        if (slice == 0)
+        {
+            // Все уже заполненные блоки, кроме предыдущего
+            referenceAreaSize = index - 1;
+        }
+        else if (sameLane)
+        {
+            referenceAreaSize = slice * instance.segmentLength + index - 1;
+        }
+        else
+        {
+            referenceAreaSize = slice * instance.segmentLength + (index == 0 ? -1 : 0);
+        }
+    }
+    else
+    {
+        if (sameLane)
+        {
+            referenceAreaSize = instance.laneLength - instance.segmentLength + index - 1;
+        }
+        else
+        {
+            referenceAreaSize = instance.laneLength - instance.segmentLength + (index == 0 ? -1 : 0);
+        }
+    }
+
+    // Неравномерное отображение J1 в позицию внутри опорной области
+    uint64_t relativePosition = pseudoRand;
+    relativePosition = relativePosition * relativePosition >> 32;
+    relativePosition = referenceAreaSize - 1 - (referenceAreaSize * relativePosition >> 32);
+
+    uint32_t startPosition = 0;
+    if (pass != 0)
+    {
+        startPosition = (slice == SYNC_POINTS - 1) ? 0 : (slice + 1) * instance.segmentLength;
+    }
+
+    return static_cast<uint32_t>((startPosition + relativePosition) % instance.laneLength);
+}
+
+// Заполнение одного сегмента (lane, slice) на проходе pass
+void Argon2::fillSegment(const Instance &instance, uint32_t pass, uint32_t lane, uint32_t slice)
+{
+    bool dataIndependent = instance.type == Argon2Type::ARGON2I ||
+                           (instance.type == Argon2Type::ARGON2ID && pass == 0 && slice < SYNC_POINTS / 2);
+
+    Argon2Block addressBlock;
+    Argon2Block inputBlock;
+    Argon2Block zeroBlock;
+    if (dataIndependent)
+    {
+        sodium_memzero(&zeroBlock, sizeof(zeroBlock));
+        sodium_memzero(&inputBlock, sizeof(inputBlock));
+        inputBlock.v[0] = pass;
+        inputBlock.v[1] = lane;
+        inputBlock.v[2] = slice;
+        inputBlock.v[3] = instance.memoryBlocks;
+        inputBlock.v[4] = instance.passes;
+        inputBlock.v[5] = static_cast<uint64_t>(instance.type);
+    }
+
+    // Первые два блока каждой полосы уже заполнены из H0
+    uint32_t startingIndex = 0;
+    if (pass == 0 && slice == 0)
+    {
+        startingIndex = 2;
+        if (dataIndependent)
+        {
+            nextAddresses(instance.fillBlock, &addressBlock, &inputBlock, &zeroBlock);
+        }
+    }
+
+    uint32_t currOffset = lane * instance.laneLength + slice * instance.segmentLength + startingIndex;
+    uint32_t prevOffset = (currOffset % instance.laneLength == 0) ? currOffset + instance.laneLength - 1 : currOffset - 1;
+
+    for (uint32_t i = startingIndex; i < instance.segmentLength; ++i, ++currOffset, ++prevOffset)
+    {
+        // Переход через начало полосы
+        if (currOffset % instance.laneLength == 1)
+        {
+            prevOffset = currOffset - 1;
+        }
+
+        uint64_t pseudoRand;
+        if (dataIndependent)
+        {
+            if (i % ADDRESSES_IN_BLOCK == 0)
+            {
+                nextAddresses(instance.fillBlock, &addressBlock, &inputBlock, &zeroBlock);
+            }
+            pseudoRand = addressBlock.v[i % ADDRESSES_IN_BLOCK];
+        }
+        else
+        {
+            pseudoRand = instance.memory[prevOffset].v[0];
+        }
+
+        // На первом срезе первого прохода ссылаться можно только на свою полосу
+        uint32_t refLane = static_cast<uint32_t>((pseudoRand >> 32) % instance.lanes);
+        if (pass == 0 && slice == 0)
+        {
+            refLane = lane;
+        }
+
+        uint32_t refIndex = indexAlpha(instance, pass, slice, i, static_cast<uint32_t>(pseudoRand), refLane == lane);
+        const Argon2Block *refBlock = instance.memory + static_cast<size_t>(instance.laneLength) * refLane + refIndex;
+        Argon2Block *currBlock = instance.memory + currOffset;
+
+        instance.fillBlock(instance.memory + prevOffset, refBlock, currBlock, pass != 0);
+    }
+}
+
+// Вычисление тега длиной tagLength байт; при некорректных параметрах
+// или неподдерживаемой реализации функции сжатия возвращается HASHING_ERROR
+ConfiguratorErrorCode Argon2::hash(const Argon2Params &params, uint8_t *tag, size_t tagLength)
+{
+    if (params.lanes < 1 || params.lanes > MAX_LANES || params.timeCost < 1 ||
+        params.memoryKiB < 8 * params.lanes || params.memoryKiB > MAX_MEMORY_KIB ||
+        params.saltLength < MIN_SALT_LENGTH || tagLength < MIN_TAG_LENGTH ||
+        (params.password == nullptr && params.passwordLength != 0))
+    {
+        return ConfiguratorErrorCode::HASHING_ERROR;
+    }
+
+    Instance instance;
+    instance.fillBlock = Argon2Kernels::get(params.kernel);
+    if (instance.fillBlock == nullptr)
+    {
+        return ConfiguratorErrorCode::HASHING_ERROR;
+    }
+
+    // Количество блоков округляется вниз до кратного 4 * p
+    instance.type = params.type;
+    instance.passes = params.timeCost;
+    instance.lanes = params.lanes;
+    instance.segmentLength = params.memoryKiB / (params.lanes * SYNC_POINTS);
+    instance.laneLength = instance.segmentLength * SYNC_POINTS;
+    instance.memoryBlocks = instance.laneLength * params.lanes;
+
+    MemoryArena &arena = MemoryArena::threadLocal();
+    size_t memoryBytes = static_cast<size_t>(instance.memoryBlocks) * sizeof(Argon2Block);
+    void *region = arena.reserve(memoryBytes);
+    if (region == nullptr)
+    {
+        return ConfiguratorErrorCode::HASHING_ERROR;
+    }
+    instance.memory = static_cast<Argon2Block *>(region);
+
+    // H0 = H^64(p, T, m, t, v, y, len(P), P, len(S), S, len(K), K, len(X), X)
+    uint8_t blockHash[PREHASH_LENGTH + 8];
+    uint8_t value[4];
+    Blake2b state(PREHASH_LENGTH);
+    const uint32_t header[6] = {params.lanes, static_cast<uint32_t>(tagLength), params.memoryKiB,
+                                params.timeCost, VERSION, static_cast<uint32_t>(params.type)};
+    for (uint32_t field : header)
+    {
+        store32(value, field);
+        state.update(value, sizeof(value));
+    }
+    const struct
+    {
+        const uint8_t *data;
+        size_t length;
+    } inputs[4] = {{params.password, params.passwordLength},
+                   {params.salt, params.saltLength},
+                   {params.secret, params.secretLength},
+                   {params.associatedData, params.associatedDataLength}};
+    for (const auto &input : inputs)
+    {
+        store32(value, static_cast<uint32_t>(input.length));
+        state.update(value, sizeof(value));
+        if (input.length > 0)
+        {
+            state.update(input.data, input.length);
+        }
+    }
+    state.final(blockHash);
+
+    // B[i][0] = H'(H0 || 0 || i), B[i][1] = H'(H0 || 1 || i)
+    for (uint32_t lane = 0; lane < instance.lanes; ++lane)
+    {
+        for (uint32_t column = 0; column < 2; ++column)
+        {
+            store32(blockHash + PREHASH_LENGTH, column);
+            store32(blockHash + PREHASH_LENGTH + 4, lane);
+            Blake2b::hashLong(reinterpret_cast<uint8_t *>(&instance.memory[lane * instance.laneLength + column]),
+                              sizeof(Argon2Block), blockHash, sizeof(blockHash));
+        }
+    }
+    sodium_memzero(blockHash, sizeof(blockHash));
+
+    // Проходы по памяти: срезы синхронизируются между полосами, полосы заполняются последовательно
+    for (uint32_t pass = 0; pass < instance.passes; ++pass)
+    {
+        for (uint32_t slice = 0; slice < SYNC_POINTS; ++slice)
+        {
+            for (uint32_t lane = 0; lane < instance.lanes; ++lane)
+            {
+                fillSegment(instance, pass, lane, slice);
+            }
+        }
+    }
+
+    // C = XOR последних блоков всех полос, тег = H'(C)
+    Argon2Block finalBlock = instance.memory[instance.laneLength - 1];
+    for (uint32_t lane = 1; lane < instance.lanes; ++lane)
+    {
+        const Argon2Block &last = instance.memory[lane * instance.laneLength + instance.laneLength - 1];
+        for (size_t i = 0; i < 128; ++i)
+        {
+            finalBlock.v[i] ^= last.v[i];
+        }
+    }
+    Blake2b::hashLong(tag, tagLength, &finalBlock, sizeof(finalBlock));
+    sodium_memzero(&finalBlock, sizeof(finalBlock));
+
+    // Рабочие блоки производны от пароля: арена затирается сразу, а не при освобождении
+    arena.wipe(memoryBytes);
+
+    return ConfiguratorErrorCode::SUCCESS;
+}
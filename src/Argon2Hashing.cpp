@@ -0,0 +1,210 @@
+// src/Argon2Hashing.cpp
+
+#include <sodium.h>
+#include <cstring>
+
+#include "Argon2Hashing.hpp"
+
+static const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Кодирование в base64 без дополнения '=' (как в libsodium и формате PHC)
+static std::string base64Encode(const uint8_t *data, size_t length)
+{
+    std::string out;
+    out.reserve((length * 4 + 2) / 3);
+
+    uint32_t accumulator = 0;
+    unsigned bits = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+        accumulator = (accumulator << 8) | data[i];
+        bits += 8;
+        while (bits >= 6)
+        {
+            bits -= 6;
+            out += base64Alphabet[(accumulator >> bits) & 0x3F];
+        }
+    }
+    if (bits > 0)
+    {
+        out += base64Alphabet[(accumulator << (6 - bits)) & 0x3F];
+    }
+    return out;
+}
+
+// Декодирование base64 без дополнения; отклоняет посторонние символы и ненулевые хвостовые биты
+static bool base64Decode(const std::string &in, std::string &out)
+{
+    out.clear();
+    uint32_t accumulator = 0;
+    unsigned bits = 0;
+    for (char c : in)
+    {
+        const char *pos = std::strchr(base64Alphabet, c);
+        if (c == '\0' || pos == nullptr)
+        {
+            return false;
+        }
+        accumulator = (accumulator << 6) | static_cast<uint32_t>(pos - base64Alphabet);
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            out += static_cast<char>((accumulator >> bits) & 0xFF);
+        }
+    }
+    return bits < 6 && (accumulator & ((1U << bits) - 1)) == 0;
+}
+
+// Чтение десятичного числа после префикса key= начиная с позиции pos
+static bool parseDecimal(const std::string &str, size_t &pos, const char *key, uint32_t &value)
+{
+    size_t keyLength = std::strlen(key);
+    if (str.compare(pos, keyLength, key) != 0)
+    {
+        return false;
+    }
+    pos += keyLength;
+
+    uint64_t result = 0;
+    size_t start = pos;
+    while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9')
+    {
+        result = result * 10 + static_cast<uint64_t>(str[pos] - '0');
+        if (result > 0xFFFFFFFFULL)
+        {
+            return false;
+        }
+        ++pos;
+    }
+    // Пустые числа и ведущие нули не допускаются
+    if (pos == start || (str[start] == '0' && pos - start > 1))
+    {
+        return false;
+    }
+    value = static_cast<uint32_t>(result);
+    return true;
+}
+
+// Разбор строки формата $argon2id$v=19$m=...,t=...,p=...$соль$хеш
+bool Argon2Hashing::parseHashString(const std::string &hashedPassword, Argon2Params &params,
+                                    std::string &salt, std::string &hash)
+{
+    size_t pos;
+    if (hashedPassword.compare(0, 10, "$argon2id$") == 0)
+    {
+        params.type = Argon2Type::ARGON2ID;
+        pos = 10;
+    }
+    else if (hashedPassword.compare(0, 9, "$argon2i$") == 0)
+    {
+        params.type = Argon2Type::ARGON2I;
+        pos = 9;
+    }
+    else
+    {
+        return false;
+    }
+
+    uint32_t version;
+    if (!parseDecimal(hashedPassword, pos, "v=", version) || version != Argon2::VERSION ||
+        !parseDecimal(hashedPassword, pos, "$m=", params.memoryKiB) ||
+        !parseDecimal(hashedPassword, pos, ",t=", params.timeCost) ||
+        !parseDecimal(hashedPassword, pos, ",p=", params.lanes) ||
+        pos >= hashedPassword.size() || hashedPassword[pos] != '$')
+    {
+        return false;
+    }
+    ++pos;
+
+    size_t separator = hashedPassword.find('$', pos);
+    if (separator == std::string::npos)
+    {
+        return false;
+    }
+    if (!base64Decode(hashedPassword.substr(pos, separator - pos), salt) ||
+        !base64Decode(hashedPassword.substr(separator + 1), hash))
+    {
+        return false;
+    }
+
+    return salt.size() >= Argon2::MIN_SALT_LENGTH && hash.size() >= Argon2::MIN_TAG_LENGTH;
+}
+
+// Параметры по умолчанию соответствуют crypto_pwhash_OPSLIMIT/MEMLIMIT_INTERACTIVE,
+// реализация функции сжатия по умолчанию выбирается по возможностям процессора
+Argon2Hashing::Argon2Hashing(uint32_t opsLimit, uint32_t memLimitKiB, Argon2Kernel compressionKernel)
+    : timeCost(opsLimit), memoryKiB(memLimitKiB), kernel(compressionKernel)
+{
+    // libsodium используется только как источник случайной соли
+    sodium_init();
+}
+
+// Метод хеширования пароля
+ConfiguratorErrorCode Argon2Hashing::pwHashMake(const std::string &password, std::string &hashedPassword)
+{
+    uint8_t salt[SALT_BYTES];
+    randombytes_buf(salt, sizeof(salt));
+
+    Argon2Params params;
+    params.type = Argon2Type::ARGON2ID;
+    params.timeCost = timeCost;
+    params.memoryKiB = memoryKiB;
+    params.lanes = 1;
+    params.password = reinterpret_cast<const uint8_t *>(password.data());
+    params.passwordLength = password.size();
+    params.salt = salt;
+    params.saltLength = sizeof(salt);
+    params.kernel = kernel;
+
+    uint8_t hash[HASH_BYTES];
+    if (Argon2::hash(params, hash, sizeof(hash)) != ConfiguratorErrorCode::SUCCESS)
+    {
+        return ConfiguratorErrorCode::HASHING_ERROR;
+    }
+
+    hashedPassword = "$argon2id$v=19$m=" + std::to_string(memoryKiB) +
+                     ",t=" + std::to_string(timeCost) +
+                     ",p=1$" + base64Encode(salt, sizeof(salt)) +
+                     "$" + base64Encode(hash, sizeof(hash));
+    sodium_memzero(hash, sizeof(hash));
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Метод сравнения записанного хеша и хеша данного пароля
+ConfiguratorErrorCode Argon2Hashing::pwHashVerify(const std::string &password, const std::string &hashedPassword)
+{
+    Argon2Params params;
+    std::string salt;
+    std::string expected;
+    if (!parseHashString(hashedPassword, params, salt, expected))
+    {
+        return ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+
+    params.password = reinterpret_cast<const uint8_t *>(password.data());
+    params.passwordLength = password.size();
+    params.salt = reinterpret_cast<const uint8_t *>(salt.data());
+    params.saltLength = salt.size();
+    params.kernel = kernel;
+
+    std::string actual(expected.size(), '\0');
+    if (Argon2::hash(params, reinterpret_cast<uint8_t *>(&actual[0]), actual.size()) != ConfiguratorErrorCode::SUCCESS)
+    {
+        return ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+
+    // Сравнение за постоянное время
+    uint8_t difference = 0;
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        difference |= static_cast<uint8_t>(actual[i] ^ expected[i]);
+    }
+    sodium_memzero(&actual[0], actual.size());
+    if (difference != 0)
+    {
+        return ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+
+    return ConfiguratorErrorCode::SUCCESS;
+}
@@ -0,0 +1,182 @@
+// src/Argon2KernelAvx2.cpp
+
+#include "Argon2Kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Файл собирается с общими флагами, набор инструкций включается только для этой единицы трансляции
+#pragma GCC target("avx2")
+
+#include <immintrin.h>
+
+// Без принудительной подстановки GCC оставляет раунды вызовами и состояние уходит в память
+#define FORCE_INLINE inline __attribute__((always_inline))
+
+// Умножение BlaMka для четырех 64-битных слов: x + y + 2 * lo(x) * lo(y)
+static FORCE_INLINE __m256i fBlaMka(__m256i x, __m256i y)
+{
+    const __m256i z = _mm256_mul_epu32(x, y);
+    return _mm256_add_epi64(_mm256_add_epi64(x, y), _mm256_add_epi64(z, z));
+}
+
+// Циклические сдвиги вправо на 32, 24, 16 и 63 бита
+static FORCE_INLINE __m256i rotr32(__m256i x)
+{
+    return _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static FORCE_INLINE __m256i rotr24(__m256i x)
+{
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                                   3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10));
+}
+
+static FORCE_INLINE __m256i rotr16(__m256i x)
+{
+    return _mm256_shuffle_epi8(x, _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                                   2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9));
+}
+
+static FORCE_INLINE __m256i rotr63(__m256i x)
+{
+    return _mm256_xor_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x));
+}
+
+// Половина функции G: сложения BlaMka и сдвиги на 32 и 24 бита
+static FORCE_INLINE void g1(__m256i &a0, __m256i &a1, __m256i &b0, __m256i &b1,
+                            __m256i &c0, __m256i &c1, __m256i &d0, __m256i &d1)
+{
+    a0 = fBlaMka(a0, b0);
+    a1 = fBlaMka(a1, b1);
+    d0 = rotr32(_mm256_xor_si256(d0, a0));
+    d1 = rotr32(_mm256_xor_si256(d1, a1));
+    c0 = fBlaMka(c0, d0);
+    c1 = fBlaMka(c1, d1);
+    b0 = rotr24(_mm256_xor_si256(b0, c0));
+    b1 = rotr24(_mm256_xor_si256(b1, c1));
+}
+
+// Вторая половина функции G: сдвиги на 16 и 63 бита
+static FORCE_INLINE void g2(__m256i &a0, __m256i &a1, __m256i &b0, __m256i &b1,
+                            __m256i &c0, __m256i &c1, __m256i &d0, __m256i &d1)
+{
+    a0 = fBlaMka(a0, b0);
+    a1 = fBlaMka(a1, b1);
+    d0 = rotr16(_mm256_xor_si256(d0, a0));
+    d1 = rotr16(_mm256_xor_si256(d1, a1));
+    c0 = fBlaMka(c0, d0);
+    c1 = fBlaMka(c1, d1);
+    b0 = rotr63(_mm256_xor_si256(b0, c0));
+    b1 = rotr63(_mm256_xor_si256(b1, c1));
+}
+
+// Раунд над двумя строками: каждая четверка слов строки лежит в одном регистре,
+// диагонали получаются поворотом слов внутри регистров
+static FORCE_INLINE void blamkaRoundRows(__m256i &a0, __m256i &a1, __m256i &b0, __m256i &b1,
+                                         __m256i &c0, __m256i &c1, __m256i &d0, __m256i &d1)
+{
+    g1(a0, a1, b0, b1, c0, c1, d0, d1);
+    g2(a0, a1, b0, b1, c0, c1, d0, d1);
+
+    b0 = _mm256_permute4x64_epi64(b0, _MM_SHUFFLE(0, 3, 2, 1));
+    c0 = _mm256_permute4x64_epi64(c0, _MM_SHUFFLE(1, 0, 3, 2));
+    d0 = _mm256_permute4x64_epi64(d0, _MM_SHUFFLE(2, 1, 0, 3));
+    b1 = _mm256_permute4x64_epi64(b1, _MM_SHUFFLE(0, 3, 2, 1));
+    c1 = _mm256_permute4x64_epi64(c1, _MM_SHUFFLE(1, 0, 3, 2));
+    d1 = _mm256_permute4x64_epi64(d1, _MM_SHUFFLE(2, 1, 0, 3));
+
+    g1(a0, a1, b0, b1, c0, c1, d0, d1);
+    g2(a0, a1, b0, b1, c0, c1, d0, d1);
+
+    b0 = _mm256_permute4x64_epi64(b0, _MM_SHUFFLE(2, 1, 0, 3));
+    c0 = _mm256_permute4x64_epi64(c0, _MM_SHUFFLE(1, 0, 3, 2));
+    d0 = _mm256_permute4x64_epi64(d0, _MM_SHUFFLE(0, 3, 2, 1));
+    b1 = _mm256_permute4x64_epi64(b1, _MM_SHUFFLE(2, 1, 0, 3));
+    c1 = _mm256_permute4x64_epi64(c1, _MM_SHUFFLE(1, 0, 3, 2));
+    d1 = _mm256_permute4x64_epi64(d1, _MM_SHUFFLE(0, 3, 2, 1));
+}
+
+// Раунд над двумя столбцами: регистр содержит по паре слов из каждого столбца,
+// поэтому для диагоналей слова перемешиваются между соседними регистрами
+static FORCE_INLINE void blamkaRoundColumns(__m256i &a0, __m256i &a1, __m256i &b0, __m256i &b1,
+                                            __m256i &c0, __m256i &c1, __m256i &d0, __m256i &d1)
+{
+    g1(a0, a1, b0, b1, c0, c1, d0, d1);
+    g2(a0, a1, b0, b1, c0, c1, d0, d1);
+
+    __m256i t1 = _mm256_blend_epi32(b0, b1, 0xCC);
+    __m256i t2 = _mm256_blend_epi32(b0, b1, 0x33);
+    b1 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1));
+    b0 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1));
+
+    t1 = c0;
+    c0 = c1;
+    c1 = t1;
+
+    t1 = _mm256_blend_epi32(d0, d1, 0xCC);
+    t2 = _mm256_blend_epi32(d0, d1, 0x33);
+    d0 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1));
+    d1 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1));
+
+    g1(a0, a1, b0, b1, c0, c1, d0, d1);
+    g2(a0, a1, b0, b1, c0, c1, d0, d1);
+
+    t1 = _mm256_blend_epi32(b0, b1, 0xCC);
+    t2 = _mm256_blend_epi32(b0, b1, 0x33);
+    b0 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1));
+    b1 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1));
+
+    t1 = c0;
+    c0 = c1;
+    c1 = t1;
+
+    t1 = _mm256_blend_epi32(d0, d1, 0x33);
+    t2 = _mm256_blend_epi32(d0, d1, 0xCC);
+    d0 = _mm256_permute4x64_epi64(t1, _MM_SHUFFLE(2, 3, 0, 1));
+    d1 = _mm256_permute4x64_epi64(t2, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+// Реализация на 256-битных регистрах (AVX2)
+void Argon2Kernels::fillBlockAvx2(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor)
+{
+    __m256i state[32];
+    __m256i blockXY[32];
+
+    const __m256i *prevWords = reinterpret_cast<const __m256i *>(prev->v);
+    const __m256i *refWords = reinterpret_cast<const __m256i *>(ref->v);
+    __m256i *nextWords = reinterpret_cast<__m256i *>(next->v);
+
+    for (size_t i = 0; i < 32; ++i)
+    {
+        state[i] = _mm256_xor_si256(_mm256_loadu_si256(prevWords + i), _mm256_loadu_si256(refWords + i));
+        blockXY[i] = withXor ? _mm256_xor_si256(state[i], _mm256_loadu_si256(nextWords + i)) : state[i];
+    }
+
+    // Строки 2i и 2i + 1 лежат в регистрах 8i..8i+3 и 8i+4..8i+7
+    for (size_t i = 0; i < 4; ++i)
+    {
+        blamkaRoundRows(state[8 * i + 0], state[8 * i + 4], state[8 * i + 1], state[8 * i + 5],
+                        state[8 * i + 2], state[8 * i + 6], state[8 * i + 3], state[8 * i + 7]);
+    }
+    // Столбцы 2i и 2i + 1 лежат в регистрах i, 4 + i, ..., 28 + i
+    for (size_t i = 0; i < 4; ++i)
+    {
+        blamkaRoundColumns(state[0 + i], state[4 + i], state[8 + i], state[12 + i],
+                           state[16 + i], state[20 + i], state[24 + i], state[28 + i]);
+    }
+
+    for (size_t i = 0; i < 32; ++i)
+    {
+        _mm256_storeu_si256(nextWords + i, _mm256_xor_si256(state[i], blockXY[i]));
+    }
+}
+
+#else
+
+// На других архитектурах векторная реализация недоступна (isSupported возвращает false)
+void Argon2Kernels::fillBlockAvx2(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor)
+{
+    fillBlockPortable(prev, ref, next, withXor);
+}
+
+#endif
@@ -0,0 +1,184 @@
+// src/Argon2KernelAvx512.cpp
+
+#include "Argon2Kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Файл собирается с общими флагами, набор инструкций включается только для этой единицы трансляции
+#pragma GCC target("avx512f")
+
+// Заголовки GCC 12 для AVX-512 дают ложные предупреждения о неинициализированных переменных
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include <immintrin.h>
+
+// Без принудительной подстановки GCC оставляет раунды вызовами и состояние уходит в память
+#define FORCE_INLINE inline __attribute__((always_inline))
+
+// Умножение BlaMka для восьми 64-битных слов: x + y + 2 * lo(x) * lo(y)
+static FORCE_INLINE __m512i fBlaMka(__m512i x, __m512i y)
+{
+    const __m512i z = _mm512_mul_epu32(x, y);
+    return _mm512_add_epi64(_mm512_add_epi64(x, y), _mm512_add_epi64(z, z));
+}
+
+// Половина функции G: сложения BlaMka и сдвиги на 32 и 24 бита
+static FORCE_INLINE void g1(__m512i &a0, __m512i &b0, __m512i &c0, __m512i &d0,
+                            __m512i &a1, __m512i &b1, __m512i &c1, __m512i &d1)
+{
+    a0 = fBlaMka(a0, b0);
+    a1 = fBlaMka(a1, b1);
+    d0 = _mm512_ror_epi64(_mm512_xor_si512(d0, a0), 32);
+    d1 = _mm512_ror_epi64(_mm512_xor_si512(d1, a1), 32);
+    c0 = fBlaMka(c0, d0);
+    c1 = fBlaMka(c1, d1);
+    b0 = _mm512_ror_epi64(_mm512_xor_si512(b0, c0), 24);
+    b1 = _mm512_ror_epi64(_mm512_xor_si512(b1, c1), 24);
+}
+
+// Вторая половина функции G: сдвиги на 16 и 63 бита
+static FORCE_INLINE void g2(__m512i &a0, __m512i &b0, __m512i &c0, __m512i &d0,
+                            __m512i &a1, __m512i &b1, __m512i &c1, __m512i &d1)
+{
+    a0 = fBlaMka(a0, b0);
+    a1 = fBlaMka(a1, b1);
+    d0 = _mm512_ror_epi64(_mm512_xor_si512(d0, a0), 16);
+    d1 = _mm512_ror_epi64(_mm512_xor_si512(d1, a1), 16);
+    c0 = fBlaMka(c0, d0);
+    c1 = fBlaMka(c1, d1);
+    b0 = _mm512_ror_epi64(_mm512_xor_si512(b0, c0), 63);
+    b1 = _mm512_ror_epi64(_mm512_xor_si512(b1, c1), 63);
+}
+
+// Раунд над четверками слов: каждая 256-битная половина регистра содержит
+// четверку слов одной матрицы 4x4, диагонали получаются поворотом внутри половин
+static FORCE_INLINE void blamkaRound(__m512i &a0, __m512i &b0, __m512i &c0, __m512i &d0,
+                                     __m512i &a1, __m512i &b1, __m512i &c1, __m512i &d1)
+{
+    g1(a0, b0, c0, d0, a1, b1, c1, d1);
+    g2(a0, b0, c0, d0, a1, b1, c1, d1);
+
+    b0 = _mm512_permutex_epi64(b0, _MM_SHUFFLE(0, 3, 2, 1));
+    b1 = _mm512_permutex_epi64(b1, _MM_SHUFFLE(0, 3, 2, 1));
+    c0 = _mm512_permutex_epi64(c0, _MM_SHUFFLE(1, 0, 3, 2));
+    c1 = _mm512_permutex_epi64(c1, _MM_SHUFFLE(1, 0, 3, 2));
+    d0 = _mm512_permutex_epi64(d0, _MM_SHUFFLE(2, 1, 0, 3));
+    d1 = _mm512_permutex_epi64(d1, _MM_SHUFFLE(2, 1, 0, 3));
+
+    g1(a0, b0, c0, d0, a1, b1, c1, d1);
+    g2(a0, b0, c0, d0, a1, b1, c1, d1);
+
+    b0 = _mm512_permutex_epi64(b0, _MM_SHUFFLE(2, 1, 0, 3));
+    b1 = _mm512_permutex_epi64(b1, _MM_SHUFFLE(2, 1, 0, 3));
+    c0 = _mm512_permutex_epi64(c0, _MM_SHUFFLE(1, 0, 3, 2));
+    c1 = _mm512_permutex_epi64(c1, _MM_SHUFFLE(1, 0, 3, 2));
+    d0 = _mm512_permutex_epi64(d0, _MM_SHUFFLE(0, 3, 2, 1));
+    d1 = _mm512_permutex_epi64(d1, _MM_SHUFFLE(0, 3, 2, 1));
+}
+
+// Обмен половинами: x = (x.lo, y.lo), y = (x.hi, y.hi); операция обратна сама себе
+static FORCE_INLINE void swapHalves(__m512i &x, __m512i &y)
+{
+    __m512i t0 = _mm512_shuffle_i64x2(x, y, _MM_SHUFFLE(1, 0, 1, 0));
+    __m512i t1 = _mm512_shuffle_i64x2(x, y, _MM_SHUFFLE(3, 2, 3, 2));
+    x = t0;
+    y = t1;
+}
+
+// Обмен четвертями: после него каждая половина регистра содержит две пары слов одного столбца
+static FORCE_INLINE void swapQuarters(__m512i &x, __m512i &y)
+{
+    const __m512i index = _mm512_setr_epi64(0, 1, 4, 5, 2, 3, 6, 7);
+    swapHalves(x, y);
+    x = _mm512_permutexvar_epi64(index, x);
+    y = _mm512_permutexvar_epi64(index, y);
+}
+
+// Обратный обмен четвертями
+static FORCE_INLINE void unswapQuarters(__m512i &x, __m512i &y)
+{
+    const __m512i index = _mm512_setr_epi64(0, 1, 4, 5, 2, 3, 6, 7);
+    x = _mm512_permutexvar_epi64(index, x);
+    y = _mm512_permutexvar_epi64(index, y);
+    swapHalves(x, y);
+}
+
+// Реализация на 512-битных регистрах (AVX-512F)
+void Argon2Kernels::fillBlockAvx512(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor)
+{
+    __m512i state[16];
+    __m512i blockXY[16];
+
+    const __m512i *prevWords = reinterpret_cast<const __m512i *>(prev->v);
+    const __m512i *refWords = reinterpret_cast<const __m512i *>(ref->v);
+    __m512i *nextWords = reinterpret_cast<__m512i *>(next->v);
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        state[i] = _mm512_xor_si512(_mm512_loadu_si512(prevWords + i), _mm512_loadu_si512(refWords + i));
+        blockXY[i] = withXor ? _mm512_xor_si512(state[i], _mm512_loadu_si512(nextWords + i)) : state[i];
+    }
+
+    // Строки 4i..4i+3: строка r занимает регистры 2r и 2r + 1, обмен половинами
+    // собирает одноименные четверки слов двух строк в одном регистре
+    for (size_t i = 0; i < 2; ++i)
+    {
+        __m512i &a0 = state[8 * i + 0];
+        __m512i &c0 = state[8 * i + 1];
+        __m512i &b0 = state[8 * i + 2];
+        __m512i &d0 = state[8 * i + 3];
+        __m512i &a1 = state[8 * i + 4];
+        __m512i &c1 = state[8 * i + 5];
+        __m512i &b1 = state[8 * i + 6];
+        __m512i &d1 = state[8 * i + 7];
+
+        swapHalves(a0, b0);
+        swapHalves(c0, d0);
+        swapHalves(a1, b1);
+        swapHalves(c1, d1);
+        blamkaRound(a0, b0, c0, d0, a1, b1, c1, d1);
+        swapHalves(a0, b0);
+        swapHalves(c0, d0);
+        swapHalves(a1, b1);
+        swapHalves(c1, d1);
+    }
+
+    // Столбцы 4i..4i+3 лежат в регистрах i, 2 + i, ..., 14 + i
+    for (size_t i = 0; i < 2; ++i)
+    {
+        __m512i &a0 = state[2 * 0 + i];
+        __m512i &a1 = state[2 * 1 + i];
+        __m512i &b0 = state[2 * 2 + i];
+        __m512i &b1 = state[2 * 3 + i];
+        __m512i &c0 = state[2 * 4 + i];
+        __m512i &c1 = state[2 * 5 + i];
+        __m512i &d0 = state[2 * 6 + i];
+        __m512i &d1 = state[2 * 7 + i];
+
+        swapQuarters(a0, a1);
+        swapQuarters(b0, b1);
+        swapQuarters(c0, c1);
+        swapQuarters(d0, d1);
+        blamkaRound(a0, b0, c0, d0, a1, b1, c1, d1);
+        unswapQuarters(a0, a1);
+        unswapQuarters(b0, b1);
+        unswapQuarters(c0, c1);
+        unswapQuarters(d0, d1);
+    }
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        _mm512_storeu_si512(nextWords + i, _mm512_xor_si512(state[i], blockXY[i]));
+    }
+}
+
+#else
+
+// На других архитектурах векторная реализация недоступна (isSupported возвращает false)
+void Argon2Kernels::fillBlockAvx512(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor)
+{
+    fillBlockPortable(prev, ref, next, withXor);
+}
+
+#endif
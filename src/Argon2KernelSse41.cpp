@@ -0,0 +1,164 @@
+// src/Argon2KernelSse41.cpp
+
+#include "Argon2Kernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// Файл собирается с общими флагами, набор инструкций включается только для этой единицы трансляции
+#pragma GCC target("sse4.1")
+
+#include <immintrin.h>
+
+// Без принудительной подстановки GCC оставляет раунды вызовами и состояние уходит в память
+#define FORCE_INLINE inline __attribute__((always_inline))
+
+// Умножение BlaMka для двух 64-битных слов: x + y + 2 * lo(x) * lo(y)
+static FORCE_INLINE __m128i fBlaMka(__m128i x, __m128i y)
+{
+    const __m128i z = _mm_mul_epu32(x, y);
+    return _mm_add_epi64(_mm_add_epi64(x, y), _mm_add_epi64(z, z));
+}
+
+// Циклические сдвиги вправо на 32, 24, 16 и 63 бита
+static FORCE_INLINE __m128i rotr32(__m128i x)
+{
+    return _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static FORCE_INLINE __m128i rotr24(__m128i x)
+{
+    return _mm_shuffle_epi8(x, _mm_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10));
+}
+
+static FORCE_INLINE __m128i rotr16(__m128i x)
+{
+    return _mm_shuffle_epi8(x, _mm_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9));
+}
+
+static FORCE_INLINE __m128i rotr63(__m128i x)
+{
+    return _mm_xor_si128(_mm_srli_epi64(x, 63), _mm_add_epi64(x, x));
+}
+
+// Половина функции G: сложения BlaMka и сдвиги на 32 и 24 бита
+static FORCE_INLINE void g1(__m128i &a0, __m128i &b0, __m128i &c0, __m128i &d0,
+                            __m128i &a1, __m128i &b1, __m128i &c1, __m128i &d1)
+{
+    a0 = fBlaMka(a0, b0);
+    a1 = fBlaMka(a1, b1);
+    d0 = rotr32(_mm_xor_si128(d0, a0));
+    d1 = rotr32(_mm_xor_si128(d1, a1));
+    c0 = fBlaMka(c0, d0);
+    c1 = fBlaMka(c1, d1);
+    b0 = rotr24(_mm_xor_si128(b0, c0));
+    b1 = rotr24(_mm_xor_si128(b1, c1));
+}
+
+// Вторая половина функции G: сдвиги на 16 и 63 бита
+static FORCE_INLINE void g2(__m128i &a0, __m128i &b0, __m128i &c0, __m128i &d0,
+                            __m128i &a1, __m128i &b1, __m128i &c1, __m128i &d1)
+{
+    a0 = fBlaMka(a0, b0);
+    a1 = fBlaMka(a1, b1);
+    d0 = rotr16(_mm_xor_si128(d0, a0));
+    d1 = rotr16(_mm_xor_si128(d1, a1));
+    c0 = fBlaMka(c0, d0);
+    c1 = fBlaMka(c1, d1);
+    b0 = rotr63(_mm_xor_si128(b0, c0));
+    b1 = rotr63(_mm_xor_si128(b1, c1));
+}
+
+// Перестановка слов для применения G к диагоналям матрицы 4x4
+static FORCE_INLINE void diagonalize(__m128i &b0, __m128i &c0, __m128i &d0,
+                                     __m128i &b1, __m128i &c1, __m128i &d1)
+{
+    __m128i t0 = _mm_alignr_epi8(b1, b0, 8);
+    __m128i t1 = _mm_alignr_epi8(b0, b1, 8);
+    b0 = t0;
+    b1 = t1;
+
+    t0 = c0;
+    c0 = c1;
+    c1 = t0;
+
+    t0 = _mm_alignr_epi8(d1, d0, 8);
+    t1 = _mm_alignr_epi8(d0, d1, 8);
+    d0 = t1;
+    d1 = t0;
+}
+
+// Обратная перестановка после обработки диагоналей
+static FORCE_INLINE void undiagonalize(__m128i &b0, __m128i &c0, __m128i &d0,
+                                       __m128i &b1, __m128i &c1, __m128i &d1)
+{
+    __m128i t0 = _mm_alignr_epi8(b0, b1, 8);
+    __m128i t1 = _mm_alignr_epi8(b1, b0, 8);
+    b0 = t0;
+    b1 = t1;
+
+    t0 = c0;
+    c0 = c1;
+    c1 = t0;
+
+    t0 = _mm_alignr_epi8(d0, d1, 8);
+    t1 = _mm_alignr_epi8(d1, d0, 8);
+    d0 = t1;
+    d1 = t0;
+}
+
+// Раунд BLAKE2b без сообщения над 16 словами, разложенными в 8 регистров
+static FORCE_INLINE void blamkaRound(__m128i &a0, __m128i &a1, __m128i &b0, __m128i &b1,
+                                     __m128i &c0, __m128i &c1, __m128i &d0, __m128i &d1)
+{
+    g1(a0, b0, c0, d0, a1, b1, c1, d1);
+    g2(a0, b0, c0, d0, a1, b1, c1, d1);
+    diagonalize(b0, c0, d0, b1, c1, d1);
+    g1(a0, b0, c0, d0, a1, b1, c1, d1);
+    g2(a0, b0, c0, d0, a1, b1, c1, d1);
+    undiagonalize(b0, c0, d0, b1, c1, d1);
+}
+
+// Реализация на 128-битных регистрах (SSSE3/SSE4.1)
+void Argon2Kernels::fillBlockSse41(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor)
+{
+    __m128i state[64];
+    __m128i blockXY[64];
+
+    const __m128i *prevWords = reinterpret_cast<const __m128i *>(prev->v);
+    const __m128i *refWords = reinterpret_cast<const __m128i *>(ref->v);
+    __m128i *nextWords = reinterpret_cast<__m128i *>(next->v);
+
+    for (size_t i = 0; i < 64; ++i)
+    {
+        state[i] = _mm_xor_si128(_mm_loadu_si128(prevWords + i), _mm_loadu_si128(refWords + i));
+        blockXY[i] = withXor ? _mm_xor_si128(state[i], _mm_loadu_si128(nextWords + i)) : state[i];
+    }
+
+    // Строки: 16 слов строки i лежат в регистрах 8i..8i+7
+    for (size_t i = 0; i < 8; ++i)
+    {
+        blamkaRound(state[8 * i + 0], state[8 * i + 1], state[8 * i + 2], state[8 * i + 3],
+                    state[8 * i + 4], state[8 * i + 5], state[8 * i + 6], state[8 * i + 7]);
+    }
+    // Столбцы: пары слов столбца i лежат в регистрах i, 8 + i, ..., 56 + i
+    for (size_t i = 0; i < 8; ++i)
+    {
+        blamkaRound(state[8 * 0 + i], state[8 * 1 + i], state[8 * 2 + i], state[8 * 3 + i],
+                    state[8 * 4 + i], state[8 * 5 + i], state[8 * 6 + i], state[8 * 7 + i]);
+    }
+
+    for (size_t i = 0; i < 64; ++i)
+    {
+        _mm_storeu_si128(nextWords + i, _mm_xor_si128(state[i], blockXY[i]));
+    }
+}
+
+#else
+
+// На других архитектурах векторная реализация недоступна (isSupported возвращает false)
+void Argon2Kernels::fillBlockSse41(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor)
+{
+    fillBlockPortable(prev, ref, next, withXor);
+}
+
+#endif
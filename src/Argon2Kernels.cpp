@@ -0,0 +1,168 @@
+// src/Argon2Kernels.cpp
+
+#include "Argon2Kernels.hpp"
+
+static inline uint64_t rotr64(uint64_t x, unsigned n)
+{
+    return (x >> n) | (x << (64 - n));
+}
+
+// Умножение BlaMka: x + y + 2 * lo(x) * lo(y)
+static inline uint64_t fBlaMka(uint64_t x, uint64_t y)
+{
+    const uint64_t m = 0xFFFFFFFFULL;
+    return x + y + 2 * ((x & m) * (y & m));
+}
+
+#define BLAMKA_G(a, b, c, d)      \
+    do                            \
+    {                             \
+        a = fBlaMka(a, b);        \
+        d = rotr64(d ^ a, 32);    \
+        c = fBlaMka(c, d);        \
+        b = rotr64(b ^ c, 24);    \
+        a = fBlaMka(a, b);        \
+        d = rotr64(d ^ a, 16);    \
+        c = fBlaMka(c, d);        \
+        b = rotr64(b ^ c, 63);    \
+    } while (0)
+
+#define BLAMKA_ROUND(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15) \
+    do                                                                                      \
+    {                                                                                       \
+        BLAMKA_G(v0, v4, v8, v12);                                                          \
+        BLAMKA_G(v1, v5, v9, v13);                                                          \
+        BLAMKA_G(v2, v6, v10, v14);                                                         \
+        BLAMKA_G(v3, v7, v11, v15);                                                         \
+        BLAMKA_G(v0, v5, v10, v15);                                                         \
+        BLAMKA_G(v1, v6, v11, v12);                                                         \
+        BLAMKA_G(v2, v7, v8, v13);                                                          \
+        BLAMKA_G(v3, v4, v9, v14);                                                          \
+    } while (0)
+
+// Переносимая реализация на 64-битных словах
+void Argon2Kernels::fillBlockPortable(const Argon2Block *prev, const Argon2Block *ref, Argon2Block *next, bool withXor)
+{
+    Argon2Block r;
+    Argon2Block tmp;
+
+    for (size_t i = 0; i < 128; ++i)
+    {
+        r.v[i] = prev->v[i] ^ ref->v[i];
+    }
+    tmp = r;
+    if (withXor)
+    {
+        for (size_t i = 0; i < 128; ++i)
+        {
+            tmp.v[i] ^= next->v[i];
+        }
+    }
+
+    uint64_t *v = r.v;
+    // Перестановка P по строкам (8 строк по 16 слов)
+    for (size_t i = 0; i < 8; ++i)
+    {
+        BLAMKA_ROUND(v[16 * i], v[16 * i + 1], v[16 * i + 2], v[16 * i + 3],
+                     v[16 * i + 4], v[16 * i + 5], v[16 * i + 6], v[16 * i + 7],
+                     v[16 * i + 8], v[16 * i + 9], v[16 * i + 10], v[16 * i + 11],
+                     v[16 * i + 12], v[16 * i + 13], v[16 * i + 14], v[16 * i + 15]);
+    }
+    // Перестановка P по столбцам (8 столбцов по 16 слов)
+    for (size_t i = 0; i < 8; ++i)
+    {
+        BLAMKA_ROUND(v[2 * i], v[2 * i + 1], v[2 * i + 16], v[2 * i + 17],
+                     v[2 * i + 32], v[2 * i + 33], v[2 * i + 48], v[2 * i + 49],
+                     v[2 * i + 64], v[2 * i + 65], v[2 * i + 80], v[2 * i + 81],
+                     v[2 * i + 96], v[2 * i + 97], v[2 * i + 112], v[2 * i + 113]);
+    }
+
+    for (size_t i = 0; i < 128; ++i)
+    {
+        next->v[i] = tmp.v[i] ^ r.v[i];
+    }
+}
+
+// Поддерживается ли реализация процессором
+bool Argon2Kernels::isSupported(Argon2Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Argon2Kernel::AUTO:
+    case Argon2Kernel::PORTABLE:
+        return true;
+#if defined(__x86_64__) || defined(__i386__)
+    case Argon2Kernel::SSE41:
+        return __builtin_cpu_supports("sse4.1");
+    case Argon2Kernel::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case Argon2Kernel::AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+        return false;
+    }
+}
+
+// Самая быстрая из поддерживаемых реализаций (определяется один раз)
+Argon2Kernel Argon2Kernels::best()
+{
+    static const Argon2Kernel selected = []
+    {
+        const Argon2Kernel candidates[] = {Argon2Kernel::AVX512, Argon2Kernel::AVX2, Argon2Kernel::SSE41};
+        for (Argon2Kernel kernel : candidates)
+        {
+            if (isSupported(kernel))
+            {
+                return kernel;
+            }
+        }
+        return Argon2Kernel::PORTABLE;
+    }();
+    return selected;
+}
+
+// Функция для реализации; AUTO соответствует best(), для неподдерживаемой возвращается nullptr
+Argon2FillBlock Argon2Kernels::get(Argon2Kernel kernel)
+{
+    if (kernel == Argon2Kernel::AUTO)
+    {
+        kernel = best();
+    }
+    if (!isSupported(kernel))
+    {
+        return nullptr;
+    }
+
+    switch (kernel)
+    {
+    case Argon2Kernel::SSE41:
+        return fillBlockSse41;
+    case Argon2Kernel::AVX2:
+        return fillBlockAvx2;
+    case Argon2Kernel::AVX512:
+        return fillBlockAvx512;
+    default:
+        return fillBlockPortable;
+    }
+}
+
+// Название реализации
+const char *Argon2Kernels::name(Argon2Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Argon2Kernel::AUTO:
+        return "auto";
+    case Argon2Kernel::PORTABLE:
+        return "portable";
+    case Argon2Kernel::SSE41:
+        return "sse4.1";
+    case Argon2Kernel::AVX2:
+        return "avx2";
+    case Argon2Kernel::AVX512:
+        return "avx512f";
+    default:
+        return "unknown";
+    }
+}
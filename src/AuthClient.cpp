@@ -0,0 +1,206 @@
+// src/AuthClient.cpp
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "AuthClient.hpp"
+
+// Затирание пароля в строке
+static void wipe(std::string &secret)
+{
+    std::memset(&secret[0], 0, secret.size());
+}
+
+AuthClient::AuthClient() : fd(-1), nextRequestId(1), inPos(0)
+{
+}
+
+// Подключение к серверу; ошибка, если сервер не запущен
+ConfiguratorErrorCode AuthClient::connect(const std::string &socketPath)
+{
+    struct sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    out.clear();
+    in.clear();
+    inPos = 0;
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    if (::connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        fd = -1;
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Отправка ровно size байт
+bool AuthClient::sendAll(const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+// Отправка запроса и прием ответа на него; поля с паролями затираются
+ConfiguratorErrorCode AuthClient::exchange(AuthProtocol::Request &request, AuthProtocol::AuthResponse &response)
+{
+    ConfiguratorErrorCode code = queueRequest(request);
+    if (code == ConfiguratorErrorCode::SUCCESS)
+    {
+        code = flushRequests();
+    }
+    // Ответы на другие номера возможны только при смешивании с конвейером и пропускаются
+    while (code == ConfiguratorErrorCode::SUCCESS)
+    {
+        code = receiveResponse(response);
+        if (code == ConfiguratorErrorCode::SUCCESS && response.requestId == request.id)
+        {
+            break;
+        }
+    }
+    return code;
+}
+
+// Добавление запроса в очередь отправки; request.id получает номер запроса, поля с паролями затираются
+ConfiguratorErrorCode AuthClient::queueRequest(AuthProtocol::Request &request)
+{
+    request.id = nextRequestId++;
+    bool encoded = fd >= 0 && AuthProtocol::appendRequest(out, request);
+    wipe(request.password);
+    wipe(request.newPassword);
+    return encoded ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::DATABASE_ERROR;
+}
+
+// Отправка накопленных запросов одним блоком
+ConfiguratorErrorCode AuthClient::flushRequests()
+{
+    bool sent = fd >= 0 && sendAll(out.data(), out.size());
+    wipe(out);
+    out.clear();
+    return sent ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::DATABASE_ERROR;
+}
+
+// Прием очередного ответа: данные читаются блоками, за один вызов recv может прийти много ответов
+ConfiguratorErrorCode AuthClient::receiveResponse(AuthProtocol::AuthResponse &response)
+{
+    if (fd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    while (true)
+    {
+        AuthProtocol::FrameStatus status = AuthProtocol::extractResponse(in, inPos, response);
+        if (status == AuthProtocol::FrameStatus::COMPLETE)
+        {
+            return ConfiguratorErrorCode::SUCCESS;
+        }
+        if (status != AuthProtocol::FrameStatus::INCOMPLETE)
+        {
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+
+        // Разобранная часть удаляется только перед чтением
+        in.erase(0, inPos);
+        inPos = 0;
+        char buffer[16384];
+        ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received <= 0)
+        {
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+        in.append(buffer, static_cast<size_t>(received));
+    }
+}
+
+// Запрос аутентификации. Ошибка возвращается при сбое обмена (в том числе когда сервер закрыл
+// соединение после последней попытки); результат проверки — в response.status
+ConfiguratorErrorCode AuthClient::authenticate(const std::string &login, const std::string &password, AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_AUTHENTICATE;
+    request.login = login;
+    request.password = password;
+    return exchange(request, response);
+}
+
+// Продолжение сессии по токену из успешного ответа authenticate
+ConfiguratorErrorCode AuthClient::resumeSession(const std::string &token, AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_RESUME_SESSION;
+    request.token = token;
+    return exchange(request, response);
+}
+
+// Завершение сессии
+ConfiguratorErrorCode AuthClient::endSession(const std::string &token, AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_END_SESSION;
+    request.token = token;
+    return exchange(request, response);
+}
+
+// Смена пароля: проверка текущего пароля и требований к новому
+ConfiguratorErrorCode AuthClient::changePassword(const std::string &login, const std::string &password, const std::string &newPassword,
+                                                 AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_CHANGE_PASSWORD;
+    request.login = login;
+    request.password = password;
+    request.newPassword = newPassword;
+    return exchange(request, response);
+}
+
+// Проверка роли пользователя сессии
+ConfiguratorErrorCode AuthClient::checkRole(const std::string &token, UserRole role, AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_CHECK_ROLE;
+    request.token = token;
+    request.role = static_cast<uint32_t>(role);
+    return exchange(request, response);
+}
+
+AuthClient::~AuthClient()
+{
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
@@ -0,0 +1,595 @@
+// src/AuthClientPool.cpp
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <future>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "AuthClientPool.hpp"
+
+static const uint64_t WAKE_ID = 0;
+
+// Затирание пароля в строке
+static void wipe(std::string &secret)
+{
+    std::memset(&secret[0], 0, secret.size());
+}
+
+AuthClientPool::AuthClientPool(const AuthClientPoolOptions &poolOptions)
+    : options(poolOptions), stopping(false), epollFd(-1), wakeFd(-1), nextConnectionId(WAKE_ID + 1),
+      nextConnectAttempt(Clock::time_point::min()), nextTimeoutCheck(Clock::time_point::max()), requestCount(0), connectCount(0),
+      connectFailureCount(0), disconnectCount(0), retryCount(0), timeoutCount(0), openConnections(0)
+{
+    options.maxConnections = std::max<size_t>(options.maxConnections, 1);
+    options.maxInFlight = std::max<size_t>(options.maxInFlight, 1);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKE_ID;
+    if (epollFd >= 0 && wakeFd >= 0 && epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) == 0)
+    {
+        ioThread = std::thread(&AuthClientPool::ioLoop, this);
+    }
+}
+
+// Постановка запроса; done вызывается ровно один раз в потоке пула
+void AuthClientPool::submit(AuthProtocol::Request request, Callback done)
+{
+    bool credentials = request.operation == AuthProtocol::OPERATION_AUTHENTICATE ||
+                       request.operation == AuthProtocol::OPERATION_CHANGE_PASSWORD;
+    if (credentials && request.deadlineMs == 0)
+    {
+        request.deadlineMs = options.deadlineMs;
+    }
+    Pending pending;
+    pending.request = std::move(request);
+    pending.done = std::move(done);
+    pending.queued = Clock::now();
+    if (!ioThread.joinable())
+    {
+        fail(pending);
+        return;
+    }
+    requestCount.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        submitted.push_back(std::move(pending));
+    }
+    uint64_t one = 1;
+    ssize_t unused = write(wakeFd, &one, sizeof(one));
+    (void)unused;
+}
+
+void AuthClientPool::authenticateAsync(const std::string &login, const std::string &password, Callback done)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_AUTHENTICATE;
+    request.login = login;
+    request.password = password;
+    submit(std::move(request), std::move(done));
+}
+
+// Блокирующий запрос через поток пула; из обратного вызова ожидание никогда бы не завершилось.
+// Ожидание ограничено requestTimeoutMs: по его истечении поток пула завершает запрос ошибкой
+ConfiguratorErrorCode AuthClientPool::call(AuthProtocol::Request request, AuthProtocol::AuthResponse &response)
+{
+    if (std::this_thread::get_id() == ioThread.get_id())
+    {
+        wipe(request.password);
+        wipe(request.newPassword);
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    std::promise<ConfiguratorErrorCode> result;
+    std::future<ConfiguratorErrorCode> ready = result.get_future();
+    submit(std::move(request), [&result, &response](ConfiguratorErrorCode code, const AuthProtocol::AuthResponse &answer)
+           {
+               response = answer;
+               result.set_value(code);
+           });
+    return ready.get();
+}
+
+ConfiguratorErrorCode AuthClientPool::authenticate(const std::string &login, const std::string &password, AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_AUTHENTICATE;
+    request.login = login;
+    request.password = password;
+    return call(std::move(request), response);
+}
+
+ConfiguratorErrorCode AuthClientPool::changePassword(const std::string &login, const std::string &password, const std::string &newPassword,
+                                                     AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_CHANGE_PASSWORD;
+    request.login = login;
+    request.password = password;
+    request.newPassword = newPassword;
+    return call(std::move(request), response);
+}
+
+ConfiguratorErrorCode AuthClientPool::checkRole(const std::string &token, UserRole role, AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_CHECK_ROLE;
+    request.token = token;
+    request.role = static_cast<uint32_t>(role);
+    return call(std::move(request), response);
+}
+
+ConfiguratorErrorCode AuthClientPool::resumeSession(const std::string &token, AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_RESUME_SESSION;
+    request.token = token;
+    return call(std::move(request), response);
+}
+
+ConfiguratorErrorCode AuthClientPool::endSession(const std::string &token, AuthProtocol::AuthResponse &response)
+{
+    AuthProtocol::Request request;
+    request.operation = AuthProtocol::OPERATION_END_SESSION;
+    request.token = token;
+    return call(std::move(request), response);
+}
+
+// Основной цикл потока пула: ответы, новые запросы, переподключение, истечение ожидания соединения и ответа
+void AuthClientPool::ioLoop()
+{
+    struct epoll_event events[64];
+    while (true)
+    {
+        int timeout = -1;
+        Clock::time_point wake = nextTimeoutCheck;
+        bool capacity = false;
+        if (!waiting.empty())
+        {
+            if (connections.size() < options.maxConnections)
+            {
+                wake = std::min(wake, nextConnectAttempt);
+            }
+            if (connections.empty())
+            {
+                wake = std::min(wake, waiting.front().queued + std::chrono::milliseconds(options.connectTimeoutMs));
+            }
+            capacity = std::any_of(connections.begin(), connections.end(), [this](const auto &entry)
+                                   { return entry.second.inFlight.size() < options.maxInFlight; });
+        }
+        Clock::time_point now = Clock::now();
+        if (capacity || wake <= now)
+        {
+            timeout = 0;
+        }
+        else if (wake != Clock::time_point::max())
+        {
+            timeout = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(wake - now).count());
+        }
+
+        int count = epoll_wait(epollFd, events, 64, timeout);
+        for (int i = 0; i < count; ++i)
+        {
+            uint64_t id = events[i].data.u64;
+            if (id == WAKE_ID)
+            {
+                uint64_t value;
+                ssize_t unused = read(wakeFd, &value, sizeof(value));
+                (void)unused;
+                continue;
+            }
+            auto it = connections.find(id);
+            if (it == connections.end())
+            {
+                continue;
+            }
+            if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !readConnection(it->second))
+            {
+                dropConnection(id);
+                continue;
+            }
+            if ((events[i].events & EPOLLOUT) && !flushConnection(id, it->second))
+            {
+                dropConnection(id);
+            }
+        }
+
+        std::vector<Pending> incoming;
+        bool stop;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            incoming.swap(submitted);
+            stop = stopping;
+        }
+        for (Pending &pending : incoming)
+        {
+            if (options.requestTimeoutMs != 0)
+            {
+                nextTimeoutCheck = std::min(nextTimeoutCheck, pending.queued + std::chrono::milliseconds(options.requestTimeoutMs));
+            }
+            waiting.push_back(std::move(pending));
+        }
+        if (stop)
+        {
+            break;
+        }
+        dispatch();
+
+        // Пока нет ни одного соединения, запросы ждут не дольше connectTimeoutMs
+        now = Clock::now();
+        while (connections.empty() && !waiting.empty() &&
+               now - waiting.front().queued >= std::chrono::milliseconds(options.connectTimeoutMs))
+        {
+            fail(waiting.front());
+            waiting.pop_front();
+        }
+        expireRequests(now);
+    }
+
+    // Остановка: ответов больше не будет
+    for (Pending &pending : waiting)
+    {
+        fail(pending);
+    }
+    waiting.clear();
+    for (auto &[id, connection] : connections)
+    {
+        for (auto &entry : connection.inFlight)
+        {
+            fail(entry.second);
+        }
+        wipe(connection.out);
+        close(connection.fd);
+    }
+    connections.clear();
+    openConnections.store(0, std::memory_order_relaxed);
+}
+
+// Новое соединение; false, если сервер недоступен. Подключение к локальному серверу выполняется сразу,
+// поэтому оно блокирующее, а обмен — неблокирующий
+bool AuthClientPool::openConnection()
+{
+    int fd;
+    int connected;
+    if (options.tcpPort == 0)
+    {
+        struct sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (options.socketPath.size() >= sizeof(address.sun_path))
+        {
+            return false;
+        }
+        std::memcpy(address.sun_path, options.socketPath.c_str(), options.socketPath.size() + 1);
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        connected = fd < 0 ? -1 : ::connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address));
+    }
+    else
+    {
+        struct sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(options.tcpPort);
+        if (inet_pton(AF_INET, options.tcpHost.c_str(), &address.sin_addr) != 1)
+        {
+            return false;
+        }
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        connected = fd < 0 ? -1 : ::connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address));
+        // Кадры запросов маленькие: без Nagle они уходят сразу, не дожидаясь ответа на предыдущие
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+
+    uint64_t id = nextConnectionId;
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = id;
+    if (connected != 0 || fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) != 0 ||
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        connectFailureCount.fetch_add(1, std::memory_order_relaxed);
+        nextConnectAttempt = Clock::now() + std::chrono::milliseconds(options.reconnectDelayMs);
+        return false;
+    }
+    ++nextConnectionId;
+    connections[id] = Connection{fd, std::string(), 0, std::string(), 0, false, 0, 0, 1, {}};
+    connectCount.fetch_add(1, std::memory_order_relaxed);
+    openConnections.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Распределение ожидающих запросов: в наименее загруженное соединение; новое соединение открывается,
+// только когда во всех открытых уже есть запросы без ответа
+void AuthClientPool::dispatch()
+{
+    while (!waiting.empty())
+    {
+        Connection *target = nullptr;
+        for (auto &entry : connections)
+        {
+            size_t load = entry.second.inFlight.size();
+            if (load < options.maxInFlight && (target == nullptr || load < target->inFlight.size()))
+            {
+                target = &entry.second;
+            }
+        }
+        if ((target == nullptr || !target->inFlight.empty()) && connections.size() < options.maxConnections &&
+            Clock::now() >= nextConnectAttempt && openConnection())
+        {
+            continue;
+        }
+        if (target == nullptr)
+        {
+            break;
+        }
+
+        Pending pending = std::move(waiting.front());
+        waiting.pop_front();
+        uint32_t requestId = target->nextRequestId++;
+        pending.request.id = requestId;
+        size_t before = target->out.size();
+        if (!AuthProtocol::appendRequest(target->out, pending.request))
+        {
+            fail(pending);
+            continue;
+        }
+        // Пароль хранится до ответа для повтора, если соединение разорвется до записи кадра
+        pending.frameStart = target->appended;
+        target->appended += target->out.size() - before;
+        target->inFlight.emplace(requestId, std::move(pending));
+    }
+
+    std::vector<uint64_t> broken;
+    for (auto &[id, connection] : connections)
+    {
+        if (connection.outOffset < connection.out.size() && !connection.waitingWritable && !flushConnection(id, connection))
+        {
+            broken.push_back(id);
+        }
+    }
+    for (uint64_t id : broken)
+    {
+        dropConnection(id);
+    }
+}
+
+// Отправка накопленных кадров соединения одним вызовом; остаток ждет EPOLLOUT
+bool AuthClientPool::flushConnection(uint64_t id, Connection &connection)
+{
+    while (connection.outOffset < connection.out.size())
+    {
+        ssize_t sent = send(connection.fd, connection.out.data() + connection.outOffset, connection.out.size() - connection.outOffset,
+                            MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        if (sent <= 0)
+        {
+            return false;
+        }
+        connection.outOffset += static_cast<size_t>(sent);
+        connection.written += static_cast<uint64_t>(sent);
+    }
+    bool pending = connection.outOffset < connection.out.size();
+    if (!pending)
+    {
+        wipe(connection.out);
+        connection.out.clear();
+        connection.outOffset = 0;
+    }
+    if (pending != connection.waitingWritable)
+    {
+        struct epoll_event event = {};
+        event.events = pending ? EPOLLIN | EPOLLOUT : EPOLLIN;
+        event.data.u64 = id;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.waitingWritable = pending;
+    }
+    return true;
+}
+
+// Прием и разбор ответов соединения; false, если соединение закрыто или ответ не разбирается
+bool AuthClientPool::readConnection(Connection &connection)
+{
+    char buffer[16384];
+    while (true)
+    {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return true;
+        }
+        if (received <= 0)
+        {
+            return false;
+        }
+        connection.in.append(buffer, static_cast<size_t>(received));
+
+        AuthProtocol::AuthResponse response;
+        AuthProtocol::FrameStatus status;
+        while ((status = AuthProtocol::extractResponse(connection.in, connection.inPos, response)) == AuthProtocol::FrameStatus::COMPLETE)
+        {
+            auto it = connection.inFlight.find(response.requestId);
+            if (it == connection.inFlight.end())
+            {
+                continue;
+            }
+            Pending pending = std::move(it->second);
+            connection.inFlight.erase(it);
+            wipe(pending.request.password);
+            wipe(pending.request.newPassword);
+            pending.done(ConfiguratorErrorCode::SUCCESS, response);
+        }
+        if (status != AuthProtocol::FrameStatus::INCOMPLETE)
+        {
+            return false;
+        }
+        connection.in.erase(0, connection.inPos);
+        connection.inPos = 0;
+    }
+}
+
+// Закрытие соединения: запросы, ни один байт которых не записан, повторяются один раз; записанные сервер
+// мог выполнить, поэтому они завершаются ошибкой
+void AuthClientPool::dropConnection(uint64_t id)
+{
+    auto it = connections.find(id);
+    if (it == connections.end())
+    {
+        return;
+    }
+    Connection &connection = it->second;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection.fd, nullptr);
+    close(connection.fd);
+    wipe(connection.out);
+    // Повторы ставятся в начало очереди в порядке номеров
+    std::vector<uint32_t> ids;
+    for (const auto &entry : connection.inFlight)
+    {
+        ids.push_back(entry.first);
+    }
+    std::sort(ids.rbegin(), ids.rend());
+    for (uint32_t requestId : ids)
+    {
+        Pending &pending = connection.inFlight.at(requestId);
+        if (connection.written <= pending.frameStart && !pending.retried)
+        {
+            pending.retried = true;
+            retryCount.fetch_add(1, std::memory_order_relaxed);
+            waiting.push_front(std::move(pending));
+        }
+        else
+        {
+            fail(pending);
+        }
+    }
+    connections.erase(it);
+    openConnections.fetch_sub(1, std::memory_order_relaxed);
+    disconnectCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Завершение ошибкой запросов, ждущих ответа дольше requestTimeoutMs; следующая проверка — к ближайшему сроку.
+// Кадр такого запроса может остаться в соединении, ответ на него отбрасывается
+void AuthClientPool::expireRequests(Clock::time_point now)
+{
+    if (now < nextTimeoutCheck)
+    {
+        return;
+    }
+    std::chrono::milliseconds timeout(options.requestTimeoutMs);
+    nextTimeoutCheck = Clock::time_point::max();
+    std::vector<Pending> expired;
+    auto expiredAt = [this, now, timeout](const Pending &pending)
+    {
+        if (now - pending.queued >= timeout)
+        {
+            return true;
+        }
+        nextTimeoutCheck = std::min(nextTimeoutCheck, pending.queued + timeout);
+        return false;
+    };
+    for (auto it = waiting.begin(); it != waiting.end();)
+    {
+        if (expiredAt(*it))
+        {
+            expired.push_back(std::move(*it));
+            it = waiting.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    for (auto &[id, connection] : connections)
+    {
+        for (auto it = connection.inFlight.begin(); it != connection.inFlight.end();)
+        {
+            if (expiredAt(it->second))
+            {
+                expired.push_back(std::move(it->second));
+                it = connection.inFlight.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+    // Обратные вызовы — после обхода: они могут ставить новые запросы
+    timeoutCount.fetch_add(expired.size(), std::memory_order_relaxed);
+    for (Pending &pending : expired)
+    {
+        fail(pending);
+    }
+}
+
+// Завершение запроса ошибкой
+void AuthClientPool::fail(Pending &pending)
+{
+    wipe(pending.request.password);
+    wipe(pending.request.newPassword);
+    AuthProtocol::AuthResponse response;
+    response.requestId = pending.request.id;
+    pending.done(ConfiguratorErrorCode::DATABASE_ERROR, response);
+}
+
+size_t AuthClientPool::connectionCount() const
+{
+    return openConnections.load(std::memory_order_relaxed);
+}
+
+AuthClientPoolStats AuthClientPool::stats() const
+{
+    AuthClientPoolStats result;
+    result.requests = requestCount.load(std::memory_order_relaxed);
+    result.connects = connectCount.load(std::memory_order_relaxed);
+    result.connectFailures = connectFailureCount.load(std::memory_order_relaxed);
+    result.disconnects = disconnectCount.load(std::memory_order_relaxed);
+    result.retried = retryCount.load(std::memory_order_relaxed);
+    result.timedOut = timeoutCount.load(std::memory_order_relaxed);
+    return result;
+}
+
+AuthClientPool::~AuthClientPool()
+{
+    if (ioThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        uint64_t one = 1;
+        ssize_t unused = write(wakeFd, &one, sizeof(one));
+        (void)unused;
+        ioThread.join();
+    }
+    const int fds[] = {epollFd, wakeFd};
+    for (int fd : fds)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+}
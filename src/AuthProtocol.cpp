@@ -0,0 +1,214 @@
+// src/AuthProtocol.cpp
+
+#include <cstring>
+
+#include "AuthProtocol.hpp"
+
+// Дописывание 32-битного числа
+static void appendUint32(std::string &out, uint32_t value)
+{
+    out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// Чтение 32-битного числа начиная с позиции pos
+static bool readUint32(std::string_view in, size_t &pos, uint32_t &value)
+{
+    if (in.size() < pos || in.size() - pos < sizeof(value))
+    {
+        return false;
+    }
+    std::memcpy(&value, in.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+}
+
+// Дописывание поля с 16-битной длиной; false, если поле длиннее
+static bool appendField(std::string &out, std::string_view field)
+{
+    if (field.size() > UINT16_MAX)
+    {
+        return false;
+    }
+    uint16_t length = static_cast<uint16_t>(field.size());
+    out.append(reinterpret_cast<const char *>(&length), sizeof(length));
+    out.append(field);
+    return true;
+}
+
+// Чтение поля с 16-битной длиной начиная с позиции pos
+static bool readField(std::string_view in, size_t &pos, std::string &field)
+{
+    uint16_t length;
+    if (in.size() < pos || in.size() - pos < sizeof(length))
+    {
+        return false;
+    }
+    std::memcpy(&length, in.data() + pos, sizeof(length));
+    pos += sizeof(length);
+    if (in.size() - pos < length)
+    {
+        return false;
+    }
+    field.assign(in.data() + pos, length);
+    pos += length;
+    return true;
+}
+
+// Дописывание кадра с содержимым payload
+void AuthProtocol::appendFrame(std::string &out, std::string_view payload)
+{
+    appendUint32(out, static_cast<uint32_t>(payload.size()));
+    out.append(payload);
+}
+
+// Выделение кадра из buffer начиная с позиции pos без копирования
+AuthProtocol::FrameStatus AuthProtocol::extractFrame(std::string_view buffer, size_t &pos, std::string_view &payload)
+{
+    size_t cursor = pos;
+    uint32_t length;
+    if (!readUint32(buffer, cursor, length))
+    {
+        return FrameStatus::INCOMPLETE;
+    }
+    if (length > MAX_FRAME_BYTES)
+    {
+        return FrameStatus::TOO_LARGE;
+    }
+    if (buffer.size() - cursor < length)
+    {
+        return FrameStatus::INCOMPLETE;
+    }
+    payload = buffer.substr(cursor, length);
+    pos = cursor + length;
+    return FrameStatus::COMPLETE;
+}
+
+// Дописывание кадра запроса: длина записывается после содержимого, когда она известна
+bool AuthProtocol::appendRequest(std::string &out, const Request &request)
+{
+    size_t start = out.size();
+    appendUint32(out, 0);
+    appendUint32(out, request.id);
+    out.push_back(request.operation);
+
+    bool encoded;
+    switch (request.operation)
+    {
+    case OPERATION_AUTHENTICATE:
+        encoded = appendField(out, request.login) && appendField(out, request.password);
+        break;
+    case OPERATION_CHANGE_PASSWORD:
+        encoded = appendField(out, request.login) && appendField(out, request.password) && appendField(out, request.newPassword);
+        break;
+    case OPERATION_CHECK_ROLE:
+        encoded = appendField(out, request.token);
+        appendUint32(out, request.role);
+        break;
+    case OPERATION_RESUME_SESSION:
+    case OPERATION_END_SESSION:
+        encoded = appendField(out, request.token);
+        break;
+    default:
+        encoded = false;
+    }
+    // Срок — необязательное последнее поле запросов с проверкой пароля: без него кадр прежний
+    if (request.deadlineMs > 0 && (request.operation == OPERATION_AUTHENTICATE || request.operation == OPERATION_CHANGE_PASSWORD))
+    {
+        appendUint32(out, request.deadlineMs);
+    }
+
+    size_t length = out.size() - start - sizeof(uint32_t);
+    if (!encoded || length > MAX_FRAME_BYTES)
+    {
+        std::memset(&out[start], 0, out.size() - start);
+        out.resize(start);
+        return false;
+    }
+    uint32_t length32 = static_cast<uint32_t>(length);
+    std::memcpy(&out[start], &length32, sizeof(length32));
+    return true;
+}
+
+// Выделение и разбор очередного кадра запроса; при COMPLETE pos сдвигается за кадр
+AuthProtocol::FrameStatus AuthProtocol::extractRequest(std::string_view buffer, size_t &pos, Request &request)
+{
+    size_t cursor = pos;
+    std::string_view payload;
+    FrameStatus status = extractFrame(buffer, cursor, payload);
+    if (status != FrameStatus::COMPLETE)
+    {
+        return status;
+    }
+
+    size_t field = 0;
+    if (!readUint32(payload, field, request.id) || field == payload.size())
+    {
+        return FrameStatus::MALFORMED;
+    }
+    request.operation = payload[field++];
+
+    bool decoded;
+    switch (request.operation)
+    {
+    case OPERATION_AUTHENTICATE:
+        decoded = readField(payload, field, request.login) && readField(payload, field, request.password) &&
+                  (field == payload.size() || readUint32(payload, field, request.deadlineMs));
+        break;
+    case OPERATION_CHANGE_PASSWORD:
+        decoded = readField(payload, field, request.login) && readField(payload, field, request.password) &&
+                  readField(payload, field, request.newPassword) &&
+                  (field == payload.size() || readUint32(payload, field, request.deadlineMs));
+        break;
+    case OPERATION_CHECK_ROLE:
+        decoded = readField(payload, field, request.token) && readUint32(payload, field, request.role);
+        break;
+    case OPERATION_RESUME_SESSION:
+    case OPERATION_END_SESSION:
+        decoded = readField(payload, field, request.token);
+        break;
+    default:
+        decoded = false;
+    }
+    if (!decoded || field != payload.size())
+    {
+        return FrameStatus::MALFORMED;
+    }
+    pos = cursor;
+    return FrameStatus::COMPLETE;
+}
+
+void AuthProtocol::appendResponse(std::string &out, const AuthResponse &response)
+{
+    appendUint32(out, static_cast<uint32_t>(4 * sizeof(uint32_t) + sizeof(uint16_t) + response.sessionToken.size()));
+    appendUint32(out, response.requestId);
+    appendUint32(out, static_cast<uint32_t>(response.status));
+    appendUint32(out, response.attemptsLeft);
+    appendUint32(out, response.retryAfterMs);
+    appendField(out, response.sessionToken);
+}
+
+AuthProtocol::FrameStatus AuthProtocol::extractResponse(std::string_view buffer, size_t &pos, AuthResponse &response)
+{
+    size_t cursor = pos;
+    std::string_view payload;
+    FrameStatus status = extractFrame(buffer, cursor, payload);
+    if (status != FrameStatus::COMPLETE)
+    {
+        return status;
+    }
+
+    size_t field = 0;
+    uint32_t code;
+    uint32_t attemptsLeft;
+    if (!readUint32(payload, field, response.requestId) || !readUint32(payload, field, code) ||
+        !readUint32(payload, field, attemptsLeft) || !readUint32(payload, field, response.retryAfterMs) ||
+        !readField(payload, field, response.sessionToken) ||
+        field != payload.size())
+    {
+        return FrameStatus::MALFORMED;
+    }
+    response.status = static_cast<UserErrorCode>(code);
+    response.attemptsLeft = attemptsLeft;
+    pos = cursor;
+    return FrameStatus::COMPLETE;
+}
@@ -0,0 +1,970 @@
+// src/AuthServer.cpp
+
+#include <cerrno>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "AuthServer.hpp"
+
+// Идентификаторы служебных дескрипторов в epoll; соединения нумеруются с FIRST_CONNECTION_ID
+static const uint64_t LISTEN_ID = 0;
+static const uint64_t WAKE_ID = 1;
+static const uint64_t STOP_ID = 2;
+static const uint64_t HTTP_LISTEN_ID = 3;
+static const uint64_t TCP_LISTEN_ID = 4;
+static const uint64_t FIRST_CONNECTION_ID = 16;
+
+// Предел непрочитанных данных соединения: клиент, присылающий запросы быстрее обработки, отключается
+static const size_t MAX_PENDING_INPUT = 16 * (AuthProtocol::MAX_FRAME_BYTES + sizeof(uint32_t));
+
+// Время сессий в секундах монотонных часов
+static int64_t nowSeconds()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Время ограничителя частоты в миллисекундах монотонных часов
+static int64_t nowMilliseconds()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Затирание пароля в строке
+static void wipe(std::string &secret)
+{
+    std::memset(&secret[0], 0, secret.size());
+}
+
+// Код результата смены пароля для клиента
+static UserErrorCode toUserErrorCode(ConfiguratorErrorCode code)
+{
+    switch (code)
+    {
+    case ConfiguratorErrorCode::SUCCESS:
+        return UserErrorCode::SUCCESS;
+    case ConfiguratorErrorCode::LOGIN_NOT_FOUND:
+        return UserErrorCode::LOGIN_NOT_EXISTS;
+    case ConfiguratorErrorCode::PASSWORD_TOO_SHORT:
+    case ConfiguratorErrorCode::PASSWORD_INVALID_CHARS:
+    case ConfiguratorErrorCode::PASSWORD_REUSED:
+        return UserErrorCode::PASSWORD_REJECTED;
+    default:
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+}
+
+AuthServer::AuthServer(Authenticator *auth, const AuthServerOptions &serverOptions, ConfiguratorAccountsEditor *accountsEditor)
+    : authenticator(auth), editor(accountsEditor), options(serverOptions), listenFd(-1), httpListenFd(-1), boundHttpPort(0),
+      tcpListenFd(-1), boundTcpPort(0),
+      epollFd(-1), wakeFd(-1), stopFd(-1),
+      nextConnectionId(FIRST_CONNECTION_ID), sessions(serverOptions.sessionStore),
+      rateLimiter(serverOptions.rateLimiter), loadShedder(serverOptions.maxPredictedLatencyMs, 1), loopExecutor(*this),
+      requestsInFlight(0), acceptedCount(0), verifiedCount(0), overloadedCount(0), cancelledDeadlineCount(0), cancelledDisconnectedCount(0)
+{
+    if (sessions == nullptr)
+    {
+        ownSessions.reset(new SessionManager(nowSeconds(), options.maxSessions));
+        sessions = ownSessions.get();
+    }
+    if (rateLimiter == nullptr)
+    {
+        ownRateLimiter.reset(new RateLimiter(options.rateLimits));
+        rateLimiter = ownRateLimiter.get();
+    }
+
+    // Остановка может быть запрошена до start()
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+// Слушающий сокет TCP на 127.0.0.1:port; boundPort — фактический порт (при port 0 его выбирает ядро)
+static bool listenLoopback(uint16_t port, bool reusePort, int &fd, uint16_t &boundPort)
+{
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (reusePort)
+    {
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse));
+    }
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    socklen_t length = sizeof(address);
+    if (bind(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0 ||
+        getsockname(fd, reinterpret_cast<struct sockaddr *>(&address), &length) != 0)
+    {
+        return false;
+    }
+    boundPort = ntohs(address.sin_port);
+    return true;
+}
+
+// Создание сокета и запуск исполнителя; существующий файл сокета заменяется.
+// Готовый сокет из options.listenFd принадлежит вызывающему и не закрывается сервером
+ConfiguratorErrorCode AuthServer::start()
+{
+    if (stopFd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    if (options.listenFd < 0)
+    {
+        struct sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (options.socketPath.size() >= sizeof(address.sun_path))
+        {
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+        std::memcpy(address.sun_path, options.socketPath.c_str(), options.socketPath.size() + 1);
+
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0)
+        {
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+        unlink(options.socketPath.c_str());
+        if (bind(listenFd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0 ||
+            listen(listenFd, SOMAXCONN) != 0)
+        {
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+    }
+
+    // HTTP и TCP принимаются только с петлевого интерфейса: пароли передаются открытым текстом
+    if (options.http && !listenLoopback(options.httpPort, options.reusePort, httpListenFd, boundHttpPort))
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    if (options.tcp && !listenLoopback(options.tcpPort, options.reusePort, tcpListenFd, boundTcpPort))
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    // Общий сокет нескольких процессов будит только один из них (EPOLLEXCLUSIVE)
+    int sharedListenFd = options.listenFd;
+    const std::pair<int, uint64_t> watched[] = {{sharedListenFd >= 0 ? sharedListenFd : listenFd, LISTEN_ID}, {wakeFd, WAKE_ID},
+                                                {stopFd, STOP_ID}, {httpListenFd, HTTP_LISTEN_ID}, {tcpListenFd, TCP_LISTEN_ID}};
+    for (const auto &[fd, id] : watched)
+    {
+        if (fd < 0)
+        {
+            continue;
+        }
+        struct epoll_event event = {};
+        event.events = fd == sharedListenFd ? EPOLLIN | EPOLLEXCLUSIVE : EPOLLIN;
+        event.data.u64 = id;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+    }
+
+    WorkStealingOptions executorOptions;
+    executorOptions.workers = options.workers;
+    executor.reset(new WorkStealingExecutor(executorOptions));
+    loadShedder = LoadShedder(options.maxPredictedLatencyMs, executor->size());
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Порт HTTP после start(); 0, если HTTP не включен
+uint16_t AuthServer::httpPort() const
+{
+    return boundHttpPort;
+}
+
+// Порт двоичного протокола по TCP после start(); 0, если TCP не включен
+uint16_t AuthServer::tcpPort() const
+{
+    return boundTcpPort;
+}
+
+// Цикл обработки событий до вызова stop()
+void AuthServer::run()
+{
+    struct epoll_event events[64];
+    while (true)
+    {
+        // Пока есть сессии, цикл просыпается раз в секунду, чтобы продвинуть колесо таймеров
+        int count = epoll_wait(epollFd, events, 64, sessions->size() > 0 ? 1000 : -1);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+        sessions->advance(nowSeconds());
+
+        for (int i = 0; i < count; ++i)
+        {
+            uint64_t id = events[i].data.u64;
+            if (id == STOP_ID)
+            {
+                return;
+            }
+            if (id == LISTEN_ID)
+            {
+                acceptConnections(listenFd >= 0 ? listenFd : options.listenFd, false);
+            }
+            else if (id == HTTP_LISTEN_ID)
+            {
+                acceptConnections(httpListenFd, true);
+            }
+            else if (id == TCP_LISTEN_ID)
+            {
+                acceptConnections(tcpListenFd, false);
+            }
+            else if (id == WAKE_ID)
+            {
+                uint64_t value;
+                ssize_t unused = read(wakeFd, &value, sizeof(value));
+                (void)unused;
+                runLoopTasks();
+            }
+            else
+            {
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                {
+                    readConnection(id);
+                }
+                if ((events[i].events & EPOLLOUT) && connections.count(id))
+                {
+                    flushConnection(id);
+                }
+            }
+        }
+        // Ответы, накопленные за проход, отправляются по одному вызову на соединение
+        flushConnections();
+    }
+}
+
+// Остановка цикла; безопасна в обработчике сигнала
+void AuthServer::stop()
+{
+    uint64_t one = 1;
+    ssize_t unused = write(stopFd, &one, sizeof(one));
+    (void)unused;
+}
+
+AuthServerStats AuthServer::stats() const
+{
+    AuthServerStats result;
+    result.accepted = acceptedCount.load(std::memory_order_relaxed);
+    result.verified = verifiedCount.load(std::memory_order_relaxed);
+    result.overloaded = overloadedCount.load(std::memory_order_relaxed);
+    result.cancelledDeadline = cancelledDeadlineCount.load(std::memory_order_relaxed);
+    result.cancelledDisconnected = cancelledDisconnectedCount.load(std::memory_order_relaxed);
+    return result;
+}
+
+void AuthServer::acceptConnections(int listener, bool http)
+{
+    bool inet = listener == httpListenFd || listener == tcpListenFd;
+    while (true)
+    {
+        struct sockaddr_in peer = {};
+        socklen_t peerLength = sizeof(peer);
+        int fd = accept4(listener, inet ? reinterpret_cast<struct sockaddr *>(&peer) : nullptr, inet ? &peerLength : nullptr,
+                         SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return; // EAGAIN: очередь пуста; прочие ошибки касаются одного соединения
+        }
+        if (connections.size() >= options.maxConnections)
+        {
+            close(fd);
+            continue;
+        }
+
+        uint64_t id = nextConnectionId++;
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = id;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            close(fd);
+            continue;
+        }
+        acceptedCount.fetch_add(1, std::memory_order_relaxed);
+        // Источник — пользователь подключившегося процесса; без учетных данных все такие соединения считаются одним источником.
+        // Для HTTP и TCP источник — адрес клиента
+        std::string source;
+        if (inet)
+        {
+            char address[INET_ADDRSTRLEN] = "unknown";
+            inet_ntop(AF_INET, &peer.sin_addr, address, sizeof(address));
+            source = std::string("ip:") + address;
+        }
+        else
+        {
+            struct ucred credentials = {};
+            socklen_t length = sizeof(credentials);
+            source = getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0
+                         ? "uid:" + std::to_string(credentials.uid)
+                         : std::string("unknown");
+        }
+        connections[id] = Connection{fd, std::move(source), std::string(), std::deque<std::string>(), 0, 0, false, false, false, 0,
+                                     http, true, 0, CancellationToken(), CancellationToken::Clock::now()};
+    }
+}
+
+void AuthServer::readConnection(uint64_t id)
+{
+    Connection &connection = connections.at(id);
+    char buffer[16384];
+    while (true)
+    {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0)
+        {
+            if (connection.in.empty())
+            {
+                connection.received = CancellationToken::Clock::now();
+            }
+            connection.in.append(buffer, static_cast<size_t>(received));
+            if (connection.in.size() > MAX_PENDING_INPUT)
+            {
+                closeConnection(id);
+                return;
+            }
+            continue;
+        }
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        // Клиент закрыл соединение или ошибка; результат задачи в исполнителе, если она есть, будет отброшен
+        closeConnection(id);
+        return;
+    }
+    processRequests(id);
+}
+
+// Разбор всех полных кадров, принятых из соединения. Вход и проверка роли ищут пользователя сразу,
+// проверка пароля выполняется в исполнителе; при maxInFlight запросов в исполнителе разбор приостанавливается
+void AuthServer::processRequests(uint64_t id)
+{
+    auto it = connections.find(id);
+    if (it == connections.end())
+    {
+        return;
+    }
+    Connection &connection = it->second;
+
+    size_t pos = 0;
+    if (connection.http)
+    {
+        processHttpRequests(id, connection, pos);
+    }
+    while (!connection.http && !connection.closeAfterWrite && connection.inFlight < options.maxInFlight)
+    {
+        AuthProtocol::Request request;
+        AuthProtocol::FrameStatus frameStatus = AuthProtocol::extractRequest(connection.in, pos, request);
+        if (frameStatus == AuthProtocol::FrameStatus::INCOMPLETE)
+        {
+            break;
+        }
+        if (frameStatus != AuthProtocol::FrameStatus::COMPLETE)
+        {
+            wipe(request.password);
+            wipe(request.newPassword);
+            closeConnection(id);
+            return;
+        }
+
+        switch (request.operation)
+        {
+        case AuthProtocol::OPERATION_AUTHENTICATE:
+        case AuthProtocol::OPERATION_CHANGE_PASSWORD:
+            processCredentials(id, connection, request);
+            break;
+        case AuthProtocol::OPERATION_CHECK_ROLE:
+            processRoleCheck(id, request);
+            break;
+        default:
+            processSessionRequest(id, request);
+        }
+    }
+
+    // Разобранные кадры содержат пароли: затираются и удаляются из буфера одним вызовом
+    if (pos > 0)
+    {
+        std::memset(&connection.in[0], 0, pos);
+        connection.in.erase(0, pos);
+    }
+}
+
+// Разбор запросов HTTP. Ответы должны идти в порядке запросов, поэтому следующий запрос разбирается
+// после ответа на предыдущий; ошибка разбора закрывает соединение после ответа
+void AuthServer::processHttpRequests(uint64_t id, Connection &connection, size_t &pos)
+{
+    static const std::string_view usersPrefix = "/users/";
+    static const std::string_view rolesSuffix = "/roles";
+    while (!connection.closeAfterWrite && connection.httpKeepAlive && connection.inFlight == 0)
+    {
+        HttpProtocol::Request request;
+        AuthProtocol::FrameStatus frameStatus = HttpProtocol::extractRequest(connection.in, pos, connection.httpScanned, request);
+        if (frameStatus == AuthProtocol::FrameStatus::INCOMPLETE)
+        {
+            return;
+        }
+        if (frameStatus != AuthProtocol::FrameStatus::COMPLETE)
+        {
+            connection.httpKeepAlive = false;
+            bool tooLarge = frameStatus == AuthProtocol::FrameStatus::TOO_LARGE;
+            queueHttpResponse(id, tooLarge ? 413 : 400, tooLarge ? "{\"status\":\"TOO_LARGE\"}" : "{\"status\":\"BAD_REQUEST\"}");
+            return;
+        }
+        connection.httpKeepAlive = request.keepAlive;
+
+        std::string_view target = request.target;
+        if (target == "/authenticate")
+        {
+            if (request.method != "POST")
+            {
+                queueHttpResponse(id, 405, "{\"status\":\"METHOD_NOT_ALLOWED\"}");
+                continue;
+            }
+            AuthProtocol::Request credentials;
+            credentials.operation = AuthProtocol::OPERATION_AUTHENTICATE;
+            credentials.deadlineMs = request.deadlineMs;
+            if (!HttpProtocol::parseCredentials(request.body, credentials.login, credentials.password))
+            {
+                wipe(credentials.password);
+                queueHttpResponse(id, 400, "{\"status\":\"BAD_REQUEST\"}");
+                continue;
+            }
+            processCredentials(id, connection, credentials);
+        }
+        else if (target.size() > usersPrefix.size() + rolesSuffix.size() && target.substr(0, usersPrefix.size()) == usersPrefix &&
+                 target.substr(target.size() - rolesSuffix.size()) == rolesSuffix)
+        {
+            std::string_view login = target.substr(usersPrefix.size(), target.size() - usersPrefix.size() - rolesSuffix.size());
+            if (request.method != "GET")
+            {
+                queueHttpResponse(id, 405, "{\"status\":\"METHOD_NOT_ALLOWED\"}");
+                continue;
+            }
+            processHttpRoles(id, request, login);
+        }
+        else
+        {
+            queueHttpResponse(id, 404, "{\"status\":\"NOT_FOUND\"}");
+        }
+    }
+}
+
+// Роли пользователя по запросу HTTP с токеном действующей сессии: таблица сессий и поиск пользователя, без исполнителя.
+// Как и в двоичном протоколе, сессия дает доступ только к ролям своего логина; чужой логин, существующий
+// или нет, получает 403 до поиска, поэтому маршрут не раскрывает, какие логины есть в базе
+void AuthServer::processHttpRoles(uint64_t id, const HttpProtocol::Request &request, std::string_view login)
+{
+    static const std::string_view bearer = "Bearer ";
+    std::string token;
+    std::string sessionLogin;
+    if (request.authorization.substr(0, bearer.size()) != bearer ||
+        !SessionManager::tokenFromHex(std::string(request.authorization.substr(bearer.size())), token) ||
+        !sessions->validate(token, nowSeconds(), sessionLogin))
+    {
+        queueHttpResponse(id, 401, "{\"status\":\"SESSION_EXPIRED\"}");
+        return;
+    }
+    if (sessionLogin != login)
+    {
+        queueHttpResponse(id, 403, "{\"status\":\"FORBIDDEN\"}");
+        return;
+    }
+
+    UserData userData;
+    UserErrorCode status = authenticator->findUser(std::string(login), userData, requestArena.resource());
+    requestArena.reset();
+    std::string body;
+    body.reserve(64 + login.size() + 10 * userData.roles.size());
+    body += "{\"status\":";
+    HttpProtocol::appendJsonString(body, HttpProtocol::statusName(status));
+    if (status == UserErrorCode::SUCCESS)
+    {
+        body += ",\"login\":";
+        HttpProtocol::appendJsonString(body, userData.login);
+        body += ",\"roles\":[";
+        for (size_t i = 0; i < userData.roles.size(); ++i)
+        {
+            body += i == 0 ? "" : ",";
+            HttpProtocol::appendJsonString(body, HttpProtocol::roleName(userData.roles[i]));
+        }
+        body += ']';
+    }
+    body += '}';
+    queueHttpResponse(id, HttpProtocol::statusCode(status), body);
+}
+
+// Вход или смена пароля: частота попыток, поиск пользователя и блокировка — в потоке цикла,
+// проверка пароля — в исполнителе. Срок отсчитывается от приема данных запроса, поэтому включает
+// ожидание в буфере соединения на пределе maxInFlight
+void AuthServer::processCredentials(uint64_t id, Connection &connection, AuthProtocol::Request &request)
+{
+    bool changePassword = request.operation == AuthProtocol::OPERATION_CHANGE_PASSWORD;
+    AuthProtocol::AuthResponse response;
+    response.requestId = request.id;
+    unsigned maxFailedAttempts;
+    response.status = authenticator->getMaxFailedAttempts(maxFailedAttempts);
+    if (response.status == UserErrorCode::SUCCESS)
+    {
+        // Частота попыток проверяется первой: отклоненная попытка не стоит ни поиска, ни хеширования
+        int64_t now = nowMilliseconds();
+        if (!rateLimiter->allow(RateLimitKind::SOURCE, connection.source, now) ||
+            !rateLimiter->allow(RateLimitKind::LOGIN, request.login, now))
+        {
+            response.status = UserErrorCode::RATE_LIMITED;
+        }
+    }
+    // Попытка, которая при текущей очереди не успеет проверяться в пределах задержки, отклоняется сразу
+    if (response.status == UserErrorCode::SUCCESS && !loadShedder.admit(response.retryAfterMs))
+    {
+        response.status = UserErrorCode::OVERLOADED;
+        overloadedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    CancellationToken cancellation =
+        connection.cancellation.withTimeout(options.requestTimeoutMs, connection.received).withTimeout(request.deadlineMs, connection.received);
+    if (response.status == UserErrorCode::SUCCESS && cancellation.reason() == CancelReason::DEADLINE)
+    {
+        response.status = UserErrorCode::DEADLINE_EXCEEDED;
+        cancelledDeadlineCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    UserData userData;
+    if (response.status == UserErrorCode::SUCCESS)
+    {
+        response.status = authenticator->findUser(request.login, userData, requestArena.resource());
+        requestArena.reset();
+    }
+    if (response.status == UserErrorCode::SUCCESS)
+    {
+        // Заблокированный логин отклоняется без постановки в исполнитель
+        response.status = authenticator->checkLockout(request.login);
+    }
+    if (response.status == UserErrorCode::SUCCESS &&
+        (request.password.empty() || (changePassword && request.newPassword.empty())))
+    {
+        response.status = UserErrorCode::PASSWORD_ENTERING_ERROR;
+    }
+    if (response.status == UserErrorCode::SUCCESS && changePassword && editor == nullptr)
+    {
+        response.status = UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+    if (response.status != UserErrorCode::SUCCESS)
+    {
+        wipe(request.password);
+        wipe(request.newPassword);
+        response.attemptsLeft = maxFailedAttempts > connection.failedAttempts ? maxFailedAttempts - connection.failedAttempts : 0;
+        queueResponse(id, response);
+        return;
+    }
+
+    ++connection.inFlight;
+    ++requestsInFlight;
+    loadShedder.started();
+    Completion completion{id, request.id, request.operation, UserErrorCode::SUCCESS, userData.login};
+    std::shared_ptr<UserData> user = std::make_shared<UserData>(std::move(userData));
+    std::shared_ptr<std::string> secret = std::make_shared<std::string>(std::move(request.password));
+    std::shared_ptr<std::string> newSecret = std::make_shared<std::string>(std::move(request.newPassword));
+    executor->submit([this, completion, user, secret, newSecret, cancellation]() mutable
+                     {
+                         // Этап проверки пароля; следующий этап ставится в очередь этого же потока.
+                         // Запрос, который отменили или срок которого истек в очереди, не хешируется
+                         completion.cancelled = cancellation.reason();
+                         if (completion.cancelled != CancelReason::NONE)
+                         {
+                             wipe(*secret);
+                             wipe(*newSecret);
+                             completion.status = UserErrorCode::DEADLINE_EXCEEDED;
+                             postCompletion(completion);
+                             return;
+                         }
+                         auto verifyStart = std::chrono::steady_clock::now();
+                         completion.status = authenticator->verifyPassword(*secret, *user);
+                         completion.verifyMicros = static_cast<uint64_t>(
+                             std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - verifyStart).count());
+                         wipe(*secret);
+                         if (completion.status != UserErrorCode::SUCCESS)
+                         {
+                             wipe(*newSecret);
+                             postCompletion(completion);
+                             return;
+                         }
+                         if (completion.operation == AuthProtocol::OPERATION_AUTHENTICATE)
+                         {
+                             executor->submit([this, completion, user]() mutable
+                                              {
+                                                  completion.status = authenticator->checkPasswordExpiration(*user);
+                                                  postCompletion(completion);
+                                              });
+                             return;
+                         }
+                         // Смена пароля допускается и после истечения срока старого; новый пароль тоже хешируется
+                         completion.cancelled = cancellation.reason();
+                         if (completion.cancelled != CancelReason::NONE)
+                         {
+                             wipe(*newSecret);
+                             completion.status = UserErrorCode::DEADLINE_EXCEEDED;
+                             postCompletion(completion);
+                             return;
+                         }
+                         startTask(editor->editPasswordAsync(user->login, *newSecret, AsyncStages{&loopExecutor, executor.get()}),
+                                   [this, completion](ConfiguratorErrorCode code) mutable
+                                   {
+                                       completion.status = toUserErrorCode(code);
+                                       postCompletion(completion);
+                                   });
+                         wipe(*newSecret);
+                     });
+}
+
+// Проверка роли пользователя сессии: таблица сессий и поиск пользователя, без исполнителя
+void AuthServer::processRoleCheck(uint64_t id, const AuthProtocol::Request &request)
+{
+    AuthProtocol::AuthResponse response;
+    response.requestId = request.id;
+    std::string login;
+    if (!sessions->validate(request.token, nowSeconds(), login))
+    {
+        response.status = UserErrorCode::SESSION_EXPIRED;
+        queueResponse(id, response);
+        return;
+    }
+
+    UserData userData;
+    response.status = authenticator->findUser(login, userData, requestArena.resource());
+    requestArena.reset();
+    if (response.status == UserErrorCode::SUCCESS)
+    {
+        UserRole role = static_cast<UserRole>(request.role);
+        bool granted = std::find(userData.roles.begin(), userData.roles.end(), role) != userData.roles.end();
+        response.status = granted ? UserErrorCode::SUCCESS : UserErrorCode::ROLE_NOT_GRANTED;
+    }
+    queueResponse(id, response);
+}
+
+// Постановка задачи в поток цикла; вызывается из потоков исполнителя
+void AuthServer::LoopExecutor::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(server.loopMutex);
+        server.loopTasks.push_back(std::move(task));
+    }
+    uint64_t one = 1;
+    ssize_t unused = write(server.wakeFd, &one, sizeof(one));
+    (void)unused;
+}
+
+// Выполнение задач, переданных в поток цикла
+void AuthServer::runLoopTasks()
+{
+    std::vector<std::function<void()>> ready;
+    {
+        std::lock_guard<std::mutex> lock(loopMutex);
+        ready.swap(loopTasks);
+    }
+    for (std::function<void()> &task : ready)
+    {
+        task();
+    }
+}
+
+// Передача результата запроса циклу событий; вызывается из потоков исполнителя
+void AuthServer::postCompletion(const Completion &completion)
+{
+    loopExecutor.submit([this, completion]
+                        { finishRequest(completion); });
+}
+
+// Ответ на запрос, проверенный в исполнителе
+void AuthServer::finishRequest(const Completion &completion)
+{
+    --requestsInFlight;
+    loadShedder.finished(completion.verifyMicros);
+    if (completion.verifyMicros > 0)
+    {
+        verifiedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (completion.cancelled == CancelReason::DEADLINE)
+    {
+        cancelledDeadlineCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (completion.cancelled == CancelReason::DISCONNECTED)
+    {
+        cancelledDisconnectedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto it = connections.find(completion.connection);
+    if (it == connections.end())
+    {
+        return; // Соединение закрыто, пока шла проверка
+    }
+    Connection &connection = it->second;
+    --connection.inFlight;
+    if (connection.closeAfterWrite)
+    {
+        return; // Попытки исчерпаны ответом на более ранний запрос
+    }
+
+    unsigned maxFailedAttempts = 0;
+    authenticator->getMaxFailedAttempts(maxFailedAttempts);
+    if (completion.status == UserErrorCode::WRONG_PASSWORD)
+    {
+        ++connection.failedAttempts;
+    }
+    else if (completion.status == UserErrorCode::SUCCESS)
+    {
+        connection.failedAttempts = 0;
+    }
+
+    AuthProtocol::AuthResponse response;
+    response.requestId = completion.requestId;
+    response.status = completion.status;
+    response.attemptsLeft = maxFailedAttempts > connection.failedAttempts ? maxFailedAttempts - connection.failedAttempts : 0;
+    if (completion.status == UserErrorCode::WRONG_PASSWORD && response.attemptsLeft == 0)
+    {
+        connection.closeAfterWrite = true;
+    }
+
+    // Сессия создается только при входе и доступном параметре maxInactiveTimeMin
+    unsigned maxInactiveTimeMin;
+    if (completion.status == UserErrorCode::SUCCESS && completion.operation == AuthProtocol::OPERATION_AUTHENTICATE &&
+        authenticator->getMaxInactiveTimeMin(maxInactiveTimeMin) == UserErrorCode::SUCCESS)
+    {
+        response.sessionToken = sessions->create(completion.login, static_cast<int64_t>(maxInactiveTimeMin) * 60, nowSeconds());
+    }
+
+    queueResponse(completion.connection, response);
+    // Разбор мог быть приостановлен на пределе maxInFlight
+    processRequests(completion.connection);
+}
+
+// Продолжение или завершение сессии: только обращение к таблице сессий, без исполнителя
+void AuthServer::processSessionRequest(uint64_t id, const AuthProtocol::Request &request)
+{
+    AuthProtocol::AuthResponse response;
+    response.requestId = request.id;
+    bool found;
+    if (request.operation == AuthProtocol::OPERATION_RESUME_SESSION)
+    {
+        std::string login;
+        found = sessions->validate(request.token, nowSeconds(), login);
+    }
+    else
+    {
+        found = sessions->revoke(request.token);
+    }
+    response.status = found ? UserErrorCode::SUCCESS : UserErrorCode::SESSION_EXPIRED;
+    queueResponse(id, response);
+}
+
+// Ответ на запрос в формате протокола соединения
+void AuthServer::queueResponse(uint64_t id, const AuthProtocol::AuthResponse &response)
+{
+    if (!connections.at(id).http)
+    {
+        std::string frame;
+        AuthProtocol::appendResponse(frame, response);
+        queueFrame(id, std::move(frame));
+        return;
+    }
+
+    std::string body;
+    body.reserve(96);
+    body += "{\"status\":";
+    HttpProtocol::appendJsonString(body, HttpProtocol::statusName(response.status));
+    body += ",\"attemptsLeft\":";
+    body += std::to_string(response.attemptsLeft);
+    if (response.retryAfterMs > 0)
+    {
+        body += ",\"retryAfterMs\":";
+        body += std::to_string(response.retryAfterMs);
+    }
+    if (!response.sessionToken.empty())
+    {
+        body += ",\"sessionToken\":";
+        HttpProtocol::appendJsonString(body, SessionManager::tokenToHex(response.sessionToken));
+    }
+    body += '}';
+    queueHttpResponse(id, HttpProtocol::statusCode(response.status), body, (response.retryAfterMs + 999) / 1000);
+}
+
+// Ответ HTTP; после ответа на запрос с Connection: close или на последнюю попытку соединение закрывается
+void AuthServer::queueHttpResponse(uint64_t id, unsigned statusCode, std::string_view body, unsigned retryAfterSeconds)
+{
+    Connection &connection = connections.at(id);
+    bool keepAlive = connection.httpKeepAlive && !connection.closeAfterWrite;
+    std::string frame;
+    HttpProtocol::appendResponse(frame, statusCode, body, keepAlive, retryAfterSeconds);
+    connection.closeAfterWrite = !keepAlive;
+    queueFrame(id, std::move(frame));
+}
+
+// Ответ ставится в очередь соединения и отправляется в конце прохода цикла вместе с остальными
+void AuthServer::queueFrame(uint64_t id, std::string frame)
+{
+    Connection &connection = connections.at(id);
+    connection.out.push_back(std::move(frame));
+    if (!connection.flushQueued)
+    {
+        connection.flushQueued = true;
+        flushList.push_back(id);
+    }
+}
+
+// Отправка ответов, накопленных за проход цикла
+void AuthServer::flushConnections()
+{
+    std::vector<uint64_t> ready;
+    ready.swap(flushList);
+    for (uint64_t id : ready)
+    {
+        auto it = connections.find(id);
+        if (it != connections.end())
+        {
+            it->second.flushQueued = false;
+            flushConnection(id);
+        }
+    }
+}
+
+// Отправка накопленных ответов: кадры передаются одним sendmsg (writev с MSG_NOSIGNAL) без склейки
+// в общий буфер; остаток ждет EPOLLOUT
+void AuthServer::flushConnection(uint64_t id)
+{
+    Connection &connection = connections.at(id);
+    while (!connection.out.empty())
+    {
+        struct iovec vectors[64];
+        size_t count = 0;
+        for (auto frame = connection.out.begin(); frame != connection.out.end() && count < 64; ++frame, ++count)
+        {
+            size_t offset = count == 0 ? connection.outOffset : 0;
+            vectors[count].iov_base = &(*frame)[offset];
+            vectors[count].iov_len = frame->size() - offset;
+        }
+        struct msghdr message = {};
+        message.msg_iov = vectors;
+        message.msg_iovlen = count;
+        ssize_t result = sendmsg(connection.fd, &message, MSG_NOSIGNAL);
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        if (result <= 0)
+        {
+            closeConnection(id);
+            return;
+        }
+
+        // Отправленные кадры удаляются, от частично отправленного запоминается смещение
+        size_t sent = static_cast<size_t>(result);
+        while (sent > 0)
+        {
+            size_t left = connection.out.front().size() - connection.outOffset;
+            if (sent < left)
+            {
+                connection.outOffset += sent;
+                break;
+            }
+            sent -= left;
+            connection.out.pop_front();
+            connection.outOffset = 0;
+        }
+    }
+
+    if (connection.out.empty() && connection.closeAfterWrite)
+    {
+        closeConnection(id);
+        return;
+    }
+
+    // Подписка на EPOLLOUT меняется только при появлении или исчезновении остатка
+    bool waitWritable = !connection.out.empty();
+    if (waitWritable != connection.waitingWritable)
+    {
+        struct epoll_event event = {};
+        event.events = waitWritable ? EPOLLIN | EPOLLOUT : EPOLLIN;
+        event.data.u64 = id;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.waitingWritable = waitWritable;
+    }
+}
+
+void AuthServer::closeConnection(uint64_t id)
+{
+    auto it = connections.find(id);
+    if (it == connections.end())
+    {
+        return;
+    }
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+    close(it->second.fd);
+    // Запросы соединения, еще стоящие в исполнителе, не будут хешироваться
+    it->second.cancellation.cancel();
+    connections.erase(it);
+}
+
+AuthServer::~AuthServer()
+{
+    // Цикл уже остановлен: запросы в исполнителе, в том числе смены пароля с этапами в потоке цикла,
+    // доводятся до конца здесь, затем исполнитель останавливается
+    while (requestsInFlight > 0)
+    {
+        struct pollfd wake = {wakeFd, POLLIN, 0};
+        poll(&wake, 1, 100);
+        uint64_t value;
+        ssize_t unused = read(wakeFd, &value, sizeof(value));
+        (void)unused;
+        runLoopTasks();
+    }
+    executor.reset();
+
+    for (auto &[id, connection] : connections)
+    {
+        close(connection.fd);
+    }
+    const int fds[] = {listenFd, httpListenFd, tcpListenFd, epollFd, wakeFd, stopFd};
+    for (int fd : fds)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+    if (listenFd >= 0)
+    {
+        unlink(options.socketPath.c_str());
+    }
+}
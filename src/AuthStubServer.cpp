@@ -0,0 +1,293 @@
+// src/AuthStubServer.cpp
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+#include "AuthStubServer.hpp"
+
+AuthStubServer::AuthStubServer(const std::string &path, bool acceptTcp)
+    : socketPath(path), tcp(acceptTcp), boundTcpPort(0), listenFd(-1), tcpListenFd(-1), stopFd(-1), nextToken(1),
+      dropRequested(false), requestCount(0), acceptedCount(0), maxBatch(0)
+{
+}
+
+// Создание сокетов и запуск потока; существующий файл сокета заменяется
+ConfiguratorErrorCode AuthStubServer::start()
+{
+    struct sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path) || loop.joinable())
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (stopFd < 0 || listenFd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    unlink(socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0 || listen(listenFd, SOMAXCONN) != 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    if (tcp)
+    {
+        struct sockaddr_in tcpAddress = {};
+        tcpAddress.sin_family = AF_INET;
+        tcpAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(tcpAddress);
+        tcpListenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (tcpListenFd < 0 || bind(tcpListenFd, reinterpret_cast<struct sockaddr *>(&tcpAddress), sizeof(tcpAddress)) != 0 ||
+            listen(tcpListenFd, SOMAXCONN) != 0 ||
+            getsockname(tcpListenFd, reinterpret_cast<struct sockaddr *>(&tcpAddress), &length) != 0)
+        {
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+        boundTcpPort = ntohs(tcpAddress.sin_port);
+    }
+    loop = std::thread(&AuthStubServer::run, this);
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+uint16_t AuthStubServer::tcpPort() const
+{
+    return boundTcpPort;
+}
+
+void AuthStubServer::addUser(const std::string &login, const std::string &password)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    passwords[login] = password;
+}
+
+void AuthStubServer::setHandler(Handler requestHandler)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    handler = std::move(requestHandler);
+}
+
+void AuthStubServer::dropConnections()
+{
+    dropRequested = true;
+    uint64_t one = 1;
+    ssize_t unused = write(stopFd, &one, sizeof(one));
+    (void)unused;
+}
+
+// Поведение по умолчанию; вызывается под mutex
+bool AuthStubServer::answer(const AuthProtocol::Request &request, AuthProtocol::AuthResponse &response)
+{
+    response.attemptsLeft = 3;
+    switch (request.operation)
+    {
+    case AuthProtocol::OPERATION_AUTHENTICATE:
+    case AuthProtocol::OPERATION_CHANGE_PASSWORD:
+    {
+        auto user = passwords.find(request.login);
+        if (user == passwords.end())
+        {
+            response.status = UserErrorCode::LOGIN_NOT_EXISTS;
+        }
+        else if (user->second != request.password)
+        {
+            response.status = UserErrorCode::WRONG_PASSWORD;
+        }
+        else if (request.operation == AuthProtocol::OPERATION_CHANGE_PASSWORD)
+        {
+            user->second = request.newPassword;
+            response.status = UserErrorCode::SUCCESS;
+        }
+        else
+        {
+            response.sessionToken = "stub-session-" + std::to_string(nextToken++);
+            sessions[response.sessionToken] = request.login;
+            response.status = UserErrorCode::SUCCESS;
+        }
+        break;
+    }
+    case AuthProtocol::OPERATION_END_SESSION:
+        response.status = sessions.erase(request.token) > 0 ? UserErrorCode::SUCCESS : UserErrorCode::SESSION_EXPIRED;
+        break;
+    default:
+        response.status = sessions.count(request.token) > 0 ? UserErrorCode::SUCCESS : UserErrorCode::SESSION_EXPIRED;
+    }
+    return true;
+}
+
+// Цикл poll: соединений немного, ответы короткие и отправляются блокирующим send
+void AuthStubServer::run()
+{
+    struct Client
+    {
+        int fd;
+        std::string in;
+    };
+    std::vector<Client> clients;
+    while (true)
+    {
+        std::vector<struct pollfd> polled = {{stopFd, POLLIN, 0}, {listenFd, POLLIN, 0}, {tcpListenFd, POLLIN, 0}};
+        for (const Client &client : clients)
+        {
+            polled.push_back({client.fd, POLLIN, 0});
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        if (polled[0].revents & POLLIN)
+        {
+            uint64_t value;
+            ssize_t unused = read(stopFd, &value, sizeof(value));
+            (void)unused;
+            if (!dropRequested.exchange(false))
+            {
+                break;
+            }
+            for (Client &client : clients)
+            {
+                close(client.fd);
+            }
+            clients.clear();
+            continue;
+        }
+        for (size_t listener = 1; listener <= 2; ++listener)
+        {
+            if (polled[listener].revents & POLLIN)
+            {
+                int fd;
+                while ((fd = accept4(polled[listener].fd, nullptr, nullptr, SOCK_CLOEXEC)) >= 0)
+                {
+                    clients.push_back({fd, std::string()});
+                    acceptedCount.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        std::vector<int> closed;
+        for (size_t i = 3; i < polled.size(); ++i)
+        {
+            if (polled[i].revents == 0)
+            {
+                continue;
+            }
+            Client &client = clients[i - 3];
+            char buffer[16384];
+            ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+            if (received <= 0)
+            {
+                closed.push_back(client.fd);
+                continue;
+            }
+            client.in.append(buffer, static_cast<size_t>(received));
+
+            size_t pos = 0;
+            size_t batch = 0;
+            std::string out;
+            bool keep = true;
+            AuthProtocol::Request request;
+            AuthProtocol::FrameStatus status;
+            while (keep && (status = AuthProtocol::extractRequest(client.in, pos, request)) == AuthProtocol::FrameStatus::COMPLETE)
+            {
+                ++batch;
+                requestCount.fetch_add(1, std::memory_order_relaxed);
+                AuthProtocol::AuthResponse response;
+                response.requestId = request.id;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    keep = handler ? handler(request, response) : answer(request, response);
+                }
+                if (keep)
+                {
+                    AuthProtocol::appendResponse(out, response);
+                }
+            }
+            client.in.erase(0, pos);
+            size_t largest = maxBatch.load(std::memory_order_relaxed);
+            if (batch > largest)
+            {
+                maxBatch.store(batch, std::memory_order_relaxed);
+            }
+            if (!out.empty() && send(client.fd, out.data(), out.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(out.size()))
+            {
+                keep = false;
+            }
+            if (!keep || (status != AuthProtocol::FrameStatus::COMPLETE && status != AuthProtocol::FrameStatus::INCOMPLETE))
+            {
+                closed.push_back(client.fd);
+            }
+        }
+        for (int fd : closed)
+        {
+            close(fd);
+            clients.erase(std::find_if(clients.begin(), clients.end(), [fd](const Client &client)
+                                       { return client.fd == fd; }));
+        }
+    }
+    for (Client &client : clients)
+    {
+        close(client.fd);
+    }
+}
+
+uint64_t AuthStubServer::requests() const
+{
+    return requestCount.load(std::memory_order_relaxed);
+}
+
+uint64_t AuthStubServer::acceptedConnections() const
+{
+    return acceptedCount.load(std::memory_order_relaxed);
+}
+
+size_t AuthStubServer::largestBatch() const
+{
+    return maxBatch.load(std::memory_order_relaxed);
+}
+
+// Остановка потока и закрытие сокетов
+void AuthStubServer::stop()
+{
+    if (loop.joinable())
+    {
+        dropRequested = false;
+        uint64_t one = 1;
+        ssize_t unused = write(stopFd, &one, sizeof(one));
+        (void)unused;
+        loop.join();
+    }
+    const int fds[] = {listenFd, tcpListenFd, stopFd};
+    for (int fd : fds)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+    listenFd = tcpListenFd = stopFd = -1;
+    if (!socketPath.empty())
+    {
+        unlink(socketPath.c_str());
+    }
+}
+
+AuthStubServer::~AuthStubServer()
+{
+    stop();
+}
@@ -0,0 +1,167 @@
+// src/AuthSupervisor.cpp
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include "AuthSupervisor.hpp"
+
+// Время запуска процессов в миллисекундах монотонных часов
+static int64_t nowMilliseconds()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+AuthSupervisor::AuthSupervisor(const AuthSupervisorOptions &supervisorOptions) : options(supervisorOptions), listenFd(-1)
+{
+    if (options.processes == 0)
+    {
+        options.processes = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+    }
+    // Остановка может быть запрошена до run()
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+// Создание слушающего сокета; существующий файл сокета заменяется
+ConfiguratorErrorCode AuthSupervisor::listen()
+{
+    struct sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (options.socketPath.size() >= sizeof(address.sun_path) || stopFd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    std::memcpy(address.sun_path, options.socketPath.c_str(), options.socketPath.size() + 1);
+
+    listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    unlink(options.socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Слушающий сокет для рабочих процессов
+int AuthSupervisor::socket() const
+{
+    return listenFd;
+}
+
+// Число рабочих процессов
+size_t AuthSupervisor::processes() const
+{
+    return options.processes;
+}
+
+// Запуск процесса с номером index; в дочернем процессе вызывает worker и завершается
+void AuthSupervisor::spawn(size_t index, const std::function<int(size_t)> &worker)
+{
+    startedAt[index] = nowMilliseconds();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        // Сигналы остановки завершают дочерний процесс, пока worker не установит свои обработчики;
+        // флаг остановки родителя дочернему процессу не нужен
+        std::signal(SIGTERM, SIG_DFL);
+        std::signal(SIGINT, SIG_DFL);
+        close(stopFd);
+        stopFd = -1;
+        _exit(worker(index));
+    }
+    // При ошибке fork процесс запускается снова через restartDelayMs
+    workers[index] = pid > 0 ? pid : 0;
+}
+
+// Запуск процессов и наблюдение за ними до stop()
+void AuthSupervisor::run(const std::function<int(size_t)> &worker)
+{
+    workers.assign(options.processes, 0);
+    startedAt.assign(options.processes, 0);
+    for (size_t i = 0; i < options.processes; ++i)
+    {
+        spawn(i, worker);
+    }
+
+    while (true)
+    {
+        struct pollfd stopEvent = {stopFd, POLLIN, 0};
+        int ready = poll(&stopEvent, 1, 100);
+        if (ready > 0)
+        {
+            break;
+        }
+        if (ready < 0 && errno != EINTR)
+        {
+            break;
+        }
+
+        // Завершившиеся процессы перезапускаются; упавший сразу после запуска — не раньше restartDelayMs
+        int64_t now = nowMilliseconds();
+        for (size_t i = 0; i < workers.size(); ++i)
+        {
+            int status;
+            if (workers[i] > 0 && waitpid(workers[i], &status, WNOHANG) == workers[i])
+            {
+                workers[i] = 0;
+            }
+            if (workers[i] == 0 && now - startedAt[i] >= static_cast<int64_t>(options.restartDelayMs))
+            {
+                spawn(i, worker);
+            }
+        }
+    }
+
+    for (pid_t pid : workers)
+    {
+        if (pid > 0)
+        {
+            kill(pid, SIGTERM);
+        }
+    }
+    for (pid_t pid : workers)
+    {
+        int status;
+        while (pid > 0 && waitpid(pid, &status, 0) < 0 && errno == EINTR)
+        {
+        }
+    }
+    workers.clear();
+    uint64_t value;
+    ssize_t unused = read(stopFd, &value, sizeof(value));
+    (void)unused;
+}
+
+// Остановка; безопасна в обработчике сигнала
+void AuthSupervisor::stop()
+{
+    uint64_t one = 1;
+    ssize_t unused = write(stopFd, &one, sizeof(one));
+    (void)unused;
+}
+
+AuthSupervisor::~AuthSupervisor()
+{
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        unlink(options.socketPath.c_str());
+    }
+    if (stopFd >= 0)
+    {
+        close(stopFd);
+    }
+}
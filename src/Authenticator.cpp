@@ -0,0 +1,337 @@
+// src/Authenticator.cpp
+
+#include <charconv>
+#include <cstring>
+#include <ctime>
+
+#include "Authenticator.hpp"
+
+Authenticator::Authenticator(ConfiguratorDatabaseInterface *database, SecurityConfigInterface *securityConfig, HashingInterface *hash,
+                             LockoutTable *lockoutTable)
+    : db(database), config(securityConfig), hasher(hash), lockout(lockoutTable)
+{
+}
+
+// Поиск активного пользователя и разбор его данных (логин, хеш пароля, дата смены пароля, роли)
+UserErrorCode Authenticator::findUser(const std::string &login, UserData &userData, std::pmr::memory_resource *arena)
+{
+    std::pmr::string strUserData(arena);
+    ConfiguratorErrorCode code = db->getActiveUserRecord(login, strUserData);
+    switch (code)
+    {
+    case ConfiguratorErrorCode::SUCCESS:
+        return parseUserData(strUserData, userData);
+    case ConfiguratorErrorCode::LOGIN_NOT_FOUND:
+        return UserErrorCode::LOGIN_NOT_EXISTS;
+    default:
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+}
+
+// Очередное слово строки, разделенной пробельными символами; пустое, если слов не осталось
+static std::string_view nextField(std::string_view &rest)
+{
+    const char *spaces = " \t\r\n\v\f";
+    size_t begin = rest.find_first_not_of(spaces);
+    if (begin == std::string_view::npos)
+    {
+        rest = std::string_view();
+        return rest;
+    }
+    size_t end = rest.find_first_of(spaces, begin);
+    std::string_view field = rest.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+    rest.remove_prefix(end == std::string_view::npos ? rest.size() : end);
+    return field;
+}
+
+// Разбор без потоков и временных строк: поля присваиваются в строки userData, сохраняя их емкость
+UserErrorCode Authenticator::parseUserData(std::string_view strUserData, UserData &userData)
+{
+    std::string_view rest = strUserData;
+    userData.roles.clear();
+
+    // Логин
+    std::string_view field = nextField(rest);
+    if (field.empty())
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+    userData.login.assign(field);
+
+    // Хеш пароля
+    field = nextField(rest);
+    if (field.empty())
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+    userData.passwordHash.assign(field);
+
+    // Дата
+    field = nextField(rest);
+    if (field.empty())
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+    userData.date.assign(field);
+
+    // Роли
+    std::string_view rolesString = nextField(rest);
+    if (rolesString.empty())
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+
+    // Парсим роли через запятую; завершающая запятая пустой роли не дает
+    while (!rolesString.empty())
+    {
+        size_t comma = rolesString.find(',');
+        std::string_view roleStr = rolesString.substr(0, comma);
+        rolesString.remove_prefix(comma == std::string_view::npos ? rolesString.size() : comma + 1);
+        if (roleStr.empty())
+        {
+            return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+        }
+
+        // Сконвертировать строку роли в число
+        int roleNumber = 0;
+        for (char ch : roleStr)
+        {
+            roleNumber = roleNumber * 10 + (ch - '0');
+        }
+
+        userData.roles.push_back(static_cast<UserRole>(roleNumber));
+    }
+
+    if (userData.roles.empty())
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+
+    return UserErrorCode::SUCCESS;
+}
+
+// Разбор записи активного пользователя, найденной не через базу (PartitionedUserTable)
+UserErrorCode Authenticator::userFromRecord(std::string_view record, UserData &userData)
+{
+    return parseUserData(record, userData);
+}
+
+// Проверка блокировки логина после неудачных попыток; не требует хеширования
+UserErrorCode Authenticator::checkLockout(const std::string &login) const
+{
+    int64_t lockedUntil;
+    if (lockout != nullptr && lockout->isLocked(login, static_cast<int64_t>(std::time(nullptr)), lockedUntil))
+    {
+        return UserErrorCode::ACCOUNT_LOCKED;
+    }
+    return UserErrorCode::SUCCESS;
+}
+
+// Проверка пароля; вызывается из нескольких потоков, если хешер это допускает
+UserErrorCode Authenticator::verifyPassword(const std::string &password, const UserData &userData) const
+{
+    if (checkLockout(userData.login) != UserErrorCode::SUCCESS)
+    {
+        return UserErrorCode::ACCOUNT_LOCKED;
+    }
+
+    ConfiguratorErrorCode code = hasher->pwHashVerify(password, userData.passwordHash);
+    if (code == ConfiguratorErrorCode::SUCCESS)
+    {
+        if (lockout != nullptr)
+        {
+            lockout->recordSuccess(userData.login);
+        }
+        return UserErrorCode::SUCCESS;
+    }
+
+    // Без обоих параметров в конфигурации блокировка не применяется
+    unsigned maxFailedAttempts;
+    unsigned lockoutTimeMin;
+    if (lockout != nullptr &&
+        config->get_maxFailedAttempts(maxFailedAttempts) == ConfiguratorErrorCode::SUCCESS &&
+        config->get_lockoutTimeMin(lockoutTimeMin) == ConfiguratorErrorCode::SUCCESS)
+    {
+        lockout->recordFailure(userData.login, maxFailedAttempts, static_cast<int64_t>(lockoutTimeMin) * 60,
+                               static_cast<int64_t>(std::time(nullptr)));
+    }
+    return UserErrorCode::WRONG_PASSWORD;
+}
+
+// Проверка, не истек ли срок действия пароля
+UserErrorCode Authenticator::checkPasswordExpiration(const UserData &userData) const
+{
+    unsigned passwordExpirationDays;
+    ConfiguratorErrorCode configuratorCode = config->get_passwordExpirationDays(passwordExpirationDays);
+    if (configuratorCode != ConfiguratorErrorCode::SUCCESS)
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+
+    int daysDifference;
+    UserErrorCode code = differenceInDays(userData.date, daysDifference);
+    if (code != UserErrorCode::SUCCESS)
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+
+    // differenceInDays не возвращает отрицательную разницу
+    if (static_cast<unsigned>(daysDifference) > passwordExpirationDays)
+    {
+        return UserErrorCode::PASSWORD_HAS_EXPIRED;
+    }
+
+    return UserErrorCode::SUCCESS;
+}
+
+// Вход целиком: поиск и проверка блокировки — исполнителем базы, проверка пароля и срока его
+// действия — исполнителем хеширования. Пароль затирается сразу после проверки
+Task<UserErrorCode> Authenticator::authenticateAsync(std::string login, std::string password, UserData &userData, AsyncStages stages)
+{
+    co_await ResumeOn(stages.database);
+    UserErrorCode code = findUser(login, userData);
+    if (code == UserErrorCode::SUCCESS)
+    {
+        code = checkLockout(userData.login);
+    }
+    if (code != UserErrorCode::SUCCESS)
+    {
+        std::memset(&password[0], 0, password.size());
+        co_return code;
+    }
+
+    co_await ResumeOn(stages.hashing);
+    code = verifyPassword(password, userData);
+    std::memset(&password[0], 0, password.size());
+    if (code != UserErrorCode::SUCCESS)
+    {
+        co_return code;
+    }
+    co_return checkPasswordExpiration(userData);
+}
+
+// Вход целиком в текущем потоке (ожидание authenticateAsync)
+UserErrorCode Authenticator::authenticate(const std::string &login, const std::string &password, UserData &userData)
+{
+    return syncWait(authenticateAsync(login, password, userData));
+}
+
+// Максимальное число попыток ввода пароля
+UserErrorCode Authenticator::getMaxFailedAttempts(unsigned &attempts) const
+{
+    if (config->get_maxFailedAttempts(attempts) != ConfiguratorErrorCode::SUCCESS)
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+    return UserErrorCode::SUCCESS;
+}
+
+// Допустимое время бездействия сессии в минутах
+UserErrorCode Authenticator::getMaxInactiveTimeMin(unsigned &minutes) const
+{
+    if (config->get_maxInactiveTimeMin(minutes) != ConfiguratorErrorCode::SUCCESS)
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+    return UserErrorCode::SUCCESS;
+}
+
+// Проверка, високосный ли год
+bool Authenticator::isLeapYear(int year)
+{
+    return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
+}
+
+// Количество дней в каждом месяце
+unsigned Authenticator::getDaysInMonth(int month, int year)
+{
+    static const unsigned daysInMonth[] = {
+        31, 28, 31, 30, 31, 30,
+        31, 31, 30, 31, 30, 31};
+    if (month == 2 && isLeapYear(year))
+    {
+        return 29;
+    }
+    return daysInMonth[month - 1];
+}
+
+// Парсинг даты вида ДД.ММ.ГГГГ
+UserErrorCode Authenticator::parseDate(std::string_view dateStr, unsigned &day, unsigned &month, unsigned &year)
+{
+    const char *pos = dateStr.data();
+    const char *end = dateStr.data() + dateStr.size();
+    unsigned *parts[] = {&day, &month, &year};
+    for (size_t i = 0; i < 3; ++i)
+    {
+        // Части разделены точками
+        if (i > 0)
+        {
+            if (pos == end || *pos != '.')
+            {
+                return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+            }
+            ++pos;
+        }
+        std::from_chars_result parsed = std::from_chars(pos, end, *parts[i]);
+        if (parsed.ec != std::errc())
+        {
+            return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+        }
+        pos = parsed.ptr;
+    }
+    if (day < 1 || day > 31 || month < 1 || month > 12)
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+    return UserErrorCode::SUCCESS;
+}
+
+// Преобразование даты в количество дней с начала отсчета
+unsigned Authenticator::daysFromEpoch(unsigned day, unsigned month, unsigned year)
+{
+    unsigned days = day;
+
+    // Дни в прошедших месяцах текущего года
+    for (unsigned m = 1; m < month; ++m)
+    {
+        days += getDaysInMonth(m, year);
+    }
+
+    // Дни в прошедших годах
+    for (unsigned y = 0; y < year; ++y)
+    {
+        days += isLeapYear(y) ? 366 : 365;
+    }
+
+    return days;
+}
+
+// Разница в днях между двумя датами
+UserErrorCode Authenticator::differenceInDays(std::string_view userDateStr, int &difference)
+{
+    unsigned userDay, userMonth, userYear;
+    UserErrorCode code = parseDate(userDateStr, userDay, userMonth, userYear);
+    if (code != UserErrorCode::SUCCESS)
+    {
+        return code;
+    }
+
+    // Текущая дата (localtime_r: метод вызывается из нескольких потоков сервера)
+    std::time_t t = std::time(nullptr);
+    std::tm now;
+    localtime_r(&t, &now);
+    int currentDay = now.tm_mday;
+    int currentMonth = now.tm_mon + 1;
+    int currentYear = now.tm_year + 1900;
+
+    int userDays = daysFromEpoch(userDay, userMonth, userYear);
+    int currentDays = daysFromEpoch(currentDay, currentMonth, currentYear);
+
+    difference = currentDays - userDays;
+    if (difference < 0)
+    {
+        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+
+    return UserErrorCode::SUCCESS;
+}
@@ -0,0 +1,376 @@
+// src/BatchAuthenticator.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BatchAuthenticator.hpp"
+#include "HashingWorkerPool.hpp"
+#include "RequestArena.hpp"
+#include "SpscQueue.hpp"
+
+// Результат записи; заполняется в пуле до готовности future
+struct BatchOutcome
+{
+    UserErrorCode status = UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    std::chrono::steady_clock::time_point finished;
+};
+
+// Запись, ожидающая вывода
+struct BatchRecord
+{
+    std::string login;
+    std::chrono::steady_clock::time_point started;
+    std::shared_ptr<BatchOutcome> outcome;
+    std::future<ConfiguratorErrorCode> done; // Не задан, если результат известен без пула
+};
+
+// Запись, переданная потоку ядра в режиме «поток на ядро»
+struct BatchCoreJob
+{
+    std::string login;
+    std::shared_ptr<std::string> password;
+    std::shared_ptr<BatchOutcome> outcome;
+    std::shared_ptr<std::promise<ConfiguratorErrorCode>> done;
+};
+
+// Потоки ядер PartitionedUserTable: каждый берет записи из своей очереди от читающего потока, ищет логин
+// в таблице (чужой раздел отвечает через poll) и проверяет найденного пользователя сам
+class BatchCoreThreads
+{
+    static constexpr size_t QUEUE_CAPACITY = 256;
+    static constexpr size_t JOBS_PER_POLL = 64;
+
+    PartitionedUserTable &table;
+    Authenticator *authenticator;
+    std::vector<std::unique_ptr<SpscQueue<BatchCoreJob>>> queues; // От читающего потока к ядру
+    std::vector<std::thread> threads;
+    std::atomic<bool> stopping{false};
+    size_t next = 0; // Ядро для следующей записи
+
+    // Завершение записи по результату поиска в таблице
+    void complete(BatchCoreJob &job, ConfiguratorErrorCode code, const std::string *record)
+    {
+        UserErrorCode status;
+        UserData userData;
+        if (code == ConfiguratorErrorCode::LOGIN_NOT_FOUND)
+        {
+            status = UserErrorCode::LOGIN_NOT_EXISTS;
+        }
+        else if (code != ConfiguratorErrorCode::SUCCESS || record == nullptr)
+        {
+            status = UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+        }
+        else
+        {
+            status = Authenticator::userFromRecord(*record, userData);
+        }
+        if (status == UserErrorCode::SUCCESS)
+        {
+            status = authenticator->checkLockout(userData.login);
+        }
+        if (status == UserErrorCode::SUCCESS)
+        {
+            status = authenticator->verifyPassword(*job.password, userData);
+        }
+        std::memset(&(*job.password)[0], 0, job.password->size());
+        if (status == UserErrorCode::SUCCESS)
+        {
+            status = authenticator->checkPasswordExpiration(userData);
+        }
+        job.outcome->status = status;
+        job.outcome->finished = std::chrono::steady_clock::now();
+        job.done->set_value(ConfiguratorErrorCode::SUCCESS);
+    }
+
+    // Цикл потока ядра core: до остановки обслуживает таблицу и свою очередь
+    void loop(size_t core)
+    {
+        BatchCoreJob job;
+        while (!stopping.load(std::memory_order_acquire))
+        {
+            size_t handled = table.poll(core);
+            for (size_t i = 0; i < JOBS_PER_POLL && queues[core]->tryPop(job); ++i, ++handled)
+            {
+                std::shared_ptr<BatchCoreJob> pending = std::make_shared<BatchCoreJob>(std::move(job));
+                table.lookup(core, pending->login, [this, pending](ConfiguratorErrorCode code, const std::string *record)
+                             { complete(*pending, code, record); });
+            }
+            if (handled == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    BatchCoreThreads(PartitionedUserTable &userTable, Authenticator *auth) : table(userTable), authenticator(auth)
+    {
+        for (size_t core = 0; core < table.cores(); ++core)
+        {
+            queues.push_back(std::make_unique<SpscQueue<BatchCoreJob>>(QUEUE_CAPACITY));
+        }
+        for (size_t core = 0; core < table.cores(); ++core)
+        {
+            threads.emplace_back([this, core]
+                                 { loop(core); });
+        }
+    }
+
+    BatchCoreThreads(const BatchCoreThreads &) = delete;
+    BatchCoreThreads &operator=(const BatchCoreThreads &) = delete;
+
+    // Передача записи очередному ядру по кругу; при заполненной очереди читающий поток ждет
+    std::future<ConfiguratorErrorCode> submit(const std::string &login, std::shared_ptr<std::string> password,
+                                              std::shared_ptr<BatchOutcome> outcome)
+    {
+        BatchCoreJob job{login, std::move(password), std::move(outcome), std::make_shared<std::promise<ConfiguratorErrorCode>>()};
+        std::future<ConfiguratorErrorCode> done = job.done->get_future();
+        size_t core = next;
+        next = (next + 1) % queues.size();
+        while (!queues[core]->tryPush(job))
+        {
+            std::this_thread::yield();
+        }
+        return done;
+    }
+
+    // Вызывается, когда все переданные записи завершены
+    ~BatchCoreThreads()
+    {
+        stopping.store(true, std::memory_order_release);
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+};
+
+// Значение процентиля p по возрастающему массиву (метод ближайшего ранга)
+static double percentile(const std::vector<double> &sorted, unsigned p)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    size_t rank = (sorted.size() * p + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+BatchAuthenticator::BatchAuthenticator(Authenticator *auth, HashingInterface *hash, const BatchAuthOptions &batchOptions)
+    : authenticator(auth), hasher(hash), options(batchOptions)
+{
+    if (options.workers == 0)
+    {
+        options.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (options.maxInFlight == 0)
+    {
+        options.maxInFlight = 4 * (options.userTable != nullptr ? options.userTable->cores() : options.workers);
+    }
+}
+
+// Обработка всех записей из in с выводом результатов в out
+BatchAuthReport BatchAuthenticator::run(std::istream &in, std::ostream &out)
+{
+    BatchAuthReport report;
+    std::vector<double> latencies;
+    std::deque<BatchRecord> window;
+
+    // Вывод самой старой записи после завершения ее проверки
+    auto retire = [&]()
+    {
+        BatchRecord &record = window.front();
+        if (record.done.valid())
+        {
+            record.done.wait();
+        }
+        std::chrono::duration<double, std::micro> latency = record.outcome->finished - record.started;
+        out << record.login << '\t' << resultName(record.outcome->status) << '\t'
+            << static_cast<long long>(latency.count()) << '\n';
+        latencies.push_back(latency.count());
+        ++report.counts[record.outcome->status];
+        ++report.records;
+        window.pop_front();
+    };
+
+    // Строки из базы разбираются в арене, которая освобождается после каждой записи
+    RequestArena requestArena;
+
+    HashingPoolOptions poolOptions;
+    poolOptions.workers = options.workers;
+    auto start = std::chrono::steady_clock::now();
+    {
+        // Пул потоков нужен, только если таблица по ядрам не задана
+        std::unique_ptr<HashingWorkerPool> pool;
+        std::unique_ptr<BatchCoreThreads> coreThreads;
+        if (options.userTable != nullptr)
+        {
+            coreThreads = std::make_unique<BatchCoreThreads>(*options.userTable, authenticator);
+        }
+        else
+        {
+            pool = std::make_unique<HashingWorkerPool>(hasher, poolOptions);
+        }
+
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+            if (line.empty())
+            {
+                continue;
+            }
+            if (window.size() >= options.maxInFlight)
+            {
+                retire();
+            }
+
+            BatchRecord record;
+            record.started = std::chrono::steady_clock::now();
+            record.outcome = std::make_shared<BatchOutcome>();
+
+            size_t tab = line.find('\t');
+            record.login = line.substr(0, tab);
+            std::shared_ptr<std::string> password = std::make_shared<std::string>();
+            if (tab != std::string::npos)
+            {
+                password->assign(line, tab + 1, std::string::npos);
+            }
+            std::memset(&line[0], 0, line.size());
+
+            UserData userData;
+            if (record.login.empty())
+            {
+                record.outcome->status = UserErrorCode::LOGIN_ENTERING_ERROR;
+            }
+            else if (password->empty())
+            {
+                record.outcome->status = UserErrorCode::PASSWORD_ENTERING_ERROR;
+            }
+            else if (coreThreads)
+            {
+                // Поиск пользователя и блокировки выполнит поток ядра
+                record.outcome->status = UserErrorCode::SUCCESS;
+            }
+            else
+            {
+                record.outcome->status = authenticator->findUser(record.login, userData, requestArena.resource());
+                requestArena.reset();
+                if (record.outcome->status == UserErrorCode::SUCCESS)
+                {
+                    record.outcome->status = authenticator->checkLockout(record.login);
+                }
+            }
+
+            if (record.outcome->status != UserErrorCode::SUCCESS)
+            {
+                record.outcome->finished = std::chrono::steady_clock::now();
+            }
+            else if (coreThreads)
+            {
+                record.done = coreThreads->submit(record.login, password, record.outcome);
+            }
+            else
+            {
+                std::shared_ptr<UserData> user = std::make_shared<UserData>(std::move(userData));
+                std::shared_ptr<BatchOutcome> outcome = record.outcome;
+                Authenticator *auth = authenticator;
+                record.done = pool->submit(HashingPriority::BULK, [auth, user, password, outcome](HashingInterface &)
+                                          {
+                                              UserErrorCode status = auth->verifyPassword(*password, *user);
+                                              std::memset(&(*password)[0], 0, password->size());
+                                              if (status == UserErrorCode::SUCCESS)
+                                              {
+                                                  status = auth->checkPasswordExpiration(*user);
+                                              }
+                                              outcome->status = status;
+                                              outcome->finished = std::chrono::steady_clock::now();
+                                              return ConfiguratorErrorCode::SUCCESS;
+                                          });
+            }
+            // Пароль записи, не попавшей в пул или к ядру, больше не нужен
+            if (!record.done.valid() && !password->empty())
+            {
+                std::memset(&(*password)[0], 0, password->size());
+            }
+            window.push_back(std::move(record));
+        }
+
+        while (!window.empty())
+        {
+            retire();
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    report.seconds = elapsed.count();
+    report.throughputPerSecond = report.seconds > 0 ? report.records / report.seconds : 0;
+    std::sort(latencies.begin(), latencies.end());
+    report.p50Micros = percentile(latencies, 50);
+    report.p90Micros = percentile(latencies, 90);
+    report.p99Micros = percentile(latencies, 99);
+    report.maxMicros = latencies.empty() ? 0 : latencies.back();
+    return report;
+}
+
+// Вывод итогов: число записей по результатам, пропускная способность, процентили задержки
+void BatchAuthenticator::printReport(const BatchAuthReport &report, std::ostream &out)
+{
+    out << "records: " << report.records << "\n";
+    for (const auto &entry : report.counts)
+    {
+        out << "  " << resultName(entry.first) << ": " << entry.second << "\n";
+    }
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(2)
+        << "elapsed: " << report.seconds << " s, " << report.throughputPerSecond << " records/s\n"
+        << "latency us: p50 " << report.p50Micros << ", p90 " << report.p90Micros
+        << ", p99 " << report.p99Micros << ", max " << report.maxMicros << "\n";
+    out.flags(flags);
+}
+
+// Краткое имя результата для вывода
+const char *BatchAuthenticator::resultName(UserErrorCode code)
+{
+    switch (code)
+    {
+    case UserErrorCode::SUCCESS:
+        return "success";
+    case UserErrorCode::LOGIN_ENTERING_ERROR:
+        return "invalid_login";
+    case UserErrorCode::PASSWORD_ENTERING_ERROR:
+        return "invalid_password";
+    case UserErrorCode::LOGIN_NOT_EXISTS:
+        return "not_found";
+    case UserErrorCode::GETTING_DATA_FROM_DB_ERROR:
+        return "database_error";
+    case UserErrorCode::WRONG_PASSWORD:
+        return "wrong_password";
+    case UserErrorCode::PASSWORD_HAS_EXPIRED:
+        return "expired";
+    case UserErrorCode::ACCOUNT_LOCKED:
+        return "locked";
+    case UserErrorCode::SESSION_EXPIRED:
+        return "session_expired";
+    case UserErrorCode::RATE_LIMITED:
+        return "rate_limited";
+    case UserErrorCode::OVERLOADED:
+        return "overloaded";
+    case UserErrorCode::DEADLINE_EXCEEDED:
+        return "deadline_exceeded";
+    default:
+        return "unknown";
+    }
+}
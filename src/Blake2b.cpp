@@ -0,0 +1,217 @@
+// src/Blake2b.cpp
+
+#include <cstring>
+
+#include "Blake2b.hpp"
+
+// Вектор инициализации BLAKE2b (совпадает с SHA-512)
+static const uint64_t blake2bIV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+
+// Перестановки слов сообщения для каждого раунда
+static const uint8_t blake2bSigma[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+    {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+    {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+    {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+    {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
+
+static inline uint64_t rotr64(uint64_t x, unsigned n)
+{
+    return (x >> n) | (x << (64 - n));
+}
+
+static inline uint64_t load64(const uint8_t *p)
+{
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v)); // Поддерживаются только little-endian платформы
+    return v;
+}
+
+static inline void store32(uint8_t *p, uint32_t v)
+{
+    std::memcpy(p, &v, sizeof(v));
+}
+
+// Функция сжатия F
+void Blake2b::compress(const uint8_t *block, bool last)
+{
+    uint64_t m[16];
+    uint64_t v[16];
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        m[i] = load64(block + i * 8);
+    }
+    for (size_t i = 0; i < 8; ++i)
+    {
+        v[i] = h[i];
+        v[i + 8] = blake2bIV[i];
+    }
+    v[12] ^= t[0];
+    v[13] ^= t[1];
+    if (last)
+    {
+        v[14] = ~v[14];
+    }
+
+#define BLAKE2B_G(r, i, a, b, c, d)                   \
+    do                                                \
+    {                                                 \
+        a = a + b + m[blake2bSigma[r][2 * (i)]];      \
+        d = rotr64(d ^ a, 32);                        \
+        c = c + d;                                    \
+        b = rotr64(b ^ c, 24);                        \
+        a = a + b + m[blake2bSigma[r][2 * (i) + 1]];  \
+        d = rotr64(d ^ a, 16);                        \
+        c = c + d;                                    \
+        b = rotr64(b ^ c, 63);                        \
+    } while (0)
+
+    for (size_t r = 0; r < 12; ++r)
+    {
+        BLAKE2B_G(r, 0, v[0], v[4], v[8], v[12]);
+        BLAKE2B_G(r, 1, v[1], v[5], v[9], v[13]);
+        BLAKE2B_G(r, 2, v[2], v[6], v[10], v[14]);
+        BLAKE2B_G(r, 3, v[3], v[7], v[11], v[15]);
+        BLAKE2B_G(r, 4, v[0], v[5], v[10], v[15]);
+        BLAKE2B_G(r, 5, v[1], v[6], v[11], v[12]);
+        BLAKE2B_G(r, 6, v[2], v[7], v[8], v[13]);
+        BLAKE2B_G(r, 7, v[3], v[4], v[9], v[14]);
+    }
+
+#undef BLAKE2B_G
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        h[i] ^= v[i] ^ v[i + 8];
+    }
+}
+
+// Инициализация с заданной длиной выхода и необязательным ключом
+Blake2b::Blake2b(size_t outLen, const uint8_t *key, size_t keyLen) : bufLength(0), outLength(outLen)
+{
+    for (size_t i = 0; i < 8; ++i)
+    {
+        h[i] = blake2bIV[i];
+    }
+    // Блок параметров: длина выхода, длина ключа, fanout = 1, depth = 1
+    h[0] ^= 0x01010000ULL ^ (static_cast<uint64_t>(keyLen) << 8) ^ outLength;
+    t[0] = 0;
+    t[1] = 0;
+
+    if (keyLen > 0)
+    {
+        // Ключ дополняется нулями до полного блока и обрабатывается как первый блок
+        uint8_t block[BLOCK_BYTES] = {0};
+        std::memcpy(block, key, keyLen);
+        update(block, BLOCK_BYTES);
+        std::memset(block, 0, BLOCK_BYTES);
+    }
+}
+
+// Добавление данных
+void Blake2b::update(const void *data, size_t length)
+{
+    const uint8_t *in = static_cast<const uint8_t *>(data);
+
+    while (length > 0)
+    {
+        // Полный буфер сжимается только когда известно, что он не последний
+        if (bufLength == BLOCK_BYTES)
+        {
+            t[0] += BLOCK_BYTES;
+            if (t[0] < BLOCK_BYTES)
+            {
+                ++t[1];
+            }
+            compress(buf, false);
+            bufLength = 0;
+        }
+
+        size_t chunk = BLOCK_BYTES - bufLength;
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+        std::memcpy(buf + bufLength, in, chunk);
+        bufLength += chunk;
+        in += chunk;
+        length -= chunk;
+    }
+}
+
+// Получение результата (outLength байт)
+void Blake2b::final(uint8_t *out)
+{
+    t[0] += bufLength;
+    if (t[0] < bufLength)
+    {
+        ++t[1];
+    }
+    std::memset(buf + bufLength, 0, BLOCK_BYTES - bufLength);
+    compress(buf, true);
+
+    uint8_t digest[OUT_BYTES];
+    std::memcpy(digest, h, sizeof(digest));
+    std::memcpy(out, digest, outLength);
+    std::memset(digest, 0, sizeof(digest));
+}
+
+// Однократное вычисление хеша
+void Blake2b::hash(uint8_t *out, size_t outLen, const void *in, size_t inLen)
+{
+    Blake2b state(outLen);
+    state.update(in, inLen);
+    state.final(out);
+}
+
+// Хеш-функция переменной длины H' из Argon2 (RFC 9106, раздел 3.3)
+void Blake2b::hashLong(uint8_t *out, size_t outLen, const void *in, size_t inLen)
+{
+    uint8_t lengthPrefix[4];
+    store32(lengthPrefix, static_cast<uint32_t>(outLen));
+
+    if (outLen <= OUT_BYTES)
+    {
+        Blake2b state(outLen);
+        state.update(lengthPrefix, sizeof(lengthPrefix));
+        state.update(in, inLen);
+        state.final(out);
+        return;
+    }
+
+    // V1 = H^64(LE32(T) || X), далее V_i = H^64(V_{i-1}); из каждого V_i берется первая половина
+    uint8_t v[OUT_BYTES];
+    Blake2b state(OUT_BYTES);
+    state.update(lengthPrefix, sizeof(lengthPrefix));
+    state.update(in, inLen);
+    state.final(v);
+    std::memcpy(out, v, OUT_BYTES / 2);
+    out += OUT_BYTES / 2;
+    size_t remaining = outLen - OUT_BYTES / 2;
+
+    while (remaining > OUT_BYTES)
+    {
+        uint8_t next[OUT_BYTES];
+        hash(next, OUT_BYTES, v, OUT_BYTES);
+        std::memcpy(v, next, OUT_BYTES);
+        std::memcpy(out, v, OUT_BYTES / 2);
+        out += OUT_BYTES / 2;
+        remaining -= OUT_BYTES / 2;
+    }
+
+    // Последний блок V_{r+1} берется целиком с длиной, равной остатку
+    uint8_t last[OUT_BYTES];
+    hash(last, remaining, v, OUT_BYTES);
+    std::memcpy(out, last, remaining);
+    std::memset(v, 0, sizeof(v));
+}
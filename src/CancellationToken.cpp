@@ -0,0 +1,37 @@
+// src/CancellationToken.cpp
+
+#include <algorithm>
+
+#include "CancellationToken.hpp"
+
+CancellationToken::CancellationToken()
+    : cancelled(std::make_shared<std::atomic<bool>>(false)), deadline(Clock::time_point::max()) {}
+
+CancellationToken CancellationToken::withTimeout(unsigned timeoutMs, Clock::time_point now) const
+{
+    CancellationToken token(*this);
+    if (timeoutMs > 0)
+    {
+        token.deadline = std::min(deadline, now + std::chrono::milliseconds(timeoutMs));
+    }
+    return token;
+}
+
+void CancellationToken::cancel()
+{
+    cancelled->store(true, std::memory_order_relaxed);
+}
+
+CancelReason CancellationToken::reason(Clock::time_point now) const
+{
+    if (cancelled->load(std::memory_order_relaxed))
+    {
+        return CancelReason::DISCONNECTED;
+    }
+    return now >= deadline ? CancelReason::DEADLINE : CancelReason::NONE;
+}
+
+bool CancellationToken::hasDeadline() const
+{
+    return deadline != Clock::time_point::max();
+}
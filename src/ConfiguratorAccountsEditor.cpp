@@ -1,9 +1,30 @@
 // src/ConfiguratorAccountsEditor.cpp
 
+#include <sodium.h>
+
 #include "AccountsEditor.hpp"
 
+// Затирание пароля при выходе из области видимости: в сопрограмме — на любом co_return и при уничтожении
+// приостановленного кадра, так что открытый пароль не остается в освобожденной памяти кадра
+class PasswordWiper
+{
+    std::string &secret;
+
+public:
+    explicit PasswordWiper(std::string &password) : secret(password) {}
+
+    PasswordWiper(const PasswordWiper &) = delete;
+    PasswordWiper &operator=(const PasswordWiper &) = delete;
+
+    ~PasswordWiper()
+    {
+        sodium_memzero(&secret[0], secret.size());
+    }
+};
+
 // Конструктор класса
-ConfiguratorAccountsEditor::ConfiguratorAccountsEditor(ConfiguratorDatabaseInterface *database, SecurityConfigInterface *security, HashingInterface *hash) : db(database), config(security), hasher(hash) {}
+ConfiguratorAccountsEditor::ConfiguratorAccountsEditor(ConfiguratorDatabaseInterface *database, SecurityConfigInterface *security, HashingInterface *hash,
+                                                       PasswordFingerprint *passwordFingerprint) : db(database), config(security), hasher(hash), fingerprint(passwordFingerprint) {}
 
 // Проверка логина на существование в архиве
 ConfiguratorErrorCode ConfiguratorAccountsEditor::checkLoginInArchive(const std::string &login)
@@ -64,48 +85,62 @@ ConfiguratorErrorCode ConfiguratorAccountsEditor::isValidChar(char c)
     }
 }
 
-// Проверка пароля на удовлетворение всем требованиям безопасности
-ConfiguratorErrorCode ConfiguratorAccountsEditor::checkPassword(const std::string &login, const std::string &password)
+// Проверка, не совпадает ли пароль с одним из прошлых паролей из записи архива
+ConfiguratorErrorCode ConfiguratorAccountsEditor::checkPasswordReuse(const std::string &login, const std::string &password, std::string userData)
 {
-    
     ConfiguratorErrorCode errorCode;
-    std::string userData;
-    
-    // Пытаемся найти пользователя в архивной базе данных по логину
-    errorCode = db->getArchiveUserByLogin(login, userData);
-    if (errorCode == ConfiguratorErrorCode::SUCCESS)
+
+    // Удаляем логин, оставляя только строку с прошлыми паролями
+    userData = userData.substr(userData.find(' ') + 1);
+
+    // Разбиваем оставшуюся строку на отдельные старые пароли по пробелам
+    std::vector<std::string> oldPasswords;
+    while (userData.find(' ') != std::string::npos)
     {
-        // Если пользователь найден в архиве:
-        // Удаляем логин, оставляя только строку с прошлыми паролями
+        oldPasswords.push_back(userData.substr(0, userData.find(' ')));
         userData = userData.substr(userData.find(' ') + 1);
+    }
+    oldPasswords.push_back(userData); // Добавляем последний (или единственный) пароль
 
-        // Разбиваем оставшуюся строку на отдельные старые пароли по пробелам
-        std::vector<std::string> oldPasswords;
-        while (userData.find(' ') != std::string::npos)
+    // Отпечаток введённого пароля вычисляется один раз для всех записей архива
+    std::string passwordFingerprint;
+    if (fingerprint != nullptr && fingerprint->isEnabled())
+    {
+        errorCode = fingerprint->compute(login, password, passwordFingerprint);
+        if (errorCode != ConfiguratorErrorCode::SUCCESS)
         {
-            oldPasswords.push_back(userData.substr(0, userData.find(' ')));
-            userData = userData.substr(userData.find(' ') + 1);
+            return errorCode;
         }
-        oldPasswords.push_back(userData); // Добавляем последний (или единственный) пароль
+    }
+
+    // Проверяем, не совпадает ли хеш введённого пароля с одним из старых
+    for (size_t i = 0; i < oldPasswords.size(); ++i)
+    {
+        std::string oldHash;
+        std::string oldFingerprint;
+        PasswordFingerprint::split(oldPasswords[i], oldHash, oldFingerprint);
 
-        // Проверяем, не совпадает ли хеш введённого пароля с одним из старых
-        for (size_t i = 0; i < oldPasswords.size(); ++i)
+        // Несовпадение отпечатков означает несовпадение паролей, медленная проверка не нужна.
+        // Записи без отпечатка (старые архивы или выключенные отпечатки) проверяются полностью
+        if (!passwordFingerprint.empty() && !oldFingerprint.empty() && oldFingerprint != passwordFingerprint)
         {
-            if (hasher->pwHashVerify(password,oldPasswords[i]) == ConfiguratorErrorCode::SUCCESS)   
-            {
-                return ConfiguratorErrorCode::PASSWORD_REUSED;
-            }
+            continue;
+        }
+
+        if (hasher->pwHashVerify(password, oldHash) == ConfiguratorErrorCode::SUCCESS)
+        {
+            return ConfiguratorErrorCode::PASSWORD_REUSED;
         }
     }
-    else if (errorCode == ConfiguratorErrorCode::DATABASE_ERROR)
-    {
-        // Если произошла ошибка при доступе к архиву — возвращаем ошибку
-        return ConfiguratorErrorCode::DATABASE_ERROR;
-    }
+    return ConfiguratorErrorCode::SUCCESS;
+}
 
+// Проверка длины и символов пароля по политике безопасности
+ConfiguratorErrorCode ConfiguratorAccountsEditor::checkPasswordRules(const std::string &password)
+{
     // Получаем минимально допустимую длину пароля из конфигурации
     unsigned minPasswordLength;
-    errorCode = config->get_minPasswordLength(minPasswordLength);
+    ConfiguratorErrorCode errorCode = config->get_minPasswordLength(minPasswordLength);
     if (errorCode == ConfiguratorErrorCode::DATABASE_ERROR)
     {
         return ConfiguratorErrorCode::DATABASE_ERROR;
@@ -131,9 +166,60 @@ ConfiguratorErrorCode ConfiguratorAccountsEditor::checkPassword(const std::strin
     return ConfiguratorErrorCode::SUCCESS;
 }
 
-// Добавление нового пользователя в БД
-ConfiguratorErrorCode ConfiguratorAccountsEditor::createAccount(const std::string &login, const std::string &password, const std::vector<UserRole> &roles)
+// Проверка пароля на удовлетворение всем требованиям безопасности. Чтение архива и политики
+// выполняется исполнителем базы, сравнение с прошлыми паролями — исполнителем хеширования
+Task<ConfiguratorErrorCode> ConfiguratorAccountsEditor::checkPasswordAsync(const std::string &login, const std::string &password, AsyncStages stages)
+{
+    // Пытаемся найти пользователя в архивной базе данных по логину
+    std::string userData;
+    ConfiguratorErrorCode errorCode = db->getArchiveUserByLogin(login, userData);
+    if (errorCode == ConfiguratorErrorCode::SUCCESS)
+    {
+        // Если пользователь найден в архиве, пароль не должен совпадать с прошлыми
+        co_await ResumeOn(stages.hashing);
+        errorCode = checkPasswordReuse(login, password, std::move(userData));
+        co_await ResumeOn(stages.database);
+        if (errorCode != ConfiguratorErrorCode::SUCCESS)
+        {
+            co_return errorCode;
+        }
+    }
+    else if (errorCode == ConfiguratorErrorCode::DATABASE_ERROR)
+    {
+        // Если произошла ошибка при доступе к архиву — возвращаем ошибку
+        co_return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    co_return checkPasswordRules(password);
+}
+
+// Формирование записи для БД: хеш пароля и, если отпечатки включены, отпечаток для архива
+ConfiguratorErrorCode ConfiguratorAccountsEditor::makeArchiveEntry(const std::string &login, const std::string &password, std::string &entry)
+{
+    ConfiguratorErrorCode errorCode = hasher->pwHashMake(password, entry);
+    if (errorCode != ConfiguratorErrorCode::SUCCESS || fingerprint == nullptr || !fingerprint->isEnabled())
+    {
+        return errorCode;
+    }
+
+    std::string passwordFingerprint;
+    errorCode = fingerprint->compute(login, password, passwordFingerprint);
+    if (errorCode != ConfiguratorErrorCode::SUCCESS)
+    {
+        return errorCode;
+    }
+    entry = PasswordFingerprint::attach(entry, passwordFingerprint);
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Добавление нового пользователя в БД. Этапы с обращениями к базе выполняются исполнителем
+// stages.database, хеширование — исполнителем stages.hashing; между этапами сопрограмма не занимает поток
+Task<ConfiguratorErrorCode> ConfiguratorAccountsEditor::createAccountAsync(std::string login, std::string password, std::vector<UserRole> roles,
+                                                                          AsyncStages stages)
 {
+    PasswordWiper wiper(password);
+    co_await ResumeOn(stages.database);
+
     // Проверка логина на уникальность (не должен присутствовать в архиве)
     ConfiguratorErrorCode errorCode;
     errorCode = checkLoginInArchive(login);
@@ -141,26 +227,34 @@ ConfiguratorErrorCode ConfiguratorAccountsEditor::createAccount(const std::strin
     // Если логин найден в архиве, считаем его уже использованным — возвращаем соответствующую ошибку
     if (errorCode != ConfiguratorErrorCode::LOGIN_NOT_FOUND)
     {
-        return errorCode;
+        co_return errorCode;
     }
 
     // Проверка пароля на соответствие требованиям безопасности
-    errorCode = checkPassword(login, password);
+    errorCode = co_await checkPasswordAsync(login, password, stages);
     if (errorCode != ConfiguratorErrorCode::SUCCESS)
     {
-        return errorCode;
+        co_return errorCode;
     }
 
     // Хеширование пароля
+    co_await ResumeOn(stages.hashing);
     std::string hashedPassword;
-    errorCode = hasher->pwHashMake(password, hashedPassword);
+    errorCode = makeArchiveEntry(login, password, hashedPassword);
     if (errorCode != ConfiguratorErrorCode::SUCCESS)
     {
-        return errorCode;
+        co_return errorCode;
     }
 
     // Добавление нового пользователя в БД
-    return db->addUser(login, hashedPassword, roles);
+    co_await ResumeOn(stages.database);
+    co_return db->addUser(login, hashedPassword, roles);
+}
+
+// Добавление нового пользователя в БД
+ConfiguratorErrorCode ConfiguratorAccountsEditor::createAccount(const std::string &login, const std::string &password, const std::vector<UserRole> &roles)
+{
+    return syncWait(createAccountAsync(login, password, roles));
 }
 
 // Удаление пользователя из БД
@@ -181,22 +275,25 @@ ConfiguratorErrorCode ConfiguratorAccountsEditor::deleteAccount(const std::strin
     return db->removeUser(login);
 }
 
-// Изменение пароля от учетной записи
-ConfiguratorErrorCode ConfiguratorAccountsEditor::editPassword(const std::string &login, const std::string &newPassword)
+// Изменение пароля от учетной записи; этапы распределяются по исполнителям, как в createAccountAsync
+Task<ConfiguratorErrorCode> ConfiguratorAccountsEditor::editPasswordAsync(std::string login, std::string newPassword, AsyncStages stages)
 {
+    PasswordWiper wiper(newPassword);
+    co_await ResumeOn(stages.database);
+
     // Проверка: существует ли активная учетная запись с таким логином
     ConfiguratorErrorCode errorCode;
     errorCode = checkLoginInActive(login);
     if (errorCode != ConfiguratorErrorCode::LOGIN_ALREADY_EXISTS)
     {
-        return errorCode;
+        co_return errorCode;
     }
 
     // Проверка нового пароля на соответствие требованиям безопасности
-    errorCode = checkPassword(login, newPassword);
+    errorCode = co_await checkPasswordAsync(login, newPassword, stages);
     if (errorCode != ConfiguratorErrorCode::SUCCESS)
     {
-        return errorCode;
+        co_return errorCode;
     }
 
     // Получение зхначения глубины хранения паролей из конфигурационного файла
@@ -204,19 +301,27 @@ ConfiguratorErrorCode ConfiguratorAccountsEditor::editPassword(const std::string
     errorCode = config->get_passwordHistoryDepth(historyDepth);
     if (errorCode != ConfiguratorErrorCode::SUCCESS)
     {
-        return errorCode;
+        co_return errorCode;
     }
 
     // Хеширование пароля
+    co_await ResumeOn(stages.hashing);
     std::string newHashedPassword;
-    errorCode = hasher->pwHashMake(newPassword, newHashedPassword);
+    errorCode = makeArchiveEntry(login, newPassword, newHashedPassword);
     if (errorCode != ConfiguratorErrorCode::SUCCESS)
     {
-        return errorCode;
+        co_return errorCode;
     }
 
     // Обновление пароля пользователя
-    return db->updatePassword(login, newHashedPassword, historyDepth);
+    co_await ResumeOn(stages.database);
+    co_return db->updatePassword(login, newHashedPassword, historyDepth);
+}
+
+// Изменение пароля от учетной записи
+ConfiguratorErrorCode ConfiguratorAccountsEditor::editPassword(const std::string &login, const std::string &newPassword)
+{
+    return syncWait(editPasswordAsync(login, newPassword));
 }
 
 // Изменение списка ролей пользователя
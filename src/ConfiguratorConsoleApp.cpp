@@ -3,11 +3,12 @@
 #include <iostream>
 #include <string>
 #include <limits>
+#include <optional>
 
 #include "ConfiguratorConsoleApp.hpp"
 #include "ConfiguratorDatabase.hpp"
 #include "SecurityConfig.hpp"
-#include "Hashing.hpp"
+#include "HashingEngine.hpp"
 #include "AccountsEditor.hpp"
 
 
@@ -27,8 +28,9 @@ void ConfiguratorConsoleApp::printMenu() const
     std::cout << "11. Remove user\n";
     std::cout << "12. List active users\n";
     std::cout << "13. List archive users\n";
+    std::cout << "14. Edit several security settings at once\n";
     std::cout << "0. Exit\n";
-    std::cout << "Enter command (0-13): ";
+    std::cout << "Enter command (0-14): ";
 }
 
 // Преобразование ConfiguratorErrorCode в строку
@@ -59,6 +61,8 @@ ConfiguratorConsoleApp::errorCodeToString(ConfiguratorErrorCode code) const
         return "Hashing error";
     case ConfiguratorErrorCode::PASSWORDS_DONT_MATCH:
         return "Passwords don't match";
+    case ConfiguratorErrorCode::CONFIG_VALUE_OUT_OF_RANGE:
+        return "Value is out of the allowed range";
 
         default:
         return "Unknown error";
@@ -72,23 +76,11 @@ void ConfiguratorConsoleApp::viewSettings() const
     ConfiguratorErrorCode code;
 
     std::cout << "\nCurrent Security Settings:\n";
-    code = config->get_minPasswordLength(val);
-    std::cout << "Minimum Password Length: " << (code == ConfiguratorErrorCode::SUCCESS ? std::to_string(val) : "N/A") << "\n";
-
-    code = config->get_passwordHistoryDepth(val);
-    std::cout << "Password History Depth: " << (code == ConfiguratorErrorCode::SUCCESS ? std::to_string(val) : "N/A") << "\n";
-
-    code = config->get_passwordExpirationDays(val);
-    std::cout << "Password Expiration Days: " << (code == ConfiguratorErrorCode::SUCCESS ? std::to_string(val) : "N/A") << "\n";
-
-    code = config->get_maxInactiveTimeMin(val);
-    std::cout << "Max Inactive Time (minutes): " << (code == ConfiguratorErrorCode::SUCCESS ? std::to_string(val) : "N/A") << "\n";
-
-    code = config->get_maxFailedAttempts(val);
-    std::cout << "Max Failed Attempts: " << (code == ConfiguratorErrorCode::SUCCESS ? std::to_string(val) : "N/A") << "\n";
-
-    code = config->get_lockoutTimeMin(val);
-    std::cout << "Lockout Time (minutes): " << (code == ConfiguratorErrorCode::SUCCESS ? std::to_string(val) : "N/A") << "\n";
+    for (const SecurityParamInfo &info : securitySchema)
+    {
+        code = config->get(info.param, val);
+        std::cout << info.title << ": " << (code == ConfiguratorErrorCode::SUCCESS ? std::to_string(val) : "N/A") << "\n";
+    }
 }
 
 // Установка значения с обработкой ввода
@@ -107,6 +99,66 @@ ConfiguratorConsoleApp::setUnsignedConfigValue(const std::string &prompt, std::f
     return setter(value);
 }
 
+// Чтение необязательного нового значения параметра: пустая строка оставляет текущее значение,
+// а если параметр не задан — устанавливает значение по умолчанию
+static bool readOptionalValue(const SecurityParamInfo &info, const SecurityConfigInterface &config,
+                              std::optional<unsigned> &value)
+{
+    unsigned current;
+    bool hasCurrent = config.get(info.param, current) == ConfiguratorErrorCode::SUCCESS;
+    std::cout << info.title << " (" << info.minValue << "-" << info.maxValue << ") ["
+              << (hasCurrent ? std::to_string(current) : "N/A, default " + std::to_string(info.defaultValue)) << "]: ";
+    std::string line;
+    if (!std::getline(std::cin, line))
+    {
+        return false;
+    }
+    if (line.empty())
+    {
+        if (!hasCurrent)
+        {
+            value = info.defaultValue;
+        }
+        return true;
+    }
+    try
+    {
+        size_t parsed;
+        unsigned long number = std::stoul(line, &parsed);
+        if (parsed != line.size() || line[0] == '-' || number > std::numeric_limits<unsigned>::max())
+        {
+            return false;
+        }
+        value = static_cast<unsigned>(number);
+        return true;
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+}
+
+// Изменение нескольких параметров безопасности одной атомарной записью
+void ConfiguratorConsoleApp::editSettings()
+{
+    // Остаток строки с номером команды
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    std::cout << "Enter new values, leave empty to keep the current one.\n";
+
+    SecurityConfigChanges changes;
+    for (const SecurityParamInfo &info : securitySchema)
+    {
+        if (!readOptionalValue(info, *config, changes.values[static_cast<size_t>(info.param)]))
+        {
+            std::cout << "Invalid input. Please enter a positive number. No settings were changed.\n";
+            return;
+        }
+    }
+
+    ConfiguratorErrorCode code = config->applyChanges(changes);
+    std::cout << "Result: " << errorCodeToString(code) << "\n";
+}
+
 // Добавление нового пользователя
 void ConfiguratorConsoleApp::addUser()
 {
@@ -226,12 +278,32 @@ void ConfiguratorConsoleApp::listArchiveUsers()
 ConfiguratorConsoleApp::ConfiguratorConsoleApp() : configPath("./configDb/config.txt"),
                                                    activeUsersPath("./configDb/active_users.txt"),
                                                    archivePath("./configDb/archive.txt"),
-                                                   tmpPath("./configDb/tmp_file.txt")
+                                                   tmpPath("./configDb/tmp_file.txt"),
+                                                   pepperPath("./configDb/pepper.key"),
+                                                   policySegmentName("/authentication_system_policy")
 {
     db = new ConfiguratorDatabase(archivePath, activeUsersPath, tmpPath);
-    config = new SecurityConfig(configPath);
-    hasher = new Hashing();
-    editor = new ConfiguratorAccountsEditor(db, config, hasher);
+
+    // Политика публикуется в разделяемую память для процессов входа; изменения файла
+    // в обход конфигуратора подхватываются и тоже публикуются
+    SecurityConfig *securityConfig = new SecurityConfig(configPath);
+    securityConfig->shareVia(policySegmentName);
+    securityConfig->watch();
+    config = securityConfig;
+    engine = HashingEngine::create().release();
+    HashingPoolOptions poolOptions;
+    poolOptions.workers = 1; // Администратор выполняет одну операцию за раз
+    hashingPool = new HashingWorkerPool(engine, poolOptions);
+    hasher = new PooledHashing(hashingPool, HashingPriority::ADMIN);
+
+    // Отпечатки паролей в архиве включаются наличием файла с перцем
+    fingerprint = new PasswordFingerprint();
+    if (fingerprint->loadPepper(pepperPath) != ConfiguratorErrorCode::SUCCESS)
+    {
+        delete fingerprint;
+        fingerprint = nullptr;
+    }
+    editor = new ConfiguratorAccountsEditor(db, config, hasher, fingerprint);
 }
 
 void ConfiguratorConsoleApp::run()
@@ -338,8 +410,12 @@ void ConfiguratorConsoleApp::run()
             listArchiveUsers();
             break;
 
+        case 14: // Изменить несколько параметров безопасности
+            editSettings();
+            break;
+
         default:
-            std::cout << "Invalid command. Please enter a number between 0 and 13.\n";
+            std::cout << "Invalid command. Please enter a number between 0 and 14.\n";
             break;
         }
     }
@@ -350,4 +426,8 @@ ConfiguratorConsoleApp::~ConfiguratorConsoleApp()
     delete db;
     delete config;
     delete editor;
+    delete fingerprint;
+    delete hasher;
+    delete hashingPool;
+    delete engine;
 }
\ No newline at end of file
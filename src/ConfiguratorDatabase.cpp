@@ -1,8 +1,87 @@
 // src/ConfiguratorDatabase.cpp
 
+#include <algorithm>
+#include <cerrno>
 #include <ctime>
+#include <fcntl.h>
+#include <string_view>
+#include <sys/file.h>
+#include <unistd.h>
 
 #include "ConfiguratorDatabase.hpp"
+#include "PasswordFingerprint.hpp"
+
+// Блокировка изменения базы между процессами (рабочие процессы authd, конфигуратор): чтение таблицы,
+// запись временного файла и переименование выполняются целиком под flock каталога базы. Файлы таблиц
+// заменяются переименованием, поэтому блокируется каталог, а не файл
+class DatabaseWriteLock
+{
+    int fd;
+    bool held;
+
+public:
+    // wait = false: без ожидания, захват повторяется вызовом tryLock
+    explicit DatabaseWriteLock(const std::string &filePath, bool wait = true) : held(false)
+    {
+        size_t slash = filePath.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : filePath.substr(0, slash + 1);
+        fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (!wait)
+        {
+            tryLock();
+            return;
+        }
+        int result;
+        while (fd >= 0 && (result = flock(fd, LOCK_EX)) != 0 && errno == EINTR)
+        {
+        }
+        held = fd >= 0 && result == 0;
+    }
+
+    DatabaseWriteLock(const DatabaseWriteLock &) = delete;
+    DatabaseWriteLock &operator=(const DatabaseWriteLock &) = delete;
+
+    // Захват без ожидания; при отказе errno == EWOULDBLOCK, если базу изменяет другой процесс
+    bool tryLock()
+    {
+        while (!held && fd >= 0)
+        {
+            if (flock(fd, LOCK_EX | LOCK_NB) == 0)
+            {
+                held = true;
+            }
+            else if (errno != EINTR)
+            {
+                break;
+            }
+        }
+        return held;
+    }
+
+    // Каталог открыт
+    bool opened() const
+    {
+        return fd >= 0;
+    }
+
+    bool locked() const
+    {
+        return held;
+    }
+
+    int descriptor() const
+    {
+        return fd;
+    }
+
+    ~DatabaseWriteLock()
+    {
+        if (fd >= 0)
+        {
+            close(fd); // Закрытие снимает блокировку
+        }
+    }
+};
 
 // Конструктор класса ConfiguratorDatabase для инициализации путей к файлам
 ConfiguratorDatabase::ConfiguratorDatabase(std::string archivePath,
@@ -60,9 +139,71 @@ ConfiguratorErrorCode ConfiguratorDatabase::getNextActiveUser(std::string &userD
     return ConfiguratorErrorCode::END_OF_TABLE;
 }
 
+// Включение индекса активных пользователей в памяти: getActiveUserByLogin перестает читать
+// файл целиком при каждом вызове и проверяет только его отметку (stat)
+void ConfiguratorDatabase::enableActiveUsersIndex()
+{
+    activeUsersIndexEnabled = true;
+    activeUsersIndex.clear();
+    activeUsersStamp = {};
+    // Индекс строится сразу: процессы, порожденные fork после этого, получают его общими страницами.
+    // Если файл пока недоступен, индекс строится при первом поиске
+    refreshActiveUsersIndex();
+}
+
+// Перестроение индекса при изменении файла активных пользователей
+ConfiguratorErrorCode ConfiguratorDatabase::refreshActiveUsersIndex()
+{
+    struct stat fileStat;
+    if (stat(activeUsersFilePath.c_str(), &fileStat) != 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    if (fileStat.st_dev == activeUsersStamp.st_dev && fileStat.st_ino == activeUsersStamp.st_ino &&
+        fileStat.st_size == activeUsersStamp.st_size && fileStat.st_mtim.tv_sec == activeUsersStamp.st_mtim.tv_sec &&
+        fileStat.st_mtim.tv_nsec == activeUsersStamp.st_mtim.tv_nsec)
+    {
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    std::ifstream file(activeUsersFilePath);
+    if (!file)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    // Как и при поиске по файлу, для повторяющегося логина используется первая строка
+    std::unordered_map<std::string, std::string> index;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        index.emplace(line.substr(0, line.find(' ')), line);
+    }
+
+    activeUsersIndex.swap(index);
+    activeUsersStamp = fileStat;
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
 // Получение данных активного пользователя по логину
 ConfiguratorErrorCode ConfiguratorDatabase::getActiveUserByLogin(const std::string &login, std::string &userData)
 {
+    if (activeUsersIndexEnabled)
+    {
+        ConfiguratorErrorCode errorCode = refreshActiveUsersIndex();
+        if (errorCode != ConfiguratorErrorCode::SUCCESS)
+        {
+            return errorCode;
+        }
+
+        auto it = activeUsersIndex.find(login);
+        if (it == activeUsersIndex.end())
+        {
+            return ConfiguratorErrorCode::LOGIN_NOT_FOUND;
+        }
+        userData = it->second;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
 
     // Открытие файла для чтения
     std::ifstream file(activeUsersFilePath);
@@ -93,6 +234,95 @@ ConfiguratorErrorCode ConfiguratorDatabase::getActiveUserByLogin(const std::stri
     return ConfiguratorErrorCode::LOGIN_NOT_FOUND;
 }
 
+// Совпадает ли логин строки таблицы (текст до первого пробела) с login
+static bool lineHasLogin(std::string_view line, const std::string &login)
+{
+    return line.substr(0, line.find(' ')) == login;
+}
+
+// Получение данных активного пользователя по логину без обращений к общей куче
+ConfiguratorErrorCode ConfiguratorDatabase::getActiveUserRecord(const std::string &login, std::pmr::string &userData)
+{
+    if (activeUsersIndexEnabled)
+    {
+        ConfiguratorErrorCode errorCode = refreshActiveUsersIndex();
+        if (errorCode != ConfiguratorErrorCode::SUCCESS)
+        {
+            return errorCode;
+        }
+
+        auto it = activeUsersIndex.find(login);
+        if (it == activeUsersIndex.end())
+        {
+            return ConfiguratorErrorCode::LOGIN_NOT_FOUND;
+        }
+        userData.assign(it->second);
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    // Файл читается блоками в буфер на стеке (ifstream и getline выделяли бы память из кучи);
+    // строка, разрезанная границей блока, собирается в памяти распределителя userData
+    int fd = open(activeUsersFilePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    ConfiguratorErrorCode result = ConfiguratorErrorCode::LOGIN_NOT_FOUND;
+    std::pmr::string pending(userData.get_allocator());
+    char chunk[8192];
+    while (result == ConfiguratorErrorCode::LOGIN_NOT_FOUND)
+    {
+        ssize_t received = read(fd, chunk, sizeof(chunk));
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received < 0)
+        {
+            result = ConfiguratorErrorCode::DATABASE_ERROR;
+            break;
+        }
+        if (received == 0)
+        {
+            // Последняя строка без перевода строки
+            if (!pending.empty() && lineHasLogin(pending, login))
+            {
+                userData.assign(pending);
+                result = ConfiguratorErrorCode::SUCCESS;
+            }
+            break;
+        }
+
+        std::string_view block(chunk, static_cast<size_t>(received));
+        size_t end;
+        while ((end = block.find('\n')) != std::string_view::npos)
+        {
+            std::string_view line = block.substr(0, end);
+            if (!pending.empty())
+            {
+                pending.append(line);
+                line = pending;
+            }
+            if (lineHasLogin(line, login))
+            {
+                userData.assign(line);
+                result = ConfiguratorErrorCode::SUCCESS;
+                break;
+            }
+            pending.clear();
+            block.remove_prefix(end + 1);
+        }
+        if (result == ConfiguratorErrorCode::LOGIN_NOT_FOUND)
+        {
+            pending.append(block);
+        }
+    }
+
+    close(fd);
+    return result;
+}
+
 // Получение данных первого пользователя из архива
 ConfiguratorErrorCode ConfiguratorDatabase::getFirstArchiveUser(std::string &userData)
 {
@@ -177,9 +407,37 @@ ConfiguratorErrorCode ConfiguratorDatabase::getArchiveUserByLogin(const std::str
     return ConfiguratorErrorCode::LOGIN_NOT_FOUND;
 }
 
+// Строка таблицы активных пользователей для нового пользователя: логин, хеш, текущая дата и роли.
+// В таблицу попадает только хеш, отпечаток пароля хранится лишь в архиве
+static std::string activeUserLine(const std::string &login, const std::string &hashedPassword, const std::vector<UserRole> &roles)
+{
+    std::string activeHash;
+    std::string fingerprint;
+    PasswordFingerprint::split(hashedPassword, activeHash, fingerprint);
+
+    std::time_t t = std::time(nullptr);
+    std::tm *now = std::localtime(&t);
+    std::string line = login + " " + activeHash + " " + std::to_string(now->tm_mday) + "." + std::to_string(now->tm_mon + 1) + "." +
+                       std::to_string(now->tm_year + 1900) + " ";
+    for (size_t i = 0; i < roles.size() - 1; ++i)
+    {
+        line += std::to_string(static_cast<int>(roles[i])) + ",";
+    }
+    line += std::to_string(static_cast<int>(roles[roles.size() - 1])) + "\n";
+    return line;
+}
+
 // Добавление нового пользователя в активных пользователей и архив
 ConfiguratorErrorCode ConfiguratorDatabase::addUser(const std::string &login, const std::string &hashedPassword, const std::vector<UserRole> &roles)
 {
+    waitAsyncAdds();
+    DatabaseWriteLock lock(activeUsersFilePath);
+    if (!lock.locked())
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    activeUsersReaders.reset();
+
     //Если пользователь с таким логином уже есть в базе - добавление невозможно
     std::string userData;
     ConfiguratorErrorCode code;
@@ -197,17 +455,8 @@ ConfiguratorErrorCode ConfiguratorDatabase::addUser(const std::string &login, co
         return ConfiguratorErrorCode::DATABASE_ERROR;
     }
 
-    // Получение текущей даты для записи в файл
-    std::time_t t = std::time(nullptr);
-    std::tm *now = std::localtime(&t);
-
     // Запись данных пользователя: логин, хеш пароля, дата создания и ролей
-    file << login << " " << hashedPassword << " " << now->tm_mday << "." << now->tm_mon + 1 << "." << now->tm_year + 1900 << " ";
-    for (size_t i = 0; i < roles.size() - 1; ++i)
-    {
-        file << static_cast<int>(roles[i]) << ",";
-    }
-    file << static_cast<int>(roles[roles.size() - 1]) << "\n";
+    file << activeUserLine(login, hashedPassword, roles);
 
     file.close();
 
@@ -230,6 +479,13 @@ ConfiguratorErrorCode ConfiguratorDatabase::addUser(const std::string &login, co
 // Удаление пользователя по логину из активных пользователей
 ConfiguratorErrorCode ConfiguratorDatabase::removeUser(const std::string &login)
 {
+    waitAsyncAdds();
+    DatabaseWriteLock lock(activeUsersFilePath);
+    if (!lock.locked())
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    activeUsersReaders.reset();
 
     // Открытие файла активных пользователей для чтения
     std::ifstream inFile(activeUsersFilePath);
@@ -275,6 +531,13 @@ ConfiguratorErrorCode ConfiguratorDatabase::removeUser(const std::string &login)
 // Обновление пароля пользователя в активных пользователях и архиве
 ConfiguratorErrorCode ConfiguratorDatabase::updatePassword(const std::string &login, const std::string &newHashedPassword, const unsigned &passwordHistoryDepth)
 {
+    waitAsyncAdds();
+    DatabaseWriteLock lock(activeUsersFilePath);
+    if (!lock.locked())
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    activeUsersReaders.reset();
 
     // Обновление пароля в таблице активных пользователей
 
@@ -294,6 +557,11 @@ ConfiguratorErrorCode ConfiguratorDatabase::updatePassword(const std::string &lo
         return ConfiguratorErrorCode::DATABASE_ERROR;
     }
 
+    // В таблицу активных пользователей попадает только хеш, отпечаток пароля хранится лишь в архиве
+    std::string activeHash;
+    std::string fingerprint;
+    PasswordFingerprint::split(newHashedPassword, activeHash, fingerprint);
+
     std::string line;
     bool found = false;
     // Чтение строк из файла активных пользователей
@@ -310,7 +578,7 @@ ConfiguratorErrorCode ConfiguratorDatabase::updatePassword(const std::string &lo
             std::tm *now = std::localtime(&t);
 
             // Формирование новой строки с обновленным паролем
-            line = login + " " + newHashedPassword + " " + std::to_string(now->tm_mday) + "." + std::to_string(now->tm_mon + 1) + "." + std::to_string(now->tm_year + 1900) + " " + roles;
+            line = login + " " + activeHash + " " + std::to_string(now->tm_mday) + "." + std::to_string(now->tm_mon + 1) + "." + std::to_string(now->tm_year + 1900) + " " + roles;
         }
         outFile << line << "\n";
     }
@@ -404,6 +672,13 @@ ConfiguratorErrorCode ConfiguratorDatabase::updatePassword(const std::string &lo
 // Обновление ролей пользователя в таблице активных пользователей
 ConfiguratorErrorCode ConfiguratorDatabase::updateRoles(const std::string &login, const std::vector<UserRole> &newRoles)
 {
+    waitAsyncAdds();
+    DatabaseWriteLock lock(activeUsersFilePath);
+    if (!lock.locked())
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    activeUsersReaders.reset();
 
     // Открытие файла активных пользователей для чтения
     std::ifstream inFile(activeUsersFilePath);
@@ -452,6 +727,242 @@ ConfiguratorErrorCode ConfiguratorDatabase::updateRoles(const std::string &login
     return found ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::LOGIN_NOT_FOUND;
 }
 
+// Асинхронный ввод-вывод для методов ...Async
+void ConfiguratorDatabase::setIoBackend(IoBackendInterface *backend)
+{
+    waitAsyncAdds();
+    ioBackend = backend;
+}
+
+// Строка с логином в содержимом таблицы; пустое представление, если ее нет
+static std::string_view findLine(std::string_view contents, const std::string &login)
+{
+    while (!contents.empty())
+    {
+        size_t end = contents.find('\n');
+        std::string_view line = contents.substr(0, end);
+        if (lineHasLogin(line, login))
+        {
+            return line;
+        }
+        contents.remove_prefix(end == std::string_view::npos ? contents.size() : end + 1);
+    }
+    return {};
+}
+
+// Чтение файла целиком через ioBackend блоками по 64 КиБ
+void ConfiguratorDatabase::readFileAsync(const std::string &path, std::function<void(ConfiguratorErrorCode, std::string_view)> done)
+{
+    // Файлы таблиц заменяются переименованием, поэтому открытый дескриптор видит целую версию файла
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat fileStat;
+    if (fd < 0 || fstat(fd, &fileStat) != 0)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+        done(ConfiguratorErrorCode::DATABASE_ERROR, {});
+        return;
+    }
+
+    // Буфер без заполнения нулями: его целиком перезаписывают чтения
+    struct ReadState
+    {
+        int fd;
+        size_t size;
+        std::unique_ptr<char[]> contents;
+        size_t remaining;
+        bool failed;
+        std::function<void(ConfiguratorErrorCode, std::string_view)> done;
+    };
+    const size_t blockSize = 65536;
+    size_t size = static_cast<size_t>(fileStat.st_size);
+    auto state = std::make_shared<ReadState>(ReadState{fd, size, std::unique_ptr<char[]>(new char[size]), (size + blockSize - 1) / blockSize, false, std::move(done)});
+    if (state->remaining == 0)
+    {
+        close(fd);
+        state->done(ConfiguratorErrorCode::SUCCESS, {});
+        return;
+    }
+    for (size_t offset = 0; offset < size; offset += blockSize)
+    {
+        size_t length = std::min(blockSize, size - offset);
+        ioBackend->read(fd, state->contents.get() + offset, length, static_cast<off_t>(offset), [state, length](ssize_t result)
+                        {
+                            state->failed = state->failed || result != static_cast<ssize_t>(length);
+                            if (--state->remaining == 0)
+                            {
+                                close(state->fd);
+                                state->done(state->failed ? ConfiguratorErrorCode::DATABASE_ERROR : ConfiguratorErrorCode::SUCCESS,
+                                            std::string_view(state->contents.get(), state->size));
+                            }
+                        });
+    }
+}
+
+// Асинхронный поиск активного пользователя
+void ConfiguratorDatabase::getActiveUserAsync(const std::string &login, std::function<void(ConfiguratorErrorCode, const std::string &)> done)
+{
+    if (activeUsersIndexEnabled || ioBackend == nullptr)
+    {
+        std::string userData;
+        ConfiguratorErrorCode code = getActiveUserByLogin(login, userData);
+        done(code, userData);
+        return;
+    }
+
+    // Поиски, поставленные до завершения начатого чтения, используют его результат
+    if (activeUsersReaders != nullptr)
+    {
+        activeUsersReaders->push_back({login, std::move(done)});
+        return;
+    }
+    auto readers = std::make_shared<std::vector<PendingLookup>>();
+    readers->push_back({login, std::move(done)});
+    activeUsersReaders = readers;
+    readFileAsync(activeUsersFilePath, [this, readers](ConfiguratorErrorCode code, std::string_view contents)
+                  {
+                      if (activeUsersReaders == readers)
+                      {
+                          activeUsersReaders.reset();
+                      }
+                      for (PendingLookup &lookup : *readers)
+                      {
+                          std::string_view line = code == ConfiguratorErrorCode::SUCCESS ? findLine(contents, lookup.login) : std::string_view();
+                          ConfiguratorErrorCode result = code != ConfiguratorErrorCode::SUCCESS ? code
+                                                         : line.empty()                         ? ConfiguratorErrorCode::LOGIN_NOT_FOUND
+                                                                                                : ConfiguratorErrorCode::SUCCESS;
+                          lookup.done(result, std::string(line));
+                      }
+                  });
+}
+
+// Асинхронное добавление пользователя
+void ConfiguratorDatabase::addUserAsync(const std::string &login, const std::string &hashedPassword, const std::vector<UserRole> &roles,
+                                        std::function<void(ConfiguratorErrorCode)> done)
+{
+    if (ioBackend == nullptr)
+    {
+        done(addUser(login, hashedPassword, roles));
+        return;
+    }
+    asyncAdds.push_back({login, hashedPassword, roles, std::move(done)});
+    startAsyncAdd();
+}
+
+// Запуск первого добавления из очереди, если ни одно не выполняется
+void ConfiguratorDatabase::startAsyncAdd()
+{
+    if (asyncAddRunning || asyncAdds.empty())
+    {
+        return;
+    }
+    asyncAddRunning = true;
+    asyncAddLock = std::make_shared<DatabaseWriteLock>(activeUsersFilePath, false);
+    continueAsyncAdd();
+}
+
+// Захват блокировки каталога и выполнение первого добавления очереди
+void ConfiguratorDatabase::continueAsyncAdd()
+{
+    if (!asyncAddLock->tryLock())
+    {
+        if (!asyncAddLock->opened() || errno != EWOULDBLOCK)
+        {
+            finishAsyncAdd(ConfiguratorErrorCode::DATABASE_ERROR);
+            return;
+        }
+        // Базу изменяет другой процесс: повтор после следующего прохода цикла завершений.
+        // Чтение нуля байт ничего не делает и нужно только для того, чтобы backend вызвал продолжение
+        ioBackend->read(asyncAddLock->descriptor(), nullptr, 0, 0, [this](ssize_t)
+                        { continueAsyncAdd(); });
+        return;
+    }
+
+    const PendingAdd &add = asyncAdds.front();
+    std::string activeLine = activeUserLine(add.login, add.hashedPassword, add.roles);
+    std::string archiveLine = add.login + " " + add.hashedPassword + "\n";
+    readFileAsync(archiveFilePath, [this, login = add.login, activeLine, archiveLine](ConfiguratorErrorCode code, std::string_view contents) mutable
+                  {
+                      //Если пользователь с таким логином уже есть в базе - добавление невозможно
+                      if (code != ConfiguratorErrorCode::SUCCESS || !findLine(contents, login).empty())
+                      {
+                          finishAsyncAdd(code != ConfiguratorErrorCode::SUCCESS ? code : ConfiguratorErrorCode::LOGIN_ALREADY_EXISTS);
+                          return;
+                      }
+
+                      struct AppendState
+                      {
+                          int activeFd;
+                          int archiveFd;
+                          std::string activeLine;
+                          std::string archiveLine;
+                          size_t remaining;
+                          bool failed;
+                      };
+                      auto state = std::make_shared<AppendState>(AppendState{open(activeUsersFilePath.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0666),
+                                                                             open(archiveFilePath.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0666),
+                                                                             std::move(activeLine), std::move(archiveLine), 4, false});
+                      if (state->activeFd < 0 || state->archiveFd < 0)
+                      {
+                          if (state->activeFd >= 0)
+                          {
+                              close(state->activeFd);
+                          }
+                          if (state->archiveFd >= 0)
+                          {
+                              close(state->archiveFd);
+                          }
+                          finishAsyncAdd(ConfiguratorErrorCode::DATABASE_ERROR);
+                          return;
+                      }
+
+                      auto step = [this, state](ssize_t expected)
+                      {
+                          return [this, state, expected](ssize_t result)
+                          {
+                              state->failed = state->failed || result != expected;
+                              if (--state->remaining == 0)
+                              {
+                                  activeUsersReaders.reset();
+                                  close(state->activeFd);
+                                  close(state->archiveFd);
+                                  finishAsyncAdd(state->failed ? ConfiguratorErrorCode::DATABASE_ERROR : ConfiguratorErrorCode::SUCCESS);
+                              }
+                          };
+                      };
+                      // Обе записи и оба fsync уходят одним пакетом; fsync начинается после записей
+                      ioBackend->write(state->activeFd, state->activeLine.data(), state->activeLine.size(), -1, step(static_cast<ssize_t>(state->activeLine.size())));
+                      ioBackend->write(state->archiveFd, state->archiveLine.data(), state->archiveLine.size(), -1, step(static_cast<ssize_t>(state->archiveLine.size())));
+                      ioBackend->fsync(state->activeFd, step(0));
+                      ioBackend->fsync(state->archiveFd, step(0));
+                  });
+}
+
+// Снятие блокировки, вызов done первого добавления и запуск следующего
+void ConfiguratorDatabase::finishAsyncAdd(ConfiguratorErrorCode code)
+{
+    asyncAddLock.reset();
+    asyncAddRunning = false;
+    PendingAdd add = std::move(asyncAdds.front());
+    asyncAdds.pop_front();
+    add.done(code);
+    startAsyncAdd();
+}
+
+// Синхронное изменение ждет асинхронные добавления этого объекта: они держат блокировку каталога,
+// и flock через новый дескриптор ждал бы сам себя. Обратные вызовы backend выполняются здесь же
+void ConfiguratorDatabase::waitAsyncAdds()
+{
+    startAsyncAdd();
+    while (asyncAddRunning)
+    {
+        ioBackend->submit();
+        ioBackend->complete(true);
+    }
+}
+
 // Деструктор для закрытия файлов перед уничтожением объекта
 ConfiguratorDatabase::~ConfiguratorDatabase()
 {
@@ -0,0 +1,23 @@
+// src/HashingEngine.cpp
+
+#include "HashingEngine.hpp"
+#include "Argon2Hashing.hpp"
+#include "Argon2Kernels.hpp"
+#include "Hashing.hpp"
+
+// Выберет ли create встроенную реализацию на этом процессоре
+bool HashingEngine::builtinPreferred()
+{
+    Argon2Kernel kernel = Argon2Kernels::best();
+    return kernel == Argon2Kernel::AVX2 || kernel == Argon2Kernel::AVX512;
+}
+
+// Хеши обеих реализаций в одном формате, поэтому выбор не влияет на уже записанные пароли
+std::unique_ptr<HashingInterface> HashingEngine::create(bool preferBuiltin)
+{
+    if (preferBuiltin && builtinPreferred())
+    {
+        return std::make_unique<Argon2Hashing>();
+    }
+    return std::make_unique<Hashing>();
+}
@@ -0,0 +1,243 @@
+// src/HashingWorkerPool.cpp
+
+#include <algorithm>
+
+#include "HashingWorkerPool.hpp"
+
+static const int INTERACTIVE = static_cast<int>(HashingPriority::INTERACTIVE);
+static const int ADMIN = static_cast<int>(HashingPriority::ADMIN);
+static const int BULK = static_cast<int>(HashingPriority::BULK);
+
+HashingWorkerPool::HashingWorkerPool(HashingInterface *hash, const HashingPoolOptions &poolOptions)
+    : hasher(hash), options(poolOptions), stopping(false), bulkRunning(0), completed{0, 0, 0}, promotedByAging(0),
+      latencyPosition(0), interactiveP99(0), bulkThrottled(false)
+{
+    if (options.workers == 0)
+    {
+        options.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (options.latencyWindow == 0)
+    {
+        options.latencyWindow = 1;
+    }
+    if (options.throttledBulkConcurrency == 0)
+    {
+        options.throttledBulkConcurrency = 1;
+    }
+    interactiveLatencies.reserve(options.latencyWindow);
+
+    for (size_t i = 0; i < options.workers; ++i)
+    {
+        workers.emplace_back(&HashingWorkerPool::workerLoop, this);
+    }
+}
+
+// Постановка задачи в очередь; hasher должен допускать вызовы из нескольких потоков
+std::future<ConfiguratorErrorCode> HashingWorkerPool::submit(HashingPriority priority, std::function<ConfiguratorErrorCode(HashingInterface &)> job)
+{
+    Task task;
+    task.run = std::move(job);
+    task.result = std::make_shared<std::promise<ConfiguratorErrorCode>>();
+    task.enqueued = std::chrono::steady_clock::now();
+    std::future<ConfiguratorErrorCode> result = task.result->get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queues[static_cast<int>(priority)].push_back(std::move(task));
+    }
+    available.notify_one();
+    return result;
+}
+
+// Проверка пароля в пуле
+std::future<ConfiguratorErrorCode> HashingWorkerPool::submitVerify(HashingPriority priority, const std::string &password, const std::string &hashedPassword)
+{
+    return submit(priority, [password, hashedPassword](HashingInterface &engine)
+                  { return engine.pwHashVerify(password, hashedPassword); });
+}
+
+// Выбор очереди для следующей задачи (-1, если запускать нечего); вызывается под mutex
+int HashingWorkerPool::pickQueue(std::chrono::steady_clock::time_point now)
+{
+    // Ограничение снимается, если интерактивных задач давно не было
+    if (bulkThrottled && queues[INTERACTIVE].empty() && now - lastInteractive >= options.throttleRecovery)
+    {
+        bulkThrottled = false;
+        interactiveLatencies.clear();
+        latencyPosition = 0;
+        interactiveP99 = std::chrono::microseconds(0);
+    }
+
+    bool higherQueued = !queues[INTERACTIVE].empty() || !queues[ADMIN].empty();
+    bool bulkAllowed = !bulkThrottled || (!higherQueued && bulkRunning < options.throttledBulkConcurrency);
+
+    // Защита от голодания: самая старая из задач низших классов, прождавших дольше starvationTimeout
+    int aged = -1;
+    for (int priority = ADMIN; priority <= BULK; ++priority)
+    {
+        if (queues[priority].empty() || (priority == BULK && !bulkAllowed))
+        {
+            continue;
+        }
+        const Task &head = queues[priority].front();
+        if (now - head.enqueued >= options.starvationTimeout &&
+            (aged < 0 || head.enqueued < queues[aged].front().enqueued))
+        {
+            aged = priority;
+        }
+    }
+    if (aged >= 0)
+    {
+        for (int priority = INTERACTIVE; priority < aged; ++priority)
+        {
+            if (!queues[priority].empty())
+            {
+                ++promotedByAging;
+                break;
+            }
+        }
+        return aged;
+    }
+
+    for (int priority = INTERACTIVE; priority <= BULK; ++priority)
+    {
+        if (!queues[priority].empty() && (priority != BULK || bulkAllowed))
+        {
+            return priority;
+        }
+    }
+    return -1;
+}
+
+// Учет завершенной задачи; вызывается под mutex
+void HashingWorkerPool::recordCompletion(int priority, std::chrono::steady_clock::time_point enqueued,
+                                         std::chrono::steady_clock::time_point finished)
+{
+    ++completed[priority];
+    if (priority != INTERACTIVE)
+    {
+        return;
+    }
+
+    std::chrono::microseconds latency = std::chrono::duration_cast<std::chrono::microseconds>(finished - enqueued);
+    if (interactiveLatencies.size() < options.latencyWindow)
+    {
+        interactiveLatencies.push_back(latency);
+    }
+    else
+    {
+        interactiveLatencies[latencyPosition] = latency;
+    }
+    latencyPosition = (latencyPosition + 1) % options.latencyWindow;
+    lastInteractive = finished;
+
+    // p99 по окну последних задач (окно небольшое, частичная сортировка копии дешевле хеширования)
+    std::vector<std::chrono::microseconds> sorted(interactiveLatencies);
+    size_t index = (sorted.size() * 99 + 99) / 100 - 1;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    interactiveP99 = sorted[index];
+
+    bulkThrottled = options.interactiveP99Target.count() > 0 && interactiveP99 > options.interactiveP99Target;
+}
+
+// Основной цикл потока
+void HashingWorkerPool::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        int priority;
+        while ((priority = pickQueue(std::chrono::steady_clock::now())) < 0)
+        {
+            if (stopping && queues[INTERACTIVE].empty() && queues[ADMIN].empty() && queues[BULK].empty())
+            {
+                return;
+            }
+            // При ограничении ожидание периодически прерывается, чтобы проверить его снятие
+            if (bulkThrottled)
+            {
+                available.wait_for(lock, options.throttleRecovery);
+            }
+            else
+            {
+                available.wait(lock);
+            }
+        }
+
+        Task task = std::move(queues[priority].front());
+        queues[priority].pop_front();
+        if (priority == BULK)
+        {
+            ++bulkRunning;
+        }
+
+        lock.unlock();
+        ConfiguratorErrorCode code = task.run(*hasher);
+        std::chrono::steady_clock::time_point finished = std::chrono::steady_clock::now();
+        lock.lock();
+
+        if (priority == BULK)
+        {
+            --bulkRunning;
+        }
+        recordCompletion(priority, task.enqueued, finished);
+
+        // Завершение задачи может разрешить запуск отложенных массовых задач
+        available.notify_all();
+
+        // Результат передается вне блокировки, статистика к этому моменту уже обновлена
+        lock.unlock();
+        task.result->set_value(code);
+        lock.lock();
+    }
+}
+
+// Текущая статистика
+HashingPoolStats HashingWorkerPool::stats()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    HashingPoolStats result;
+    for (int priority = INTERACTIVE; priority <= BULK; ++priority)
+    {
+        result.completed[priority] = completed[priority];
+        result.queued[priority] = queues[priority].size();
+    }
+    result.promotedByAging = promotedByAging;
+    result.interactiveP99 = interactiveP99;
+    result.bulkThrottled = bulkThrottled;
+    return result;
+}
+
+// Дожидается выполнения задач в очереди и останавливает потоки
+HashingWorkerPool::~HashingWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+PooledHashing::PooledHashing(HashingWorkerPool *workerPool, HashingPriority taskPriority)
+    : pool(workerPool), priority(taskPriority) {}
+
+// Метод хеширования пароля
+ConfiguratorErrorCode PooledHashing::pwHashMake(const std::string &password, std::string &hashedPassword)
+{
+    // Вызов ждет результата, поэтому ссылки на аргументы остаются действительными
+    return pool->submit(priority, [&password, &hashedPassword](HashingInterface &engine)
+                        { return engine.pwHashMake(password, hashedPassword); })
+        .get();
+}
+
+// Метод сравнения записанного хеша и хеша данного пароля
+ConfiguratorErrorCode PooledHashing::pwHashVerify(const std::string &password, const std::string &hashedPassword)
+{
+    return pool->submit(priority, [&password, &hashedPassword](HashingInterface &engine)
+                        { return engine.pwHashVerify(password, hashedPassword); })
+        .get();
+}
@@ -0,0 +1,498 @@
+// src/HttpProtocol.cpp
+
+#include <charconv>
+
+#include "HttpProtocol.hpp"
+
+// Сравнение имени заголовка без учета регистра; lowercase записано строчными буквами
+static bool equalsIgnoreCase(std::string_view value, std::string_view lowercase)
+{
+    if (value.size() != lowercase.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < value.size(); ++i)
+    {
+        char ch = value[i];
+        if (ch >= 'A' && ch <= 'Z')
+        {
+            ch = static_cast<char>(ch - 'A' + 'a');
+        }
+        if (ch != lowercase[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Удаление пробелов и табуляций по краям значения заголовка
+static std::string_view trim(std::string_view value)
+{
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+    {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+    {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+// Выделение очередного запроса; поиск конца заголовков продолжается с уже просмотренного места
+AuthProtocol::FrameStatus HttpProtocol::extractRequest(std::string_view buffer, size_t &pos, size_t &scanned, Request &request)
+{
+    std::string_view rest = buffer.substr(pos);
+    size_t headerEnd = rest.find("\r\n\r\n", scanned >= 3 ? scanned - 3 : 0);
+    if (headerEnd == std::string_view::npos)
+    {
+        scanned = rest.size();
+        return rest.size() > MAX_REQUEST_BYTES ? AuthProtocol::FrameStatus::TOO_LARGE : AuthProtocol::FrameStatus::INCOMPLETE;
+    }
+    scanned = headerEnd;
+    if (headerEnd + 4 > MAX_REQUEST_BYTES)
+    {
+        return AuthProtocol::FrameStatus::TOO_LARGE;
+    }
+
+    // Строка запроса: метод, цель и версия через одиночные пробелы
+    size_t lineEnd = rest.find("\r\n");
+    std::string_view line = rest.substr(0, lineEnd);
+    size_t methodEnd = line.find(' ');
+    size_t targetEnd = methodEnd == std::string_view::npos ? methodEnd : line.find(' ', methodEnd + 1);
+    if (targetEnd == std::string_view::npos || methodEnd == 0 || targetEnd == methodEnd + 1)
+    {
+        return AuthProtocol::FrameStatus::MALFORMED;
+    }
+    std::string_view version = line.substr(targetEnd + 1);
+    if (version != "HTTP/1.1" && version != "HTTP/1.0")
+    {
+        return AuthProtocol::FrameStatus::MALFORMED;
+    }
+    request.method = line.substr(0, methodEnd);
+    request.target = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    request.authorization = std::string_view();
+    request.deadlineMs = 0;
+    request.keepAlive = version == "HTTP/1.1";
+
+    // Заголовки; учитываются только влияющие на разбор и авторизацию
+    size_t contentLength = 0;
+    size_t cursor = lineEnd + 2;
+    while (cursor < headerEnd + 2)
+    {
+        size_t end = rest.find("\r\n", cursor);
+        std::string_view header = rest.substr(cursor, end - cursor);
+        cursor = end + 2;
+        size_t colon = header.find(':');
+        if (colon == std::string_view::npos || colon == 0)
+        {
+            return AuthProtocol::FrameStatus::MALFORMED;
+        }
+        std::string_view name = header.substr(0, colon);
+        std::string_view value = trim(header.substr(colon + 1));
+        if (equalsIgnoreCase(name, "content-length"))
+        {
+            auto [last, error] = std::from_chars(value.data(), value.data() + value.size(), contentLength);
+            if (error != std::errc() || last != value.data() + value.size() || value.empty())
+            {
+                return AuthProtocol::FrameStatus::MALFORMED;
+            }
+            if (contentLength > MAX_REQUEST_BYTES)
+            {
+                return AuthProtocol::FrameStatus::TOO_LARGE;
+            }
+        }
+        else if (equalsIgnoreCase(name, "connection"))
+        {
+            if (equalsIgnoreCase(value, "close"))
+            {
+                request.keepAlive = false;
+            }
+            else if (equalsIgnoreCase(value, "keep-alive"))
+            {
+                request.keepAlive = true;
+            }
+        }
+        else if (equalsIgnoreCase(name, "authorization"))
+        {
+            request.authorization = value;
+        }
+        else if (equalsIgnoreCase(name, "x-deadline-ms"))
+        {
+            auto [last, error] = std::from_chars(value.data(), value.data() + value.size(), request.deadlineMs);
+            if (error != std::errc() || last != value.data() + value.size() || value.empty())
+            {
+                return AuthProtocol::FrameStatus::MALFORMED;
+            }
+        }
+        else if (equalsIgnoreCase(name, "transfer-encoding"))
+        {
+            return AuthProtocol::FrameStatus::MALFORMED; // Тело без Content-Length не поддерживается
+        }
+    }
+
+    size_t total = headerEnd + 4 + contentLength;
+    if (total > MAX_REQUEST_BYTES)
+    {
+        return AuthProtocol::FrameStatus::TOO_LARGE;
+    }
+    if (rest.size() < total)
+    {
+        return AuthProtocol::FrameStatus::INCOMPLETE;
+    }
+    request.body = rest.substr(headerEnd + 4, contentLength);
+    pos += total;
+    scanned = 0;
+    return AuthProtocol::FrameStatus::COMPLETE;
+}
+
+static void skipSpace(std::string_view json, size_t &pos)
+{
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\n' || json[pos] == '\r'))
+    {
+        ++pos;
+    }
+}
+
+// Четыре шестнадцатеричные цифры escape-последовательности \u
+static bool readHex4(std::string_view json, size_t &pos, unsigned &value)
+{
+    if (json.size() - pos < 4)
+    {
+        return false;
+    }
+    auto [last, error] = std::from_chars(json.data() + pos, json.data() + pos + 4, value, 16);
+    if (error != std::errc() || last != json.data() + pos + 4)
+    {
+        return false;
+    }
+    pos += 4;
+    return true;
+}
+
+// Запись кодовой точки в UTF-8
+static void appendUtf8(std::string &out, unsigned code)
+{
+    if (code < 0x80)
+    {
+        out += static_cast<char>(code);
+    }
+    else if (code < 0x800)
+    {
+        out += static_cast<char>(0xc0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3f));
+    }
+    else if (code < 0x10000)
+    {
+        out += static_cast<char>(0xe0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (code & 0x3f));
+    }
+    else
+    {
+        out += static_cast<char>(0xf0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (code & 0x3f));
+    }
+}
+
+// Строка JSON начиная с открывающей кавычки; escape-последовательности раскрываются
+static bool readString(std::string_view json, size_t &pos, std::string &value)
+{
+    if (pos >= json.size() || json[pos] != '"')
+    {
+        return false;
+    }
+    ++pos;
+    value.clear();
+    while (pos < json.size())
+    {
+        char ch = json[pos++];
+        if (ch == '"')
+        {
+            return true;
+        }
+        if (static_cast<unsigned char>(ch) < 0x20)
+        {
+            return false;
+        }
+        if (ch != '\\')
+        {
+            value += ch;
+            continue;
+        }
+        if (pos >= json.size())
+        {
+            return false;
+        }
+        char escape = json[pos++];
+        unsigned code;
+        switch (escape)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            value += escape;
+            break;
+        case 'b':
+            value += '\b';
+            break;
+        case 'f':
+            value += '\f';
+            break;
+        case 'n':
+            value += '\n';
+            break;
+        case 'r':
+            value += '\r';
+            break;
+        case 't':
+            value += '\t';
+            break;
+        case 'u':
+            if (!readHex4(json, pos, code) || (code >= 0xdc00 && code < 0xe000))
+            {
+                return false;
+            }
+            if (code >= 0xd800 && code < 0xdc00)
+            {
+                // Суррогатная пара: вторая половина обязана следовать сразу
+                unsigned low;
+                if (json.substr(pos, 2) != "\\u" || (pos += 2, !readHex4(json, pos, low)) || low < 0xdc00 || low >= 0xe000)
+                {
+                    return false;
+                }
+                code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+            }
+            appendUtf8(value, code);
+            break;
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+// Строковые поля login и password из объекта JSON; значения разбираются сразу в поля результата
+bool HttpProtocol::parseCredentials(std::string_view body, std::string &login, std::string &password)
+{
+    size_t pos = 0;
+    skipSpace(body, pos);
+    if (pos >= body.size() || body[pos++] != '{')
+    {
+        return false;
+    }
+    bool hasLogin = false;
+    bool hasPassword = false;
+    std::string key;
+    std::string ignored;
+    skipSpace(body, pos);
+    bool empty = pos < body.size() && body[pos] == '}';
+    if (empty)
+    {
+        ++pos;
+    }
+    while (!empty)
+    {
+        skipSpace(body, pos);
+        if (!readString(body, pos, key))
+        {
+            return false;
+        }
+        skipSpace(body, pos);
+        if (pos >= body.size() || body[pos++] != ':')
+        {
+            return false;
+        }
+        skipSpace(body, pos);
+        std::string *target = &ignored;
+        if (key == "login")
+        {
+            target = &login;
+            hasLogin = true;
+        }
+        else if (key == "password")
+        {
+            target = &password;
+            hasPassword = true;
+        }
+        if (!readString(body, pos, *target))
+        {
+            return false;
+        }
+        skipSpace(body, pos);
+        if (pos >= body.size())
+        {
+            return false;
+        }
+        char separator = body[pos++];
+        if (separator == '}')
+        {
+            break;
+        }
+        if (separator != ',')
+        {
+            return false;
+        }
+    }
+    skipSpace(body, pos);
+    return pos == body.size() && hasLogin && hasPassword;
+}
+
+// Дописывание строки JSON в кавычках с экранированием
+void HttpProtocol::appendJsonString(std::string &out, std::string_view value)
+{
+    static const char digits[] = "0123456789abcdef";
+    out += '"';
+    for (char ch : value)
+    {
+        if (ch == '"' || ch == '\\')
+        {
+            out += '\\';
+            out += ch;
+        }
+        else if (static_cast<unsigned char>(ch) < 0x20)
+        {
+            out += "\\u00";
+            out += digits[ch >> 4];
+            out += digits[ch & 0x0f];
+        }
+        else
+        {
+            out += ch;
+        }
+    }
+    out += '"';
+}
+
+static std::string_view reasonPhrase(unsigned statusCode)
+{
+    switch (statusCode)
+    {
+    case 200:
+        return "OK";
+    case 400:
+        return "Bad Request";
+    case 401:
+        return "Unauthorized";
+    case 403:
+        return "Forbidden";
+    case 404:
+        return "Not Found";
+    case 405:
+        return "Method Not Allowed";
+    case 413:
+        return "Content Too Large";
+    case 429:
+        return "Too Many Requests";
+    case 503:
+        return "Service Unavailable";
+    case 504:
+        return "Gateway Timeout";
+    default:
+        return "Internal Server Error";
+    }
+}
+
+// Дописывание ответа с телом JSON; буфер расширяется один раз под заголовки и тело
+void HttpProtocol::appendResponse(std::string &out, unsigned statusCode, std::string_view body, bool keepAlive, unsigned retryAfterSeconds)
+{
+    std::string_view reason = reasonPhrase(statusCode);
+    char number[24];
+    out.reserve(out.size() + 128 + reason.size() + body.size());
+    out += "HTTP/1.1 ";
+    out.append(number, std::to_chars(number, number + sizeof(number), statusCode).ptr);
+    out += ' ';
+    out += reason;
+    out += "\r\nContent-Type: application/json\r\nContent-Length: ";
+    out.append(number, std::to_chars(number, number + sizeof(number), body.size()).ptr);
+    if (retryAfterSeconds > 0)
+    {
+        out += "\r\nRetry-After: ";
+        out.append(number, std::to_chars(number, number + sizeof(number), retryAfterSeconds).ptr);
+    }
+    out += keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+    out += body;
+}
+
+// Код HTTP для результата проверки
+unsigned HttpProtocol::statusCode(UserErrorCode status)
+{
+    switch (status)
+    {
+    case UserErrorCode::SUCCESS:
+        return 200;
+    case UserErrorCode::LOGIN_ENTERING_ERROR:
+    case UserErrorCode::PASSWORD_ENTERING_ERROR:
+    case UserErrorCode::PASSWORD_REJECTED:
+        return 400;
+    case UserErrorCode::LOGIN_NOT_EXISTS:
+    case UserErrorCode::WRONG_PASSWORD:
+    case UserErrorCode::SESSION_EXPIRED:
+        return 401;
+    case UserErrorCode::PASSWORD_HAS_EXPIRED:
+    case UserErrorCode::ACCOUNT_LOCKED:
+    case UserErrorCode::ROLE_NOT_GRANTED:
+        return 403;
+    case UserErrorCode::RATE_LIMITED:
+        return 429;
+    case UserErrorCode::OVERLOADED:
+        return 503;
+    case UserErrorCode::DEADLINE_EXCEEDED:
+        return 504;
+    default:
+        return 500;
+    }
+}
+
+const char *HttpProtocol::statusName(UserErrorCode status)
+{
+    switch (status)
+    {
+    case UserErrorCode::SUCCESS:
+        return "SUCCESS";
+    case UserErrorCode::LOGIN_ENTERING_ERROR:
+        return "LOGIN_ENTERING_ERROR";
+    case UserErrorCode::PASSWORD_ENTERING_ERROR:
+        return "PASSWORD_ENTERING_ERROR";
+    case UserErrorCode::LOGIN_NOT_EXISTS:
+        return "LOGIN_NOT_EXISTS";
+    case UserErrorCode::WRONG_PASSWORD:
+        return "WRONG_PASSWORD";
+    case UserErrorCode::PASSWORD_HAS_EXPIRED:
+        return "PASSWORD_HAS_EXPIRED";
+    case UserErrorCode::ACCOUNT_LOCKED:
+        return "ACCOUNT_LOCKED";
+    case UserErrorCode::SESSION_EXPIRED:
+        return "SESSION_EXPIRED";
+    case UserErrorCode::RATE_LIMITED:
+        return "RATE_LIMITED";
+    case UserErrorCode::PASSWORD_REJECTED:
+        return "PASSWORD_REJECTED";
+    case UserErrorCode::ROLE_NOT_GRANTED:
+        return "ROLE_NOT_GRANTED";
+    case UserErrorCode::OVERLOADED:
+        return "OVERLOADED";
+    case UserErrorCode::DEADLINE_EXCEEDED:
+        return "DEADLINE_EXCEEDED";
+    default:
+        return "GETTING_DATA_FROM_DB_ERROR";
+    }
+}
+
+const char *HttpProtocol::roleName(UserRole role)
+{
+    switch (role)
+    {
+    case UserRole::ROLE1:
+        return "ROLE1";
+    case UserRole::ROLE2:
+        return "ROLE2";
+    case UserRole::ROLE3:
+        return "ROLE3";
+    default:
+        return "ROLE4";
+    }
+}
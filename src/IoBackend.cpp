@@ -0,0 +1,19 @@
+// src/IoBackend.cpp
+
+#include "IoBackend.hpp"
+#include "IoUringBackend.hpp"
+#include "ThreadPoolIoBackend.hpp"
+
+// io_uring может быть запрещен (seccomp, kernel.io_uring_disabled) или отсутствовать в старом ядре
+std::unique_ptr<IoBackendInterface> IoBackend::create(bool preferIoUring, unsigned entries, size_t threads)
+{
+    if (preferIoUring)
+    {
+        std::unique_ptr<IoUringBackend> ring = std::make_unique<IoUringBackend>(entries);
+        if (ring->available())
+        {
+            return ring;
+        }
+    }
+    return std::make_unique<ThreadPoolIoBackend>(threads);
+}
@@ -0,0 +1,314 @@
+// src/IoUringBackend.cpp
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <utility>
+
+#include "IoUringBackend.hpp"
+
+static int ioUringSetup(unsigned entries, io_uring_params *params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static int ioUringRegister(int fd, unsigned opcode, void *arg, unsigned count)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+// Индексы колец общие с ядром: владелец читает чужой индекс с acquire и публикует свой с release
+static unsigned loadAcquire(unsigned *index)
+{
+    return std::atomic_ref<unsigned>(*index).load(std::memory_order_acquire);
+}
+
+static void storeRelease(unsigned *index, unsigned value)
+{
+    std::atomic_ref<unsigned>(*index).store(value, std::memory_order_release);
+}
+
+IoUringBackend::IoUringBackend(unsigned entries)
+{
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ringFd = ioUringSetup(entries, &params);
+    if (ringFd < 0)
+    {
+        return;
+    }
+
+    // Ядра без операций чтения и записи по адресу (до 5.6) считаются неподдерживаемыми
+    std::vector<unsigned char> probeBuffer(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op), 0);
+    io_uring_probe *probe = reinterpret_cast<io_uring_probe *>(probeBuffer.data());
+    if (ioUringRegister(ringFd, IORING_REGISTER_PROBE, probe, 256) < 0)
+    {
+        release();
+        return;
+    }
+    for (unsigned operation : {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_FSYNC})
+    {
+        if (operation > probe->last_op || !(probe->ops[operation].flags & IO_URING_OP_SUPPORTED))
+        {
+            release();
+            return;
+        }
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMap)
+    {
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    }
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED)
+    {
+        sqRing = nullptr;
+        release();
+        return;
+    }
+    if (singleMap)
+    {
+        cqRing = sqRing;
+    }
+    else
+    {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED)
+        {
+            cqRing = nullptr;
+            release();
+            return;
+        }
+    }
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (sqesMap == MAP_FAILED)
+    {
+        release();
+        return;
+    }
+    sqes = static_cast<io_uring_sqe *>(sqesMap);
+
+    char *sq = static_cast<char *>(sqRing);
+    sqHead = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sqMask = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sqEntries = params.sq_entries;
+    sqArray = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    char *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cqMask = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqEntries = params.cq_entries;
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    completionFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (completionFd < 0 || ioUringRegister(ringFd, IORING_REGISTER_EVENTFD, &completionFd, 1) < 0)
+    {
+        release();
+    }
+}
+
+// Освобождение кольца; после него available() возвращает false
+void IoUringBackend::release()
+{
+    if (sqes != nullptr)
+    {
+        munmap(sqes, sqesSize);
+        sqes = nullptr;
+    }
+    if (cqRing != nullptr && cqRing != sqRing)
+    {
+        munmap(cqRing, cqRingSize);
+    }
+    cqRing = nullptr;
+    if (sqRing != nullptr)
+    {
+        munmap(sqRing, sqRingSize);
+        sqRing = nullptr;
+    }
+    if (completionFd >= 0)
+    {
+        close(completionFd);
+        completionFd = -1;
+    }
+    if (ringFd >= 0)
+    {
+        close(ringFd);
+        ringFd = -1;
+    }
+}
+
+// Создано ли кольцо и поддерживает ли ядро нужные операции
+bool IoUringBackend::available() const
+{
+    return ringFd >= 0;
+}
+
+// Сохранение обратного вызова; номер уходит в user_data операции
+uint32_t IoUringBackend::store(Completion done)
+{
+    if (freeSlots.empty())
+    {
+        callbacks.push_back(std::move(done));
+        return static_cast<uint32_t>(callbacks.size() - 1);
+    }
+    uint32_t slot = freeSlots.back();
+    freeSlots.pop_back();
+    callbacks[slot] = std::move(done);
+    return slot;
+}
+
+void IoUringBackend::enqueue(Operation operation, int fd, void *buffer, size_t size, off_t offset, Completion done)
+{
+    queued.push_back({operation, fd, buffer, size, offset, store(std::move(done))});
+}
+
+void IoUringBackend::read(int fd, void *buffer, size_t size, off_t offset, Completion done)
+{
+    enqueue(Operation::READ, fd, buffer, size, offset, std::move(done));
+}
+
+void IoUringBackend::write(int fd, const void *data, size_t size, off_t offset, Completion done)
+{
+    enqueue(Operation::WRITE, fd, const_cast<void *>(data), size, offset, std::move(done));
+}
+
+void IoUringBackend::fsync(int fd, Completion done)
+{
+    enqueue(Operation::FSYNC, fd, nullptr, 0, 0, std::move(done));
+}
+
+// Заполнение кольца отправки и один io_uring_enter на весь пакет
+size_t IoUringBackend::submit()
+{
+    size_t filled = 0;
+    unsigned tail = *sqTail;
+    while (filled < queued.size() && submitted + filled < cqEntries && tail - loadAcquire(sqHead) < sqEntries)
+    {
+        const Request &request = queued[filled];
+        unsigned index = tail & sqMask;
+        io_uring_sqe &sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.fd = request.fd;
+        sqe.user_data = request.slot;
+        switch (request.operation)
+        {
+        case Operation::READ:
+            sqe.opcode = IORING_OP_READ;
+            break;
+        case Operation::WRITE:
+            sqe.opcode = IORING_OP_WRITE;
+            break;
+        case Operation::FSYNC:
+            sqe.opcode = IORING_OP_FSYNC;
+            sqe.flags = IOSQE_IO_DRAIN;
+            break;
+        }
+        sqe.addr = reinterpret_cast<uintptr_t>(request.buffer);
+        sqe.len = static_cast<uint32_t>(request.size);
+        sqe.off = static_cast<uint64_t>(request.offset);
+        sqArray[index] = index;
+        ++tail;
+        ++filled;
+    }
+    if (filled == 0)
+    {
+        return 0;
+    }
+    storeRelease(sqTail, tail);
+
+    // Операции, которые ядро не приняло, остаются в кольце и уходят со следующим вызовом
+    while (ioUringEnter(ringFd, tail - loadAcquire(sqHead), 0, 0) < 0 && errno == EINTR)
+    {
+    }
+    submitted += filled;
+    queued.erase(queued.begin(), queued.begin() + static_cast<std::ptrdiff_t>(filled));
+    return filled;
+}
+
+// Обратные вызовы завершившихся операций
+size_t IoUringBackend::complete(bool wait)
+{
+    if (wait && submitted == 0 && !queued.empty())
+    {
+        submit();
+    }
+    unsigned head = *cqHead;
+    if (wait && submitted > 0 && head == loadAcquire(cqTail))
+    {
+        while (ioUringEnter(ringFd, *sqTail - loadAcquire(sqHead), 1, IORING_ENTER_GETEVENTS) < 0 && errno == EINTR)
+        {
+        }
+    }
+
+    uint64_t value;
+    ssize_t unused = ::read(completionFd, &value, sizeof(value));
+    (void)unused;
+
+    // Голова перечитывается на каждом шаге: обратный вызов может сам вызвать complete()
+    size_t completed = 0;
+    while ((head = *cqHead) != loadAcquire(cqTail))
+    {
+        const io_uring_cqe &cqe = cqes[head & cqMask];
+        uint32_t slot = static_cast<uint32_t>(cqe.user_data);
+        ssize_t result = cqe.res;
+        storeRelease(cqHead, ++head);
+        --submitted;
+
+        // Обратный вызов может поставить новые операции и занять освободившийся номер
+        Completion done = std::move(callbacks[slot]);
+        callbacks[slot] = nullptr;
+        freeSlots.push_back(slot);
+        ++completed;
+        done(result);
+    }
+    return completed;
+}
+
+int IoUringBackend::eventFd() const
+{
+    return completionFd;
+}
+
+size_t IoUringBackend::inFlight() const
+{
+    return queued.size() + submitted;
+}
+
+const char *IoUringBackend::name() const
+{
+    return "io_uring";
+}
+
+IoUringBackend::~IoUringBackend()
+{
+    // Обратные вызовы не выполняются: объекты, на которые они ссылаются, могут быть уже уничтожены
+    while (ringFd >= 0 && submitted > 0)
+    {
+        unsigned head = *cqHead;
+        if (head == loadAcquire(cqTail) && ioUringEnter(ringFd, *sqTail - loadAcquire(sqHead), 1, IORING_ENTER_GETEVENTS) < 0 &&
+            errno != EINTR)
+        {
+            break;
+        }
+        unsigned tail = loadAcquire(cqTail);
+        submitted -= tail - head;
+        storeRelease(cqHead, tail);
+    }
+    release();
+}
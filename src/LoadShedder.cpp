@@ -0,0 +1,65 @@
+// src/LoadShedder.cpp
+
+#include <algorithm>
+
+#include "LoadShedder.hpp"
+
+LoadShedder::LoadShedder(unsigned maxLatencyMs, size_t workerThreads)
+    : maxLatencyMicros(static_cast<uint64_t>(maxLatencyMs) * 1000), workers(workerThreads > 0 ? workerThreads : 1),
+      averageVerifyMicros(0), measured(false), queued(0), rejected(0) {}
+
+// Ожидаемая задержка новой проверки: полные волны проверок перед ней и она сама
+uint64_t LoadShedder::predictedLatencyMicros() const
+{
+    return static_cast<uint64_t>(static_cast<double>(queued / workers + 1) * averageVerifyMicros);
+}
+
+// Допуск новой проверки
+bool LoadShedder::admit(uint32_t &retryAfterMs)
+{
+    retryAfterMs = 0;
+    if (maxLatencyMicros == 0 || !measured)
+    {
+        return true;
+    }
+    uint64_t predicted = predictedLatencyMicros();
+    if (predicted <= maxLatencyMicros)
+    {
+        return true;
+    }
+    // Лишние волны уйдут за время, на которое оценка превышает предел; не раньше одной проверки
+    uint64_t wait = std::max<uint64_t>(predicted - maxLatencyMicros, static_cast<uint64_t>(averageVerifyMicros));
+    retryAfterMs = static_cast<uint32_t>(std::min<uint64_t>((wait + 999) / 1000, UINT32_MAX));
+    ++rejected;
+    return false;
+}
+
+void LoadShedder::started()
+{
+    ++queued;
+}
+
+void LoadShedder::finished(uint64_t verifyMicros)
+{
+    if (queued > 0)
+    {
+        --queued;
+    }
+    if (verifyMicros == 0)
+    {
+        return;
+    }
+    averageVerifyMicros = measured ? averageVerifyMicros + (static_cast<double>(verifyMicros) - averageVerifyMicros) / 8
+                                   : static_cast<double>(verifyMicros);
+    measured = true;
+}
+
+size_t LoadShedder::depth() const
+{
+    return queued;
+}
+
+uint64_t LoadShedder::rejectedCount() const
+{
+    return rejected;
+}
@@ -0,0 +1,280 @@
+// src/LockoutTable.cpp
+
+#include <cstring>
+#include <fcntl.h>
+#include <sodium.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "LockoutTable.hpp"
+
+static_assert(LockoutFileHeader::KEY_BYTES == crypto_shorthash_KEYBYTES, "the lockout file stores a SipHash key");
+
+LockoutTable::LockoutTable() : fd(-1), mapping(nullptr), mappingSize(0), slots(nullptr), capacity(0), hashKey()
+{
+    // libsodium — источник ключа хеша для нового файла
+    sodium_init();
+}
+
+// SipHash-2-4 с ключом файла: ключ один для всех процессов, открывших файл, но неизвестен без доступа к нему
+uint64_t LockoutTable::keyOf(const std::string &login) const
+{
+    unsigned char out[crypto_shorthash_BYTES];
+    crypto_shorthash(out, reinterpret_cast<const unsigned char *>(login.data()), login.size(), hashKey);
+    uint64_t hash;
+    std::memcpy(&hash, out, sizeof(hash));
+    return hash != 0 ? hash : 1;
+}
+
+// Открытие или создание файла. Размер существующего файла сохраняется;
+// файл другого формата создается заново
+ConfiguratorErrorCode LockoutTable::open(const std::string &path, size_t slotCount)
+{
+    size_t requested = 1;
+    while (requested < slotCount || requested < MAX_PROBE)
+    {
+        requested <<= 1;
+    }
+
+    // Счетчики не должны быть доступны на запись другим пользователям
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    // Проверка и инициализация заголовка сериализуются между процессами
+    if (flock(fd, LOCK_EX) != 0)
+    {
+        close(fd);
+        fd = -1;
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    LockoutFileHeader header{};
+    struct stat fileStat;
+    bool valid = fstat(fd, &fileStat) == 0 &&
+                 pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                 header.magic == LockoutFileHeader::MAGIC && header.version == LockoutFileHeader::VERSION &&
+                 header.capacity >= MAX_PROBE && (header.capacity & (header.capacity - 1)) == 0 &&
+                 static_cast<uint64_t>(fileStat.st_size) == sizeof(header) + header.capacity * sizeof(LockoutSlot);
+    if (!valid)
+    {
+        header = LockoutFileHeader{};
+        header.magic = LockoutFileHeader::MAGIC;
+        header.version = LockoutFileHeader::VERSION;
+        header.capacity = requested;
+        randombytes_buf(header.hashKey, sizeof(header.hashKey));
+        size_t size = sizeof(header) + requested * sizeof(LockoutSlot);
+        // Усечение до нуля обнуляет прежнее содержимое
+        valid = ftruncate(fd, 0) == 0 && ftruncate(fd, static_cast<off_t>(size)) == 0 &&
+                pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    }
+
+    if (valid)
+    {
+        capacity = static_cast<size_t>(header.capacity);
+        mappingSize = sizeof(header) + capacity * sizeof(LockoutSlot);
+        mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    flock(fd, LOCK_UN);
+
+    if (!valid || mapping == MAP_FAILED)
+    {
+        mapping = nullptr;
+        capacity = 0;
+        close(fd);
+        fd = -1;
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    std::memcpy(hashKey, header.hashKey, sizeof(hashKey));
+    sodium_memzero(&header, sizeof(header));
+    slots = reinterpret_cast<LockoutSlot *>(static_cast<char *>(mapping) + sizeof(LockoutFileHeader));
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Поиск записи логина без вставки
+LockoutSlot *LockoutTable::find(uint64_t key) const
+{
+    if (slots == nullptr)
+    {
+        return nullptr;
+    }
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < MAX_PROBE; ++i)
+    {
+        LockoutSlot &slot = slots[(key + i) & mask];
+        if (slot.key.load(std::memory_order_acquire) == key)
+        {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+// Все записи окна поиска ключа заблокированы в момент now; lockedUntil — ближайшее окончание блокировки
+bool LockoutTable::windowLocked(uint64_t key, int64_t now, int64_t &lockedUntil) const
+{
+    if (slots == nullptr)
+    {
+        return false;
+    }
+    size_t mask = capacity - 1;
+    lockedUntil = 0;
+    for (size_t i = 0; i < MAX_PROBE; ++i)
+    {
+        const LockoutSlot &slot = slots[(key + i) & mask];
+        int64_t until = slot.lockedUntil.load(std::memory_order_acquire);
+        if (slot.key.load(std::memory_order_relaxed) == 0 || until <= now)
+        {
+            return false;
+        }
+        lockedUntil = i == 0 || until < lockedUntil ? until : lockedUntil;
+    }
+    return true;
+}
+
+// Поиск или занятие записи; staleAfter — через сколько секунд без неудач запись можно занять заново
+LockoutSlot *LockoutTable::findOrInsert(uint64_t key, int64_t now, int64_t staleAfter)
+{
+    if (slots == nullptr)
+    {
+        return nullptr;
+    }
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < MAX_PROBE; ++i)
+    {
+        LockoutSlot &slot = slots[(key + i) & mask];
+        uint64_t current = slot.key.load(std::memory_order_acquire);
+        if (current == 0 && slot.key.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+        {
+            return &slot; // Свободная запись всегда обнулена
+        }
+        if (current == key)
+        {
+            return &slot;
+        }
+    }
+
+    // Окно заполнено: занимается запись без действующей блокировки, лучше всего без недавних неудач,
+    // иначе — с самой старой неудачей. Запись, измененная другим потоком во время выбора, выбирается заново.
+    // Попытка, учтенная прежним владельцем между заменой ключа и сбросом, теряется
+    for (size_t attempt = 0; attempt < MAX_PROBE; ++attempt)
+    {
+        LockoutSlot *victim = nullptr;
+        uint64_t victimKey = 0;
+        int64_t oldest = 0;
+        for (size_t i = 0; i < MAX_PROBE; ++i)
+        {
+            LockoutSlot &slot = slots[(key + i) & mask];
+            uint64_t current = slot.key.load(std::memory_order_acquire);
+            if (current == key)
+            {
+                return &slot; // Занята другим потоком для этого же логина
+            }
+            int64_t lastFailure = slot.lastFailure.load(std::memory_order_relaxed);
+            if (slot.lockedUntil.load(std::memory_order_relaxed) > now || (victim != nullptr && lastFailure >= oldest))
+            {
+                continue;
+            }
+            victim = &slot;
+            victimKey = current;
+            oldest = lastFailure;
+            if (now - lastFailure > staleAfter)
+            {
+                break;
+            }
+        }
+        if (victim == nullptr)
+        {
+            return nullptr;
+        }
+        if (victim->key.compare_exchange_strong(victimKey, key, std::memory_order_acq_rel))
+        {
+            victim->failures.store(0, std::memory_order_relaxed);
+            victim->lockedUntil.store(0, std::memory_order_relaxed);
+            victim->lastFailure.store(0, std::memory_order_release);
+            return victim;
+        }
+    }
+    return nullptr;
+}
+
+// Заблокирован ли логин в момент now; lockedUntil — время окончания блокировки
+bool LockoutTable::isLocked(const std::string &login, int64_t now, int64_t &lockedUntil) const
+{
+    uint64_t key = keyOf(login);
+    LockoutSlot *slot = find(key);
+    if (slot == nullptr)
+    {
+        // Логину без записи негде учесть неудачу, если все окно заблокировано
+        lockedUntil = 0;
+        return windowLocked(key, now, lockedUntil);
+    }
+    lockedUntil = slot->lockedUntil.load(std::memory_order_acquire);
+    return lockedUntil > now;
+}
+
+// Учет неудачной попытки
+bool LockoutTable::recordFailure(const std::string &login, unsigned maxFailures, int64_t lockoutSeconds, int64_t now)
+{
+    if (maxFailures == 0 || lockoutSeconds <= 0)
+    {
+        return false; // Блокировка отключена
+    }
+    LockoutSlot *slot = findOrInsert(keyOf(login), now, lockoutSeconds);
+    if (slot == nullptr)
+    {
+        return true; // Все записи окна заблокированы: неудачу негде учесть, и логин считается заблокированным
+    }
+    if (slot->lockedUntil.load(std::memory_order_acquire) > now)
+    {
+        return true;
+    }
+
+    // Неудачи старше окна подсчета не учитываются
+    uint32_t failures;
+    int64_t previous = slot->lastFailure.exchange(now, std::memory_order_acq_rel);
+    if (now - previous > lockoutSeconds)
+    {
+        slot->failures.store(1, std::memory_order_relaxed);
+        failures = 1;
+    }
+    else
+    {
+        failures = slot->failures.fetch_add(1, std::memory_order_acq_rel) + 1;
+    }
+
+    if (failures >= maxFailures)
+    {
+        slot->failures.store(0, std::memory_order_relaxed);
+        slot->lockedUntil.store(now + lockoutSeconds, std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+// Сброс счетчика после успешного входа
+void LockoutTable::recordSuccess(const std::string &login)
+{
+    LockoutSlot *slot = find(keyOf(login));
+    if (slot != nullptr)
+    {
+        slot->failures.store(0, std::memory_order_relaxed);
+    }
+}
+
+LockoutTable::~LockoutTable()
+{
+    if (mapping != nullptr)
+    {
+        munmap(mapping, mappingSize);
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
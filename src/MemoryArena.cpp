@@ -0,0 +1,109 @@
+// src/MemoryArena.cpp
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <sodium.h>
+
+#include "MemoryArena.hpp"
+
+// Размер огромной страницы, под который выравнивается область
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+static size_t roundUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+MemoryArena::MemoryArena() : base(nullptr), capacity(0), hugePages(false) {}
+
+// Освобождение текущей области
+void MemoryArena::release()
+{
+    if (base != nullptr)
+    {
+        // Область содержит производные от паролей данные - затираем перед возвратом системе
+        sodium_memzero(base, capacity);
+        munmap(base, capacity);
+    }
+    base = nullptr;
+    capacity = 0;
+    hugePages = false;
+}
+
+// Получение области размером не менее bytes байт; при нехватке область пересоздается
+void *MemoryArena::reserve(size_t bytes)
+{
+    if (bytes <= capacity)
+    {
+        return base;
+    }
+
+    release();
+    size_t length = roundUp(bytes, HUGE_PAGE_SIZE);
+
+    // Сначала пробуем явные огромные страницы (требуют настроенного vm.nr_hugepages)
+    void *region = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+    if (region != MAP_FAILED)
+    {
+        base = region;
+        capacity = length;
+        hugePages = true;
+        return base;
+    }
+
+    // Иначе обычное отображение с просьбой к ядру использовать прозрачные огромные страницы
+    region = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED)
+    {
+        return nullptr;
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(region, length, MADV_HUGEPAGE);
+#endif
+
+    // Заранее вызываем страничные отказы, чтобы они не попадали во время хеширования
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    volatile char *bytesPtr = static_cast<volatile char *>(region);
+    for (size_t offset = 0; offset < length; offset += pageSize)
+    {
+        bytesPtr[offset] = 0;
+    }
+
+    base = region;
+    capacity = length;
+    return base;
+}
+
+// Затирание первых bytes байт области (не больше ее размера)
+void MemoryArena::wipe(size_t bytes)
+{
+    if (base != nullptr)
+    {
+        sodium_memzero(base, bytes < capacity ? bytes : capacity);
+    }
+}
+
+// Текущий размер области
+size_t MemoryArena::size() const
+{
+    return capacity;
+}
+
+// Выделена ли область на явных огромных страницах
+bool MemoryArena::usesHugePages() const
+{
+    return hugePages;
+}
+
+// Арена текущего потока (создается при первом обращении, живет до завершения потока)
+MemoryArena &MemoryArena::threadLocal()
+{
+    thread_local MemoryArena arena;
+    return arena;
+}
+
+MemoryArena::~MemoryArena()
+{
+    release();
+}
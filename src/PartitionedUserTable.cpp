@@ -0,0 +1,149 @@
+// src/PartitionedUserTable.cpp
+
+#include <utility>
+
+#include "PartitionedUserTable.hpp"
+
+PartitionedUserTable::PartitionedUserTable(size_t cores, size_t queueCapacity) : coreCount(cores > 0 ? cores : 1)
+{
+    for (size_t i = 0; i < coreCount; ++i)
+    {
+        state.push_back(std::make_unique<Core>());
+        state.back()->held.resize(coreCount);
+    }
+    // Очереди ядра к самому себе не используются, но индексируются так же
+    for (size_t i = 0; i < coreCount * coreCount; ++i)
+    {
+        queues.push_back(std::make_unique<SpscQueue<Message>>(queueCapacity));
+    }
+}
+
+// Заполнение разделов из базы; для повторяющегося логина, как в ConfiguratorDatabase, используется первая строка
+ConfiguratorErrorCode PartitionedUserTable::load(ConfiguratorDatabaseInterface &db)
+{
+    for (std::unique_ptr<Core> &core : state)
+    {
+        core->partition.clear();
+    }
+    std::string line;
+    ConfiguratorErrorCode errorCode = db.getFirstActiveUser(line);
+    while (errorCode == ConfiguratorErrorCode::SUCCESS)
+    {
+        std::string login = line.substr(0, line.find(' '));
+        state[owner(login)]->partition.emplace(std::move(login), line);
+        errorCode = db.getNextActiveUser(line);
+    }
+    return errorCode == ConfiguratorErrorCode::END_OF_TABLE ? ConfiguratorErrorCode::SUCCESS : errorCode;
+}
+
+// Ядро — владелец раздела с логином
+size_t PartitionedUserTable::owner(std::string_view login) const
+{
+    return std::hash<std::string_view>{}(login) % coreCount;
+}
+
+// Поиск записи в разделе ядра
+ConfiguratorErrorCode PartitionedUserTable::find(const Core &core, const std::string &login, const std::string *&record) const
+{
+    auto it = core.partition.find(login);
+    record = it != core.partition.end() ? &it->second : nullptr;
+    return record != nullptr ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::LOGIN_NOT_FOUND;
+}
+
+// Отправка сообщения ядру to; при заполненной очереди сообщение ждет следующего poll(from).
+// Отправка не ждет получателя, поэтому ядра, отправляющие друг другу, не блокируют друг друга
+void PartitionedUserTable::send(size_t from, size_t to, Message &message)
+{
+    std::deque<Message> &held = state[from]->held[to];
+    if (!held.empty() || !queues[from * coreCount + to]->tryPush(message))
+    {
+        held.push_back(std::move(message));
+    }
+}
+
+// Поиск записи из потока ядра core
+void PartitionedUserTable::lookup(size_t core, std::string_view login, Callback done)
+{
+    size_t target = owner(login);
+    Core &self = *state[core];
+    if (target == core)
+    {
+        const std::string *record;
+        ConfiguratorErrorCode errorCode = find(self, std::string(login), record);
+        done(errorCode, record);
+        return;
+    }
+
+    Message message;
+    if (self.freeTags.empty())
+    {
+        message.tag = static_cast<uint32_t>(self.pending.size());
+        self.pending.push_back(std::move(done));
+    }
+    else
+    {
+        message.tag = self.freeTags.back();
+        self.freeTags.pop_back();
+        self.pending[message.tag] = std::move(done);
+    }
+    message.login.assign(login);
+    ++self.inFlight;
+    send(core, target, message);
+}
+
+// Обработка входящих сообщений ядра core
+size_t PartitionedUserTable::poll(size_t core)
+{
+    Core &self = *state[core];
+    // Сначала отложенные сообщения: они старше новых ответов в той же очереди
+    for (size_t to = 0; to < coreCount; ++to)
+    {
+        std::deque<Message> &held = self.held[to];
+        while (!held.empty() && queues[core * coreCount + to]->tryPush(held.front()))
+        {
+            held.pop_front();
+        }
+    }
+
+    size_t processed = 0;
+    Message message;
+    for (size_t from = 0; from < coreCount; ++from)
+    {
+        if (from == core)
+        {
+            continue;
+        }
+        SpscQueue<Message> &incoming = *queues[from * coreCount + core];
+        // Не больше емкости очереди за вызов: отправитель, пишущий без остановки, не задерживает остальных
+        for (size_t i = 0; i < incoming.capacity() && incoming.tryPop(message); ++i)
+        {
+            ++processed;
+            if (!message.reply)
+            {
+                message.reply = true;
+                message.code = find(self, message.login, message.record);
+                message.login.clear();
+                send(core, from, message);
+                continue;
+            }
+            // Обратный вызов может сразу отправить новый запрос и занять освободившийся тег
+            Callback done = std::move(self.pending[message.tag]);
+            self.pending[message.tag] = nullptr;
+            self.freeTags.push_back(message.tag);
+            --self.inFlight;
+            done(message.code, message.record);
+        }
+    }
+    return processed;
+}
+
+// Запросов ядра core, ожидающих ответа
+size_t PartitionedUserTable::inFlight(size_t core) const
+{
+    return state[core]->inFlight;
+}
+
+size_t PartitionedUserTable::cores() const
+{
+    return coreCount;
+}
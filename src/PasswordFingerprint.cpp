@@ -0,0 +1,136 @@
+// src/PasswordFingerprint.cpp
+
+#include <sodium.h>
+#include <fstream>
+
+#include "PasswordFingerprint.hpp"
+
+// Значение шестнадцатеричной цифры или -1
+static int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// Конструктор класса (перец не загружен, отпечатки выключены)
+PasswordFingerprint::PasswordFingerprint() : key(), loaded(false)
+{
+    sodium_init();
+}
+
+// Загрузка перца из файла: 64 шестнадцатеричных символа (пробельные символы в конце допускаются)
+ConfiguratorErrorCode PasswordFingerprint::loadPepper(const std::string &pepperPath)
+{
+    loaded = false;
+
+    std::ifstream file(pepperPath);
+    if (!file)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    std::string hex;
+    file >> hex;
+    std::string rest;
+    if (hex.size() != KEY_BYTES * 2 || (file >> rest))
+    {
+        sodium_memzero(&hex[0], hex.size());
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    for (size_t i = 0; i < KEY_BYTES; ++i)
+    {
+        int high = hexValue(hex[2 * i]);
+        int low = hexValue(hex[2 * i + 1]);
+        if (high < 0 || low < 0)
+        {
+            sodium_memzero(&hex[0], hex.size());
+            sodium_memzero(key, sizeof(key));
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+        key[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    sodium_memzero(&hex[0], hex.size());
+
+    loaded = true;
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Загружен ли перец
+bool PasswordFingerprint::isEnabled() const
+{
+    return loaded;
+}
+
+// Вычисление отпечатка пароля пользователя (8 шестнадцатеричных символов)
+ConfiguratorErrorCode PasswordFingerprint::compute(const std::string &login, const std::string &password, std::string &fingerprint) const
+{
+    if (!loaded)
+    {
+        return ConfiguratorErrorCode::HASHING_ERROR;
+    }
+
+    // Логин входит в сообщение, чтобы одинаковые пароли разных пользователей давали разные отпечатки
+    std::string message = login;
+    message += '\0';
+    message += password;
+
+    unsigned char mac[crypto_auth_hmacsha256_BYTES];
+    int result = crypto_auth_hmacsha256(mac, reinterpret_cast<const unsigned char *>(message.data()), message.size(), key);
+    sodium_memzero(&message[0], message.size());
+    if (result != 0)
+    {
+        return ConfiguratorErrorCode::HASHING_ERROR;
+    }
+
+    static const char digits[] = "0123456789abcdef";
+    fingerprint.clear();
+    for (size_t i = 0; i < FINGERPRINT_BYTES; ++i)
+    {
+        fingerprint += digits[mac[i] >> 4];
+        fingerprint += digits[mac[i] & 0x0F];
+    }
+    sodium_memzero(mac, sizeof(mac));
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Формирование записи архива из хеша и отпечатка
+std::string PasswordFingerprint::attach(const std::string &hashedPassword, const std::string &fingerprint)
+{
+    if (fingerprint.empty())
+    {
+        return hashedPassword;
+    }
+    return hashedPassword + SEPARATOR + fingerprint;
+}
+
+// Разбор записи архива; для записей без отпечатка fingerprint будет пустым
+void PasswordFingerprint::split(const std::string &entry, std::string &hashedPassword, std::string &fingerprint)
+{
+    size_t separator = entry.rfind(SEPARATOR);
+    if (separator == std::string::npos)
+    {
+        hashedPassword = entry;
+        fingerprint.clear();
+        return;
+    }
+    hashedPassword = entry.substr(0, separator);
+    fingerprint = entry.substr(separator + 1);
+}
+
+// Деструктор затирает перец
+PasswordFingerprint::~PasswordFingerprint()
+{
+    sodium_memzero(key, sizeof(key));
+}
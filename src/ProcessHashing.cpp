@@ -0,0 +1,478 @@
+// src/ProcessHashing.cpp
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ProcessHashing.hpp"
+
+static const char OPERATION_MAKE = 'M';
+static const char OPERATION_VERIFY = 'V';
+static const char OPERATION_SPAWN = 'S';
+static const char OPERATION_STOP = 'K';
+
+// Запрос к порождателю: запустить процесс с номером index или дождаться завершения процесса pid
+struct ForkerRequest
+{
+    char operation;
+    size_t index;
+    pid_t pid;
+};
+
+// Дописывание поля с 32-битной длиной
+static void appendField(std::string &message, const std::string &field)
+{
+    uint32_t length = static_cast<uint32_t>(field.size());
+    message.append(reinterpret_cast<const char *>(&length), sizeof(length));
+    message.append(field);
+}
+
+// Чтение поля с 32-битной длиной начиная с позиции pos
+static bool readField(const char *message, size_t size, size_t &pos, std::string &field)
+{
+    uint32_t length;
+    if (size - pos < sizeof(length))
+    {
+        return false;
+    }
+    std::memcpy(&length, message + pos, sizeof(length));
+    pos += sizeof(length);
+    if (size - pos < length)
+    {
+        return false;
+    }
+    field.assign(message + pos, length);
+    pos += length;
+    return true;
+}
+
+// Прием сообщения не дольше timeoutMs (0 — без срока); timedOut — срок истек
+static ssize_t receiveWithin(int socket, char *buffer, size_t size, unsigned timeoutMs, bool &timedOut)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (true)
+    {
+        int wait = -1;
+        if (timeoutMs != 0)
+        {
+            auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0)
+            {
+                timedOut = true;
+                return -1;
+            }
+            wait = static_cast<int>(left);
+        }
+        struct pollfd entry = {socket, POLLIN, 0};
+        int ready = poll(&entry, 1, wait);
+        if (ready < 0 && errno != EINTR)
+        {
+            return -1;
+        }
+        if (ready > 0)
+        {
+            return recv(socket, buffer, size, MSG_DONTWAIT);
+        }
+    }
+}
+
+// Ответ порождателя: pid и, если descriptor >= 0, сокет рабочего процесса (SCM_RIGHTS)
+static bool sendDescriptor(int socket, pid_t pid, int descriptor)
+{
+    struct iovec data = {&pid, sizeof(pid)};
+    struct msghdr message = {};
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    if (descriptor >= 0)
+    {
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(header), &descriptor, sizeof(int));
+    }
+    return sendmsg(socket, &message, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(pid));
+}
+
+// Прием ответа порождателя; descriptor = -1, если сокет не передан
+static bool receiveDescriptor(int socket, pid_t &pid, int &descriptor)
+{
+    descriptor = -1;
+    struct iovec data = {&pid, sizeof(pid)};
+    struct msghdr message = {};
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    ssize_t received;
+    do
+    {
+        received = recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+    } while (received < 0 && errno == EINTR);
+    if (received != static_cast<ssize_t>(sizeof(pid)))
+    {
+        return false;
+    }
+    for (struct cmsghdr *header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+    {
+        if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS)
+        {
+            std::memcpy(&descriptor, CMSG_DATA(header), sizeof(int));
+        }
+    }
+    return true;
+}
+
+ProcessHashing::ProcessHashing(HashingInterface *hash, const ProcessHashingOptions &processOptions)
+    : hasher(hash), options(processOptions), alive(0), restarts(0), forker(-1), control(-1)
+{
+    if (options.workers == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        options.workers = cpus > 0 ? static_cast<size_t>(cpus) : 1;
+    }
+    workers.resize(options.workers, Worker{-1, -1});
+
+    // Порождатель создается, пока основной процесс однопоточный; дальше fork выполняет только он
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0)
+    {
+        return;
+    }
+    forker = fork();
+    if (forker < 0)
+    {
+        close(sockets[0]);
+        close(sockets[1]);
+        return;
+    }
+    if (forker == 0)
+    {
+        close(sockets[0]);
+        control = sockets[1];
+        runForker();
+        // Обработчики atexit основного процесса в порождателе не выполняются
+        _exit(0);
+    }
+    close(sockets[1]);
+    control = sockets[0];
+
+    for (size_t i = 0; i < workers.size(); ++i)
+    {
+        if (spawn(i))
+        {
+            idle.push_back(i);
+            ++alive;
+        }
+    }
+}
+
+// Запуск рабочего процесса с номером index через порождатель
+bool ProcessHashing::spawn(size_t index)
+{
+    std::lock_guard<std::mutex> lock(spawnMutex);
+    if (control < 0)
+    {
+        return false;
+    }
+
+    ForkerRequest request = {OPERATION_SPAWN, index, -1};
+    pid_t pid = -1;
+    int socket = -1;
+    if (send(control, &request, sizeof(request), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(request)) ||
+        !receiveDescriptor(control, pid, socket))
+    {
+        return false; // Порождатель завершился: новые процессы запустить нельзя
+    }
+    if (pid <= 0 || socket < 0)
+    {
+        if (socket >= 0)
+        {
+            close(socket);
+        }
+        return false;
+    }
+    workers[index].pid = pid;
+    workers[index].socket = socket;
+    return true;
+}
+
+// Остановка рабочего процесса с номером index
+void ProcessHashing::stop(size_t index)
+{
+    std::lock_guard<std::mutex> lock(spawnMutex);
+    Worker &worker = workers[index];
+    if (worker.socket >= 0)
+    {
+        close(worker.socket);
+        worker.socket = -1;
+    }
+    // Рабочий процесс — дочерний для порождателя: дождаться его завершения может только порождатель
+    if (worker.pid > 0 && control >= 0)
+    {
+        ForkerRequest request = {OPERATION_STOP, index, worker.pid};
+        pid_t done;
+        int unused;
+        if (send(control, &request, sizeof(request), MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(request)))
+        {
+            receiveDescriptor(control, done, unused);
+        }
+    }
+    worker.pid = -1;
+}
+
+// Цикл порождателя: запуск рабочих процессов и ожидание их завершения по запросам основного
+void ProcessHashing::runForker()
+{
+    while (true)
+    {
+        ForkerRequest request;
+        ssize_t received = recv(control, &request, sizeof(request), 0);
+        if (received < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received != static_cast<ssize_t>(sizeof(request)))
+        {
+            break; // Основной процесс закрыл сокет или завершился
+        }
+
+        if (request.operation == OPERATION_STOP)
+        {
+            // Закрытый сокет завершает цикл обработки; зависший процесс завершается принудительно
+            if (waitpid(request.pid, nullptr, WNOHANG) == 0)
+            {
+                kill(request.pid, SIGKILL);
+                waitpid(request.pid, nullptr, 0);
+            }
+            sendDescriptor(control, request.pid, -1);
+            continue;
+        }
+
+        int sockets[2];
+        if (request.operation != OPERATION_SPAWN || socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0)
+        {
+            sendDescriptor(control, -1, -1);
+            continue;
+        }
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            // Рабочий процесс: сокеты других процессов порождатель не хранит, управляющий сокет не нужен
+            close(control);
+            close(sockets[0]);
+            if (options.pinWorkers)
+            {
+                long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(static_cast<int>(request.index % static_cast<size_t>(cpus > 0 ? cpus : 1)), &set);
+                sched_setaffinity(0, sizeof(set), &set);
+            }
+            serve(sockets[1]);
+            _exit(0);
+        }
+        close(sockets[1]);
+        sendDescriptor(control, pid, pid > 0 ? sockets[0] : -1);
+        close(sockets[0]);
+    }
+
+    // Рабочие процессы завершаются по закрытию своих сокетов основным процессом
+    while (waitpid(-1, nullptr, 0) > 0 || errno == EINTR)
+    {
+    }
+}
+
+// Цикл обработки запросов в рабочем процессе
+void ProcessHashing::serve(int socket)
+{
+    char request[MAX_MESSAGE_BYTES];
+    while (true)
+    {
+        ssize_t received = recv(socket, request, sizeof(request), 0);
+        if (received <= 0)
+        {
+            return; // Основной процесс закрыл сокет или завершился
+        }
+
+        size_t pos = 1;
+        std::string password;
+        std::string hashIn;
+        std::string hashOut;
+        ConfiguratorErrorCode code = ConfiguratorErrorCode::HASHING_ERROR;
+        if (readField(request, static_cast<size_t>(received), pos, password) &&
+            readField(request, static_cast<size_t>(received), pos, hashIn))
+        {
+            if (request[0] == OPERATION_MAKE)
+            {
+                code = hasher->pwHashMake(password, hashOut);
+            }
+            else if (request[0] == OPERATION_VERIFY)
+            {
+                code = hasher->pwHashVerify(password, hashIn);
+            }
+        }
+        std::memset(&password[0], 0, password.size());
+        std::memset(request, 0, static_cast<size_t>(received));
+
+        int32_t wireCode = static_cast<int32_t>(code);
+        std::string response(reinterpret_cast<const char *>(&wireCode), sizeof(wireCode));
+        appendField(response, hashOut);
+        if (send(socket, response.data(), response.size(), MSG_NOSIGNAL) < 0)
+        {
+            return;
+        }
+    }
+}
+
+// Выполнение запроса в свободном процессе с одной повторной попыткой при его падении; зависший процесс
+// завершается без повтора запроса
+ConfiguratorErrorCode ProcessHashing::call(char operation, const std::string &password, const std::string &hashIn, std::string &hashOut)
+{
+    std::string request(1, operation);
+    appendField(request, password);
+    appendField(request, hashIn);
+    if (request.size() > MAX_MESSAGE_BYTES)
+    {
+        std::memset(&request[0], 0, request.size());
+        return ConfiguratorErrorCode::HASHING_ERROR;
+    }
+
+    ConfiguratorErrorCode code = ConfiguratorErrorCode::HASHING_ERROR;
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        size_t index;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]
+                           { return !idle.empty() || alive == 0; });
+            if (idle.empty())
+            {
+                break; // Ни одного процесса запустить не удалось
+            }
+            index = idle.back();
+            idle.pop_back();
+        }
+
+        // Процесс index принадлежит этому потоку, пока не возвращен в idle
+        int socket = workers[index].socket;
+        char response[MAX_MESSAGE_BYTES];
+        ssize_t received = -1;
+        bool timedOut = false;
+        if (socket >= 0 && send(socket, request.data(), request.size(), MSG_NOSIGNAL) == static_cast<ssize_t>(request.size()))
+        {
+            received = receiveWithin(socket, response, sizeof(response), options.timeoutMs, timedOut);
+        }
+
+        size_t pos = sizeof(int32_t);
+        int32_t wireCode;
+        bool ok = received >= static_cast<ssize_t>(sizeof(wireCode)) &&
+                  readField(response, static_cast<size_t>(received), pos, hashOut);
+        if (ok)
+        {
+            std::memcpy(&wireCode, response, sizeof(wireCode));
+            code = static_cast<ConfiguratorErrorCode>(wireCode);
+            std::lock_guard<std::mutex> lock(mutex);
+            idle.push_back(index);
+            available.notify_one();
+            break;
+        }
+
+        // Процесс упал, завис или его сокет закрыт: перезапуск через порождатель без mutex, другие вызовы его не ждут
+        stop(index);
+        bool restarted = spawn(index);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++restarts;
+            if (restarted)
+            {
+                idle.push_back(index);
+            }
+            else
+            {
+                --alive;
+            }
+            available.notify_all();
+        }
+        if (timedOut)
+        {
+            break;
+        }
+    }
+
+    std::memset(&request[0], 0, request.size());
+    return code;
+}
+
+// Метод хеширования пароля
+ConfiguratorErrorCode ProcessHashing::pwHashMake(const std::string &password, std::string &hashedPassword)
+{
+    return call(OPERATION_MAKE, password, std::string(), hashedPassword);
+}
+
+// Метод сравнения записанного хеша и хеша данного пароля
+ConfiguratorErrorCode ProcessHashing::pwHashVerify(const std::string &password, const std::string &hashedPassword)
+{
+    std::string unused;
+    return call(OPERATION_VERIFY, password, hashedPassword, unused);
+}
+
+// Идентификаторы запущенных рабочих процессов
+std::vector<pid_t> ProcessHashing::workerPids()
+{
+    std::lock_guard<std::mutex> lock(spawnMutex);
+    std::vector<pid_t> pids;
+    for (const Worker &worker : workers)
+    {
+        if (worker.pid > 0)
+        {
+            pids.push_back(worker.pid);
+        }
+    }
+    return pids;
+}
+
+// Число перезапусков упавших процессов
+size_t ProcessHashing::restartCount()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return restarts;
+}
+
+// Закрывает сокеты и дожидается завершения рабочих процессов и порождателя
+ProcessHashing::~ProcessHashing()
+{
+    std::lock_guard<std::mutex> lock(spawnMutex);
+    for (Worker &worker : workers)
+    {
+        if (worker.socket >= 0)
+        {
+            close(worker.socket);
+            worker.socket = -1;
+        }
+        worker.pid = -1;
+    }
+    // Порождатель дожидается своих рабочих процессов и завершается, увидев закрытый управляющий сокет
+    if (control >= 0)
+    {
+        close(control);
+        control = -1;
+    }
+    if (forker > 0)
+    {
+        waitpid(forker, nullptr, 0);
+        forker = -1;
+    }
+}
@@ -0,0 +1,170 @@
+// src/RateLimiter.cpp
+
+#include <algorithm>
+#include <cerrno>
+#include <new>
+#include <sys/mman.h>
+
+#include "RateLimiter.hpp"
+
+// Наименьшая степень двойки не меньше value
+static size_t roundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+RateLimiter::RateLimiter(const RateLimiterOptions &options) : sharedMapping(MAP_FAILED), sharedSize(0)
+{
+    policies[static_cast<size_t>(RateLimitKind::LOGIN)] = options.login;
+    policies[static_cast<size_t>(RateLimitKind::SOURCE)] = options.source;
+
+    size_t setCount = roundUpToPowerOfTwo(std::max<size_t>(options.capacity / WAYS, 1));
+    size_t shardCount = std::min(roundUpToPowerOfTwo(std::max<size_t>(options.shards, 1)), setCount);
+    setMask = setCount - 1;
+    shardMask = shardCount - 1;
+
+    // Анонимное отображение заполнено нулями: все корзины свободны. Без памяти ограничитель пропускает все попытки
+    if (!options.shared)
+    {
+        sets = static_cast<BucketSet *>(arena.reserve(setCount * sizeof(BucketSet)));
+        ownShards.reset(new Shard[shardCount]);
+        shards = ownShards.get();
+        return;
+    }
+    sharedSize = setCount * sizeof(BucketSet) + shardCount * sizeof(Shard);
+    sharedMapping = mmap(nullptr, sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (sharedMapping == MAP_FAILED)
+    {
+        sets = nullptr;
+        shards = nullptr;
+        return;
+    }
+    sets = static_cast<BucketSet *>(sharedMapping);
+    shards = new (sets + setCount) Shard[shardCount];
+
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    for (size_t i = 0; i < shardCount; ++i)
+    {
+        pthread_mutex_init(&shards[i].mutex, &attributes);
+    }
+    pthread_mutexattr_destroy(&attributes);
+}
+
+// Захват сегмента. Процесс, завершившийся под мьютексом, мог не дописать одну корзину; каждое ее поле
+// записывается одной операцией, поэтому корзина остается пригодной и сегмент не сбрасывается
+void RateLimiter::lock(Shard &shard)
+{
+    if (sharedMapping != MAP_FAILED)
+    {
+        if (pthread_mutex_lock(&shard.mutex) == EOWNERDEAD)
+        {
+            pthread_mutex_consistent(&shard.mutex);
+        }
+        return;
+    }
+    while (shard.locked.test_and_set(std::memory_order_acquire))
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+void RateLimiter::unlock(Shard &shard)
+{
+    if (sharedMapping != MAP_FAILED)
+    {
+        pthread_mutex_unlock(&shard.mutex);
+        return;
+    }
+    shard.locked.clear(std::memory_order_release);
+}
+
+// Хеш ключа вместе с его видом: логин и источник с одинаковой строкой — разные корзины
+uint64_t RateLimiter::keyOf(RateLimitKind kind, const std::string &key)
+{
+    uint64_t hash = 14695981039346656037ull ^ static_cast<uint64_t>(kind);
+    for (unsigned char ch : key)
+    {
+        hash = (hash ^ ch) * 1099511628211ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash != 0 ? hash : 1;
+}
+
+// Списание попытки для ключа в момент nowMs
+bool RateLimiter::allow(RateLimitKind kind, const std::string &key, int64_t nowMs)
+{
+    const RateLimitPolicy &policy = policies[static_cast<size_t>(kind)];
+    if (policy.perSecond <= 0 || sets == nullptr)
+    {
+        return true;
+    }
+
+    uint64_t hash = keyOf(kind, key);
+    size_t setIndex = static_cast<size_t>(hash) & setMask;
+    BucketSet &set = sets[setIndex];
+    Shard &shard = shards[setIndex & shardMask];
+
+    // Отметки хранятся по модулю 2^32 мс (~49 дней): разность считается без знака,
+    // корзина, простаивавшая дольше, пополняется не полностью
+    uint32_t stamp = static_cast<uint32_t>(nowMs);
+
+    lock(shard);
+
+    Bucket *bucket = nullptr;
+    Bucket *victim = &set.buckets[0];
+    for (Bucket &candidate : set.buckets)
+    {
+        if (candidate.key == hash)
+        {
+            bucket = &candidate;
+            break;
+        }
+        // Свободная корзина, иначе та, к которой дольше всех не обращались
+        if (victim->key != 0 && (candidate.key == 0 || uint32_t(stamp - candidate.stamp) > uint32_t(stamp - victim->stamp)))
+        {
+            victim = &candidate;
+        }
+    }
+
+    if (bucket == nullptr)
+    {
+        bucket = victim;
+        bucket->key = hash;
+        bucket->tokens = static_cast<float>(policy.burst);
+    }
+    else
+    {
+        double refilled = bucket->tokens + uint32_t(stamp - bucket->stamp) * policy.perSecond / 1000;
+        bucket->tokens = static_cast<float>(std::min(refilled, policy.burst));
+    }
+    bucket->stamp = stamp;
+
+    bool allowed = bucket->tokens >= 1;
+    if (allowed)
+    {
+        bucket->tokens -= 1;
+    }
+
+    unlock(shard);
+    return allowed;
+}
+
+RateLimiter::~RateLimiter()
+{
+    if (sharedMapping != MAP_FAILED)
+    {
+        munmap(sharedMapping, sharedSize);
+    }
+}
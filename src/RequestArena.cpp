@@ -0,0 +1,21 @@
+// src/RequestArena.cpp
+
+#include "RequestArena.hpp"
+
+// Пул хранит блоки до 64 КиБ: арена запрашивает у него растущие блоки, и все они переиспользуются
+RequestArena::RequestArena()
+    : upstream(std::pmr::pool_options{0, 64 * 1024}), arena(buffer, sizeof(buffer), &upstream)
+{
+}
+
+// Распределитель для данных текущего запроса
+std::pmr::memory_resource *RequestArena::resource()
+{
+    return &arena;
+}
+
+// Освобождение всех данных запроса
+void RequestArena::reset()
+{
+    arena.release();
+}
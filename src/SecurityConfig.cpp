@@ -1,11 +1,51 @@
 // src/SecurityConfig.cpp
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <iterator>
 #include <fstream>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "SecurityConfig.hpp"
 
-// Загрузка данных конфигурации из файла
-ConfiguratorErrorCode SecurityConfig::loadFromConfigFile()
+// Сравнение снимков
+bool SecurityConfig::Snapshot::operator==(const Snapshot &other) const
+{
+    for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+    {
+        if (present[i] != other.present[i] || rejected[i] != other.rejected[i] || (present[i] && fields[i] != other.fields[i]))
+        {
+            return false;
+        }
+    }
+    return complete == other.complete && unknown == other.unknown;
+}
+
+// Действующее значение параметра: из файла или по умолчанию из схемы
+bool SecurityConfig::Snapshot::value(size_t index, unsigned &result) const
+{
+    if (present[index])
+    {
+        result = fields[index];
+        return true;
+    }
+    if (!complete || rejected[index])
+    {
+        return false;
+    }
+    result = securitySchema[index].defaultValue;
+    return true;
+}
+
+// Чтение данных конфигурации из файла. Значения вне допустимого диапазона не загружаются,
+// при этом возвращается ошибка
+ConfiguratorErrorCode SecurityConfig::loadFromConfigFile(Snapshot &snapshot) const
 {
     // Открытие файла конфигурации для чтения
     std::ifstream file(configFilePath);
@@ -15,187 +55,363 @@ ConfiguratorErrorCode SecurityConfig::loadFromConfigFile()
         return ConfiguratorErrorCode::DATABASE_ERROR;
     }
 
-    // Очистка текущих данных конфигурации
-    data.clear();
-
+    ConfiguratorErrorCode errorCode = ConfiguratorErrorCode::SUCCESS;
     std::string key;
     unsigned value;
-    // Чтение данных из файла и сохранение в контейнер data
+    // Чтение данных из файла: параметры схемы проверяются и раскладываются по массиву
     while (file >> key >> value)
     {
-        data[key] = value;
+        SecurityParam param;
+        if (!findSecurityParam(key, param))
+        {
+            snapshot.unknown[key] = value;
+        }
+        else if (securityValueInRange(param, value))
+        {
+            snapshot.fields[static_cast<size_t>(param)] = value;
+            snapshot.present[static_cast<size_t>(param)] = true;
+        }
+        else
+        {
+            snapshot.rejected[static_cast<size_t>(param)] = true;
+            errorCode = ConfiguratorErrorCode::CONFIG_VALUE_OUT_OF_RANGE;
+        }
     }
 
-    return ConfiguratorErrorCode::SUCCESS;
+    // Чтение, остановившееся до конца файла, означает некорректный формат
+    if (!file.eof())
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    snapshot.complete = true;
+    return errorCode;
 }
 
-// Сохранение данных конфигурации в файл
-ConfiguratorErrorCode SecurityConfig::saveToConfigFile() const
+// Атомарное сохранение данных конфигурации в файл: запись во временный файл, fsync и rename.
+// Читатель видит либо старый, либо новый файл целиком
+ConfiguratorErrorCode SecurityConfig::saveToConfigFile(const Snapshot &snapshot) const
 {
-    // Открытие файла конфигурации для записи
-    std::ofstream file(configFilePath);
-    if (!file)
+    // Файл, доступный только для чтения, не перезаписывается (rename заменил бы его в обход прав)
+    struct stat fileStat;
+    mode_t mode = 0644;
+    if (stat(configFilePath.c_str(), &fileStat) == 0)
+    {
+        if (access(configFilePath.c_str(), W_OK) != 0)
+        {
+            return ConfiguratorErrorCode::DATABASE_ERROR;
+        }
+        mode = fileStat.st_mode & 0777;
+    }
+
+    // Формирование содержимого файла: параметры в порядке схемы, затем ключи вне схемы
+    std::string content;
+    for (const SecurityParamInfo &info : securitySchema)
+    {
+        size_t index = static_cast<size_t>(info.param);
+        if (snapshot.present[index])
+        {
+            content += std::string(info.key) + " " + std::to_string(snapshot.fields[index]) + "\n";
+        }
+    }
+    for (const auto &[key, value] : snapshot.unknown)
+    {
+        content += key + " " + std::to_string(value) + "\n";
+    }
+
+    // Запись во временный файл рядом с основным (rename атомарен только в пределах одной файловой системы)
+    int fd = open(tmpFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, mode);
+    if (fd < 0)
     {
         // Ошибка при открытии файла
         return ConfiguratorErrorCode::DATABASE_ERROR;
     }
 
-    // Запись данных из контейнера data в файл
-    for (const auto &[key, value] : data)
+    size_t written = 0;
+    while (written < content.size())
     {
-        file << key << " " << value << "\n";
+        ssize_t result = write(fd, content.data() + written, content.size() - written);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        written += static_cast<size_t>(result);
+    }
+
+    // Данные должны оказаться на диске до переименования, иначе после сбоя возможен пустой файл
+    bool ok = written == content.size() && fsync(fd) == 0;
+    ok = close(fd) == 0 && ok;
+    if (!ok || rename(tmpFilePath.c_str(), configFilePath.c_str()) != 0)
+    {
+        unlink(tmpFilePath.c_str());
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    // Синхронизация каталога фиксирует само переименование
+    std::string directory = configFilePath.substr(0, configFilePath.find_last_of('/') + 1);
+    int dirFd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0)
+    {
+        fsync(dirFd);
+        close(dirFd);
     }
 
     return ConfiguratorErrorCode::SUCCESS;
 }
 
-// Конструктор класса SecurityConfig, инициализирует путь к файлу конфигурации и    загружает данные из файла
-SecurityConfig::SecurityConfig(std::string configPath) : configFilePath(configPath)
-{
-    // Загрузка конфигурационных параметров из файла
-    loadFromConfigFile();
-}
+// Номера объектов SecurityConfig для кеша снимков в потоках
+static std::atomic<uint64_t> nextInstanceId(1);
 
-// Установка минимальной длины пароля и сохранение изменений в файл конфигурации
-ConfiguratorErrorCode SecurityConfig::set_minPasswordLength(const unsigned length)
+// Конструктор класса SecurityConfig, инициализирует путь к файлу конфигурации и    загружает данные из файла
+SecurityConfig::SecurityConfig(std::string configPath)
+    : instanceId(nextInstanceId.fetch_add(1, std::memory_order_relaxed)), generation(0), configFilePath(configPath), tmpFilePath(configPath + ".tmp"), inotifyFd(-1), stopFd(-1)
 {
-    // Обновление значения минимальной длины пароля в контейнере данных
-    data[minPasswordLength] = length;
+    // Загрузка конфигурационных параметров из файла; прочитанное до ошибки тоже публикуется
+    std::unique_ptr<Snapshot> snapshot(new Snapshot());
+    loadFromConfigFile(*snapshot);
 
-    // Сохранение изменений в файл конфигурации
-    return saveToConfigFile();
+    std::lock_guard<std::mutex> lock(writerMutex);
+    publish(std::move(snapshot));
 }
 
-// Установка глубины истории паролей и сохранение изменений в файл конфигурации
-ConfiguratorErrorCode SecurityConfig::set_passwordHistoryDepth(const unsigned depth)
+// Публикация нового снимка (вызывается под writerMutex); одинаковые данные не публикуются повторно
+void SecurityConfig::publish(std::unique_ptr<Snapshot> snapshot)
 {
-    // Обновление значения глубины истории паролей в контейнере данных
-    data[passwordHistoryDepth] = depth;
+    std::shared_ptr<const Snapshot> old = current.load(std::memory_order_relaxed);
+    if (old == nullptr || !(*old == *snapshot))
+    {
+        // release: читатель, получивший указатель, видит снимок полностью заполненным
+        current.store(std::shared_ptr<const Snapshot>(std::move(snapshot)), std::memory_order_release);
+        generation.fetch_add(1, std::memory_order_release);
+    }
 
-    // Сохранение изменений в файл конфигурации
-    return saveToConfigFile();
+    // Отметка файла обновляется и при неизменных данных: файл мог быть перезаписан
+    publishShared();
 }
 
-// Установка срока действия пароля (в днях) и сохранение изменений в файл конфигурации
-ConfiguratorErrorCode SecurityConfig::set_passwordExpirationDays(const unsigned days)
+// Запись текущего снимка и отметки файла в разделяемую память (вызывается под writerMutex)
+void SecurityConfig::publishShared()
 {
-    // Обновление значения срока действия пароля в контейнере данных
-    data[passwordExpirationDays] = days;
+    SharedPolicy policy;
+    if (sharedWriter == nullptr || stat(configFilePath.c_str(), &policy.fileStat) != 0)
+    {
+        return;
+    }
 
-    // Сохранение изменений в файл конфигурации
-    return saveToConfigFile();
+    std::shared_ptr<const Snapshot> snapshot = current.load(std::memory_order_relaxed);
+    // Читатели сегмента получают действующие значения, включая значения по умолчанию
+    for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+    {
+        policy.values[i] = 0;
+        policy.present[i] = snapshot->value(i, policy.values[i]);
+    }
+    sharedWriter->write(policy);
 }
 
-// Установка максимального времени неактивности пользователя (в минутах) и сохранение изменений в файл конфигурации
-ConfiguratorErrorCode SecurityConfig::set_maxInactiveTimeMin(const unsigned minutes)
+// Публикация политики в сегмент разделяемой памяти segmentName при каждом изменении,
+// чтобы другие процессы читали ее через SharedSecurityConfig без разбора файла
+ConfiguratorErrorCode SecurityConfig::shareVia(const std::string &segmentName)
 {
-    // Обновление значения максимального времени неактивности в контейнере данных
-    data[maxInactiveTimeMin] = minutes;
+    std::unique_ptr<SharedPolicyWriter> writer(new SharedPolicyWriter());
+    ConfiguratorErrorCode errorCode = writer->open(segmentName);
+    if (errorCode != ConfiguratorErrorCode::SUCCESS)
+    {
+        return errorCode;
+    }
 
-    // Сохранение изменений в файл конфигурации
-    return saveToConfigFile();
+    std::lock_guard<std::mutex> lock(writerMutex);
+    sharedWriter = std::move(writer);
+    publishShared();
+    return ConfiguratorErrorCode::SUCCESS;
 }
 
-// Установка максимального числа неудачных попыток входа и сохранение изменений в файл конфигурации
-ConfiguratorErrorCode SecurityConfig::set_maxFailedAttempts(const unsigned attempts)
+// Перечитывание файла конфигурации и публикация нового снимка.
+// Если файл не читается или содержит некорректные данные, текущий снимок остается прежним
+ConfiguratorErrorCode SecurityConfig::reload()
 {
-    // Обновление значения максимального числа неудачных попыток входа в контейнере данных
-    data[maxFailedAttempts] = attempts;
+    std::lock_guard<std::mutex> lock(writerMutex);
 
-    // Сохранение изменений в файл конфигурации
-    return saveToConfigFile();
+    std::unique_ptr<Snapshot> snapshot(new Snapshot());
+    ConfiguratorErrorCode errorCode = loadFromConfigFile(*snapshot);
+    if (errorCode == ConfiguratorErrorCode::SUCCESS)
+    {
+        publish(std::move(snapshot));
+    }
+    return errorCode;
 }
 
-// Установка времени блокировки учетной записи (в минутах) и сохранение изменений в файл конфигурации
-ConfiguratorErrorCode SecurityConfig::set_lockoutTimeMin(const unsigned minutes)
+// Запуск потока, который перечитывает конфигурацию при каждом изменении файла (inotify).
+// Отслеживается каталог файла, поэтому замена файла через rename тоже замечается
+ConfiguratorErrorCode SecurityConfig::watch()
 {
-    // Обновление значения времени блокировки в контейнере данных
-    data[lockoutTimeMin] = minutes;
+    if (watcher.joinable())
+    {
+        return ConfiguratorErrorCode::SUCCESS;
+    }
 
-    // Сохранение изменений в файл конфигурации
-    return saveToConfigFile();
-}
+    size_t slash = configFilePath.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : configFilePath.substr(0, slash + 1);
 
-// Получение минимальной длины пароля из конфигурации
-ConfiguratorErrorCode SecurityConfig::get_minPasswordLength(unsigned &length) const
-{
-    // Проверка, существует ли параметр минимальной длины пароля в данных
-    if (!data.count(minPasswordLength))
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (inotifyFd < 0 || stopFd < 0 ||
+        inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
     {
+        if (inotifyFd >= 0)
+        {
+            close(inotifyFd);
+            inotifyFd = -1;
+        }
+        if (stopFd >= 0)
+        {
+            close(stopFd);
+            stopFd = -1;
+        }
         return ConfiguratorErrorCode::DATABASE_ERROR;
     }
 
-    // Присваивание значения минимальной длины пароля
-    length = data.at(minPasswordLength);
+    // Изменения между загрузкой в конструкторе и установкой наблюдения не теряются
+    reload();
+
+    watcher = std::thread(&SecurityConfig::watchLoop, this);
     return ConfiguratorErrorCode::SUCCESS;
 }
 
-// Получение глубины истории паролей из конфигурации
-ConfiguratorErrorCode SecurityConfig::get_passwordHistoryDepth(unsigned &depth) const
+// Цикл потока, отслеживающего изменения файла
+void SecurityConfig::watchLoop()
 {
-    // Проверка, существует ли параметр глубины истории паролей в данных
-    if (!data.count(passwordHistoryDepth))
+    std::string fileName = configFilePath.substr(configFilePath.find_last_of('/') + 1);
+    alignas(struct inotify_event) char buffer[4096];
+
+    while (true)
     {
-        return ConfiguratorErrorCode::DATABASE_ERROR;
+        struct pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents != 0)
+        {
+            return;
+        }
+
+        // Все накопившиеся события обрабатываются одной перезагрузкой
+        bool changed = false;
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+        {
+            for (char *ptr = buffer; ptr < buffer + length;)
+            {
+                const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(ptr);
+                if (event->len > 0 && fileName == event->name)
+                {
+                    changed = true;
+                }
+                ptr += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        if (changed)
+        {
+            reload();
+        }
     }
+}
 
-    // Присваивание значения глубины истории паролей
-    depth = data.at(passwordHistoryDepth);
-    return ConfiguratorErrorCode::SUCCESS;
+// Номер текущего снимка конфигурации
+unsigned long SecurityConfig::snapshotGeneration() const
+{
+    return generation.load(std::memory_order_acquire);
 }
 
-// Получение срока действия пароля (в днях) из конфигурации
-ConfiguratorErrorCode SecurityConfig::get_passwordExpirationDays(unsigned &days) const
+// Применение нескольких изменений одной атомарной записью файла конфигурации.
+// При ошибке записи или значении вне допустимого диапазона ни одно изменение не применяется
+ConfiguratorErrorCode SecurityConfig::applyChanges(const SecurityConfigChanges &changes)
 {
-    // Проверка, существует ли параметр срока действия пароля в данных
-    if (!data.count(passwordExpirationDays))
+    for (const SecurityParamInfo &info : securitySchema)
     {
-        return ConfiguratorErrorCode::DATABASE_ERROR;
+        const std::optional<unsigned> &value = changes.get(info.param);
+        if (value.has_value() && !securityValueInRange(info.param, *value))
+        {
+            return ConfiguratorErrorCode::CONFIG_VALUE_OUT_OF_RANGE;
+        }
     }
 
-    // Присваивание значения срока действия пароля
-    days = data.at(passwordExpirationDays);
-    return ConfiguratorErrorCode::SUCCESS;
-}
+    std::lock_guard<std::mutex> lock(writerMutex);
 
-// Получение максимального времени неактивности пользователя (в минутах) из конфигурации
-ConfiguratorErrorCode SecurityConfig::get_maxInactiveTimeMin(unsigned &minutes) const
-{
-    // Проверка, существует ли параметр максимального времени неактивности в данных
-    if (!data.count(maxInactiveTimeMin))
+    // Изменения применяются к копии, которая публикуется только после успешной записи
+    std::unique_ptr<Snapshot> staged(new Snapshot(*current.load(std::memory_order_relaxed).get()));
+    for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
     {
-        return ConfiguratorErrorCode::DATABASE_ERROR;
+        if (changes.values[i].has_value())
+        {
+            staged->fields[i] = *changes.values[i];
+            staged->present[i] = true;
+        }
     }
 
-    // Присваивание значения максимального времени неактивности
-    minutes = data.at(maxInactiveTimeMin);
-    return ConfiguratorErrorCode::SUCCESS;
+    ConfiguratorErrorCode errorCode = saveToConfigFile(*staged);
+    if (errorCode == ConfiguratorErrorCode::SUCCESS)
+    {
+        // Снимок теперь совпадает с записанным файлом: отклоненные значения в него не попали
+        staged->complete = true;
+        std::fill(std::begin(staged->rejected), std::end(staged->rejected), false);
+        publish(std::move(staged));
+    }
+    return errorCode;
 }
 
-// Получение максимального числа неудачных попыток входа из конфигурации
-ConfiguratorErrorCode SecurityConfig::get_maxFailedAttempts(unsigned &attempts) const
+// Получение значения параметра из текущего снимка (без ожидания писателя)
+ConfiguratorErrorCode SecurityConfig::get(SecurityParam param, unsigned &value) const
 {
-    // Проверка, существует ли параметр максимального числа неудачных попыток в данных
-    if (!data.count(maxFailedAttempts))
+    // Ссылка на снимок, последним прочитанный потоком. Пока номер снимка прежний, чтение обходится без
+    // загрузки current и изменения счетчика ссылок. acquire в паре с release в publish: снимок с номером
+    // не старше прочитанного уже опубликован
+    struct ReaderCache
+    {
+        uint64_t instance = 0;
+        unsigned long generation = 0;
+        std::shared_ptr<const Snapshot> snapshot;
+    };
+    static thread_local ReaderCache cache;
+    unsigned long published = generation.load(std::memory_order_acquire);
+    if (cache.instance != instanceId || cache.generation != published)
+    {
+        cache.snapshot = current.load(std::memory_order_acquire);
+        cache.instance = instanceId;
+        cache.generation = published;
+    }
+    size_t index = static_cast<size_t>(param);
+    if (index >= SECURITY_PARAM_COUNT || !cache.snapshot->value(index, value))
     {
         return ConfiguratorErrorCode::DATABASE_ERROR;
     }
-
-    // Присваивание значения максимального числа неудачных попыток
-    attempts = data.at(maxFailedAttempts);
     return ConfiguratorErrorCode::SUCCESS;
 }
 
-// Получение времени блокировки пользователя (в минутах) из конфигурации
-ConfiguratorErrorCode SecurityConfig::get_lockoutTimeMin(unsigned &minutes) const
+// Останавливает поток отслеживания изменений
+SecurityConfig::~SecurityConfig()
 {
-    // Проверка, существует ли параметр времени блокировки в данных
-    if (!data.count(lockoutTimeMin))
+    if (watcher.joinable())
     {
-        return ConfiguratorErrorCode::DATABASE_ERROR;
+        uint64_t one = 1;
+        ssize_t unused = write(stopFd, &one, sizeof(one));
+        (void)unused;
+        watcher.join();
+    }
+    if (inotifyFd >= 0)
+    {
+        close(inotifyFd);
+    }
+    if (stopFd >= 0)
+    {
+        close(stopFd);
     }
-
-    // Присваивание значения времени блокировки
-    minutes = data.at(lockoutTimeMin);
-    return ConfiguratorErrorCode::SUCCESS;
 }
@@ -0,0 +1,292 @@
+// src/SessionManager.cpp
+
+#include <sodium.h>
+
+#include "SessionManager.hpp"
+
+SessionManager::SessionManager(int64_t now, size_t sessionLimit)
+    : maxSessions(sessionLimit), currentTick(now), active(0)
+{
+    // libsodium — источник случайных токенов
+    sodium_init();
+    for (unsigned level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        for (size_t slot = 0; slot < WHEEL_SIZE; ++slot)
+        {
+            wheel[level][slot] = NONE;
+        }
+    }
+}
+
+// Постановка сессии в колесо по сроку lastActive + idleSeconds
+void SessionManager::schedule(uint32_t index)
+{
+    Session &session = sessions[index];
+    int64_t deadline = session.lastActive + session.idleSeconds;
+    if (deadline <= currentTick)
+    {
+        deadline = currentTick + 1;
+    }
+
+    // Уровень выбирается по оставшемуся времени; срок за пределами колеса проверяется заново по истечении
+    int64_t delta = deadline - currentTick;
+    unsigned level = 0;
+    while (level + 1 < WHEEL_LEVELS && delta >= (int64_t(1) << (WHEEL_BITS * (level + 1))))
+    {
+        ++level;
+    }
+    int64_t range = int64_t(1) << (WHEEL_BITS * WHEEL_LEVELS);
+    if (delta >= range)
+    {
+        deadline = currentTick + range - 1;
+    }
+
+    size_t slot = static_cast<size_t>(deadline >> (WHEEL_BITS * level)) & (WHEEL_SIZE - 1);
+    session.level = static_cast<uint8_t>(level);
+    session.slot = static_cast<uint8_t>(slot);
+    session.prev = NONE;
+    session.next = wheel[level][slot];
+    if (session.next != NONE)
+    {
+        sessions[session.next].prev = index;
+    }
+    wheel[level][slot] = index;
+}
+
+void SessionManager::unlink(uint32_t index)
+{
+    Session &session = sessions[index];
+    if (session.prev != NONE)
+    {
+        sessions[session.prev].next = session.next;
+    }
+    else
+    {
+        wheel[session.level][session.slot] = session.next;
+    }
+    if (session.next != NONE)
+    {
+        sessions[session.next].prev = session.prev;
+    }
+}
+
+// Освобождение записи; сессия уже исключена из колеса
+void SessionManager::release(uint32_t index)
+{
+    Session &session = sessions[index];
+    byToken.erase(session.token);
+    sodium_memzero(session.token.data(), session.token.size());
+    session.login.clear();
+    session.used = false;
+    freeSessions.push_back(index);
+    --active;
+}
+
+// Перераспределение ячейки уровня level по более низким уровням
+void SessionManager::cascade(unsigned level)
+{
+    size_t slot = static_cast<size_t>(currentTick >> (WHEEL_BITS * level)) & (WHEEL_SIZE - 1);
+    uint32_t index = wheel[level][slot];
+    wheel[level][slot] = NONE;
+    while (index != NONE)
+    {
+        // Срок, совпавший с текущей секундой, истекает здесь: ячейка младшего уровня для нее уже выбрана
+        uint32_t next = sessions[index].next;
+        Session &session = sessions[index];
+        if (session.lastActive + session.idleSeconds <= currentTick)
+        {
+            release(index);
+        }
+        else
+        {
+            schedule(index);
+        }
+        index = next;
+    }
+}
+
+// Создание сессии; пустая строка, если достигнут предел числа сессий или idleSeconds == 0
+std::string SessionManager::create(const std::string &login, int64_t idleSeconds, int64_t now)
+{
+    if (idleSeconds <= 0 || active >= maxSessions)
+    {
+        return std::string();
+    }
+
+    Token token;
+    do
+    {
+        randombytes_buf(token.data(), token.size());
+    } while (byToken.count(token) != 0);
+
+    uint32_t index;
+    if (!freeSessions.empty())
+    {
+        index = freeSessions.back();
+        freeSessions.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(sessions.size());
+        sessions.emplace_back();
+    }
+
+    Session &session = sessions[index];
+    session.token = token;
+    session.login = login;
+    session.lastActive = now;
+    session.idleSeconds = idleSeconds;
+    session.used = true;
+    byToken.emplace(token, index);
+    ++active;
+    schedule(index);
+    return std::string(reinterpret_cast<const char *>(token.data()), token.size());
+}
+
+// Проверка токена с продлением сессии; false, если сессии нет или она истекла
+bool SessionManager::validate(const std::string &token, int64_t now, std::string &login)
+{
+    if (token.size() != TOKEN_BYTES)
+    {
+        return false;
+    }
+    Token key;
+    std::memcpy(key.data(), token.data(), key.size());
+    auto it = byToken.find(key);
+    if (it == byToken.end())
+    {
+        return false;
+    }
+
+    // Сессия могла истечь между шагами колеса
+    uint32_t index = it->second;
+    Session &session = sessions[index];
+    if (session.lastActive + session.idleSeconds <= now)
+    {
+        unlink(index);
+        release(index);
+        return false;
+    }
+    if (now > session.lastActive)
+    {
+        session.lastActive = now;
+    }
+    login = session.login;
+    return true;
+}
+
+// Завершение сессии; false, если сессии нет
+bool SessionManager::revoke(const std::string &token)
+{
+    if (token.size() != TOKEN_BYTES)
+    {
+        return false;
+    }
+    Token key;
+    std::memcpy(key.data(), token.data(), key.size());
+    auto it = byToken.find(key);
+    if (it == byToken.end())
+    {
+        return false;
+    }
+    uint32_t index = it->second;
+    unlink(index);
+    release(index);
+    return true;
+}
+
+// Удаление сессий, бездействующих дольше допустимого, к моменту now
+void SessionManager::advance(int64_t now)
+{
+    if (active == 0 && now > currentTick)
+    {
+        currentTick = now; // Пустое колесо не нужно прокручивать посекундно
+        return;
+    }
+
+    while (currentTick < now)
+    {
+        ++currentTick;
+
+        // Когда младший уровень проходит полный круг, очередная ячейка старшего уровня раскладывается вниз
+        for (unsigned level = 1; level < WHEEL_LEVELS; ++level)
+        {
+            if ((currentTick & ((int64_t(1) << (WHEEL_BITS * level)) - 1)) != 0)
+            {
+                break;
+            }
+            cascade(level);
+        }
+
+        // Сессии, к которым обращались после постановки в колесо, переносятся на новый срок
+        size_t slot = static_cast<size_t>(currentTick) & (WHEEL_SIZE - 1);
+        uint32_t index = wheel[0][slot];
+        wheel[0][slot] = NONE;
+        while (index != NONE)
+        {
+            uint32_t next = sessions[index].next;
+            Session &session = sessions[index];
+            if (session.lastActive + session.idleSeconds > currentTick)
+            {
+                schedule(index);
+            }
+            else
+            {
+                release(index);
+            }
+            index = next;
+        }
+    }
+}
+
+// Число действующих сессий
+size_t SessionManager::size() const
+{
+    return active;
+}
+
+// Представление токена для вывода пользователю
+std::string SessionManager::tokenToHex(const std::string &token)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    for (unsigned char ch : token)
+    {
+        hex += digits[ch >> 4];
+        hex += digits[ch & 0x0f];
+    }
+    return hex;
+}
+
+// Токен из шестнадцатеричной записи
+bool SessionManager::tokenFromHex(const std::string &hex, std::string &token)
+{
+    if (hex.size() != 2 * TOKEN_BYTES)
+    {
+        return false;
+    }
+    token.assign(TOKEN_BYTES, '\0');
+    for (size_t i = 0; i < hex.size(); ++i)
+    {
+        char ch = hex[i];
+        int value;
+        if (ch >= '0' && ch <= '9')
+        {
+            value = ch - '0';
+        }
+        else if (ch >= 'a' && ch <= 'f')
+        {
+            value = ch - 'a' + 10;
+        }
+        else if (ch >= 'A' && ch <= 'F')
+        {
+            value = ch - 'A' + 10;
+        }
+        else
+        {
+            return false;
+        }
+        token[i / 2] = static_cast<char>(token[i / 2] | (i % 2 == 0 ? value << 4 : value));
+    }
+    return true;
+}
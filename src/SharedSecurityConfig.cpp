@@ -0,0 +1,298 @@
+// src/SharedSecurityConfig.cpp
+
+#include <chrono>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+#include "SecurityConfig.hpp"
+#include "SharedSecurityConfig.hpp"
+
+// Время изменения файла в наносекундах
+static int64_t mtimeNs(const struct stat &fileStat)
+{
+    return static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+}
+
+SharedPolicyWriter::SharedPolicyWriter() : fd(-1), segment(nullptr)
+{
+}
+
+// Создание или открытие сегмента с именем segmentName (например, "/authentication_system_policy")
+ConfiguratorErrorCode SharedPolicyWriter::open(const std::string &segmentName)
+{
+    // Политика не секретна: сегмент доступен всем на чтение, на запись — только владельцу
+    fd = shm_open(segmentName.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    // Новый сегмент заполнен нулями: magic не установлен, и читатели его не используют
+    void *mapping = MAP_FAILED;
+    if (ftruncate(fd, sizeof(SharedPolicySegment)) == 0)
+    {
+        mapping = mmap(nullptr, sizeof(SharedPolicySegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (mapping == MAP_FAILED)
+    {
+        close(fd);
+        fd = -1;
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    segment = static_cast<SharedPolicySegment *>(mapping);
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Запись политики; писатели разных процессов сериализуются блокировкой flock на сегменте
+ConfiguratorErrorCode SharedPolicyWriter::write(const SharedPolicy &policy)
+{
+    if (segment == nullptr || flock(fd, LOCK_EX) != 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    uint32_t presentMask = 0;
+    for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+    {
+        presentMask |= policy.present[i] ? 1u << i : 0;
+    }
+
+    // Нечетный счетчик при удержании блокировки оставил писатель, завершившийся посреди записи:
+    // счетчик продолжается со следующего четного значения
+    uint64_t sequence = segment->sequence.load(std::memory_order_relaxed);
+    sequence += sequence % 2;
+
+    // Нечетный счетчик: запись идет; release-барьер не дает записям полей обогнать его
+    segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    segment->magic.store(SharedPolicySegment::MAGIC, std::memory_order_relaxed);
+    segment->paramCount.store(static_cast<uint32_t>(SECURITY_PARAM_COUNT), std::memory_order_relaxed);
+    segment->presentMask.store(presentMask, std::memory_order_relaxed);
+    for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+    {
+        segment->values[i].store(policy.values[i], std::memory_order_relaxed);
+    }
+    segment->fileDevice.store(static_cast<uint64_t>(policy.fileStat.st_dev), std::memory_order_relaxed);
+    segment->fileInode.store(static_cast<uint64_t>(policy.fileStat.st_ino), std::memory_order_relaxed);
+    segment->fileSize.store(static_cast<uint64_t>(policy.fileStat.st_size), std::memory_order_relaxed);
+    segment->fileMtimeNs.store(mtimeNs(policy.fileStat), std::memory_order_relaxed);
+
+    // Четный счетчик: запись завершена
+    segment->sequence.store(sequence + 2, std::memory_order_release);
+
+    flock(fd, LOCK_UN);
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+SharedPolicyWriter::~SharedPolicyWriter()
+{
+    if (segment != nullptr)
+    {
+        munmap(segment, sizeof(SharedPolicySegment));
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+SharedSecurityConfig::SharedSecurityConfig() : fd(-1), segment(nullptr), stuckSequence(0)
+{
+}
+
+// Чтение полей под seqlock. Запись длится доли микросекунды, поэтому сначала чтение повторяется сразу,
+// затем с уступанием процессора, но не дольше SHARED_POLICY_READ_TIMEOUT_MS
+template <typename Read>
+bool SharedSecurityConfig::readConsistent(Read read) const
+{
+    std::chrono::steady_clock::time_point deadline;
+    for (unsigned attempt = 0;; ++attempt)
+    {
+        uint64_t before = segment->sequence.load(std::memory_order_acquire);
+        if (before % 2 == 0)
+        {
+            read();
+            // acquire-барьер не дает повторному чтению счетчика обогнать чтение полей
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (segment->sequence.load(std::memory_order_relaxed) == before)
+            {
+                return true;
+            }
+        }
+        else if (before == stuckSequence.load(std::memory_order_relaxed))
+        {
+            return false; // Счетчик не изменился с прошлого отказа
+        }
+
+        if (attempt < 64)
+        {
+            continue;
+        }
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (attempt == 64)
+        {
+            deadline = now + std::chrono::milliseconds(SHARED_POLICY_READ_TIMEOUT_MS);
+        }
+        else if (now >= deadline)
+        {
+            if (before % 2 != 0)
+            {
+                stuckSequence.store(before, std::memory_order_relaxed);
+            }
+            return false;
+        }
+        std::this_thread::yield();
+    }
+}
+
+// Подключение к сегменту. Ошибка возвращается, если сегмента нет, он еще не заполнен,
+// принадлежит другому владельцу, чем файл конфигурации, или политика в нем получена не из текущей
+// версии файла configPath (файл изменен в обход конфигуратора) — тогда следует читать файл
+ConfiguratorErrorCode SharedSecurityConfig::attach(const std::string &segmentName, const std::string &path)
+{
+    configPath = path;
+    fd = shm_open(segmentName.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    // Сегмент, созданный не владельцем файла конфигурации, не используется
+    struct stat segmentStat;
+    struct stat fileStat;
+    void *mapping = MAP_FAILED;
+    if (fstat(fd, &segmentStat) == 0 && stat(configPath.c_str(), &fileStat) == 0 &&
+        segmentStat.st_uid == fileStat.st_uid && segmentStat.st_size >= static_cast<off_t>(sizeof(SharedPolicySegment)))
+    {
+        mapping = mmap(nullptr, sizeof(SharedPolicySegment), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    if (mapping == MAP_FAILED)
+    {
+        close(fd);
+        fd = -1;
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    segment = static_cast<const SharedPolicySegment *>(mapping);
+
+    // Политика должна соответствовать текущей версии файла
+    SharedPolicy policy;
+    if (readPolicy(policy) != ConfiguratorErrorCode::SUCCESS ||
+        policy.fileStat.st_dev != fileStat.st_dev || policy.fileStat.st_ino != fileStat.st_ino ||
+        policy.fileStat.st_size != fileStat.st_size || mtimeNs(policy.fileStat) != mtimeNs(fileStat))
+    {
+        munmap(const_cast<SharedPolicySegment *>(segment), sizeof(SharedPolicySegment));
+        segment = nullptr;
+        close(fd);
+        fd = -1;
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Согласованная копия всей политики
+ConfiguratorErrorCode SharedSecurityConfig::readPolicy(SharedPolicy &policy) const
+{
+    if (segment == nullptr)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    uint32_t magic = 0;
+    uint32_t paramCount = 0;
+    uint32_t presentMask = 0;
+    int64_t fileMtimeNs = 0;
+    bool consistent = readConsistent([&]
+                                     {
+                                         magic = segment->magic.load(std::memory_order_relaxed);
+                                         paramCount = segment->paramCount.load(std::memory_order_relaxed);
+                                         presentMask = segment->presentMask.load(std::memory_order_relaxed);
+                                         for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+                                         {
+                                             policy.values[i] = segment->values[i].load(std::memory_order_relaxed);
+                                         }
+                                         policy.fileStat.st_dev = static_cast<dev_t>(segment->fileDevice.load(std::memory_order_relaxed));
+                                         policy.fileStat.st_ino = static_cast<ino_t>(segment->fileInode.load(std::memory_order_relaxed));
+                                         policy.fileStat.st_size = static_cast<off_t>(segment->fileSize.load(std::memory_order_relaxed));
+                                         fileMtimeNs = segment->fileMtimeNs.load(std::memory_order_relaxed);
+                                     });
+    if (!consistent)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    // Сегмент не заполнен или записан программой с другой схемой
+    if (magic != SharedPolicySegment::MAGIC || paramCount != SECURITY_PARAM_COUNT)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+    {
+        policy.present[i] = (presentMask >> i) & 1u;
+    }
+    policy.fileStat.st_mtim.tv_sec = static_cast<time_t>(fileMtimeNs / 1000000000);
+    policy.fileStat.st_mtim.tv_nsec = static_cast<long>(fileMtimeNs % 1000000000);
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Получение значения параметра из сегмента: под seqlock читается только нужное поле
+ConfiguratorErrorCode SharedSecurityConfig::get(SecurityParam param, unsigned &value) const
+{
+    size_t index = static_cast<size_t>(param);
+    if (segment == nullptr || index >= SECURITY_PARAM_COUNT)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    uint32_t magic = 0;
+    uint32_t presentMask = 0;
+    uint32_t fieldValue = 0;
+    bool consistent = readConsistent([&]
+                                     {
+                                         magic = segment->magic.load(std::memory_order_relaxed);
+                                         presentMask = segment->presentMask.load(std::memory_order_relaxed);
+                                         fieldValue = segment->values[index].load(std::memory_order_relaxed);
+                                     });
+    if (!consistent)
+    {
+        // Запись в сегмент не завершается: файл разбирается один раз, дальше значения берутся из него
+        std::lock_guard<std::mutex> lock(fileConfigMutex);
+        if (!fileConfig)
+        {
+            fileConfig = std::make_unique<SecurityConfig>(configPath);
+        }
+        return fileConfig->get(param, value);
+    }
+
+    if (magic != SharedPolicySegment::MAGIC || !((presentMask >> index) & 1u))
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+
+    value = fieldValue;
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Сегмент доступен только для чтения; политика изменяется конфигуратором
+ConfiguratorErrorCode SharedSecurityConfig::applyChanges(const SecurityConfigChanges &)
+{
+    return ConfiguratorErrorCode::DATABASE_ERROR;
+}
+
+SharedSecurityConfig::~SharedSecurityConfig()
+{
+    if (segment != nullptr)
+    {
+        munmap(const_cast<SharedPolicySegment *>(segment), sizeof(SharedPolicySegment));
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
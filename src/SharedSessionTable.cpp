@@ -0,0 +1,221 @@
+// src/SharedSessionTable.cpp
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <sodium.h>
+#include <sys/mman.h>
+
+#include "SharedSessionTable.hpp"
+
+SharedSessionTable::SharedSessionTable()
+    : mapping(MAP_FAILED), mappingSize(0), active(nullptr), groups(nullptr), groupMask(0), lastSweep(0)
+{
+    // libsodium — источник случайных токенов
+    sodium_init();
+}
+
+// Создание таблицы на slotCount записей; вызывается до fork
+ConfiguratorErrorCode SharedSessionTable::open(size_t slotCount)
+{
+    if (mapping != MAP_FAILED)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    size_t groupCount = 1;
+    while (groupCount * GROUP_SLOTS < slotCount)
+    {
+        groupCount <<= 1;
+    }
+
+    // Счетчик занимает первую строку кеша, группы идут следом; анонимная память заполнена нулями
+    mappingSize = 64 + groupCount * sizeof(Group);
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+        return ConfiguratorErrorCode::DATABASE_ERROR;
+    }
+    active = new (mapping) std::atomic<uint64_t>(0);
+    groups = reinterpret_cast<Group *>(static_cast<char *>(mapping) + 64);
+    groupMask = groupCount - 1;
+
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    for (size_t i = 0; i < groupCount; ++i)
+    {
+        pthread_mutex_init(&groups[i].mutex, &attributes);
+    }
+    pthread_mutexattr_destroy(&attributes);
+    return ConfiguratorErrorCode::SUCCESS;
+}
+
+// Токен случаен, поэтому его первые байты — готовый хеш
+SharedSessionTable::Group &SharedSessionTable::groupOf(const unsigned char *token) const
+{
+    uint64_t hash;
+    std::memcpy(&hash, token, sizeof(hash));
+    return groups[hash & groupMask];
+}
+
+// Захват мьютекса группы. Процесс, завершившийся под мьютексом, мог оставить запись недописанной:
+// записи группы сбрасываются, их сессии теряются
+void SharedSessionTable::lock(Group &group)
+{
+    if (pthread_mutex_lock(&group.mutex) == EOWNERDEAD)
+    {
+        for (Slot &slot : group.slots)
+        {
+            if (slot.used)
+            {
+                release(slot);
+            }
+        }
+        pthread_mutex_consistent(&group.mutex);
+    }
+}
+
+// Освобождение записи (под мьютексом группы)
+void SharedSessionTable::release(Slot &slot)
+{
+    sodium_memzero(&slot, sizeof(slot));
+    active->fetch_sub(1, std::memory_order_relaxed);
+}
+
+// Создание сессии; пустая строка, если в группе нет места, логин слишком длинный или idleSeconds == 0
+std::string SharedSessionTable::create(const std::string &login, int64_t idleSeconds, int64_t now)
+{
+    if (groups == nullptr || idleSeconds <= 0 || login.size() > MAX_LOGIN)
+    {
+        return std::string();
+    }
+
+    unsigned char token[TOKEN_BYTES];
+    randombytes_buf(token, sizeof(token));
+    Group &group = groupOf(token);
+    lock(group);
+    Slot *free = nullptr;
+    for (Slot &slot : group.slots)
+    {
+        if (slot.used && slot.lastActive + slot.idleSeconds <= now)
+        {
+            release(slot);
+        }
+        if (!slot.used && free == nullptr)
+        {
+            free = &slot;
+        }
+    }
+    if (free != nullptr)
+    {
+        std::memcpy(free->token, token, sizeof(token));
+        std::memcpy(free->login, login.c_str(), login.size() + 1);
+        free->lastActive = now;
+        free->idleSeconds = idleSeconds;
+        free->used = true;
+        active->fetch_add(1, std::memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&group.mutex);
+
+    std::string result = free != nullptr ? std::string(reinterpret_cast<const char *>(token), sizeof(token)) : std::string();
+    sodium_memzero(token, sizeof(token));
+    return result;
+}
+
+// Проверка токена с продлением сессии; false, если сессии нет или она истекла
+bool SharedSessionTable::validate(const std::string &token, int64_t now, std::string &login)
+{
+    if (groups == nullptr || token.size() != TOKEN_BYTES)
+    {
+        return false;
+    }
+    const unsigned char *key = reinterpret_cast<const unsigned char *>(token.data());
+    Group &group = groupOf(key);
+    bool found = false;
+    lock(group);
+    for (Slot &slot : group.slots)
+    {
+        if (!slot.used || std::memcmp(slot.token, key, TOKEN_BYTES) != 0)
+        {
+            continue;
+        }
+        if (slot.lastActive + slot.idleSeconds <= now)
+        {
+            release(slot);
+            break;
+        }
+        if (now > slot.lastActive)
+        {
+            slot.lastActive = now;
+        }
+        login = slot.login;
+        found = true;
+        break;
+    }
+    pthread_mutex_unlock(&group.mutex);
+    return found;
+}
+
+// Завершение сессии; false, если сессии нет
+bool SharedSessionTable::revoke(const std::string &token)
+{
+    if (groups == nullptr || token.size() != TOKEN_BYTES)
+    {
+        return false;
+    }
+    const unsigned char *key = reinterpret_cast<const unsigned char *>(token.data());
+    Group &group = groupOf(key);
+    bool found = false;
+    lock(group);
+    for (Slot &slot : group.slots)
+    {
+        if (slot.used && std::memcmp(slot.token, key, TOKEN_BYTES) == 0)
+        {
+            release(slot);
+            found = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&group.mutex);
+    return found;
+}
+
+// Освобождение истекших сессий всей таблицы, не чаще раза в секунду на процесс
+void SharedSessionTable::advance(int64_t now)
+{
+    if (groups == nullptr || now <= lastSweep)
+    {
+        return;
+    }
+    lastSweep = now;
+    if (active->load(std::memory_order_relaxed) == 0)
+    {
+        return;
+    }
+    for (size_t i = 0; i <= groupMask; ++i)
+    {
+        lock(groups[i]);
+        for (Slot &slot : groups[i].slots)
+        {
+            if (slot.used && slot.lastActive + slot.idleSeconds <= now)
+            {
+                release(slot);
+            }
+        }
+        pthread_mutex_unlock(&groups[i].mutex);
+    }
+}
+
+size_t SharedSessionTable::size() const
+{
+    return active != nullptr ? static_cast<size_t>(active->load(std::memory_order_relaxed)) : 0;
+}
+
+SharedSessionTable::~SharedSessionTable()
+{
+    if (mapping != MAP_FAILED)
+    {
+        munmap(mapping, mappingSize);
+    }
+}
@@ -0,0 +1,197 @@
+// src/ThreadPoolIoBackend.cpp
+
+#include <cerrno>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "ThreadPoolIoBackend.hpp"
+
+ThreadPoolIoBackend::ThreadPoolIoBackend(size_t threads)
+{
+    completionFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    for (size_t i = 0; i < (threads > 0 ? threads : 2); ++i)
+    {
+        workers.emplace_back(&ThreadPoolIoBackend::workerLoop, this);
+    }
+}
+
+// Выполнение одной операции; -errno при ошибке
+static ssize_t perform(int operation, int fd, void *buffer, size_t size, off_t offset)
+{
+    ssize_t result;
+    do
+    {
+        if (operation == 0)
+        {
+            result = pread(fd, buffer, size, offset);
+        }
+        else if (operation == 1)
+        {
+            // pwrite не принимает отрицательное смещение: запись с текущей позиции
+            result = offset < 0 ? ::write(fd, buffer, size) : pwrite(fd, buffer, size, offset);
+        }
+        else
+        {
+            result = ::fsync(fd);
+        }
+    } while (result < 0 && errno == EINTR);
+    return result < 0 ? -errno : result;
+}
+
+// Основной цикл потока
+void ThreadPoolIoBackend::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        changed.wait(lock, [this]
+                     { return (stopping && pending.empty()) ||
+                              (!pending.empty() && !draining && (pending.front().operation != Operation::FSYNC || running == 0)); });
+        if (pending.empty())
+        {
+            return;
+        }
+        Request request = pending.front();
+        pending.pop_front();
+        bool barrier = request.operation == Operation::FSYNC;
+        draining = barrier;
+        ++running;
+        lock.unlock();
+
+        ssize_t result = perform(static_cast<int>(request.operation), request.fd, request.buffer, request.size, request.offset);
+
+        lock.lock();
+        --running;
+        if (barrier)
+        {
+            draining = false;
+        }
+        results.emplace_back(request.slot, result);
+        uint64_t one = 1;
+        ssize_t unused = ::write(completionFd, &one, sizeof(one));
+        (void)unused;
+        completed.notify_one();
+        // Ожидающий fsync может начаться, а после fsync — все остальные
+        changed.notify_all();
+    }
+}
+
+void ThreadPoolIoBackend::enqueue(Operation operation, int fd, void *buffer, size_t size, off_t offset, Completion done)
+{
+    uint32_t slot;
+    if (freeSlots.empty())
+    {
+        slot = static_cast<uint32_t>(callbacks.size());
+        callbacks.push_back(std::move(done));
+    }
+    else
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        callbacks[slot] = std::move(done);
+    }
+    queued.push_back({operation, fd, buffer, size, offset, slot});
+}
+
+void ThreadPoolIoBackend::read(int fd, void *buffer, size_t size, off_t offset, Completion done)
+{
+    enqueue(Operation::READ, fd, buffer, size, offset, std::move(done));
+}
+
+void ThreadPoolIoBackend::write(int fd, const void *data, size_t size, off_t offset, Completion done)
+{
+    enqueue(Operation::WRITE, fd, const_cast<void *>(data), size, offset, std::move(done));
+}
+
+void ThreadPoolIoBackend::fsync(int fd, Completion done)
+{
+    enqueue(Operation::FSYNC, fd, nullptr, 0, 0, std::move(done));
+}
+
+// Передача пакета потокам под одним захватом мьютекса
+size_t ThreadPoolIoBackend::submit()
+{
+    size_t count = queued.size();
+    if (count == 0)
+    {
+        return 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.insert(pending.end(), queued.begin(), queued.end());
+    }
+    changed.notify_all();
+    submitted += count;
+    queued.clear();
+    return count;
+}
+
+// Обратные вызовы завершившихся операций
+size_t ThreadPoolIoBackend::complete(bool wait)
+{
+    if (wait && submitted == 0 && !queued.empty())
+    {
+        submit();
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (wait && submitted > ready.size())
+        {
+            completed.wait(lock, [this]
+                           { return !results.empty() || !ready.empty(); });
+        }
+        ready.insert(ready.end(), results.begin(), results.end());
+        results.clear();
+    }
+    uint64_t value;
+    ssize_t unused = ::read(completionFd, &value, sizeof(value));
+    (void)unused;
+
+    // Завершения берутся из общей очереди по одному: обратный вызов может сам вызвать complete()
+    size_t count = 0;
+    while (!ready.empty())
+    {
+        std::pair<uint32_t, ssize_t> result = ready.front();
+        ready.pop_front();
+        --submitted;
+        // Обратный вызов может поставить новые операции и занять освободившийся номер
+        Completion done = std::move(callbacks[result.first]);
+        callbacks[result.first] = nullptr;
+        freeSlots.push_back(result.first);
+        ++count;
+        done(result.second);
+    }
+    return count;
+}
+
+int ThreadPoolIoBackend::eventFd() const
+{
+    return completionFd;
+}
+
+size_t ThreadPoolIoBackend::inFlight() const
+{
+    return queued.size() + submitted;
+}
+
+const char *ThreadPoolIoBackend::name() const
+{
+    return "threads";
+}
+
+ThreadPoolIoBackend::~ThreadPoolIoBackend()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    if (completionFd >= 0)
+    {
+        close(completionFd);
+    }
+}
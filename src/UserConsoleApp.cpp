@@ -1,18 +1,25 @@
 // src/UserConsoleApp.cpp
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <limits>
+#include <memory>
+#include <thread>
 #include <vector>
-#include <sstream>
 #include <termios.h>
 #include <unistd.h>
-#include <ctime>
 
 #include "UserConsoleApp.hpp"
 #include "ConfiguratorDatabase.hpp"
 #include "SecurityConfig.hpp"
-#include "Hashing.hpp"
+#include "SharedSecurityConfig.hpp"
+#include "HashingEngine.hpp"
+#include "BatchAuthenticator.hpp"
+#include "PartitionedUserTable.hpp"
+#include "SessionManager.hpp"
 
 std::string UserConsoleApp::errorCodeToString(UserErrorCode code) const
 {
@@ -32,6 +39,20 @@ std::string UserConsoleApp::errorCodeToString(UserErrorCode code) const
         return "Incorrect password was entered.";
     case UserErrorCode::PASSWORD_HAS_EXPIRED:
         return "The password has expired";
+    case UserErrorCode::ACCOUNT_LOCKED:
+        return "The account is temporarily locked after too many failed attempts";
+    case UserErrorCode::SESSION_EXPIRED:
+        return "The session has expired or does not exist";
+    case UserErrorCode::RATE_LIMITED:
+        return "Too many login attempts, try again later";
+    case UserErrorCode::PASSWORD_REJECTED:
+        return "The new password does not meet the security requirements";
+    case UserErrorCode::ROLE_NOT_GRANTED:
+        return "The user does not have this role";
+    case UserErrorCode::OVERLOADED:
+        return "The server is overloaded, try again later";
+    case UserErrorCode::DEADLINE_EXCEEDED:
+        return "The server did not check the password in time, try again";
     default:
         return "Unknown error";
     }
@@ -50,77 +71,6 @@ UserErrorCode UserConsoleApp::loginEntering(const std::string &prompt, std::stri
     return UserErrorCode::SUCCESS;
 }
 
-UserErrorCode UserConsoleApp::loginVerification(const std::string &login, std::string &strUserData)
-{
-    ConfiguratorErrorCode code = db->getActiveUserByLogin(login, strUserData);
-    switch (code)
-    {
-    case ConfiguratorErrorCode::SUCCESS:
-        return UserErrorCode::SUCCESS;
-    case ConfiguratorErrorCode::LOGIN_NOT_FOUND:
-        return UserErrorCode::LOGIN_NOT_EXISTS;
-    default:
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-}
-
-UserErrorCode UserConsoleApp::parseUserData(const std::string &strUserData)
-{
-    std::istringstream iss(strUserData);
-
-    // Логин
-    if (!(iss >> userData.login) || userData.login.empty())
-    {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-
-    // Хеш пароля
-    if (!(iss >> userData.passwordHash) || userData.passwordHash.empty())
-    {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-
-    // Дата
-    if (!(iss >> userData.date) || userData.date.empty())
-    {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-
-    // Роли
-    std::string rolesString;
-    if (!(iss >> rolesString) || rolesString.empty())
-    {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-
-    // Парсим роли через запятую
-    std::istringstream rolesStream(rolesString);
-    std::string roleStr;
-    while (std::getline(rolesStream, roleStr, ','))
-    {
-        if (roleStr.empty())
-        {
-            return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-        }
-
-        // Сконвертировать строку роли в число
-        int roleNumber = 0;
-        for (char ch : roleStr)
-        {
-            roleNumber = roleNumber * 10 + (ch - '0');
-        }
-
-        userData.roles.push_back(static_cast<UserRole>(roleNumber));
-    }
-
-    if (userData.roles.empty())
-    {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-
-    return UserErrorCode::SUCCESS;
-}
-
 UserErrorCode UserConsoleApp::passwordEntering(const std::string &prompt, std::string &password)
 {
     std::cout << prompt << std::endl;
@@ -156,14 +106,13 @@ UserErrorCode UserConsoleApp::passwordEntering(const std::string &prompt, std::s
 UserErrorCode UserConsoleApp::passwordVerification()
 {
     unsigned maxFailedAttempts;
-    ConfiguratorErrorCode configuratorCode = config->get_maxFailedAttempts(maxFailedAttempts);
-    if (configuratorCode != ConfiguratorErrorCode::SUCCESS)
+    UserErrorCode code = authenticator->getMaxFailedAttempts(maxFailedAttempts);
+    if (code != UserErrorCode::SUCCESS)
     {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+        return code;
     }
 
     unsigned currentFailedAttempts = 0;
-    UserErrorCode code;
     while (currentFailedAttempts < maxFailedAttempts)
     {
         std::string password;
@@ -183,10 +132,10 @@ UserErrorCode UserConsoleApp::passwordVerification()
         }
 
         // Проверка правильности введенного пароля
-        configuratorCode = hasher->pwHashVerify(password, userData.passwordHash);
-        if (configuratorCode == ConfiguratorErrorCode::SUCCESS)
+        code = authenticator->verifyPassword(password, userData);
+        if (code == UserErrorCode::SUCCESS || code == UserErrorCode::ACCOUNT_LOCKED)
         {
-            return UserErrorCode::SUCCESS;
+            return code;
         }
         else
         {
@@ -198,127 +147,88 @@ UserErrorCode UserConsoleApp::passwordVerification()
     return UserErrorCode::WRONG_PASSWORD;
 }
 
-UserErrorCode UserConsoleApp::PasswordExpirationCheck()
+// Вход через сервер аутентификации: сервер выполняет те же проверки и считает попытки
+UserErrorCode UserConsoleApp::remoteAuthentication(const std::string &login, std::string &sessionToken)
 {
-    unsigned passwordExpirationDays;
-    ConfiguratorErrorCode configuratorCode = config->get_passwordExpirationDays(passwordExpirationDays);
-    if (configuratorCode != ConfiguratorErrorCode::SUCCESS)
-    {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-
-    int daysDifference;
-    UserErrorCode code = differenceInDays(userData.date, daysDifference);
-    if (code != UserErrorCode::SUCCESS)
+    std::string prompt = "Enter your password:";
+    while (true)
     {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
+        std::string password;
+        UserErrorCode code = passwordEntering(prompt, password);
+        if (code != UserErrorCode::SUCCESS)
+        {
+            return code;
+        }
 
-    if (daysDifference > passwordExpirationDays)
-    {
-        return UserErrorCode::PASSWORD_HAS_EXPIRED;
+        AuthProtocol::AuthResponse response;
+        ConfiguratorErrorCode configuratorCode = client->authenticate(login, password, response);
+        std::memset(&password[0], 0, password.size());
+        if (configuratorCode != ConfiguratorErrorCode::SUCCESS)
+        {
+            return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+        }
+        if (response.status != UserErrorCode::WRONG_PASSWORD || response.attemptsLeft == 0)
+        {
+            sessionToken = response.sessionToken;
+            return response.status;
+        }
+        prompt = "Wrong password, try again:";
     }
-
-    return UserErrorCode::SUCCESS;
 }
 
-// Проверка, високосный ли год
-bool UserConsoleApp::isLeapYear(int year)
-{
-    return (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
-}
-
-// Количество дней в каждом месяце
-unsigned UserConsoleApp::getDaysInMonth(int month, int year)
+UserConsoleApp::UserConsoleApp() : configPath("./configDb/config.txt"),
+                                   activeUsersPath("./configDb/active_users.txt"),
+                                   archivePath("./configDb/archive.txt"),
+                                   tmpPath("./configDb/tmp_file.txt"),
+                                   policySegmentName("/authentication_system_policy"),
+                                   authdSocketPath("./configDb/authd.sock"),
+                                   lockoutPath("./configDb/lockout.dat"),
+                                   db(nullptr), config(nullptr), hasher(nullptr), lockout(nullptr), authenticator(nullptr)
 {
-    static const unsigned daysInMonth[] = {
-        31, 28, 31, 30, 31, 30,
-        31, 31, 30, 31, 30, 31};
-    if (month == 2 && isLeapYear(year))
+    // Если запущен сервер аутентификации, проверки выполняет он и база в этом процессе не нужна
+    client = new AuthClient();
+    if (client->connect(authdSocketPath) == ConfiguratorErrorCode::SUCCESS)
     {
-        return 29;
+        return;
     }
-    return daysInMonth[month - 1];
-}
+    delete client;
+    client = nullptr;
 
-// Парсинг даты
-UserErrorCode UserConsoleApp::parseDate(const std::string &dateStr, unsigned &day, unsigned &month, unsigned &year)
-{
-    std::istringstream iss(dateStr);
-    char dot1, dot2;
-
-    if (!(iss >> day >> dot1 >> month >> dot2 >> year))
-    {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-    if (dot1 != '.' || dot2 != '.')
-    {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-    if (day < 1 || day > 31 || month < 1 || month > 12)
-    {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
-    }
-    return UserErrorCode::SUCCESS;
+    openLocal(false);
 }
 
-// Преобразование даты в количество дней с начала отсчета
-unsigned UserConsoleApp::daysFromEpoch(unsigned day, unsigned month, unsigned year)
+// Создание базы, конфигурации и хешера для проверок в этом процессе
+void UserConsoleApp::openLocal(bool indexActiveUsers)
 {
-    unsigned days = day;
-
-    // Дни в прошедших месяцах текущего года
-    for (unsigned m = 1; m < month; ++m)
+    ConfiguratorDatabase *database = new ConfiguratorDatabase(archivePath, activeUsersPath, tmpPath);
+    if (indexActiveUsers)
     {
-        days += getDaysInMonth(m, year);
+        database->enableActiveUsersIndex();
     }
+    db = database;
 
-    // Дни в прошедших годах
-    for (unsigned y = 0; y < year; ++y)
+    // Политика читается из разделяемой памяти, опубликованной конфигуратором;
+    // если сегмента нет или он устарел, разбирается файл конфигурации
+    SharedSecurityConfig *sharedConfig = new SharedSecurityConfig();
+    if (sharedConfig->attach(policySegmentName, configPath) == ConfiguratorErrorCode::SUCCESS)
     {
-        days += isLeapYear(y) ? 366 : 365;
+        config = sharedConfig;
     }
-
-    return days;
-}
-
-// Разница в днях между двумя датами
-UserErrorCode UserConsoleApp::differenceInDays(const std::string &userDateStr, int &difference)
-{
-    unsigned userDay, userMonth, userYear;
-    UserErrorCode code = parseDate(userDateStr, userDay, userMonth, userYear);
-    if (code != UserErrorCode::SUCCESS)
+    else
     {
-        return code;
+        delete sharedConfig;
+        config = new SecurityConfig(configPath);
     }
+    hasher = HashingEngine::create().release();
 
-    // Текущая дата
-    std::time_t t = std::time(nullptr);
-    std::tm *now = std::localtime(&t);
-    int currentDay = now->tm_mday;
-    int currentMonth = now->tm_mon + 1;
-    int currentYear = now->tm_year + 1900;
-
-    int userDays = daysFromEpoch(userDay, userMonth, userYear);
-    int currentDays = daysFromEpoch(currentDay, currentMonth, currentYear);
-
-    difference = currentDays - userDays;
-    if (difference < 0)
+    // Без файла счетчиков вход возможен, но число попыток ограничено только в пределах сеанса
+    lockout = new LockoutTable();
+    if (lockout->open(lockoutPath) != ConfiguratorErrorCode::SUCCESS)
     {
-        return UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+        delete lockout;
+        lockout = nullptr;
     }
-
-    return UserErrorCode::SUCCESS;
-}
-
-UserConsoleApp::UserConsoleApp() : configPath("./configDb/config.txt"),
-                                   activeUsersPath("./configDb/active_users.txt"),
-                                   archivePath("./configDb/archive.txt"),
-                                   tmpPath("./configDb/tmp_file.txt")
-{
-    db = new ConfiguratorDatabase(archivePath, activeUsersPath, tmpPath);
-    config = new SecurityConfig(configPath);
-    hasher = new Hashing();
+    authenticator = new Authenticator(db, config, hasher, lockout);
 }
 
 void UserConsoleApp::run()
@@ -332,19 +242,31 @@ void UserConsoleApp::run()
         return;
     }
 
-    // Проверка наличия логина в базе пользователей
-    std::string strUserData;
-    code = loginVerification(login, strUserData);
+    // Вход через сервер аутентификации
+    if (client != nullptr)
+    {
+        std::string sessionToken;
+        code = remoteAuthentication(login, sessionToken);
+        std::cout << (code == UserErrorCode::SUCCESS ? "Access is allowed" : errorCodeToString(code)) << std::endl;
+        if (code == UserErrorCode::SUCCESS && !sessionToken.empty())
+        {
+            std::cout << "Session token: " << SessionManager::tokenToHex(sessionToken) << std::endl;
+        }
+        return;
+    }
+
+    // Проверка наличия логина в базе пользователей и парсинг строки данных пользователя
+    // на логин, хешированный пароль, дату изменения пароля и список ролей
+    code = authenticator->findUser(login, userData, requestArena.resource());
+    requestArena.reset();
     if (code != UserErrorCode::SUCCESS)
     {
         std::cout << errorCodeToString(code) << std::endl;
         return;
     }
 
-
-    // Парсинг строки данных пользователя на логин, хешированный пароль,
-    // дату изменения пароля и список ролей
-    code = parseUserData(strUserData);
+    // Заблокированному логину пароль не запрашивается
+    code = authenticator->checkLockout(userData.login);
     if (code != UserErrorCode::SUCCESS)
     {
         std::cout << errorCodeToString(code) << std::endl;
@@ -360,7 +282,7 @@ void UserConsoleApp::run()
     }
 
     // Проверка, не истек ли срок действия пароля
-    code = PasswordExpirationCheck();
+    code = authenticator->checkPasswordExpiration(userData);
     if (code != UserErrorCode::SUCCESS)
     {
         std::cout << errorCodeToString(code) << std::endl;
@@ -371,8 +293,77 @@ void UserConsoleApp::run()
     std::cout << "Access is allowed" << std::endl;
 }
 
+// Пакетный режим: записи проверяются в этом процессе пулом потоков, даже если запущен authd —
+// сервер закрывает соединение после нескольких неверных паролей подряд. В режиме perCore активные
+// пользователи загружаются в таблицу с разделом на каждое ядро, и записи обслуживают потоки ядер
+bool UserConsoleApp::runBatch(const std::string &path, bool perCore)
+{
+    std::ifstream file;
+    if (path != "-")
+    {
+        file.open(path);
+        if (!file.is_open())
+        {
+            std::cerr << "Cannot open " << path << std::endl;
+            return false;
+        }
+    }
+    if (authenticator != nullptr)
+    {
+        delete authenticator;
+        delete lockout;
+        delete db;
+        delete config;
+        delete hasher;
+    }
+    openLocal(true);
+
+    BatchAuthOptions options;
+    std::unique_ptr<PartitionedUserTable> table;
+    if (perCore)
+    {
+        table = std::make_unique<PartitionedUserTable>(std::max(1u, std::thread::hardware_concurrency()));
+        if (table->load(*db) != ConfiguratorErrorCode::SUCCESS)
+        {
+            std::cerr << "Cannot load active users" << std::endl;
+            return false;
+        }
+        options.userTable = table.get();
+    }
+    BatchAuthenticator batch(authenticator, hasher, options);
+    BatchAuthReport report = batch.run(path == "-" ? std::cin : file, std::cout);
+    std::cout.flush();
+    BatchAuthenticator::printReport(report, std::cerr);
+    return true;
+}
+
+// Повторный вход по токену сессии: проверяет authd, пароль не запрашивается
+void UserConsoleApp::runSession(const std::string &hexToken)
+{
+    if (client == nullptr)
+    {
+        std::cout << "Sessions are available only when the authentication daemon is running" << std::endl;
+        return;
+    }
+
+    std::string token;
+    AuthProtocol::AuthResponse response;
+    if (!SessionManager::tokenFromHex(hexToken, token))
+    {
+        response.status = UserErrorCode::SESSION_EXPIRED;
+    }
+    else if (client->resumeSession(token, response) != ConfiguratorErrorCode::SUCCESS)
+    {
+        response.status = UserErrorCode::GETTING_DATA_FROM_DB_ERROR;
+    }
+    std::cout << (response.status == UserErrorCode::SUCCESS ? "Access is allowed" : errorCodeToString(response.status)) << std::endl;
+}
+
 UserConsoleApp::~UserConsoleApp()
 {
+    delete client;
+    delete authenticator;
+    delete lockout;
     delete db;
     delete config;
     delete hasher;
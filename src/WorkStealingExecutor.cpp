@@ -0,0 +1,168 @@
+// src/WorkStealingExecutor.cpp
+
+#include <algorithm>
+
+#include "WorkStealingExecutor.hpp"
+
+// Исполнитель и номер потока, в котором выполняется текущая задача
+static thread_local const WorkStealingExecutor *currentExecutor = nullptr;
+static thread_local size_t currentWorker = 0;
+
+WorkStealingExecutor::WorkStealingExecutor(const WorkStealingOptions &options)
+    : pending(0), sleeping(0), nextWorker(0), stopping(false)
+{
+    size_t count = options.workers != 0 ? options.workers : std::max(1u, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < count; ++i)
+    {
+        workers.emplace_back(new Worker());
+        workers.back()->random = 0x9e3779b97f4a7c15ull * (i + 1);
+    }
+    // Потоки запускаются после создания всех очередей: поток сразу начинает просматривать чужие
+    for (size_t i = 0; i < count; ++i)
+    {
+        workers[i]->thread = std::thread(&WorkStealingExecutor::workerLoop, this, i);
+    }
+}
+
+// Постановка задачи; вызывается из любого потока, в том числе из задачи этого исполнителя
+void WorkStealingExecutor::submit(std::function<void()> task)
+{
+    bool local = currentExecutor == this;
+    size_t index = local ? currentWorker : nextWorker.fetch_add(1) % workers.size();
+    Worker &worker = *workers[index];
+
+    // Счетчик увеличивается до постановки: взявший задачу поток не уменьшит его ниже нуля.
+    // pending и sleeping меняются в разном порядке постановщиком и засыпающим потоком:
+    // хотя бы один из них видит изменение другого, и задача не остается без исполнителя
+    pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        (local ? worker.tasks : worker.injected).push_back(std::move(task));
+    }
+    if (sleeping.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+        }
+        wake.notify_one();
+    }
+}
+
+// Задача из своей очереди или перехваченная у другого потока
+bool WorkStealingExecutor::takeTask(size_t index, std::function<void()> &task)
+{
+    Worker &self = *workers[index];
+    {
+        std::lock_guard<std::mutex> lock(self.mutex);
+        if (!self.tasks.empty())
+        {
+            // Своя очередь — с конца: следующий этап только что выполненного запроса
+            task = std::move(self.tasks.back());
+            self.tasks.pop_back();
+            pending.fetch_sub(1);
+            return true;
+        }
+        if (!self.injected.empty())
+        {
+            // Затем самая старая задача извне
+            task = std::move(self.injected.front());
+            self.injected.pop_front();
+            pending.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Обход остальных очередей с случайного места (xorshift)
+    size_t count = workers.size();
+    self.random ^= self.random << 13;
+    self.random ^= self.random >> 7;
+    self.random ^= self.random << 17;
+    size_t start = static_cast<size_t>(self.random % count);
+    for (size_t step = 0; step < count; ++step)
+    {
+        size_t victimIndex = (start + step) % count;
+        if (victimIndex == index)
+        {
+            continue;
+        }
+        Worker &victim = *workers[victimIndex];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        std::deque<std::function<void()>> &victimTasks = victim.injected.empty() ? victim.tasks : victim.injected;
+        if (!victimTasks.empty())
+        {
+            // Чужая очередь — с начала: самая старая задача, сначала из поставленных извне
+            task = std::move(victimTasks.front());
+            victimTasks.pop_front();
+            pending.fetch_sub(1);
+            self.stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Основной цикл потока
+void WorkStealingExecutor::workerLoop(size_t index)
+{
+    currentExecutor = this;
+    currentWorker = index;
+    Worker &self = *workers[index];
+
+    std::function<void()> task;
+    while (true)
+    {
+        if (takeTask(index, task))
+        {
+            task();
+            task = nullptr;
+            self.executed.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Задачи, поставленные выполняемыми задачами, учтены в pending до их завершения
+        if (stopping.load() && pending.load() == 0)
+        {
+            return;
+        }
+
+        sleeping.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this]
+                      { return pending.load() > 0 || stopping.load(); });
+        }
+        sleeping.fetch_sub(1);
+    }
+}
+
+// Число потоков
+size_t WorkStealingExecutor::size() const
+{
+    return workers.size();
+}
+
+// Текущая статистика
+WorkStealingStats WorkStealingExecutor::stats() const
+{
+    WorkStealingStats result;
+    for (const std::unique_ptr<Worker> &worker : workers)
+    {
+        result.executed += worker->executed.load(std::memory_order_relaxed);
+        result.stolen += worker->stolen.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+// Дожидается выполнения всех задач и останавливает потоки
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::unique_ptr<Worker> &worker : workers)
+    {
+        worker->thread.join();
+    }
+}
@@ -0,0 +1,235 @@
+// tests/test_Argon2Hashing.cpp
+
+#include <gtest/gtest.h>
+#include <sodium.h>
+#include <cstring>
+
+#include "Argon2Hashing.hpp"
+#include "Argon2Kernels.hpp"
+#include "Blake2b.hpp"
+#include "Hashing.hpp"
+#include "HashingEngine.hpp"
+#include "MemoryArena.hpp"
+
+// Перевод байтов в шестнадцатеричную строку
+static std::string toHex(const uint8_t *data, size_t length)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i < length; ++i)
+    {
+        out += digits[data[i] >> 4];
+        out += digits[data[i] & 0x0F];
+    }
+    return out;
+}
+
+// Вычисление тега для тестового вектора RFC 9106 (раздел 5)
+static std::string rfc9106Tag(Argon2Type type, Argon2Kernel kernel = Argon2Kernel::PORTABLE)
+{
+    uint8_t password[32];
+    uint8_t salt[16];
+    uint8_t secret[8];
+    uint8_t associatedData[12];
+    std::memset(password, 0x01, sizeof(password));
+    std::memset(salt, 0x02, sizeof(salt));
+    std::memset(secret, 0x03, sizeof(secret));
+    std::memset(associatedData, 0x04, sizeof(associatedData));
+
+    Argon2Params params;
+    params.type = type;
+    params.timeCost = 3;
+    params.memoryKiB = 32;
+    params.lanes = 4;
+    params.password = password;
+    params.passwordLength = sizeof(password);
+    params.salt = salt;
+    params.saltLength = sizeof(salt);
+    params.secret = secret;
+    params.secretLength = sizeof(secret);
+    params.associatedData = associatedData;
+    params.associatedDataLength = sizeof(associatedData);
+    params.kernel = kernel;
+
+    uint8_t tag[32];
+    EXPECT_EQ(Argon2::hash(params, tag, sizeof(tag)), ConfiguratorErrorCode::SUCCESS);
+    return toHex(tag, sizeof(tag));
+}
+
+class Argon2HashingTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (sodium_init() == -1)
+        {
+            FAIL() << "Не удалось инициализировать libsodium";
+        }
+    }
+};
+
+// Проверка BLAKE2b-512 на векторе из RFC 7693
+TEST_F(Argon2HashingTest, Blake2b_KnownAnswer)
+{
+    uint8_t out[64];
+    Blake2b::hash(out, sizeof(out), "abc", 3);
+    EXPECT_EQ(toHex(out, sizeof(out)),
+              "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d1"
+              "7d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+}
+
+// Тестовые векторы RFC 9106 для всех трех вариантов
+TEST_F(Argon2HashingTest, Rfc9106_KnownAnswers)
+{
+    EXPECT_EQ(rfc9106Tag(Argon2Type::ARGON2D), "512b391b6f1162975371d30919734294f868e3be3984f3c1a13a4db9fabe4acb");
+    EXPECT_EQ(rfc9106Tag(Argon2Type::ARGON2I), "c814d9d1dc7f37aa13f0d77f2494bda1c8de6b016dd388d29952a4c4672b6ce8");
+    EXPECT_EQ(rfc9106Tag(Argon2Type::ARGON2ID), "0d640df58d78766c08c037a34a8b53c9d01ef0452d75b65eb52520e96b01e659");
+}
+
+// Тестовые векторы RFC 9106 для каждой векторной реализации, поддерживаемой процессором
+TEST_F(Argon2HashingTest, Rfc9106_KnownAnswersPerKernel)
+{
+    const Argon2Kernel kernels[] = {Argon2Kernel::SSE41, Argon2Kernel::AVX2, Argon2Kernel::AVX512, Argon2Kernel::AUTO};
+    for (Argon2Kernel kernel : kernels)
+    {
+        if (!Argon2Kernels::isSupported(kernel))
+        {
+            std::cout << "Skipping unsupported kernel " << Argon2Kernels::name(kernel) << std::endl;
+            continue;
+        }
+        SCOPED_TRACE(Argon2Kernels::name(kernel));
+        EXPECT_EQ(rfc9106Tag(Argon2Type::ARGON2D, kernel), "512b391b6f1162975371d30919734294f868e3be3984f3c1a13a4db9fabe4acb");
+        EXPECT_EQ(rfc9106Tag(Argon2Type::ARGON2I, kernel), "c814d9d1dc7f37aa13f0d77f2494bda1c8de6b016dd388d29952a4c4672b6ce8");
+        EXPECT_EQ(rfc9106Tag(Argon2Type::ARGON2ID, kernel), "0d640df58d78766c08c037a34a8b53c9d01ef0452d75b65eb52520e96b01e659");
+    }
+}
+
+// Векторные функции сжатия совпадают с переносимой на случайных блоках (с XOR и без)
+TEST_F(Argon2HashingTest, KernelsMatchPortable)
+{
+    Argon2Block prev, ref, next;
+    randombytes_buf(&prev, sizeof(prev));
+    randombytes_buf(&ref, sizeof(ref));
+    randombytes_buf(&next, sizeof(next));
+
+    const Argon2Kernel kernels[] = {Argon2Kernel::SSE41, Argon2Kernel::AVX2, Argon2Kernel::AVX512};
+    for (bool withXor : {false, true})
+    {
+        Argon2Block expected = next;
+        Argon2Kernels::fillBlockPortable(&prev, &ref, &expected, withXor);
+
+        for (Argon2Kernel kernel : kernels)
+        {
+            if (!Argon2Kernels::isSupported(kernel))
+            {
+                continue;
+            }
+            SCOPED_TRACE(Argon2Kernels::name(kernel));
+            Argon2Block actual = next;
+            Argon2Kernels::get(kernel)(&prev, &ref, &actual, withXor);
+            EXPECT_EQ(std::memcmp(&actual, &expected, sizeof(Argon2Block)), 0);
+        }
+    }
+}
+
+// Хеш встроенной реализации проверяется libsodium и наоборот
+TEST_F(Argon2HashingTest, CompatibleWithLibsodium)
+{
+    Argon2Hashing argon2(2, 8192);
+    Hashing sodium;
+    std::string password = "testpassword123";
+    std::string hashedPassword;
+
+    ASSERT_EQ(argon2.pwHashMake(password, hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(hashedPassword.rfind("$argon2id$v=19$m=8192,t=2,p=1$", 0), 0u);
+    EXPECT_EQ(sodium.pwHashVerify(password, hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(sodium.pwHashVerify("wrongpassword", hashedPassword), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+
+    ASSERT_EQ(sodium.pwHashMake(password, hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(argon2.pwHashVerify(password, hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(argon2.pwHashVerify("wrongpassword", hashedPassword), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+}
+
+// Встроенная реализация выбирается только с функцией сжатия AVX2 или AVX-512, иначе — libsodium
+TEST_F(Argon2HashingTest, EngineSelectedByKernel)
+{
+    Argon2Kernel best = Argon2Kernels::best();
+    EXPECT_EQ(HashingEngine::builtinPreferred(), best == Argon2Kernel::AVX2 || best == Argon2Kernel::AVX512);
+
+    std::unique_ptr<HashingInterface> preferred = HashingEngine::create();
+    EXPECT_EQ(dynamic_cast<Argon2Hashing *>(preferred.get()) != nullptr, HashingEngine::builtinPreferred());
+    EXPECT_EQ(dynamic_cast<Hashing *>(preferred.get()) != nullptr, !HashingEngine::builtinPreferred());
+
+    std::unique_ptr<HashingInterface> sodium = HashingEngine::create(false);
+    EXPECT_NE(dynamic_cast<Hashing *>(sodium.get()), nullptr);
+}
+
+// Проверка пустого пароля
+TEST_F(Argon2HashingTest, EmptyPassword)
+{
+    Argon2Hashing argon2(1, 64);
+    std::string hashedPassword;
+
+    ASSERT_EQ(argon2.pwHashMake("", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(argon2.pwHashVerify("", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(argon2.pwHashVerify("x", hashedPassword), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+}
+
+// Некорректные строки хеша отклоняются без вычисления
+TEST_F(Argon2HashingTest, InvalidHashStrings)
+{
+    Argon2Hashing argon2(1, 64);
+    std::string hashedPassword;
+    ASSERT_EQ(argon2.pwHashMake("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+
+    EXPECT_EQ(argon2.pwHashVerify("password", "invalidhash"), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+    EXPECT_EQ(argon2.pwHashVerify("password", ""), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+
+    std::string wrongVersion = hashedPassword;
+    wrongVersion.replace(wrongVersion.find("v=19"), 4, "v=16");
+    EXPECT_EQ(argon2.pwHashVerify("password", wrongVersion), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+
+    std::string truncated = hashedPassword.substr(0, hashedPassword.rfind('$'));
+    EXPECT_EQ(argon2.pwHashVerify("password", truncated), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+
+    std::string badChars = hashedPassword;
+    badChars[badChars.size() - 2] = '!';
+    EXPECT_EQ(argon2.pwHashVerify("password", badChars), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+
+    EXPECT_EQ(argon2.pwHashVerify("password", "$argon2id$v=19$m=1,t=1,p=1$c2FsdHNhbHQ$aGFzaGhhc2g"),
+              ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+}
+
+// Арена переиспользуется между вызовами и растет только при необходимости
+TEST_F(Argon2HashingTest, ArenaReusedAcrossCalls)
+{
+    MemoryArena arena;
+    void *first = arena.reserve(1024 * 1024);
+    ASSERT_NE(first, nullptr);
+    EXPECT_GE(arena.size(), 1024u * 1024);
+
+    EXPECT_EQ(arena.reserve(512 * 1024), first);
+    EXPECT_EQ(arena.reserve(1024 * 1024), first);
+
+    ASSERT_NE(arena.reserve(8 * 1024 * 1024), nullptr);
+    EXPECT_GE(arena.size(), 8u * 1024 * 1024);
+}
+
+// После хеширования рабочие блоки в арене потока затерты
+TEST_F(Argon2HashingTest, ArenaWipedAfterHash)
+{
+    Argon2Hashing argon2(1, 1024);
+    std::string hashedPassword;
+    ASSERT_EQ(argon2.pwHashMake("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_EQ(argon2.pwHashVerify("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+
+    MemoryArena &arena = MemoryArena::threadLocal();
+    const uint8_t *memory = static_cast<const uint8_t *>(arena.reserve(1024 * 1024));
+    ASSERT_NE(memory, nullptr);
+    size_t nonZero = 0;
+    for (size_t i = 0; i < 1024 * 1024; ++i)
+    {
+        nonZero += memory[i] != 0;
+    }
+    EXPECT_EQ(nonZero, 0u);
+}
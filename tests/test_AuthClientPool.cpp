@@ -0,0 +1,273 @@
+// tests/test_AuthClientPool.cpp
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AuthClientPool.hpp"
+#include "AuthStubServer.hpp"
+
+static const std::string socketPath = "./tests/files/auth_pool_test.sock";
+
+// Ожидание условия не дольше 10 с
+template <typename Condition>
+static bool waitFor(Condition condition)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!condition() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return condition();
+}
+
+// Блокирующие методы и сессия через заменитель сервера по Unix-сокету и по TCP
+TEST(AuthClientPoolTest, SyncCallsOverUnixAndTcp)
+{
+    AuthStubServer stub(socketPath, true);
+    stub.addUser("user", "password");
+    ASSERT_EQ(stub.start(), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_GT(stub.tcpPort(), 0);
+
+    for (bool tcp : {false, true})
+    {
+        SCOPED_TRACE(tcp ? "tcp" : "unix");
+        AuthClientPoolOptions options;
+        options.socketPath = socketPath;
+        options.tcpPort = tcp ? stub.tcpPort() : 0;
+        AuthClientPool pool(options);
+        AuthProtocol::AuthResponse response;
+        ASSERT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+        std::string token = response.sessionToken;
+        EXPECT_FALSE(token.empty());
+
+        ASSERT_EQ(pool.authenticate("user", "wrong", response), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(response.status, UserErrorCode::WRONG_PASSWORD);
+        ASSERT_EQ(pool.checkRole(token, UserRole::ROLE1, response), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+        ASSERT_EQ(pool.resumeSession(token, response), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+        ASSERT_EQ(pool.endSession(token, response), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+        ASSERT_EQ(pool.resumeSession(token, response), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(response.status, UserErrorCode::SESSION_EXPIRED);
+
+        // Последовательные вызовы одного потока используют одно соединение
+        EXPECT_EQ(pool.connectionCount(), 1u);
+        EXPECT_EQ(pool.stats().connects, 1u);
+    }
+    EXPECT_EQ(stub.acceptedConnections(), 2u);
+}
+
+// Запросы многих потоков и обратные вызовы делят ограниченное число соединений конвейером
+TEST(AuthClientPoolTest, MultiplexesOverBoundedPool)
+{
+    AuthStubServer stub(socketPath);
+    stub.addUser("user", "password");
+    ASSERT_EQ(stub.start(), ConfiguratorErrorCode::SUCCESS);
+
+    AuthClientPoolOptions options;
+    options.socketPath = socketPath;
+    options.maxConnections = 2;
+    AuthClientPool pool(options);
+
+    std::atomic<int> succeeded(0);
+    std::atomic<int> completed(0);
+    const int asyncCalls = 500;
+    for (int i = 0; i < asyncCalls; ++i)
+    {
+        pool.authenticateAsync("user", "password", [&](ConfiguratorErrorCode code, const AuthProtocol::AuthResponse &response)
+                               {
+                                   succeeded += code == ConfiguratorErrorCode::SUCCESS && response.status == UserErrorCode::SUCCESS;
+                                   ++completed;
+                               });
+    }
+    std::vector<std::thread> callers;
+    std::atomic<int> syncSucceeded(0);
+    for (int t = 0; t < 4; ++t)
+    {
+        callers.emplace_back([&pool, &syncSucceeded]
+                             {
+                                 for (int i = 0; i < 50; ++i)
+                                 {
+                                     AuthProtocol::AuthResponse response;
+                                     syncSucceeded += pool.authenticate("user", "password", response) == ConfiguratorErrorCode::SUCCESS &&
+                                                      response.status == UserErrorCode::SUCCESS;
+                                 }
+                             });
+    }
+    for (std::thread &caller : callers)
+    {
+        caller.join();
+    }
+    ASSERT_TRUE(waitFor([&completed]
+                        { return completed.load() == asyncCalls; }));
+    EXPECT_EQ(succeeded.load(), asyncCalls);
+    EXPECT_EQ(syncSucceeded.load(), 200);
+    EXPECT_LE(stub.acceptedConnections(), 2u);
+    EXPECT_GT(stub.largestBatch(), 1u);
+    EXPECT_EQ(pool.stats().requests, 700u);
+
+    // Блокирующий вызов из обратного вызова не ждет сам себя
+    std::atomic<int> nested(-1);
+    pool.authenticateAsync("user", "password", [&pool, &nested](ConfiguratorErrorCode, const AuthProtocol::AuthResponse &)
+                           {
+                               AuthProtocol::AuthResponse response;
+                               nested = static_cast<int>(pool.authenticate("user", "password", response));
+                           });
+    ASSERT_TRUE(waitFor([&nested]
+                        { return nested.load() >= 0; }));
+    EXPECT_EQ(nested.load(), static_cast<int>(ConfiguratorErrorCode::DATABASE_ERROR));
+}
+
+// После разрыва соединения пул подключается заново; записанные в сокет запросы без ответа не повторяются:
+// сервер мог их выполнить
+TEST(AuthClientPoolTest, ReconnectsAndFailsWrittenRequests)
+{
+    AuthStubServer stub(socketPath);
+    stub.addUser("user", "password");
+    ASSERT_EQ(stub.start(), ConfiguratorErrorCode::SUCCESS);
+    AuthClientPoolOptions options;
+    options.socketPath = socketPath;
+    AuthClientPool pool(options);
+
+    AuthProtocol::AuthResponse response;
+    ASSERT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    stub.dropConnections();
+    ASSERT_TRUE(waitFor([&pool]
+                        { return pool.connectionCount() == 0; }));
+    ASSERT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+
+    // Сервер закрывает соединение на первом запросе каждого вида
+    std::atomic<int> dropped(0);
+    stub.setHandler([&dropped](const AuthProtocol::Request &request, AuthProtocol::AuthResponse &answer)
+                    {
+                        int bit = request.operation == AuthProtocol::OPERATION_AUTHENTICATE ? 1 : 2;
+                        if ((dropped.fetch_or(bit) & bit) == 0)
+                        {
+                            return false;
+                        }
+                        answer.status = UserErrorCode::SUCCESS;
+                        return true;
+                    });
+    EXPECT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::DATABASE_ERROR);
+    ASSERT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+    EXPECT_EQ(pool.changePassword("user", "password", "new password", response), ConfiguratorErrorCode::DATABASE_ERROR);
+    ASSERT_EQ(pool.changePassword("user", "password", "new password", response), ConfiguratorErrorCode::SUCCESS);
+
+    AuthClientPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.retried, 0u);
+    EXPECT_EQ(stats.disconnects, 3u);
+    EXPECT_EQ(stats.connects, 4u);
+}
+
+// Запросы, оставшиеся в буфере пула при разрыве, повторяются в новом соединении, записанные — нет
+TEST(AuthClientPoolTest, RetriesOnlyUnsentRequests)
+{
+    AuthStubServer stub(socketPath);
+    ASSERT_EQ(stub.start(), ConfiguratorErrorCode::SUCCESS);
+    // Первый запрос держит поток заменителя, пока сокет не заполнится, затем соединение закрывается
+    std::atomic<bool> release(false);
+    std::atomic<bool> first(true);
+    stub.setHandler([&](const AuthProtocol::Request &, AuthProtocol::AuthResponse &answer)
+                    {
+                        if (first.exchange(false))
+                        {
+                            while (!release.load())
+                            {
+                                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                            }
+                            return false;
+                        }
+                        answer.status = UserErrorCode::SUCCESS;
+                        return true;
+                    });
+
+    AuthClientPoolOptions options;
+    options.socketPath = socketPath;
+    options.maxConnections = 1;
+    options.maxInFlight = 256;
+    AuthClientPool pool(options);
+    const int calls = 256;
+    std::atomic<int> succeeded(0);
+    std::atomic<int> failed(0);
+    for (int i = 0; i < calls; ++i)
+    {
+        // Кадры около 4 КиБ: 256 кадров не помещаются в буфер сокета
+        pool.authenticateAsync(std::string(3900, 'u'), "password", [&](ConfiguratorErrorCode code, const AuthProtocol::AuthResponse &)
+                               { ++(code == ConfiguratorErrorCode::SUCCESS ? succeeded : failed); });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    release = true;
+    ASSERT_TRUE(waitFor([&]
+                        { return succeeded.load() + failed.load() == calls; }));
+
+    AuthClientPoolStats stats = pool.stats();
+    EXPECT_GT(failed.load(), 0);
+    EXPECT_GT(succeeded.load(), 0);
+    EXPECT_EQ(stats.retried, static_cast<uint64_t>(succeeded.load()));
+}
+
+// Запрос без ответа завершается ошибкой через requestTimeoutMs, поздний ответ отбрасывается
+TEST(AuthClientPoolTest, RequestTimeout)
+{
+    AuthStubServer stub(socketPath);
+    ASSERT_EQ(stub.start(), ConfiguratorErrorCode::SUCCESS);
+    std::atomic<bool> release(false);
+    stub.setHandler([&release](const AuthProtocol::Request &, AuthProtocol::AuthResponse &answer)
+                    {
+                        while (!release.load())
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        }
+                        answer.status = UserErrorCode::SUCCESS;
+                        return true;
+                    });
+
+    AuthClientPoolOptions options;
+    options.socketPath = socketPath;
+    options.requestTimeoutMs = 100;
+    AuthClientPool pool(options);
+    AuthProtocol::AuthResponse response;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::DATABASE_ERROR);
+    auto waited = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(waited, std::chrono::milliseconds(100));
+    EXPECT_LT(waited, std::chrono::seconds(5));
+    EXPECT_EQ(pool.stats().timedOut, 1u);
+
+    release = true;
+    ASSERT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+    EXPECT_EQ(pool.stats().timedOut, 1u);
+}
+
+// Пока сервер недоступен, запросы ждут connectTimeoutMs; после запуска сервера пул подключается сам
+TEST(AuthClientPoolTest, WaitsForServerThenFails)
+{
+    AuthClientPoolOptions options;
+    options.socketPath = "./tests/files/auth_pool_missing.sock";
+    options.connectTimeoutMs = 100;
+    options.reconnectDelayMs = 10;
+    AuthClientPool pool(options);
+
+    AuthProtocol::AuthResponse response;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::DATABASE_ERROR);
+    auto waited = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(waited, std::chrono::milliseconds(100));
+    EXPECT_LT(waited, std::chrono::seconds(5));
+    EXPECT_GT(pool.stats().connectFailures, 1u);
+
+    AuthStubServer stub(options.socketPath);
+    stub.addUser("user", "password");
+    ASSERT_EQ(stub.start(), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+}
@@ -0,0 +1,744 @@
+// tests/test_AuthServer.cpp
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "AccountsEditor.hpp"
+#include "AuthClient.hpp"
+#include "AuthClientPool.hpp"
+#include "AuthServer.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "HttpProtocol.hpp"
+#include "SecurityConfig.hpp"
+
+// Хеширование-заглушка без вычислений, допускает вызовы из нескольких потоков
+class PlainHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = "hash:" + password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return hashedPassword == "hash:" + password ? ConfiguratorErrorCode::SUCCESS
+                                                    : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+// Хеширование постоянной длительности: проверка занимает поток исполнителя на delayMs
+class SlowHashing : public PlainHashing
+{
+    unsigned delayMs;
+
+public:
+    explicit SlowHashing(unsigned delay) : delayMs(delay) {}
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+        return PlainHashing::pwHashVerify(password, hashedPassword);
+    }
+};
+
+class AuthServerTest : public ::testing::Test
+{
+protected:
+    std::string testArchivePath = "./tests/files/authd_archive.txt";
+    std::string testActiveUsersPath = "./tests/files/authd_active_users.txt";
+    std::string testTmpPath = "./tests/files/authd_tmp";
+    std::string testConfigPath = "./tests/files/authd_config.txt";
+    std::string socketPath = "./tests/files/authd_test.sock";
+
+    PlainHashing hasher;
+    ConfiguratorDatabase *db;
+    SecurityConfig *config;
+    Authenticator *authenticator;
+    ConfiguratorAccountsEditor *editor;
+    AuthServer *server;
+    std::thread loop;
+
+    void SetUp() override
+    {
+        std::ofstream(testActiveUsersPath) << "expired hash:password 01.01.2000 1\n";
+        std::ofstream(testArchivePath) << "expired hash:password\n";
+        std::ofstream(testConfigPath) << "maxFailedAttempts 3\n"
+                                      << "maxInactiveTimeMin 10\n"
+                                      << "passwordExpirationDays 30\n"
+                                      << "minPasswordLength 8\n"
+                                      << "passwordHistoryDepth 3\n";
+
+        db = new ConfiguratorDatabase(testArchivePath, testActiveUsersPath, testTmpPath);
+        db->enableActiveUsersIndex();
+        ASSERT_EQ(db->addUser("user", "hash:password", {UserRole::ROLE1}), ConfiguratorErrorCode::SUCCESS);
+        config = new SecurityConfig(testConfigPath);
+        authenticator = new Authenticator(db, config, &hasher);
+        editor = new ConfiguratorAccountsEditor(db, config, &hasher);
+
+        AuthServerOptions options;
+        options.socketPath = socketPath;
+        options.workers = 2;
+        options.rateLimits.login = {0.001, 8};
+        options.http = true;
+        server = new AuthServer(authenticator, options, editor);
+        ASSERT_EQ(server->start(), ConfiguratorErrorCode::SUCCESS);
+        loop = std::thread([this]
+                           { server->run(); });
+    }
+
+    void TearDown() override
+    {
+        server->stop();
+        if (loop.joinable())
+        {
+            loop.join();
+        }
+        delete server;
+        delete editor;
+        delete authenticator;
+        delete config;
+        delete db;
+        std::remove(testArchivePath.c_str());
+        std::remove(testActiveUsersPath.c_str());
+        std::remove(testTmpPath.c_str());
+        std::remove(testConfigPath.c_str());
+    }
+};
+
+// Кадры и сообщения протокола разбираются обратно без потерь
+TEST(AuthProtocolTest, RoundTrip)
+{
+    std::string buffer;
+    AuthProtocol::Request request;
+    request.id = 7;
+    request.operation = AuthProtocol::OPERATION_CHANGE_PASSWORD;
+    request.login = "user";
+    request.password = "pass word";
+    request.newPassword = "new";
+    request.deadlineMs = 250;
+    ASSERT_TRUE(AuthProtocol::appendRequest(buffer, request));
+    AuthProtocol::Request roleCheck;
+    roleCheck.id = 8;
+    roleCheck.operation = AuthProtocol::OPERATION_CHECK_ROLE;
+    roleCheck.token = "token";
+    roleCheck.role = static_cast<uint32_t>(UserRole::ROLE3);
+    ASSERT_TRUE(AuthProtocol::appendRequest(buffer, roleCheck));
+    AuthProtocol::AuthResponse response;
+    response.requestId = 9;
+    response.status = UserErrorCode::WRONG_PASSWORD;
+    response.attemptsLeft = 2;
+    response.retryAfterMs = 40;
+    response.sessionToken = "token";
+    AuthProtocol::appendResponse(buffer, response);
+
+    size_t pos = 0;
+    AuthProtocol::Request decoded;
+    ASSERT_EQ(AuthProtocol::extractRequest(buffer, pos, decoded), AuthProtocol::FrameStatus::COMPLETE);
+    EXPECT_EQ(decoded.id, 7u);
+    EXPECT_EQ(decoded.operation, AuthProtocol::OPERATION_CHANGE_PASSWORD);
+    EXPECT_EQ(decoded.login, "user");
+    EXPECT_EQ(decoded.password, "pass word");
+    EXPECT_EQ(decoded.newPassword, "new");
+    EXPECT_EQ(decoded.deadlineMs, 250u);
+
+    ASSERT_EQ(AuthProtocol::extractRequest(buffer, pos, decoded), AuthProtocol::FrameStatus::COMPLETE);
+    EXPECT_EQ(decoded.id, 8u);
+    EXPECT_EQ(decoded.token, "token");
+    EXPECT_EQ(decoded.role, static_cast<uint32_t>(UserRole::ROLE3));
+
+    // Ответ не разбирается как запрос; разбор ответа не сдвигает позицию при ошибке
+    size_t responsePos = pos;
+    EXPECT_EQ(AuthProtocol::extractRequest(buffer, responsePos, decoded), AuthProtocol::FrameStatus::MALFORMED);
+    EXPECT_EQ(responsePos, pos);
+    AuthProtocol::AuthResponse decodedResponse;
+    ASSERT_EQ(AuthProtocol::extractResponse(buffer, pos, decodedResponse), AuthProtocol::FrameStatus::COMPLETE);
+    EXPECT_EQ(decodedResponse.requestId, 9u);
+    EXPECT_EQ(decodedResponse.status, UserErrorCode::WRONG_PASSWORD);
+    EXPECT_EQ(decodedResponse.attemptsLeft, 2u);
+    EXPECT_EQ(decodedResponse.retryAfterMs, 40u);
+    EXPECT_EQ(decodedResponse.sessionToken, "token");
+    EXPECT_EQ(pos, buffer.size());
+
+    // Неполный кадр ждет данных, кадр сверх лимита отклоняется по заголовку
+    pos = 0;
+    EXPECT_EQ(AuthProtocol::extractRequest(buffer.substr(0, 6), pos, decoded), AuthProtocol::FrameStatus::INCOMPLETE);
+    std::string oversized;
+    AuthProtocol::appendFrame(oversized, std::string(AuthProtocol::MAX_FRAME_BYTES + 1, 'a'));
+    EXPECT_EQ(AuthProtocol::extractRequest(oversized.substr(0, 4), pos, decoded), AuthProtocol::FrameStatus::TOO_LARGE);
+    request.password = std::string(AuthProtocol::MAX_FRAME_BYTES, 'a');
+    std::string rejected;
+    EXPECT_FALSE(AuthProtocol::appendRequest(rejected, request));
+    EXPECT_TRUE(rejected.empty());
+}
+
+// Подключение к HTTP-порту сервера
+static int connectHttp(uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Чтение одного ответа HTTP с Content-Length; пустая строка, если соединение закрыто
+static std::string readHttpResponse(int fd, std::string &in)
+{
+    while (true)
+    {
+        size_t headerEnd = in.find("\r\n\r\n");
+        size_t lengthAt = in.find("Content-Length: ");
+        if (headerEnd != std::string::npos && lengthAt < headerEnd)
+        {
+            size_t total = headerEnd + 4 + std::stoul(in.substr(lengthAt + 16));
+            if (in.size() >= total)
+            {
+                std::string response = in.substr(0, total);
+                in.erase(0, total);
+                return response;
+            }
+        }
+        char chunk[1024];
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0)
+        {
+            return std::string();
+        }
+        in.append(chunk, static_cast<size_t>(received));
+    }
+}
+
+// Запрос HTTP разбирается по мере прихода данных; несколько запросов в буфере выделяются по очереди
+TEST(HttpProtocolTest, IncrementalParse)
+{
+    std::string body = "{\"login\": \"user\", \"password\": \"pa\\\"ss\\u0431\"}";
+    std::string raw = "POST /authenticate HTTP/1.1\r\nHost: x\r\nX-Deadline-Ms: 250\r\ncontent-length: " + std::to_string(body.size()) + "\r\n\r\n" + body +
+                      "GET /users/user/roles HTTP/1.1\r\nAuthorization: Bearer abc\r\nConnection: close\r\n\r\n";
+
+    std::string buffer;
+    size_t pos = 0;
+    size_t scanned = 0;
+    HttpProtocol::Request request;
+    size_t i = 0;
+    for (; i < raw.size(); ++i)
+    {
+        buffer += raw[i];
+        AuthProtocol::FrameStatus status = HttpProtocol::extractRequest(buffer, pos, scanned, request);
+        if (status == AuthProtocol::FrameStatus::COMPLETE)
+        {
+            break;
+        }
+        ASSERT_EQ(status, AuthProtocol::FrameStatus::INCOMPLETE);
+    }
+    EXPECT_EQ(pos, i + 1);
+    EXPECT_EQ(scanned, 0u);
+    EXPECT_EQ(request.method, "POST");
+    EXPECT_EQ(request.target, "/authenticate");
+    EXPECT_EQ(request.deadlineMs, 250u);
+    EXPECT_TRUE(request.keepAlive);
+    std::string login;
+    std::string password;
+    ASSERT_TRUE(HttpProtocol::parseCredentials(request.body, login, password));
+    EXPECT_EQ(login, "user");
+    EXPECT_EQ(password, "pa\"ss\xd0\xb1");
+
+    buffer = raw;
+    ASSERT_EQ(HttpProtocol::extractRequest(buffer, pos, scanned, request), AuthProtocol::FrameStatus::COMPLETE);
+    EXPECT_EQ(request.target, "/users/user/roles");
+    EXPECT_EQ(request.authorization, "Bearer abc");
+    EXPECT_EQ(request.deadlineMs, 0u);
+    EXPECT_FALSE(request.keepAlive);
+    EXPECT_EQ(pos, raw.size());
+
+    // Неподдерживаемое кодирование тела и запрос сверх лимита отклоняются
+    pos = 0;
+    scanned = 0;
+    EXPECT_EQ(HttpProtocol::extractRequest("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n", pos, scanned, request),
+              AuthProtocol::FrameStatus::MALFORMED);
+    EXPECT_EQ(HttpProtocol::extractRequest(std::string(HttpProtocol::MAX_REQUEST_BYTES + 1, 'a'), pos, scanned, request),
+              AuthProtocol::FrameStatus::TOO_LARGE);
+    EXPECT_FALSE(HttpProtocol::parseCredentials("{\"login\": \"user\"}", login, password));
+    EXPECT_FALSE(HttpProtocol::parseCredentials("{\"login\": \"user\", \"password\": 1}", login, password));
+}
+
+// Вход и роли по HTTP в одном соединении с keep-alive; ответы идут в порядке запросов,
+// Connection: close закрывает соединение после ответа
+TEST_F(AuthServerTest, HttpAuthenticateAndRoles)
+{
+    int fd = connectHttp(server->httpPort());
+    ASSERT_GE(fd, 0);
+
+    std::string body = "{\"login\":\"user\",\"password\":\"password\"}";
+    std::string out = "POST /authenticate HTTP/1.1\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body +
+                      "GET /users/user/roles HTTP/1.1\r\n\r\n";
+    ASSERT_EQ(send(fd, out.data(), out.size(), MSG_NOSIGNAL), static_cast<ssize_t>(out.size()));
+    std::string in;
+    std::string response = readHttpResponse(fd, in);
+    ASSERT_EQ(response.substr(0, 15), "HTTP/1.1 200 OK");
+    EXPECT_NE(response.find("Connection: keep-alive"), std::string::npos);
+    size_t tokenAt = response.find("\"sessionToken\":\"");
+    ASSERT_NE(tokenAt, std::string::npos);
+    std::string token = response.substr(tokenAt + 16, 2 * SessionManager::TOKEN_BYTES);
+    response = readHttpResponse(fd, in);
+    EXPECT_EQ(response.substr(0, 12), "HTTP/1.1 401");
+
+    out = "GET /users/user/roles HTTP/1.1\r\nAuthorization: Bearer " + token + "\r\n\r\n" +
+          "GET /users/expired/roles HTTP/1.1\r\nAuthorization: Bearer " + token + "\r\n\r\n" +
+          "GET /users/nobody/roles HTTP/1.1\r\nAuthorization: Bearer " + token + "\r\n\r\n" +
+          "GET /unknown HTTP/1.1\r\nConnection: close\r\n\r\n";
+    ASSERT_EQ(send(fd, out.data(), out.size(), MSG_NOSIGNAL), static_cast<ssize_t>(out.size()));
+    response = readHttpResponse(fd, in);
+    EXPECT_NE(response.find("{\"status\":\"SUCCESS\",\"login\":\"user\",\"roles\":[\"ROLE1\"]}"), std::string::npos);
+    // Чужой логин закрыт независимо от того, существует ли он
+    response = readHttpResponse(fd, in);
+    EXPECT_EQ(response.substr(0, 12), "HTTP/1.1 403");
+    EXPECT_EQ(response.find("roles\":"), std::string::npos);
+    std::string forbidden = response.substr(response.find("\r\n\r\n"));
+    response = readHttpResponse(fd, in);
+    EXPECT_EQ(response.substr(0, 12), "HTTP/1.1 403");
+    EXPECT_EQ(response.substr(response.find("\r\n\r\n")), forbidden);
+    response = readHttpResponse(fd, in);
+    EXPECT_EQ(response.substr(0, 12), "HTTP/1.1 404");
+    EXPECT_NE(response.find("Connection: close"), std::string::npos);
+    EXPECT_EQ(readHttpResponse(fd, in), "");
+    close(fd);
+
+    // Неразбираемый запрос получает 400 и закрывает соединение
+    fd = connectHttp(server->httpPort());
+    ASSERT_GE(fd, 0);
+    out = "POST /authenticate HTTP/1.1\r\nContent-Length: 2\r\n\r\n{}";
+    ASSERT_EQ(send(fd, out.data(), out.size(), MSG_NOSIGNAL), static_cast<ssize_t>(out.size()));
+    response = readHttpResponse(fd, in);
+    EXPECT_EQ(response.substr(0, 12), "HTTP/1.1 400");
+    out = "garbage\r\n\r\n";
+    ASSERT_EQ(send(fd, out.data(), out.size(), MSG_NOSIGNAL), static_cast<ssize_t>(out.size()));
+    response = readHttpResponse(fd, in);
+    EXPECT_EQ(response.substr(0, 12), "HTTP/1.1 400");
+    EXPECT_EQ(readHttpResponse(fd, in), "");
+    close(fd);
+}
+
+// Успешный вход, неизвестный логин и истекший пароль
+TEST_F(AuthServerTest, AuthenticationResults)
+{
+    AuthClient client;
+    ASSERT_EQ(client.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+
+    AuthProtocol::AuthResponse response;
+    ASSERT_EQ(client.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+
+    ASSERT_EQ(client.authenticate("nobody", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::LOGIN_NOT_EXISTS);
+
+    ASSERT_EQ(client.authenticate("expired", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::PASSWORD_HAS_EXPIRED);
+}
+
+// Неверные пароли уменьшают число попыток, после последней соединение закрывается
+TEST_F(AuthServerTest, FailedAttemptsCloseConnection)
+{
+    AuthClient client;
+    ASSERT_EQ(client.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+
+    AuthProtocol::AuthResponse response;
+    for (unsigned left = 2;; --left)
+    {
+        ASSERT_EQ(client.authenticate("user", "wrong", response), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(response.status, UserErrorCode::WRONG_PASSWORD);
+        EXPECT_EQ(response.attemptsLeft, left);
+        if (left == 0)
+        {
+            break;
+        }
+    }
+    EXPECT_NE(client.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+
+    // Новое соединение начинает счет заново
+    AuthClient other;
+    ASSERT_EQ(other.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_EQ(other.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+}
+
+// Запросы, отправленные одним блоком, разбираются за одно чтение; ответы без хеширования приходят раньше
+// ответа на вход, отправленный первым. Кадр сверх лимита закрывает соединение
+TEST_F(AuthServerTest, PipelinedRequestsAnsweredOutOfOrder)
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    socketPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)), 0);
+
+    std::string out;
+    AuthProtocol::Request request;
+    request.id = 1;
+    request.login = "user";
+    request.password = "password";
+    ASSERT_TRUE(AuthProtocol::appendRequest(out, request));
+    request.id = 2;
+    request.login = "nobody";
+    ASSERT_TRUE(AuthProtocol::appendRequest(out, request));
+    request.id = 3;
+    request.operation = AuthProtocol::OPERATION_RESUME_SESSION;
+    request.token = "unknown";
+    ASSERT_TRUE(AuthProtocol::appendRequest(out, request));
+    ASSERT_EQ(send(fd, out.data(), out.size(), MSG_NOSIGNAL), static_cast<ssize_t>(out.size()));
+
+    std::string in;
+    char chunk[256];
+    std::vector<AuthProtocol::AuthResponse> responses;
+    size_t pos = 0;
+    while (responses.size() < 3)
+    {
+        AuthProtocol::AuthResponse response;
+        AuthProtocol::FrameStatus status = AuthProtocol::extractResponse(in, pos, response);
+        if (status == AuthProtocol::FrameStatus::COMPLETE)
+        {
+            responses.push_back(response);
+            continue;
+        }
+        ASSERT_EQ(status, AuthProtocol::FrameStatus::INCOMPLETE);
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        ASSERT_GT(received, 0);
+        in.append(chunk, static_cast<size_t>(received));
+    }
+    EXPECT_EQ(responses[0].requestId, 2u);
+    EXPECT_EQ(responses[0].status, UserErrorCode::LOGIN_NOT_EXISTS);
+    EXPECT_EQ(responses[1].requestId, 3u);
+    EXPECT_EQ(responses[1].status, UserErrorCode::SESSION_EXPIRED);
+    EXPECT_EQ(responses[2].requestId, 1u);
+    EXPECT_EQ(responses[2].status, UserErrorCode::SUCCESS);
+
+    uint32_t length = AuthProtocol::MAX_FRAME_BYTES + 1;
+    ASSERT_EQ(send(fd, &length, sizeof(length), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(length)));
+    EXPECT_EQ(recv(fd, chunk, sizeof(chunk), 0), 0);
+    close(fd);
+}
+
+// Конвейер клиента: много запросов одним блоком, каждый ответ находит свой запрос по номеру.
+// Входы сверх частоты для логина (8 в тесте) отклоняются
+TEST_F(AuthServerTest, ClientPipelinesManyRequests)
+{
+    AuthClient client;
+    ASSERT_EQ(client.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+
+    const unsigned requests = 200;
+    std::vector<UserErrorCode> expected(requests + 1);
+    unsigned logins = 0;
+    for (unsigned i = 0; i < requests; ++i)
+    {
+        AuthProtocol::Request request;
+        request.operation = i % 2 == 0 ? AuthProtocol::OPERATION_AUTHENTICATE : AuthProtocol::OPERATION_RESUME_SESSION;
+        request.login = "user";
+        request.password = "password";
+        request.token = "unknown";
+        ASSERT_EQ(client.queueRequest(request), ConfiguratorErrorCode::SUCCESS);
+        if (request.operation == AuthProtocol::OPERATION_AUTHENTICATE)
+        {
+            expected.at(request.id) = logins++ < 8 ? UserErrorCode::SUCCESS : UserErrorCode::RATE_LIMITED;
+        }
+        else
+        {
+            expected.at(request.id) = UserErrorCode::SESSION_EXPIRED;
+        }
+    }
+    ASSERT_EQ(client.flushRequests(), ConfiguratorErrorCode::SUCCESS);
+
+    std::vector<bool> seen(requests + 1, false);
+    for (unsigned i = 0; i < requests; ++i)
+    {
+        AuthProtocol::AuthResponse response;
+        ASSERT_EQ(client.receiveResponse(response), ConfiguratorErrorCode::SUCCESS);
+        ASSERT_LE(response.requestId, requests);
+        EXPECT_FALSE(seen[response.requestId]);
+        seen[response.requestId] = true;
+        EXPECT_EQ(response.status, expected[response.requestId]);
+    }
+}
+
+// Смена пароля проверяет текущий пароль и требования к новому; новый пароль действует сразу
+TEST_F(AuthServerTest, ChangePassword)
+{
+    AuthClient client;
+    ASSERT_EQ(client.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+
+    AuthProtocol::AuthResponse response;
+    ASSERT_EQ(client.changePassword("user", "wrong", "NewPassword1", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::WRONG_PASSWORD);
+    ASSERT_EQ(client.changePassword("user", "password", "bad!", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::PASSWORD_REJECTED);
+
+    // Истекший пароль можно сменить
+    ASSERT_EQ(client.changePassword("expired", "password", "NewPassword1", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+    ASSERT_EQ(client.authenticate("expired", "NewPassword1", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+    ASSERT_EQ(client.changePassword("expired", "NewPassword1", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::PASSWORD_REJECTED); // Пароль из архива
+}
+
+// Роль проверяется по токену сессии
+TEST_F(AuthServerTest, CheckRole)
+{
+    AuthClient client;
+    ASSERT_EQ(client.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+
+    AuthProtocol::AuthResponse response;
+    ASSERT_EQ(client.checkRole("unknown", UserRole::ROLE1, response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SESSION_EXPIRED);
+
+    ASSERT_EQ(client.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_EQ(response.status, UserErrorCode::SUCCESS);
+    std::string token = response.sessionToken;
+    ASSERT_EQ(client.checkRole(token, UserRole::ROLE1, response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+    ASSERT_EQ(client.checkRole(token, UserRole::ROLE2, response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::ROLE_NOT_GRANTED);
+}
+
+// Успешный вход выдает токен; по нему вход повторяется без пароля до завершения сессии
+TEST_F(AuthServerTest, SessionResume)
+{
+    AuthClient client;
+    ASSERT_EQ(client.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+
+    AuthProtocol::AuthResponse response;
+    ASSERT_EQ(client.authenticate("user", "wrong", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_TRUE(response.sessionToken.empty());
+    ASSERT_EQ(client.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_EQ(response.status, UserErrorCode::SUCCESS);
+    std::string token = response.sessionToken;
+    ASSERT_EQ(token.size(), SessionManager::TOKEN_BYTES);
+
+    // Токен действует и в другом соединении
+    AuthClient other;
+    ASSERT_EQ(other.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_EQ(other.resumeSession(token, response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+
+    ASSERT_EQ(other.endSession(token, response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+    ASSERT_EQ(client.resumeSession(token, response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SESSION_EXPIRED);
+}
+
+// Попытки для логина сверх допустимой частоты отклоняются без проверки пароля, другие логины не затронуты
+TEST_F(AuthServerTest, LoginRateLimited)
+{
+    AuthClient client;
+    ASSERT_EQ(client.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+
+    AuthProtocol::AuthResponse response;
+    for (int i = 0; i < 8; ++i)
+    {
+        ASSERT_EQ(client.authenticate("nobody", "password", response), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(response.status, UserErrorCode::LOGIN_NOT_EXISTS);
+    }
+    ASSERT_EQ(client.authenticate("nobody", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::RATE_LIMITED);
+
+    ASSERT_EQ(client.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+}
+
+// При очереди проверок, которая не уложится в предел задержки, новые попытки сразу получают OVERLOADED
+// с паузой перед повтором; по HTTP — 503 с заголовком Retry-After
+TEST_F(AuthServerTest, OverloadedRequestsRejectedEarly)
+{
+    SlowHashing slowHasher(50);
+    Authenticator slowAuthenticator(db, config, &slowHasher);
+    AuthServerOptions options;
+    options.socketPath = "./tests/files/authd_overload_test.sock";
+    options.workers = 1;
+    options.rateLimits.login = {0, 0};
+    options.http = true;
+    options.maxPredictedLatencyMs = 120;
+    AuthServer overloaded(&slowAuthenticator, options);
+    ASSERT_EQ(overloaded.start(), ConfiguratorErrorCode::SUCCESS);
+    std::thread overloadedLoop([&overloaded]
+                               { overloaded.run(); });
+
+    AuthClient client;
+    ASSERT_EQ(client.connect(options.socketPath), ConfiguratorErrorCode::SUCCESS);
+    AuthProtocol::AuthResponse response;
+    // Первая проверка дает замер времени проверки (~50 мс)
+    ASSERT_EQ(client.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+
+    // Ожидаемые задержки: 50, 100, 150, ... мс — принимаются две попытки из пяти
+    for (int i = 0; i < 5; ++i)
+    {
+        AuthProtocol::Request request;
+        request.login = "user";
+        request.password = "password";
+        ASSERT_EQ(client.queueRequest(request), ConfiguratorErrorCode::SUCCESS);
+    }
+    ASSERT_EQ(client.flushRequests(), ConfiguratorErrorCode::SUCCESS);
+
+    int fd = connectHttp(overloaded.httpPort());
+    ASSERT_GE(fd, 0);
+    std::string body = "{\"login\": \"user\", \"password\": \"password\"}";
+    std::string request = "POST /authenticate HTTP/1.1\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+    ASSERT_EQ(send(fd, request.data(), request.size(), 0), static_cast<ssize_t>(request.size()));
+    std::string in;
+    std::string httpResponse = readHttpResponse(fd, in);
+    EXPECT_EQ(httpResponse.rfind("HTTP/1.1 503 Service Unavailable\r\n", 0), 0u);
+    EXPECT_NE(httpResponse.find("\r\nRetry-After: 1\r\n"), std::string::npos);
+    EXPECT_NE(httpResponse.find("\"status\":\"OVERLOADED\""), std::string::npos);
+    close(fd);
+
+    unsigned succeeded = 0;
+    unsigned rejected = 0;
+    for (int i = 0; i < 5; ++i)
+    {
+        ASSERT_EQ(client.receiveResponse(response), ConfiguratorErrorCode::SUCCESS);
+        if (response.status == UserErrorCode::OVERLOADED)
+        {
+            ++rejected;
+            EXPECT_GT(response.retryAfterMs, 0u);
+        }
+        else
+        {
+            EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+            EXPECT_EQ(response.retryAfterMs, 0u);
+            ++succeeded;
+        }
+    }
+    EXPECT_EQ(succeeded, 2u);
+    EXPECT_EQ(rejected, 3u);
+
+    overloaded.stop();
+    overloadedLoop.join();
+}
+
+// Запрос, срок которого истек в очереди исполнителя, и запросы отключившегося клиента не хешируются
+TEST_F(AuthServerTest, ExpiredAndDisconnectedRequestsSkipVerification)
+{
+    SlowHashing slowHasher(100);
+    Authenticator slowAuthenticator(db, config, &slowHasher);
+    AuthServerOptions options;
+    options.socketPath = "./tests/files/authd_deadline_test.sock";
+    options.workers = 1;
+    options.rateLimits.login = {0, 0};
+    AuthServer deadlines(&slowAuthenticator, options);
+    ASSERT_EQ(deadlines.start(), ConfiguratorErrorCode::SUCCESS);
+    std::thread deadlinesLoop([&deadlines]
+                              { deadlines.run(); });
+
+    // Проверки начинаются через 0, 100, 200 и 300 мс: в срок 150 мс успевают две
+    AuthClient client;
+    ASSERT_EQ(client.connect(options.socketPath), ConfiguratorErrorCode::SUCCESS);
+    for (int i = 0; i < 4; ++i)
+    {
+        AuthProtocol::Request request;
+        request.login = "user";
+        request.password = "password";
+        request.deadlineMs = 150;
+        ASSERT_EQ(client.queueRequest(request), ConfiguratorErrorCode::SUCCESS);
+    }
+    ASSERT_EQ(client.flushRequests(), ConfiguratorErrorCode::SUCCESS);
+    std::vector<UserErrorCode> statuses;
+    for (int i = 0; i < 4; ++i)
+    {
+        AuthProtocol::AuthResponse response;
+        ASSERT_EQ(client.receiveResponse(response), ConfiguratorErrorCode::SUCCESS);
+        statuses.push_back(response.status);
+    }
+    EXPECT_EQ(std::count(statuses.begin(), statuses.end(), UserErrorCode::SUCCESS), 2);
+    EXPECT_EQ(std::count(statuses.begin(), statuses.end(), UserErrorCode::DEADLINE_EXCEEDED), 2);
+
+    // Клиент отключается во время первой из трех проверок
+    {
+        AuthClient leaving;
+        ASSERT_EQ(leaving.connect(options.socketPath), ConfiguratorErrorCode::SUCCESS);
+        for (int i = 0; i < 3; ++i)
+        {
+            AuthProtocol::Request request;
+            request.login = "user";
+            request.password = "password";
+            ASSERT_EQ(leaving.queueRequest(request), ConfiguratorErrorCode::SUCCESS);
+        }
+        ASSERT_EQ(leaving.flushRequests(), ConfiguratorErrorCode::SUCCESS);
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (deadlines.stats().cancelledDisconnected < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    AuthServerStats stats = deadlines.stats();
+    EXPECT_EQ(stats.verified, 3u);
+    EXPECT_EQ(stats.cancelledDeadline, 2u);
+    EXPECT_EQ(stats.cancelledDisconnected, 2u);
+    EXPECT_EQ(stats.overloaded, 0u);
+
+    deadlines.stop();
+    deadlinesLoop.join();
+}
+
+// Пул клиентской библиотеки по TCP: после исчерпания попыток сервер закрывает соединение, пул открывает новое
+TEST_F(AuthServerTest, ClientPoolOverTcp)
+{
+    AuthServerOptions options;
+    options.socketPath = "./tests/files/authd_pool_test.sock";
+    options.workers = 2;
+    options.rateLimits.login = {0, 0};
+    options.tcp = true;
+    AuthServer tcpServer(authenticator, options, editor);
+    ASSERT_EQ(tcpServer.start(), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_GT(tcpServer.tcpPort(), 0);
+    std::thread tcpLoop([&tcpServer]
+                        { tcpServer.run(); });
+
+    AuthClientPoolOptions poolOptions;
+    poolOptions.tcpPort = tcpServer.tcpPort();
+    poolOptions.maxConnections = 2;
+    AuthClientPool pool(poolOptions);
+    AuthProtocol::AuthResponse response;
+    ASSERT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_EQ(response.status, UserErrorCode::SUCCESS);
+    ASSERT_EQ(pool.checkRole(response.sessionToken, UserRole::ROLE1, response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(pool.authenticate("user", "wrong", response), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(response.status, UserErrorCode::WRONG_PASSWORD);
+    }
+    // Запрос, записанный в соединение до того, как пул заметил его закрытие, не повторяется: ждем закрытия
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (pool.connectionCount() != 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(pool.connectionCount(), 0u);
+    ASSERT_EQ(pool.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+    EXPECT_EQ(pool.stats().connects, 2u);
+
+    tcpServer.stop();
+    tcpLoop.join();
+}
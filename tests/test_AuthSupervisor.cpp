@@ -0,0 +1,199 @@
+// tests/test_AuthSupervisor.cpp
+
+#include <gtest/gtest.h>
+#include <csignal>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "AuthClient.hpp"
+#include "AuthServer.hpp"
+#include "AuthSupervisor.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+#include "SharedSessionTable.hpp"
+
+// Хеширование-заглушка без вычислений
+class PlainHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = "hash:" + password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return hashedPassword == "hash:" + password ? ConfiguratorErrorCode::SUCCESS
+                                                    : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+static const std::string socketPath = "./tests/files/supervisor_test.sock";
+
+// Номер процесса, принявшего соединение; -1, если соединение не удалось
+static pid_t askWorkerPid()
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    socketPath.copy(address.sun_path, sizeof(address.sun_path) - 1);
+    pid_t pid = -1;
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0 && recv(fd, &pid, sizeof(pid), MSG_WAITALL) != sizeof(pid))
+    {
+        pid = -1;
+    }
+    close(fd);
+    return pid;
+}
+
+// Процессы принимают соединения из общего сокета; убитый процесс перезапускается, остановка завершает все процессы
+TEST(AuthSupervisorTest, SharedListenerAndRestart)
+{
+    AuthSupervisorOptions options;
+    options.socketPath = socketPath;
+    options.processes = 2;
+    options.restartDelayMs = 50;
+    AuthSupervisor supervisor(options);
+    ASSERT_EQ(supervisor.listen(), ConfiguratorErrorCode::SUCCESS);
+    int listenFd = supervisor.socket();
+
+    // Рабочий процесс отвечает на каждое соединение своим pid
+    std::thread parent([&supervisor, listenFd]
+                       { supervisor.run([listenFd](size_t)
+                                        {
+                                            while (true)
+                                            {
+                                                int fd = accept(listenFd, nullptr, nullptr);
+                                                if (fd >= 0)
+                                                {
+                                                    pid_t pid = getpid();
+                                                    ssize_t unused = send(fd, &pid, sizeof(pid), MSG_NOSIGNAL);
+                                                    (void)unused;
+                                                    close(fd);
+                                                }
+                                                else
+                                                {
+                                                    usleep(1000); // Сокет неблокирующий: соединение забрал другой процесс
+                                                }
+                                            }
+                                            return 0;
+                                        }); });
+
+    std::set<pid_t> pids;
+    for (int i = 0; i < 200 && pids.size() < 2; ++i)
+    {
+        pid_t pid = askWorkerPid();
+        ASSERT_GT(pid, 0);
+        pids.insert(pid);
+    }
+    ASSERT_EQ(pids.size(), 2u);
+
+    pid_t killed = *pids.begin();
+    ASSERT_EQ(kill(killed, SIGKILL), 0);
+    std::set<pid_t> after;
+    for (int i = 0; i < 2000 && after.size() < 2; ++i)
+    {
+        pid_t pid = askWorkerPid();
+        ASSERT_NE(pid, killed);
+        after.insert(pid);
+    }
+    EXPECT_EQ(after.size(), 2u); // Вместо убитого работает новый процесс
+
+    supervisor.stop();
+    parent.join();
+    for (pid_t pid : after)
+    {
+        EXPECT_NE(kill(pid, 0), 0); // Процессы завершены и собраны
+    }
+}
+
+static AuthServer *workerServer = nullptr;
+
+static void stopWorkerServer(int)
+{
+    if (workerServer != nullptr)
+    {
+        workerServer->stop();
+    }
+}
+
+// Серверы в рабочих процессах с общим сокетом, базой, открытой до fork, и общими сессиями:
+// токен, выданный одним процессом, принимается на любом соединении
+TEST(AuthSupervisorTest, WorkersServeAuthentication)
+{
+    std::string archivePath = "./tests/files/supervisor_archive.txt";
+    std::string activeUsersPath = "./tests/files/supervisor_active_users.txt";
+    std::string tmpPath = "./tests/files/supervisor_tmp";
+    std::string configPath = "./tests/files/supervisor_config.txt";
+    std::ofstream(activeUsersPath) << "user hash:password 01.01.2020 1\n";
+    std::ofstream(archivePath) << "user hash:password\n";
+    std::ofstream(configPath) << "maxFailedAttempts 3\nmaxInactiveTimeMin 10\npasswordExpirationDays 36500\n";
+    {
+        ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+        db.enableActiveUsersIndex();
+        SecurityConfig config(configPath);
+        PlainHashing hasher;
+        Authenticator authenticator(&db, &config, &hasher);
+
+        AuthSupervisorOptions options;
+        options.socketPath = socketPath;
+        options.processes = 2;
+        AuthSupervisor supervisor(options);
+        ASSERT_EQ(supervisor.listen(), ConfiguratorErrorCode::SUCCESS);
+        AuthServerOptions serverOptions;
+        serverOptions.listenFd = supervisor.socket();
+        serverOptions.workers = 1;
+        serverOptions.rateLimits.login = {0, 0};
+        SharedSessionTable sessions;
+        ASSERT_EQ(sessions.open(1024), ConfiguratorErrorCode::SUCCESS);
+        serverOptions.sessionStore = &sessions;
+        std::thread parent([&]
+                           { supervisor.run([&](size_t)
+                                            {
+                                                AuthServer server(&authenticator, serverOptions);
+                                                if (server.start() != ConfiguratorErrorCode::SUCCESS)
+                                                {
+                                                    return 1;
+                                                }
+                                                workerServer = &server;
+                                                std::signal(SIGTERM, stopWorkerServer);
+                                                server.run();
+                                                return 0;
+                                            }); });
+
+        std::string token;
+        for (int i = 0; i < 20; ++i)
+        {
+            AuthClient client;
+            ASSERT_EQ(client.connect(socketPath), ConfiguratorErrorCode::SUCCESS);
+            AuthProtocol::AuthResponse response;
+            if (!token.empty())
+            {
+                ASSERT_EQ(client.resumeSession(token, response), ConfiguratorErrorCode::SUCCESS);
+                EXPECT_EQ(response.status, UserErrorCode::SUCCESS) << i;
+            }
+            ASSERT_EQ(client.authenticate("user", "password", response), ConfiguratorErrorCode::SUCCESS);
+            EXPECT_EQ(response.status, UserErrorCode::SUCCESS);
+            if (token.empty())
+            {
+                token = response.sessionToken;
+            }
+            ASSERT_EQ(client.authenticate("user", "wrong", response), ConfiguratorErrorCode::SUCCESS);
+            EXPECT_EQ(response.status, UserErrorCode::WRONG_PASSWORD);
+        }
+
+        supervisor.stop();
+        parent.join();
+    }
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+    std::remove(configPath.c_str());
+}
@@ -0,0 +1,172 @@
+// tests/test_BatchAuthenticator.cpp
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "BatchAuthenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+
+// Хеширование-заглушка без вычислений, допускает вызовы из нескольких потоков
+class PlainHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = "hash:" + password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return hashedPassword == "hash:" + password ? ConfiguratorErrorCode::SUCCESS
+                                                    : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+class BatchAuthenticatorTest : public ::testing::Test
+{
+protected:
+    std::string testArchivePath = "./tests/files/batch_archive.txt";
+    std::string testActiveUsersPath = "./tests/files/batch_active_users.txt";
+    std::string testTmpPath = "./tests/files/batch_tmp";
+    std::string testConfigPath = "./tests/files/batch_config.txt";
+
+    PlainHashing hasher;
+    ConfiguratorDatabase *db;
+    SecurityConfig *config;
+    Authenticator *authenticator;
+
+    void SetUp() override
+    {
+        std::ofstream(testActiveUsersPath) << "expired hash:password 01.01.2000 1\n";
+        std::ofstream(testArchivePath) << "expired hash:password\n";
+        std::ofstream(testConfigPath) << "passwordExpirationDays 30\n";
+
+        db = new ConfiguratorDatabase(testArchivePath, testActiveUsersPath, testTmpPath);
+        db->addUser("user", "hash:password", {UserRole::ROLE1});
+        config = new SecurityConfig(testConfigPath);
+        authenticator = new Authenticator(db, config, &hasher);
+    }
+
+    void TearDown() override
+    {
+        delete authenticator;
+        delete config;
+        delete db;
+        std::remove(testArchivePath.c_str());
+        std::remove(testActiveUsersPath.c_str());
+        std::remove(testTmpPath.c_str());
+        std::remove(testConfigPath.c_str());
+    }
+};
+
+// Результаты выводятся в порядке записей, итоги считаются по всем записям
+TEST_F(BatchAuthenticatorTest, ResultsInInputOrder)
+{
+    std::istringstream in("user\tpassword\n"
+                          "user\twrong\n"
+                          "\n"
+                          "expired\tpassword\r\n"
+                          "nobody\tpassword\n"
+                          "user\n"
+                          "\tpassword\n");
+    std::ostringstream out;
+
+    BatchAuthOptions options;
+    options.workers = 2;
+    options.maxInFlight = 2;
+    BatchAuthenticator batch(authenticator, &hasher, options);
+    BatchAuthReport report = batch.run(in, out);
+
+    std::istringstream lines(out.str());
+    std::vector<std::pair<std::string, std::string>> results;
+    std::string login;
+    std::string result;
+    std::string latency;
+    while (std::getline(lines, login, '\t') && std::getline(lines, result, '\t') && std::getline(lines, latency))
+    {
+        results.emplace_back(login, result);
+    }
+    std::vector<std::pair<std::string, std::string>> expected = {
+        {"user", "success"},
+        {"user", "wrong_password"},
+        {"expired", "expired"},
+        {"nobody", "not_found"},
+        {"user", "invalid_password"},
+        {"", "invalid_login"}};
+    EXPECT_EQ(results, expected);
+
+    EXPECT_EQ(report.records, 6u);
+    EXPECT_EQ(report.counts[UserErrorCode::SUCCESS], 1u);
+    EXPECT_EQ(report.counts[UserErrorCode::WRONG_PASSWORD], 1u);
+    EXPECT_EQ(report.counts[UserErrorCode::PASSWORD_HAS_EXPIRED], 1u);
+    EXPECT_EQ(report.counts[UserErrorCode::LOGIN_NOT_EXISTS], 1u);
+    EXPECT_LE(report.p50Micros, report.p99Micros);
+    EXPECT_LE(report.p99Micros, report.maxMicros);
+    EXPECT_GT(report.throughputPerSecond, 0);
+
+    std::ostringstream summary;
+    BatchAuthenticator::printReport(report, summary);
+    EXPECT_NE(summary.str().find("records: 6"), std::string::npos);
+    EXPECT_NE(summary.str().find("p99"), std::string::npos);
+}
+
+// В режиме «поток на ядро» записи обслуживают потоки ядер таблицы, в том числе логины из чужих разделов,
+// а порядок вывода сохраняется
+TEST_F(BatchAuthenticatorTest, PerCoreTableKeepsInputOrder)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        db->addUser("user" + std::to_string(i), "hash:password" + std::to_string(i), {UserRole::ROLE1});
+    }
+    PartitionedUserTable table(3);
+    ASSERT_EQ(table.load(*db), ConfiguratorErrorCode::SUCCESS);
+
+    std::string input;
+    std::vector<std::pair<std::string, std::string>> expected;
+    for (int i = 0; i < 300; ++i)
+    {
+        std::string login = "user" + std::to_string(i % 10);
+        bool right = i % 3 != 0;
+        input += login + "\tpassword" + std::to_string(right ? i % 10 : 99) + "\n";
+        expected.emplace_back(login, i % 10 >= 8 ? "not_found" : right ? "success" : "wrong_password");
+    }
+    input += "expired\tpassword\n";
+    expected.emplace_back("expired", "expired");
+    std::istringstream in(input);
+    std::ostringstream out;
+
+    BatchAuthOptions options;
+    options.userTable = &table;
+    options.maxInFlight = 16;
+    BatchAuthenticator batch(authenticator, &hasher, options);
+    BatchAuthReport report = batch.run(in, out);
+
+    std::istringstream lines(out.str());
+    std::vector<std::pair<std::string, std::string>> results;
+    std::string login;
+    std::string result;
+    std::string latency;
+    while (std::getline(lines, login, '\t') && std::getline(lines, result, '\t') && std::getline(lines, latency))
+    {
+        results.emplace_back(login, result);
+    }
+    EXPECT_EQ(results, expected);
+    EXPECT_EQ(report.records, 301u);
+    EXPECT_EQ(report.counts[UserErrorCode::LOGIN_NOT_EXISTS], 60u);
+}
+
+// Пустой вход дает пустой отчет
+TEST_F(BatchAuthenticatorTest, EmptyInput)
+{
+    std::istringstream in("");
+    std::ostringstream out;
+    BatchAuthenticator batch(authenticator, &hasher);
+    BatchAuthReport report = batch.run(in, out);
+    EXPECT_TRUE(out.str().empty());
+    EXPECT_EQ(report.records, 0u);
+    EXPECT_EQ(report.maxMicros, 0);
+}
@@ -0,0 +1,45 @@
+// tests/test_CancellationToken.cpp
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+#include "CancellationToken.hpp"
+
+// Срок берется наименьший из заданных; 0 не меняет срок
+TEST(CancellationTokenTest, EarliestDeadlineWins)
+{
+    CancellationToken::Clock::time_point now = CancellationToken::Clock::now();
+    CancellationToken connection;
+    EXPECT_FALSE(connection.hasDeadline());
+    EXPECT_EQ(connection.reason(now + std::chrono::hours(24)), CancelReason::NONE);
+
+    CancellationToken request = connection.withTimeout(500, now).withTimeout(100, now).withTimeout(0, now);
+    EXPECT_TRUE(request.hasDeadline());
+    EXPECT_EQ(request.reason(now + std::chrono::milliseconds(99)), CancelReason::NONE);
+    EXPECT_EQ(request.reason(now + std::chrono::milliseconds(100)), CancelReason::DEADLINE);
+    EXPECT_EQ(connection.withTimeout(100, now).withTimeout(500, now).reason(now + std::chrono::milliseconds(100)),
+              CancelReason::DEADLINE);
+}
+
+// Отмена соединения видна всем копиям, в том числе в других потоках, и важнее срока
+TEST(CancellationTokenTest, CancelIsSharedByCopies)
+{
+    CancellationToken::Clock::time_point now = CancellationToken::Clock::now();
+    CancellationToken connection;
+    CancellationToken request = connection.withTimeout(10, now);
+    CancelReason seen = CancelReason::NONE;
+    std::thread worker([&request, &seen, now]
+                       {
+                           auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                           while (request.reason(now) == CancelReason::NONE && std::chrono::steady_clock::now() < deadline)
+                           {
+                               std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                           }
+                           seen = request.reason(now + std::chrono::seconds(1));
+                       });
+    connection.cancel();
+    worker.join();
+    EXPECT_EQ(seen, CancelReason::DISCONNECTED);
+    EXPECT_EQ(CancellationToken().reason(now), CancelReason::NONE);
+}
@@ -7,9 +7,15 @@
 #include "ConfiguratorDatabaseInterface.hpp"
 #include "SecurityConfigInterface.hpp"
 #include "HashingInterface.hpp"
+#include "PasswordFingerprint.hpp"
+#include "WorkStealingExecutor.hpp"
+
+#include <fstream>
+#include <thread>
 
 using ::testing::_;
 using ::testing::DoAll;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::SetArgReferee;
 
@@ -33,19 +39,8 @@ public:
 class MockSecurityConfig : public SecurityConfigInterface
 {
 public:
-    MOCK_METHOD(ConfiguratorErrorCode, set_minPasswordLength, (const unsigned length), (override));
-    MOCK_METHOD(ConfiguratorErrorCode, set_passwordHistoryDepth, (const unsigned depth), (override));
-    MOCK_METHOD(ConfiguratorErrorCode, set_passwordExpirationDays, (const unsigned days), (override));
-    MOCK_METHOD(ConfiguratorErrorCode, set_maxInactiveTimeMin, (const unsigned minutes), (override));
-    MOCK_METHOD(ConfiguratorErrorCode, set_maxFailedAttempts, (const unsigned attempts), (override));
-    MOCK_METHOD(ConfiguratorErrorCode, set_lockoutTimeMin, (const unsigned minutes), (override));
-
-    MOCK_METHOD(ConfiguratorErrorCode, get_minPasswordLength, (unsigned &length), (const, override));
-    MOCK_METHOD(ConfiguratorErrorCode, get_passwordHistoryDepth, (unsigned &depth), (const, override));
-    MOCK_METHOD(ConfiguratorErrorCode, get_passwordExpirationDays, (unsigned &days), (const, override));
-    MOCK_METHOD(ConfiguratorErrorCode, get_maxInactiveTimeMin, (unsigned &minutes), (const, override));
-    MOCK_METHOD(ConfiguratorErrorCode, get_maxFailedAttempts, (unsigned &attempts), (const, override));
-    MOCK_METHOD(ConfiguratorErrorCode, get_lockoutTimeMin, (unsigned &minutes), (const, override));
+    MOCK_METHOD(ConfiguratorErrorCode, get, (SecurityParam param, unsigned &value), (const, override));
+    MOCK_METHOD(ConfiguratorErrorCode, applyChanges, (const SecurityConfigChanges &changes), (override));
 };
 
 class MockHashing : public HashingInterface
@@ -87,8 +82,8 @@ TEST_F(ConfiguratorAccountsEditorTest, CreateAccount_Success)
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND))  // Для checkLoginInArchive
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND)); // Для checkPassword
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
     EXPECT_CALL(mockDb, addUser(login, _, roles))
         .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
@@ -123,8 +118,8 @@ TEST_F(ConfiguratorAccountsEditorTest, CreateAccount_PasswordTooShort)
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND))
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
     auto result = accountsEditor.createAccount(login, password, roles);
     EXPECT_EQ(result, ConfiguratorErrorCode::PASSWORD_TOO_SHORT);
@@ -140,8 +135,8 @@ TEST_F(ConfiguratorAccountsEditorTest, CreateAccount_ValidSpecialPasswordChars)
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND))
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
     EXPECT_CALL(mockDb, addUser(login, _, roles))
         .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
@@ -163,8 +158,8 @@ TEST_F(ConfiguratorAccountsEditorTest, CreateAccount_InvalidPasswordChars)
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND))
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
     auto result = accountsEditor.createAccount(login, password, roles);
     EXPECT_EQ(result, ConfiguratorErrorCode::PASSWORD_INVALID_CHARS);
@@ -207,8 +202,8 @@ TEST_F(ConfiguratorAccountsEditorTest, CreateAccount_DatabaseErrorOnAddUser)
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND))
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
     EXPECT_CALL(mockDb, addUser(login, _, roles))
         .WillOnce(Return(ConfiguratorErrorCode::DATABASE_ERROR));
@@ -231,8 +226,8 @@ TEST_F(ConfiguratorAccountsEditorTest, CreateAccount_PasswordHashingError)
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND))  // Для checkLoginInArchive
         .WillOnce(Return(ConfiguratorErrorCode::LOGIN_NOT_FOUND)); // Для checkPassword
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
     EXPECT_CALL(mockHasher, pwHashMake(password, _))
         .WillOnce(Return(ConfiguratorErrorCode::HASHING_ERROR));
@@ -318,11 +313,11 @@ TEST_F(ConfiguratorAccountsEditorTest, EditPassword_Success)
     EXPECT_CALL(mockHasher, pwHashMake(newPassword, _))
         .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
-    EXPECT_CALL(mockConfig, get_passwordHistoryDepth(_))
-        .WillOnce(DoAll(SetArgReferee<0>(passwordHistoryDepth), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::PASSWORD_HISTORY_DEPTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(passwordHistoryDepth), Return(ConfiguratorErrorCode::SUCCESS)));
 
     EXPECT_CALL(mockDb, updatePassword(login, _, passwordHistoryDepth))
         .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
@@ -331,6 +326,59 @@ TEST_F(ConfiguratorAccountsEditorTest, EditPassword_Success)
     EXPECT_EQ(result, ConfiguratorErrorCode::SUCCESS);
 }
 
+// Сопрограмма смены пароля: обращения к базе — в потоке исполнителя базы, хеширование — в потоке хеширования
+TEST_F(ConfiguratorAccountsEditorTest, EditPasswordAsync_RunsStagesOnExecutors)
+{
+    std::string login = "existing_user";
+    std::string newPassword = "NewPass123";
+    std::thread::id verifyThread, makeThread, updateThread, historyThread;
+
+    EXPECT_CALL(mockDb, getActiveUserByLogin(login, _))
+        .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
+    EXPECT_CALL(mockDb, getArchiveUserByLogin(login, _))
+        .WillOnce(DoAll(SetArgReferee<1>(login + " hash1"), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockHasher, pwHashVerify(newPassword, "hash1"))
+        .WillOnce(Invoke([&](const std::string &, const std::string &)
+                         {
+                             verifyThread = std::this_thread::get_id();
+                             return ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+                         }));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::PASSWORD_HISTORY_DEPTH, _))
+        .WillOnce(Invoke([&](SecurityParam, unsigned &value)
+                         {
+                             historyThread = std::this_thread::get_id();
+                             value = 3;
+                             return ConfiguratorErrorCode::SUCCESS;
+                         }));
+    EXPECT_CALL(mockHasher, pwHashMake(newPassword, _))
+        .WillOnce(Invoke([&](const std::string &, std::string &hash)
+                         {
+                             makeThread = std::this_thread::get_id();
+                             hash = "newhash";
+                             return ConfiguratorErrorCode::SUCCESS;
+                         }));
+    EXPECT_CALL(mockDb, updatePassword(login, "newhash", 3u))
+        .WillOnce(Invoke([&](const std::string &, const std::string &, const unsigned &)
+                         {
+                             updateThread = std::this_thread::get_id();
+                             return ConfiguratorErrorCode::SUCCESS;
+                         }));
+
+    WorkStealingOptions options;
+    options.workers = 1;
+    WorkStealingExecutor database(options);
+    WorkStealingExecutor hashing(options);
+    auto result = syncWait(accountsEditor.editPasswordAsync(login, newPassword, AsyncStages{&database, &hashing}));
+    EXPECT_EQ(result, ConfiguratorErrorCode::SUCCESS);
+
+    EXPECT_EQ(historyThread, updateThread);
+    EXPECT_EQ(verifyThread, makeThread);
+    EXPECT_NE(updateThread, makeThread);
+    EXPECT_NE(updateThread, std::this_thread::get_id());
+}
+
 TEST_F(ConfiguratorAccountsEditorTest, EditPassword_LoginNotFound)
 {
     std::string login = "nonexistent_user";
@@ -358,8 +406,8 @@ TEST_F(ConfiguratorAccountsEditorTest, EditPassword_PasswordTooShort)
         .Times(testing::AtLeast(1))
         .WillRepeatedly(Return(ConfiguratorErrorCode::PASSWORDS_DONT_MATCH));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
     auto result = accountsEditor.editPassword(login, newPassword);
     EXPECT_EQ(result, ConfiguratorErrorCode::PASSWORD_TOO_SHORT);
@@ -380,8 +428,8 @@ TEST_F(ConfiguratorAccountsEditorTest, EditPassword_InvalidPasswordChars)
         .Times(testing::AtLeast(1))
         .WillRepeatedly(Return(ConfiguratorErrorCode::PASSWORDS_DONT_MATCH));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
     auto result = accountsEditor.editPassword(login, newPassword);
     EXPECT_EQ(result, ConfiguratorErrorCode::PASSWORD_INVALID_CHARS);
@@ -448,7 +496,7 @@ TEST_F(ConfiguratorAccountsEditorTest, EditPassword_DatabaseErrorOnGetMinPasswor
         .Times(testing::AtLeast(1))
         .WillRepeatedly(Return(ConfiguratorErrorCode::PASSWORDS_DONT_MATCH));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
         .WillOnce(Return(ConfiguratorErrorCode::DATABASE_ERROR));
 
     auto result = accountsEditor.editPassword(login, newPassword);
@@ -470,10 +518,10 @@ TEST_F(ConfiguratorAccountsEditorTest, EditPassword_DatabaseErrorOnHistoryDepth)
         .Times(testing::AtLeast(1))
         .WillRepeatedly(Return(ConfiguratorErrorCode::PASSWORDS_DONT_MATCH));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
-    EXPECT_CALL(mockConfig, get_passwordHistoryDepth(_))
+    EXPECT_CALL(mockConfig, get(SecurityParam::PASSWORD_HISTORY_DEPTH, _))
         .WillOnce(Return(ConfiguratorErrorCode::DATABASE_ERROR));
 
     auto result = accountsEditor.editPassword(login, newPassword);
@@ -496,11 +544,11 @@ TEST_F(ConfiguratorAccountsEditorTest, EditPassword_DatabaseErrorOnUpdate)
         .Times(testing::AtLeast(1))
         .WillRepeatedly(Return(ConfiguratorErrorCode::PASSWORDS_DONT_MATCH));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
-    EXPECT_CALL(mockConfig, get_passwordHistoryDepth(_))
-        .WillOnce(DoAll(SetArgReferee<0>(passwordHistoryDepth), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::PASSWORD_HISTORY_DEPTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(passwordHistoryDepth), Return(ConfiguratorErrorCode::SUCCESS)));
 
     EXPECT_CALL(mockHasher, pwHashMake(newPassword, _))
         .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
@@ -528,11 +576,11 @@ TEST_F(ConfiguratorAccountsEditorTest, EditPassword_PasswordHashingError)
         .Times(testing::AtLeast(1))
         .WillRepeatedly(Return(ConfiguratorErrorCode::PASSWORDS_DONT_MATCH));
 
-    EXPECT_CALL(mockConfig, get_minPasswordLength(_))
-        .WillOnce(DoAll(SetArgReferee<0>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
 
-    EXPECT_CALL(mockConfig, get_passwordHistoryDepth(_))
-        .WillOnce(DoAll(SetArgReferee<0>(passwordHistoryDepth), Return(ConfiguratorErrorCode::SUCCESS)));
+    EXPECT_CALL(mockConfig, get(SecurityParam::PASSWORD_HISTORY_DEPTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(passwordHistoryDepth), Return(ConfiguratorErrorCode::SUCCESS)));
 
     EXPECT_CALL(mockHasher, pwHashMake(newPassword, _))
         .WillOnce(Return(ConfiguratorErrorCode::HASHING_ERROR));
@@ -599,4 +647,84 @@ TEST_F(ConfiguratorAccountsEditorTest, EditRoles_DatabaseErrorOnUpdate)
 
     auto result = accountsEditor.editRoles(login, newRoles);
     EXPECT_EQ(result, ConfiguratorErrorCode::DATABASE_ERROR);
-}
\ No newline at end of file
+}
+// Редактор с включенными отпечатками паролей в архиве
+class ConfiguratorAccountsEditorFingerprintTest : public ConfiguratorAccountsEditorTest
+{
+protected:
+    const std::string pepperPath = "./tests/files/test_pepper.key";
+    PasswordFingerprint fingerprint;
+    ConfiguratorAccountsEditor fingerprintEditor{&mockDb, &mockConfig, &mockHasher, &fingerprint};
+
+    void SetUp() override
+    {
+        std::ofstream(pepperPath) << std::string(64, 'a') << "\n";
+        ASSERT_EQ(fingerprint.loadPepper(pepperPath), ConfiguratorErrorCode::SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        std::remove(pepperPath.c_str());
+    }
+};
+
+// Записи с несовпадающим отпечатком не требуют медленной проверки, старые записи без отпечатка проверяются
+TEST_F(ConfiguratorAccountsEditorFingerprintTest, EditPassword_SkipsVerifyOnFingerprintMismatch)
+{
+    std::string login = "existing_user";
+    std::string newPassword = "NewPass123";
+    std::string expectedFingerprint;
+    ASSERT_EQ(fingerprint.compute(login, newPassword, expectedFingerprint), ConfiguratorErrorCode::SUCCESS);
+    std::string otherFingerprint = expectedFingerprint == "00000000" ? "11111111" : "00000000";
+    std::string userData = login + " legacyhash hash1#" + otherFingerprint + " hash2#" + otherFingerprint;
+
+    EXPECT_CALL(mockDb, getActiveUserByLogin(login, _))
+        .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
+
+    EXPECT_CALL(mockDb, getArchiveUserByLogin(login, _))
+        .WillOnce(DoAll(SetArgReferee<1>(userData), Return(ConfiguratorErrorCode::SUCCESS)));
+
+    // Полностью проверяется только запись старого формата
+    EXPECT_CALL(mockHasher, pwHashVerify(newPassword, "legacyhash"))
+        .WillOnce(Return(ConfiguratorErrorCode::PASSWORDS_DONT_MATCH));
+    EXPECT_CALL(mockHasher, pwHashVerify(newPassword, "hash1")).Times(0);
+    EXPECT_CALL(mockHasher, pwHashVerify(newPassword, "hash2")).Times(0);
+
+    EXPECT_CALL(mockConfig, get(SecurityParam::MIN_PASSWORD_LENGTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(8), Return(ConfiguratorErrorCode::SUCCESS)));
+
+    EXPECT_CALL(mockConfig, get(SecurityParam::PASSWORD_HISTORY_DEPTH, _))
+        .WillOnce(DoAll(SetArgReferee<1>(3), Return(ConfiguratorErrorCode::SUCCESS)));
+
+    EXPECT_CALL(mockHasher, pwHashMake(newPassword, _))
+        .WillOnce(DoAll(SetArgReferee<1>("newhash"), Return(ConfiguratorErrorCode::SUCCESS)));
+
+    // В БД передается хеш с отпечатком нового пароля
+    EXPECT_CALL(mockDb, updatePassword(login, "newhash#" + expectedFingerprint, 3u))
+        .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
+
+    auto result = fingerprintEditor.editPassword(login, newPassword);
+    EXPECT_EQ(result, ConfiguratorErrorCode::SUCCESS);
+}
+
+// Совпадение отпечатка подтверждается полной проверкой хеша
+TEST_F(ConfiguratorAccountsEditorFingerprintTest, EditPassword_ConfirmsFingerprintMatch)
+{
+    std::string login = "existing_user";
+    std::string newPassword = "ReusedPass123";
+    std::string expectedFingerprint;
+    ASSERT_EQ(fingerprint.compute(login, newPassword, expectedFingerprint), ConfiguratorErrorCode::SUCCESS);
+    std::string userData = login + " hash1#" + expectedFingerprint;
+
+    EXPECT_CALL(mockDb, getActiveUserByLogin(login, _))
+        .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
+
+    EXPECT_CALL(mockDb, getArchiveUserByLogin(login, _))
+        .WillOnce(DoAll(SetArgReferee<1>(userData), Return(ConfiguratorErrorCode::SUCCESS)));
+
+    EXPECT_CALL(mockHasher, pwHashVerify(newPassword, "hash1"))
+        .WillOnce(Return(ConfiguratorErrorCode::SUCCESS));
+
+    auto result = fingerprintEditor.editPassword(login, newPassword);
+    EXPECT_EQ(result, ConfiguratorErrorCode::PASSWORD_REUSED);
+}
@@ -3,8 +3,12 @@
 #include <gtest/gtest.h>
 #include <fstream>
 #include <filesystem>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
 
 #include "ConfiguratorDatabase.hpp"
+#include "IoBackend.hpp"
 
 class ConfiguratorDatabaseTest : public ::testing::Test
 {
@@ -203,6 +207,36 @@ TEST_F(ConfiguratorDatabaseTest, MultipleUpdatePasswordCorrectly)
     EXPECT_EQ(userData.find(oldPassword), std::string::npos);
 }
 
+// Отпечаток пароля записывается только в архив, в таблице активных пользователей остается хеш
+TEST_F(ConfiguratorDatabaseTest, UpdatePassword_FingerprintOnlyInArchive)
+{
+    std::string userData;
+    ConfiguratorErrorCode code;
+    std::string login = "user1";
+
+    code = db->updatePassword(login, "newhashed#0a1b2c3d", 3);
+    EXPECT_EQ(code, ConfiguratorErrorCode::SUCCESS);
+
+    code = db->getActiveUserByLogin(login, userData);
+    EXPECT_EQ(code, ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(userData.rfind("user1 newhashed ", 0), 0u);
+
+    code = db->getArchiveUserByLogin(login, userData);
+    EXPECT_EQ(code, ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(userData, "user1 hashedpass1 newhashed#0a1b2c3d");
+
+    code = db->addUser("user3", "hashedpass3#deadbeef", {UserRole::ROLE1});
+    EXPECT_EQ(code, ConfiguratorErrorCode::SUCCESS);
+
+    code = db->getActiveUserByLogin("user3", userData);
+    EXPECT_EQ(code, ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(userData.rfind("user3 hashedpass3 ", 0), 0u);
+
+    code = db->getArchiveUserByLogin("user3", userData);
+    EXPECT_EQ(code, ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(userData, "user3 hashedpass3#deadbeef");
+}
+
 // Убедимся, что ошибка при открытии файлов возвращает корректный код ошибки
 TEST_F(ConfiguratorDatabaseTest, FileOpenError)
 {
@@ -365,4 +399,155 @@ TEST_F(ConfiguratorDatabaseTest, getFirstArchiveUser_EmptyFile)
 
     code = db->getFirstArchiveUser(userData);
     EXPECT_EQ(code, ConfiguratorErrorCode::END_OF_TABLE);
-}
\ No newline at end of file
+}
+// Индекс активных пользователей перестраивается после изменения файла
+TEST_F(ConfiguratorDatabaseTest, ActiveUsersIndexFollowsFile)
+{
+    db->enableActiveUsersIndex();
+    std::string userData;
+    EXPECT_EQ(db->getActiveUserByLogin("user2", userData), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(userData, "user2 hashedpass2 02.02.2002 2");
+    EXPECT_EQ(db->getActiveUserByLogin("testuser", userData), ConfiguratorErrorCode::LOGIN_NOT_FOUND);
+
+    ASSERT_EQ(db->addUser("testuser", "12345678", {UserRole::ROLE1}), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(db->getActiveUserByLogin("testuser", userData), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(userData.rfind("testuser 12345678 ", 0), 0u);
+
+    ASSERT_EQ(db->removeUser("user2"), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(db->getActiveUserByLogin("user2", userData), ConfiguratorErrorCode::LOGIN_NOT_FOUND);
+}
+
+// Асинхронные поиск и добавление дают тот же результат, что и синхронные методы
+TEST_F(ConfiguratorDatabaseTest, AsyncLookupAndAddUser)
+{
+    for (bool preferIoUring : {true, false})
+    {
+        std::unique_ptr<IoBackendInterface> backend = IoBackend::create(preferIoUring);
+        SCOPED_TRACE(backend->name());
+        db->setIoBackend(backend.get());
+
+        std::string login = std::string("async_") + backend->name();
+        std::vector<ConfiguratorErrorCode> codes;
+        std::string found;
+        db->getActiveUserAsync("user2", [&](ConfiguratorErrorCode code, const std::string &userData)
+                               {
+                                   codes.push_back(code);
+                                   found = userData;
+                               });
+        db->getActiveUserAsync(login, [&](ConfiguratorErrorCode code, const std::string &)
+                               { codes.push_back(code); });
+        db->addUserAsync(login, "hash#fingerprint", {UserRole::ROLE1, UserRole::ROLE2}, [&](ConfiguratorErrorCode code)
+                         { codes.push_back(code); });
+        while (backend->inFlight() > 0)
+        {
+            backend->submit();
+            backend->complete(true);
+        }
+        ASSERT_EQ(codes.size(), 3u);
+        EXPECT_EQ(codes[0], ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(found, "user2 hashedpass2 02.02.2002 2");
+        EXPECT_EQ(codes[1], ConfiguratorErrorCode::LOGIN_NOT_FOUND);
+        EXPECT_EQ(codes[2], ConfiguratorErrorCode::SUCCESS);
+
+        std::string userData;
+        ASSERT_EQ(db->getActiveUserByLogin(login, userData), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(userData.rfind(login + " hash ", 0), 0u);
+        EXPECT_EQ(userData.substr(userData.rfind(' ')), " 0,1");
+        ASSERT_EQ(db->getArchiveUserByLogin(login, userData), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(userData, login + " hash#fingerprint");
+
+        // Повторное добавление отклоняется, блокировка базы снята после завершения
+        ConfiguratorErrorCode duplicate = ConfiguratorErrorCode::SUCCESS;
+        db->addUserAsync(login, "other", {UserRole::ROLE1}, [&](ConfiguratorErrorCode code)
+                         { duplicate = code; });
+        while (backend->inFlight() > 0)
+        {
+            backend->submit();
+            backend->complete(true);
+        }
+        EXPECT_EQ(duplicate, ConfiguratorErrorCode::LOGIN_ALREADY_EXISTS);
+        EXPECT_EQ(db->removeUser(login), ConfiguratorErrorCode::SUCCESS);
+        db->setIoBackend(nullptr);
+    }
+}
+
+// Добавления, поставленные до завершения предыдущего, и синхронное изменение во время добавления не ждут сами себя
+TEST_F(ConfiguratorDatabaseTest, ConcurrentAsyncAddsAndSyncWrite)
+{
+    for (bool preferIoUring : {true, false})
+    {
+        std::unique_ptr<IoBackendInterface> backend = IoBackend::create(preferIoUring);
+        SCOPED_TRACE(backend->name());
+        db->setIoBackend(backend.get());
+
+        std::string prefix = std::string("concurrent_") + backend->name();
+        std::vector<ConfiguratorErrorCode> codes;
+        for (const char *suffix : {"1", "2", "1"})
+        {
+            db->addUserAsync(prefix + suffix, "hash", {UserRole::ROLE1}, [&](ConfiguratorErrorCode code)
+                             { codes.push_back(code); });
+        }
+        // Синхронное изменение сначала выполняет поставленные добавления
+        EXPECT_EQ(db->updateRoles(prefix + "2", {UserRole::ROLE3}), ConfiguratorErrorCode::SUCCESS);
+        ASSERT_EQ(codes.size(), 3u);
+        EXPECT_EQ(codes[0], ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(codes[1], ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(codes[2], ConfiguratorErrorCode::LOGIN_ALREADY_EXISTS);
+
+        // Синхронное изменение из обратного вызова другой операции, пока добавление в пути
+        ConfiguratorErrorCode added = ConfiguratorErrorCode::DATABASE_ERROR;
+        ConfiguratorErrorCode removed = ConfiguratorErrorCode::DATABASE_ERROR;
+        db->getActiveUserAsync("user2", [&](ConfiguratorErrorCode, const std::string &)
+                               { removed = db->removeUser(prefix + "3"); });
+        db->addUserAsync(prefix + "3", "hash", {UserRole::ROLE1}, [&](ConfiguratorErrorCode code)
+                         { added = code; });
+        while (backend->inFlight() > 0)
+        {
+            backend->submit();
+            backend->complete(true);
+        }
+        EXPECT_EQ(added, ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(removed, ConfiguratorErrorCode::SUCCESS);
+
+        std::string userData;
+        ASSERT_EQ(db->getActiveUserByLogin(prefix + "2", userData), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(userData.substr(userData.rfind(' ')), " 2");
+        EXPECT_EQ(db->getActiveUserByLogin(prefix + "3", userData), ConfiguratorErrorCode::LOGIN_NOT_FOUND);
+        db->setIoBackend(nullptr);
+        EXPECT_EQ(db->removeUser(prefix + "1"), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(db->removeUser(prefix + "2"), ConfiguratorErrorCode::SUCCESS);
+    }
+}
+
+// Пока базу изменяет другой процесс, добавление повторяет захват из цикла завершений, не блокируя поток
+TEST_F(ConfiguratorDatabaseTest, AsyncAddWaitsForForeignLock)
+{
+    std::unique_ptr<IoBackendInterface> backend = IoBackend::create(false);
+    db->setIoBackend(backend.get());
+    int foreign = open("./tests/files", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    ASSERT_GE(foreign, 0);
+    ASSERT_EQ(flock(foreign, LOCK_EX), 0);
+
+    bool done = false;
+    db->addUserAsync("foreign_lock", "hash", {UserRole::ROLE1}, [&](ConfiguratorErrorCode code)
+                     {
+                         EXPECT_EQ(code, ConfiguratorErrorCode::SUCCESS);
+                         done = true;
+                     });
+    for (int i = 0; i < 20; ++i)
+    {
+        backend->submit();
+        backend->complete(true);
+    }
+    EXPECT_FALSE(done);
+
+    close(foreign);
+    while (backend->inFlight() > 0)
+    {
+        backend->submit();
+        backend->complete(true);
+    }
+    EXPECT_TRUE(done);
+    db->setIoBackend(nullptr);
+    EXPECT_EQ(db->removeUser("foreign_lock"), ConfiguratorErrorCode::SUCCESS);
+}
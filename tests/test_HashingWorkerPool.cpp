@@ -0,0 +1,169 @@
+// tests/test_HashingWorkerPool.cpp
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "HashingWorkerPool.hpp"
+
+// Хеширование-заглушка: пароль совпадает, если хеш равен "hash:" + пароль
+class FakeHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = "hash:" + password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return hashedPassword == "hash:" + password ? ConfiguratorErrorCode::SUCCESS : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+class HashingWorkerPoolTest : public ::testing::Test
+{
+protected:
+    FakeHashing hasher;
+
+    std::mutex orderMutex;
+    std::vector<std::string> order; // Порядок выполнения задач
+
+    std::atomic<bool> gateOpen{false};
+
+    // Задача, занимающая поток до открытия шлюза
+    std::function<ConfiguratorErrorCode(HashingInterface &)> gate()
+    {
+        return [this](HashingInterface &)
+        {
+            while (!gateOpen)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return ConfiguratorErrorCode::SUCCESS;
+        };
+    }
+
+    // Задача, записывающая свое имя в порядок выполнения
+    std::function<ConfiguratorErrorCode(HashingInterface &)> record(const std::string &name,
+                                                                    std::chrono::milliseconds duration = std::chrono::milliseconds(0))
+    {
+        return [this, name, duration](HashingInterface &)
+        {
+            std::this_thread::sleep_for(duration);
+            std::lock_guard<std::mutex> lock(orderMutex);
+            order.push_back(name);
+            return ConfiguratorErrorCode::SUCCESS;
+        };
+    }
+};
+
+// Результаты хеширования возвращаются через future и адаптер PooledHashing
+TEST_F(HashingWorkerPoolTest, ReturnsResults)
+{
+    HashingPoolOptions options;
+    options.workers = 2;
+    HashingWorkerPool pool(&hasher, options);
+    PooledHashing pooled(&pool, HashingPriority::ADMIN);
+
+    std::string hashedPassword;
+    EXPECT_EQ(pooled.pwHashMake("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(hashedPassword, "hash:password");
+    EXPECT_EQ(pooled.pwHashVerify("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+
+    EXPECT_EQ(pool.submitVerify(HashingPriority::INTERACTIVE, "password", hashedPassword).get(), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(pool.submitVerify(HashingPriority::BULK, "wrong", hashedPassword).get(), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+
+    HashingPoolStats stats = pool.stats();
+    EXPECT_EQ(stats.completed[static_cast<int>(HashingPriority::INTERACTIVE)], 1u);
+    EXPECT_EQ(stats.completed[static_cast<int>(HashingPriority::ADMIN)], 2u);
+    EXPECT_EQ(stats.completed[static_cast<int>(HashingPriority::BULK)], 1u);
+}
+
+// Задачи берутся в порядке приоритета, а не постановки
+TEST_F(HashingWorkerPoolTest, HigherPriorityRunsFirst)
+{
+    HashingPoolOptions options;
+    options.workers = 1;
+    options.starvationTimeout = std::chrono::milliseconds(10000);
+    HashingWorkerPool pool(&hasher, options);
+
+    auto blocked = pool.submit(HashingPriority::INTERACTIVE, gate());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto bulk = pool.submit(HashingPriority::BULK, record("bulk"));
+    auto admin = pool.submit(HashingPriority::ADMIN, record("admin"));
+    auto interactive = pool.submit(HashingPriority::INTERACTIVE, record("interactive"));
+    gateOpen = true;
+
+    blocked.get();
+    bulk.get();
+    admin.get();
+    interactive.get();
+    EXPECT_EQ(order, (std::vector<std::string>{"interactive", "admin", "bulk"}));
+}
+
+// Задача низшего класса, прождавшая дольше starvationTimeout, выполняется вне очереди
+TEST_F(HashingWorkerPoolTest, StarvationProtection)
+{
+    HashingPoolOptions options;
+    options.workers = 1;
+    options.starvationTimeout = std::chrono::milliseconds(20);
+    HashingWorkerPool pool(&hasher, options);
+
+    auto blocked = pool.submit(HashingPriority::INTERACTIVE, gate());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    auto bulk = pool.submit(HashingPriority::BULK, record("bulk"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    auto interactive = pool.submit(HashingPriority::INTERACTIVE, record("interactive"));
+    gateOpen = true;
+
+    blocked.get();
+    bulk.get();
+    interactive.get();
+    EXPECT_EQ(order, (std::vector<std::string>{"bulk", "interactive"}));
+    EXPECT_EQ(pool.stats().promotedByAging, 1u);
+}
+
+// При превышении цели по p99 массовые задачи ждут интерактивные даже после долгого ожидания,
+// а после периода без интерактивных задач ограничение снимается
+TEST_F(HashingWorkerPoolTest, BulkThrottledWhenInteractiveP99AboveTarget)
+{
+    HashingPoolOptions options;
+    options.workers = 1;
+    options.starvationTimeout = std::chrono::milliseconds(1);
+    options.interactiveP99Target = std::chrono::microseconds(1000);
+    options.throttleRecovery = std::chrono::milliseconds(200);
+    HashingWorkerPool pool(&hasher, options);
+
+    // Медленные интерактивные задачи поднимают p99 выше цели
+    pool.submit(HashingPriority::INTERACTIVE, record("slow", std::chrono::milliseconds(5))).get();
+    HashingPoolStats stats = pool.stats();
+    EXPECT_TRUE(stats.bulkThrottled);
+    EXPECT_GE(stats.interactiveP99.count(), 5000);
+
+    order.clear();
+    gateOpen = false;
+    auto blocked = pool.submit(HashingPriority::INTERACTIVE, gate());
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    auto bulk = pool.submit(HashingPriority::BULK, record("bulk"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    auto interactive = pool.submit(HashingPriority::INTERACTIVE, record("interactive"));
+    gateOpen = true;
+
+    blocked.get();
+    bulk.get();
+    interactive.get();
+    EXPECT_EQ(order, (std::vector<std::string>{"interactive", "bulk"}));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    pool.submit(HashingPriority::BULK, record("bulk")).get();
+    EXPECT_FALSE(pool.stats().bulkThrottled);
+}
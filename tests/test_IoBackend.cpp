@@ -0,0 +1,131 @@
+// tests/test_IoBackend.cpp
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fcntl.h>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "IoBackend.hpp"
+#include "IoUringBackend.hpp"
+#include "ThreadPoolIoBackend.hpp"
+
+static const std::string filePath = "./tests/files/io_backend_test.dat";
+
+// Обе реализации; io_uring — если ядро его поддерживает
+static std::vector<std::unique_ptr<IoBackendInterface>> backends()
+{
+    std::vector<std::unique_ptr<IoBackendInterface>> result;
+    std::unique_ptr<IoUringBackend> ring = std::make_unique<IoUringBackend>(16);
+    if (ring->available())
+    {
+        result.push_back(std::move(ring));
+    }
+    result.push_back(std::make_unique<ThreadPoolIoBackend>(3));
+    return result;
+}
+
+static void completeAll(IoBackendInterface &backend)
+{
+    backend.submit();
+    while (backend.inFlight() > 0)
+    {
+        backend.complete(true);
+        backend.submit();
+    }
+}
+
+// Пакет записей по смещениям и пакет чтений; операций больше, чем мест в кольце
+TEST(IoBackendTest, BatchedWritesAndReads)
+{
+    for (std::unique_ptr<IoBackendInterface> &backend : backends())
+    {
+        SCOPED_TRACE(backend->name());
+        int fd = open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        ASSERT_GE(fd, 0);
+
+        const size_t blocks = 100;
+        const size_t blockSize = 512;
+        std::vector<std::string> written;
+        for (size_t i = 0; i < blocks; ++i)
+        {
+            written.push_back(std::string(blockSize, static_cast<char>('a' + i % 26)));
+        }
+        size_t writes = 0;
+        for (size_t i = 0; i < blocks; ++i)
+        {
+            backend->write(fd, written[i].data(), blockSize, static_cast<off_t>(i * blockSize), [&writes](ssize_t result)
+                           { writes += result == static_cast<ssize_t>(blockSize); });
+        }
+        bool synced = false;
+        backend->fsync(fd, [&synced](ssize_t result)
+                       { synced = result == 0; });
+        EXPECT_EQ(backend->inFlight(), blocks + 1);
+        completeAll(*backend);
+        EXPECT_EQ(writes, blocks);
+        EXPECT_TRUE(synced);
+
+        std::vector<std::string> read(blocks, std::string(blockSize, '\0'));
+        size_t reads = 0;
+        for (size_t i = 0; i < blocks; ++i)
+        {
+            backend->read(fd, read[i].data(), blockSize, static_cast<off_t>(i * blockSize), [&reads](ssize_t result)
+                          { reads += result == static_cast<ssize_t>(blockSize); });
+        }
+        completeAll(*backend);
+        EXPECT_EQ(reads, blocks);
+        EXPECT_EQ(read, written);
+
+        // Ошибка возвращается как -errno
+        ssize_t badResult = 0;
+        char byte;
+        backend->read(-1, &byte, 1, 0, [&badResult](ssize_t result)
+                      { badResult = result; });
+        completeAll(*backend);
+        EXPECT_EQ(badResult, -EBADF);
+        close(fd);
+    }
+    std::remove(filePath.c_str());
+}
+
+// Дописывания в файл с O_APPEND завершаются до fsync, поставленного после них в том же пакете
+TEST(IoBackendTest, FsyncAfterAppends)
+{
+    for (std::unique_ptr<IoBackendInterface> &backend : backends())
+    {
+        SCOPED_TRACE(backend->name());
+        int fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0600);
+        ASSERT_GE(fd, 0);
+        std::vector<std::string> order;
+        std::string lines[3] = {"first\n", "second\n", "third\n"};
+        for (std::string &line : lines)
+        {
+            backend->write(fd, line.data(), line.size(), -1, [&order](ssize_t)
+                           { order.push_back("write"); });
+        }
+        backend->fsync(fd, [&order](ssize_t)
+                       { order.push_back("fsync"); });
+        completeAll(*backend);
+        close(fd);
+        EXPECT_EQ(order, std::vector<std::string>({"write", "write", "write", "fsync"}));
+
+        FILE *file = std::fopen(filePath.c_str(), "r");
+        ASSERT_NE(file, nullptr);
+        char buffer[64] = {};
+        size_t size = std::fread(buffer, 1, sizeof(buffer), file);
+        std::fclose(file);
+        EXPECT_EQ(size, 19u); // Все три строки, без перезаписи друг друга
+    }
+    std::remove(filePath.c_str());
+}
+
+// Без io_uring выбирается пул потоков
+TEST(IoBackendTest, FallsBackToThreads)
+{
+    std::unique_ptr<IoBackendInterface> fallback = IoBackend::create(false);
+    EXPECT_STREQ(fallback->name(), "threads");
+    std::unique_ptr<IoBackendInterface> best = IoBackend::create();
+    EXPECT_STREQ(best->name(), IoUringBackend(4).available() ? "io_uring" : "threads");
+}
@@ -0,0 +1,52 @@
+// tests/test_LoadShedder.cpp
+
+#include <gtest/gtest.h>
+
+#include "LoadShedder.hpp"
+
+// До первого замера запросы принимаются; затем — пока ожидаемая задержка не превышает предел
+TEST(LoadShedderTest, AdmitsUntilPredictedLatencyExceedsLimit)
+{
+    LoadShedder shedder(100, 2);
+    uint32_t retryAfterMs = 7;
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(shedder.admit(retryAfterMs));
+        EXPECT_EQ(retryAfterMs, 0u);
+        shedder.started();
+    }
+    EXPECT_EQ(shedder.predictedLatencyMicros(), 0u);
+
+    // Проверка 20 мс, два потока: 9 в очереди — 4 волны перед новым запросом
+    shedder.finished(20000);
+    EXPECT_EQ(shedder.depth(), 9u);
+    EXPECT_EQ(shedder.predictedLatencyMicros(), 100000u);
+    EXPECT_TRUE(shedder.admit(retryAfterMs));
+    shedder.started();
+
+    // 10 в очереди: 120 мс > 100 мс, повтор не раньше одной проверки
+    EXPECT_FALSE(shedder.admit(retryAfterMs));
+    EXPECT_EQ(retryAfterMs, 20u);
+    EXPECT_EQ(shedder.rejectedCount(), 1u);
+
+    // Скользящее среднее: новый замер входит с весом 1/8
+    shedder.finished(100000);
+    EXPECT_EQ(shedder.predictedLatencyMicros(), 5u * 30000u);
+    EXPECT_FALSE(shedder.admit(retryAfterMs));
+    EXPECT_EQ(retryAfterMs, 50u);
+}
+
+// Без предела запросы принимаются при любой очереди
+TEST(LoadShedderTest, DisabledWithoutLimit)
+{
+    LoadShedder shedder(0, 1);
+    shedder.started();
+    shedder.finished(1000000);
+    for (int i = 0; i < 100; ++i)
+    {
+        shedder.started();
+    }
+    uint32_t retryAfterMs;
+    EXPECT_TRUE(shedder.admit(retryAfterMs));
+    EXPECT_EQ(shedder.rejectedCount(), 0u);
+}
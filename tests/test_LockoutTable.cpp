@@ -0,0 +1,237 @@
+// tests/test_LockoutTable.cpp
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LockoutTable.hpp"
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+
+class LockoutTableTest : public ::testing::Test
+{
+protected:
+    std::string testLockoutPath = "./tests/files/lockout.dat";
+
+    void TearDown() override
+    {
+        std::remove(testLockoutPath.c_str());
+    }
+};
+
+// После maxFailures неудач подряд логин блокируется на lockoutSeconds
+TEST_F(LockoutTableTest, LocksAfterMaxFailures)
+{
+    LockoutTable table;
+    ASSERT_EQ(table.open(testLockoutPath, 64), ConfiguratorErrorCode::SUCCESS);
+
+    int64_t lockedUntil;
+    EXPECT_FALSE(table.recordFailure("user", 3, 60, 1000));
+    EXPECT_FALSE(table.recordFailure("user", 3, 60, 1001));
+    EXPECT_FALSE(table.isLocked("user", 1001, lockedUntil));
+    EXPECT_TRUE(table.recordFailure("user", 3, 60, 1002));
+    EXPECT_TRUE(table.isLocked("user", 1002, lockedUntil));
+    EXPECT_EQ(lockedUntil, 1062);
+    EXPECT_FALSE(table.isLocked("other", 1002, lockedUntil));
+
+    // Блокировка снимается по истечении срока
+    EXPECT_TRUE(table.isLocked("user", 1061, lockedUntil));
+    EXPECT_FALSE(table.isLocked("user", 1062, lockedUntil));
+}
+
+// Успешный вход и пауза дольше окна подсчета сбрасывают счетчик
+TEST_F(LockoutTableTest, CounterResets)
+{
+    LockoutTable table;
+    ASSERT_EQ(table.open(testLockoutPath, 64), ConfiguratorErrorCode::SUCCESS);
+
+    int64_t lockedUntil;
+    table.recordFailure("user", 3, 60, 1000);
+    table.recordFailure("user", 3, 60, 1001);
+    table.recordSuccess("user");
+    EXPECT_FALSE(table.recordFailure("user", 3, 60, 1002));
+
+    table.recordFailure("user", 3, 60, 1003);
+    EXPECT_FALSE(table.recordFailure("user", 3, 60, 1100));
+    EXPECT_FALSE(table.isLocked("user", 1100, lockedUntil));
+
+    // Нулевой срок блокировки отключает ее
+    for (int64_t now = 2000; now < 2010; ++now)
+    {
+        EXPECT_FALSE(table.recordFailure("nolock", 3, 0, now));
+    }
+}
+
+// Счетчики и блокировки сохраняются в файле
+TEST_F(LockoutTableTest, SurvivesReopen)
+{
+    {
+        LockoutTable table;
+        ASSERT_EQ(table.open(testLockoutPath, 64), ConfiguratorErrorCode::SUCCESS);
+        table.recordFailure("user", 2, 600, 1000);
+        table.recordFailure("user", 2, 600, 1001);
+        table.recordFailure("counted", 2, 600, 1001);
+    }
+
+    // Размер существующего файла сохраняется независимо от запрошенного
+    LockoutTable table;
+    ASSERT_EQ(table.open(testLockoutPath, 4096), ConfiguratorErrorCode::SUCCESS);
+    int64_t lockedUntil;
+    EXPECT_TRUE(table.isLocked("user", 1002, lockedUntil));
+    EXPECT_EQ(lockedUntil, 1601);
+    EXPECT_TRUE(table.recordFailure("counted", 2, 600, 1002));
+
+    // Файл другого формата создается заново
+    std::ofstream(testLockoutPath) << "garbage";
+    LockoutTable fresh;
+    ASSERT_EQ(fresh.open(testLockoutPath, 64), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_FALSE(fresh.isLocked("user", 1002, lockedUntil));
+}
+
+// Неудачи, учтенные из нескольких потоков, не теряются
+TEST_F(LockoutTableTest, ConcurrentFailuresAreCounted)
+{
+    LockoutTable table;
+    ASSERT_EQ(table.open(testLockoutPath, 1024), ConfiguratorErrorCode::SUCCESS);
+
+    const unsigned threads = 4;
+    const unsigned perThread = 250;
+    std::atomic<unsigned> locked{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&table, &locked]
+                             {
+                                 for (unsigned i = 0; i < perThread; ++i)
+                                 {
+                                     locked += table.recordFailure("user", threads * perThread, 60, 1000) ? 1 : 0;
+                                     table.recordFailure("user" + std::to_string(i), 1000, 60, 1000);
+                                 }
+                             });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    // Блокирует ровно последняя из threads * perThread попыток
+    EXPECT_EQ(locked.load(), 1u);
+    int64_t lockedUntil;
+    EXPECT_TRUE(table.isLocked("user", 1000, lockedUntil));
+    EXPECT_FALSE(table.isLocked("user0", 1000, lockedUntil));
+}
+
+// Переполненное окно поиска не пропускает неудачи: вытесняется запись с самой старой неудачей,
+// а если все записи заблокированы, новый логин тоже считается заблокированным
+TEST_F(LockoutTableTest, FullWindowNeverDropsFailures)
+{
+    LockoutTable table;
+    ASSERT_EQ(table.open(testLockoutPath, 64), ConfiguratorErrorCode::SUCCESS);
+
+    // Логинов больше, чем записей: каждое окно заполнено недавними неудачами
+    for (int i = 0; i < 256; ++i)
+    {
+        table.recordFailure("filler" + std::to_string(i), 3, 60, 1000);
+    }
+    int64_t lockedUntil;
+    EXPECT_FALSE(table.recordFailure("victim", 3, 60, 1001));
+    EXPECT_FALSE(table.recordFailure("victim", 3, 60, 1002));
+    EXPECT_TRUE(table.recordFailure("victim", 3, 60, 1003));
+    EXPECT_TRUE(table.isLocked("victim", 1003, lockedUntil));
+    EXPECT_EQ(lockedUntil, 1063);
+
+    // Все записи заблокированы: неудачу негде учесть, и логин считается заблокированным до ближайшего окончания
+    for (int i = 0; i < 256; ++i)
+    {
+        for (int64_t now = 1100; now < 1103; ++now)
+        {
+            table.recordFailure("locked" + std::to_string(i), 3, 60, now);
+        }
+    }
+    EXPECT_TRUE(table.isLocked("newcomer", 1103, lockedUntil));
+    EXPECT_GT(lockedUntil, 1103);
+    EXPECT_TRUE(table.recordFailure("newcomer", 3, 60, 1103));
+    EXPECT_FALSE(table.isLocked("newcomer", 1200, lockedUntil));
+}
+
+// Ключ хеша создается с файлом и сохраняется в нем: другой файл раскладывает логины иначе
+TEST_F(LockoutTableTest, HashKeyIsPerFile)
+{
+    std::string otherPath = testLockoutPath + ".other";
+    LockoutFileHeader first{};
+    LockoutFileHeader second{};
+    {
+        LockoutTable table;
+        ASSERT_EQ(table.open(testLockoutPath, 64), ConfiguratorErrorCode::SUCCESS);
+        LockoutTable other;
+        ASSERT_EQ(other.open(otherPath, 64), ConfiguratorErrorCode::SUCCESS);
+    }
+    std::ifstream(testLockoutPath, std::ios::binary).read(reinterpret_cast<char *>(&first), sizeof(first));
+    std::ifstream(otherPath, std::ios::binary).read(reinterpret_cast<char *>(&second), sizeof(second));
+    EXPECT_EQ(first.version, static_cast<uint32_t>(LockoutFileHeader::VERSION));
+    EXPECT_NE(std::string(reinterpret_cast<char *>(first.hashKey), sizeof(first.hashKey)),
+              std::string(reinterpret_cast<char *>(second.hashKey), sizeof(second.hashKey)));
+
+    // Повторное открытие сохраняет ключ
+    {
+        LockoutTable table;
+        ASSERT_EQ(table.open(testLockoutPath, 64), ConfiguratorErrorCode::SUCCESS);
+    }
+    LockoutFileHeader reopened{};
+    std::ifstream(testLockoutPath, std::ios::binary).read(reinterpret_cast<char *>(&reopened), sizeof(reopened));
+    EXPECT_EQ(std::string(reinterpret_cast<char *>(first.hashKey), sizeof(first.hashKey)),
+              std::string(reinterpret_cast<char *>(reopened.hashKey), sizeof(reopened.hashKey)));
+    std::remove(otherPath.c_str());
+}
+
+// Хеширование-заглушка, считающее вызовы проверки
+class CountingHashing : public HashingInterface
+{
+public:
+    unsigned verifies = 0;
+
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = "hash:" + password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        ++verifies;
+        return hashedPassword == "hash:" + password ? ConfiguratorErrorCode::SUCCESS
+                                                    : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+// Заблокированный логин отклоняется без вычисления хеша, даже с верным паролем
+TEST_F(LockoutTableTest, AuthenticatorSkipsHashingWhenLocked)
+{
+    std::string testConfigPath = "./tests/files/lockout_config.txt";
+    std::ofstream(testConfigPath) << "lockoutTimeMin 5\n"
+                                  << "maxFailedAttempts 2\n";
+    SecurityConfig config(testConfigPath);
+    ConfiguratorDatabase db("./tests/files/lockout_archive.txt", "./tests/files/lockout_active.txt", "./tests/files/lockout_tmp");
+    LockoutTable table;
+    ASSERT_EQ(table.open(testLockoutPath, 64), ConfiguratorErrorCode::SUCCESS);
+    CountingHashing hasher;
+    Authenticator authenticator(&db, &config, &hasher, &table);
+
+    UserData userData;
+    userData.login = "user";
+    userData.passwordHash = "hash:password";
+    EXPECT_EQ(authenticator.verifyPassword("wrong", userData), UserErrorCode::WRONG_PASSWORD);
+    EXPECT_EQ(authenticator.checkLockout("user"), UserErrorCode::SUCCESS);
+    EXPECT_EQ(authenticator.verifyPassword("wrong", userData), UserErrorCode::WRONG_PASSWORD);
+    EXPECT_EQ(authenticator.checkLockout("user"), UserErrorCode::ACCOUNT_LOCKED);
+    EXPECT_EQ(hasher.verifies, 2u);
+
+    EXPECT_EQ(authenticator.verifyPassword("password", userData), UserErrorCode::ACCOUNT_LOCKED);
+    EXPECT_EQ(hasher.verifies, 2u);
+
+    std::remove(testConfigPath.c_str());
+}
@@ -0,0 +1,139 @@
+// tests/test_PartitionedUserTable.cpp
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConfiguratorDatabase.hpp"
+#include "PartitionedUserTable.hpp"
+#include "SpscQueue.hpp"
+
+// Порядок FIFO, емкость округляется до степени двойки, заполненная очередь не принимает элемент
+TEST(SpscQueueTest, FifoAndCapacity)
+{
+    SpscQueue<std::string> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+    for (int i = 0; i < 4; ++i)
+    {
+        std::string value = "item" + std::to_string(i);
+        ASSERT_TRUE(queue.tryPush(value));
+    }
+    std::string extra = "extra";
+    EXPECT_FALSE(queue.tryPush(extra));
+    EXPECT_EQ(extra, "extra");
+
+    std::string value;
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, "item" + std::to_string(i));
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+// Передача между потоками через маленькую очередь без потерь и перестановок
+TEST(SpscQueueTest, TransfersBetweenThreadsInOrder)
+{
+    SpscQueue<unsigned> queue(8);
+    const unsigned count = 200000;
+    std::thread producer([&queue]
+                         {
+                             for (unsigned i = 0; i < count; ++i)
+                             {
+                                 unsigned value = i;
+                                 while (!queue.tryPush(value))
+                                 {
+                                     std::this_thread::yield();
+                                 }
+                             }
+                         });
+    unsigned expected = 0;
+    unsigned value;
+    while (expected < count)
+    {
+        if (queue.tryPop(value))
+        {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+// Каждое ядро ищет все логины: чужие — через раздел владельца, отсутствующий — LOGIN_NOT_FOUND
+TEST(PartitionedUserTableTest, RoutesLookupsToOwnerCores)
+{
+    std::string archivePath = "./tests/files/partitioned_archive.txt";
+    std::string activeUsersPath = "./tests/files/partitioned_active_users.txt";
+    std::string tmpPath = "./tests/files/partitioned_tmp";
+    const unsigned users = 100;
+    {
+        std::ofstream active(activeUsersPath);
+        for (unsigned i = 0; i < users; ++i)
+        {
+            active << "user" << i << " hash" << i << " 01.01.2020 1\n";
+        }
+        active << "user0 duplicate 01.01.2020 1\n";
+        std::ofstream(archivePath) << "";
+    }
+
+    ConfiguratorDatabase db(archivePath, activeUsersPath, tmpPath);
+    const size_t cores = 4;
+    PartitionedUserTable table(cores, 4); // Маленькие очереди: часть сообщений проходит через отложенные
+    ASSERT_EQ(table.load(db), ConfiguratorErrorCode::SUCCESS);
+
+    std::atomic<size_t> finished(0);
+    std::atomic<unsigned> failures(0);
+    std::vector<std::thread> threads;
+    for (size_t core = 0; core < cores; ++core)
+    {
+        threads.emplace_back([&, core]
+                             {
+                                 unsigned completed = 0;
+                                 for (unsigned i = 0; i <= users; ++i)
+                                 {
+                                     std::string login = "user" + std::to_string(i);
+                                     table.lookup(core, login, [&, i](ConfiguratorErrorCode code, const std::string *record)
+                                                  {
+                                                      ++completed;
+                                                      bool ok = i < users ? code == ConfiguratorErrorCode::SUCCESS && record != nullptr &&
+                                                                                *record == "user" + std::to_string(i) + " hash" + std::to_string(i) + " 01.01.2020 1"
+                                                                          : code == ConfiguratorErrorCode::LOGIN_NOT_FOUND && record == nullptr;
+                                                      if (!ok)
+                                                      {
+                                                          ++failures;
+                                                      }
+                                                  });
+                                     table.poll(core);
+                                 }
+                                 // Ядро продолжает отвечать другим, пока все не получат свои ответы
+                                 while (completed <= users)
+                                 {
+                                     table.poll(core);
+                                 }
+                                 ++finished;
+                                 while (finished < cores)
+                                 {
+                                     table.poll(core);
+                                 }
+                                 EXPECT_EQ(table.inFlight(core), 0u);
+                             });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(failures.load(), 0u);
+
+    std::remove(archivePath.c_str());
+    std::remove(activeUsersPath.c_str());
+    std::remove(tmpPath.c_str());
+}
@@ -0,0 +1,88 @@
+// tests/test_PasswordFingerprint.cpp
+
+#include <gtest/gtest.h>
+#include <fstream>
+
+#include "PasswordFingerprint.hpp"
+
+class PasswordFingerprintTest : public ::testing::Test
+{
+protected:
+    const std::string pepperPath = "./tests/files/test_pepper.key";
+
+    void TearDown() override
+    {
+        std::remove(pepperPath.c_str());
+    }
+};
+
+// Без перца отпечатки выключены
+TEST_F(PasswordFingerprintTest, DisabledWithoutPepper)
+{
+    PasswordFingerprint fingerprint;
+    std::string value;
+    EXPECT_FALSE(fingerprint.isEnabled());
+    EXPECT_EQ(fingerprint.loadPepper("./tests/files/nonexistent.key"), ConfiguratorErrorCode::DATABASE_ERROR);
+    EXPECT_FALSE(fingerprint.isEnabled());
+    EXPECT_EQ(fingerprint.compute("user", "password", value), ConfiguratorErrorCode::HASHING_ERROR);
+}
+
+// Некорректные файлы перца отклоняются
+TEST_F(PasswordFingerprintTest, InvalidPepperFile)
+{
+    PasswordFingerprint fingerprint;
+
+    std::ofstream(pepperPath) << std::string(63, 'a');
+    EXPECT_EQ(fingerprint.loadPepper(pepperPath), ConfiguratorErrorCode::DATABASE_ERROR);
+
+    std::ofstream(pepperPath) << std::string(63, 'a') << "z";
+    EXPECT_EQ(fingerprint.loadPepper(pepperPath), ConfiguratorErrorCode::DATABASE_ERROR);
+
+    std::ofstream(pepperPath) << std::string(64, 'a') << " extra";
+    EXPECT_EQ(fingerprint.loadPepper(pepperPath), ConfiguratorErrorCode::DATABASE_ERROR);
+    EXPECT_FALSE(fingerprint.isEnabled());
+}
+
+// Отпечаток — первые 4 байта HMAC-SHA256(перец, логин || 0x00 || пароль), зависит от перца и логина
+TEST_F(PasswordFingerprintTest, ComputeDependsOnPepperAndLogin)
+{
+    PasswordFingerprint fingerprint;
+    std::string first, second;
+
+    std::ofstream(pepperPath) << std::string(64, '0') << "\n";
+    ASSERT_EQ(fingerprint.loadPepper(pepperPath), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_TRUE(fingerprint.isEnabled());
+
+    ASSERT_EQ(fingerprint.compute("user", "password", first), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(first.size(), PasswordFingerprint::FINGERPRINT_BYTES * 2);
+    ASSERT_EQ(fingerprint.compute("user", "password", second), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(first, second);
+
+    ASSERT_EQ(fingerprint.compute("other", "password", second), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_NE(first, second);
+    ASSERT_EQ(fingerprint.compute("user", "password2", second), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_NE(first, second);
+
+    std::ofstream(pepperPath) << std::string(64, 'F');
+    ASSERT_EQ(fingerprint.loadPepper(pepperPath), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_EQ(fingerprint.compute("user", "password", second), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_NE(first, second);
+}
+
+// Формирование и разбор записей архива, в том числе старого формата без отпечатка
+TEST_F(PasswordFingerprintTest, AttachAndSplit)
+{
+    std::string hash, value;
+
+    std::string entry = PasswordFingerprint::attach("$argon2id$v=19$m=65536,t=2,p=1$c2FsdA$aGFzaA", "0a1b2c3d");
+    EXPECT_EQ(entry, "$argon2id$v=19$m=65536,t=2,p=1$c2FsdA$aGFzaA#0a1b2c3d");
+    PasswordFingerprint::split(entry, hash, value);
+    EXPECT_EQ(hash, "$argon2id$v=19$m=65536,t=2,p=1$c2FsdA$aGFzaA");
+    EXPECT_EQ(value, "0a1b2c3d");
+
+    PasswordFingerprint::split("$argon2id$v=19$m=65536,t=2,p=1$c2FsdA$aGFzaA", hash, value);
+    EXPECT_EQ(hash, "$argon2id$v=19$m=65536,t=2,p=1$c2FsdA$aGFzaA");
+    EXPECT_TRUE(value.empty());
+
+    EXPECT_EQ(PasswordFingerprint::attach("hash", ""), "hash");
+}
@@ -0,0 +1,211 @@
+// tests/test_ProcessHashing.cpp
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "ProcessHashing.hpp"
+
+// Хеширование-заглушка: хеш содержит pid процесса, пароль "crash" завершает процесс аварийно,
+// пароль "hang" оставляет его без ответа
+class CrashingHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        if (password == "crash")
+        {
+            std::abort();
+        }
+        if (password == "hang")
+        {
+            pause();
+        }
+        hashedPassword = "hash:" + password + ":" + std::to_string(getpid());
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        if (password == "crash")
+        {
+            std::abort();
+        }
+        return hashedPassword.rfind("hash:" + password + ":", 0) == 0 ? ConfiguratorErrorCode::SUCCESS
+                                                                       : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+class ProcessHashingTest : public ::testing::Test
+{
+protected:
+    CrashingHashing hasher;
+};
+
+// Операции выполняются в рабочих процессах, результат возвращается основному
+TEST_F(ProcessHashingTest, HashesInWorkerProcesses)
+{
+    ProcessHashingOptions options;
+    options.workers = 2;
+    options.pinWorkers = true;
+    ProcessHashing pool(&hasher, options);
+    ASSERT_EQ(pool.workerPids().size(), 2u);
+
+    std::string hashedPassword;
+    ASSERT_EQ(pool.pwHashMake("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(hashedPassword.rfind("hash:password:", 0), 0u);
+    EXPECT_NE(hashedPassword, "hash:password:" + std::to_string(getpid()));
+
+    EXPECT_EQ(pool.pwHashVerify("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(pool.pwHashVerify("wrong", hashedPassword), ConfiguratorErrorCode::PASSWORDS_DONT_MATCH);
+}
+
+// Падение рабочего процесса не затрагивает основной: процесс перезапускается, следующие запросы выполняются
+TEST_F(ProcessHashingTest, CrashedWorkerIsRestarted)
+{
+    ProcessHashingOptions options;
+    options.workers = 1;
+    ProcessHashing pool(&hasher, options);
+    std::vector<pid_t> before = pool.workerPids();
+    ASSERT_EQ(before.size(), 1u);
+
+    // Запрос роняет и исходный, и перезапущенный процесс
+    std::string hashedPassword;
+    EXPECT_EQ(pool.pwHashMake("crash", hashedPassword), ConfiguratorErrorCode::HASHING_ERROR);
+    EXPECT_EQ(pool.restartCount(), 2u);
+
+    std::vector<pid_t> after = pool.workerPids();
+    ASSERT_EQ(after.size(), 1u);
+    EXPECT_NE(after[0], before[0]);
+
+    ASSERT_EQ(pool.pwHashMake("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(pool.pwHashVerify("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+}
+
+// Процесс, завершенный извне (как при нехватке памяти), заменяется, запрос повторяется прозрачно
+TEST_F(ProcessHashingTest, KilledWorkerIsReplacedTransparently)
+{
+    ProcessHashingOptions options;
+    options.workers = 1;
+    ProcessHashing pool(&hasher, options);
+    std::vector<pid_t> before = pool.workerPids();
+    ASSERT_EQ(before.size(), 1u);
+
+    kill(before[0], SIGKILL);
+
+    std::string hashedPassword;
+    EXPECT_EQ(pool.pwHashMake("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(pool.restartCount(), 1u);
+}
+
+// Слишком длинный запрос отклоняется без обращения к процессам
+TEST_F(ProcessHashingTest, OversizedRequestRejected)
+{
+    ProcessHashingOptions options;
+    options.workers = 1;
+    ProcessHashing pool(&hasher, options);
+
+    std::string hashedPassword;
+    EXPECT_EQ(pool.pwHashMake(std::string(ProcessHashing::MAX_MESSAGE_BYTES, 'a'), hashedPassword),
+              ConfiguratorErrorCode::HASHING_ERROR);
+    EXPECT_EQ(pool.restartCount(), 0u);
+}
+
+// Зависший процесс завершается через timeoutMs без повтора запроса, пока другой процесс обслуживает вызовы
+TEST_F(ProcessHashingTest, HungWorkerIsKilledAfterTimeout)
+{
+    ProcessHashingOptions options;
+    options.workers = 2;
+    options.timeoutMs = 200;
+    ProcessHashing pool(&hasher, options);
+    std::vector<pid_t> before = pool.workerPids();
+    ASSERT_EQ(before.size(), 2u);
+
+    std::string hashedPassword;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(pool.pwHashMake("hang", hashedPassword), ConfiguratorErrorCode::HASHING_ERROR);
+    auto waited = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(waited, std::chrono::milliseconds(200));
+    EXPECT_LT(waited, std::chrono::seconds(5));
+    EXPECT_EQ(pool.restartCount(), 1u);
+
+    std::vector<pid_t> after = pool.workerPids();
+    ASSERT_EQ(after.size(), 2u);
+    int replaced = 0;
+    for (pid_t pid : before)
+    {
+        // Завершенный процесс уже дождан: сигнал его не находит
+        if (pid != after[0] && pid != after[1])
+        {
+            ++replaced;
+            EXPECT_NE(kill(pid, 0), 0);
+        }
+    }
+    EXPECT_EQ(replaced, 1);
+    ASSERT_EQ(pool.pwHashMake("password", hashedPassword), ConfiguratorErrorCode::SUCCESS);
+}
+
+// Рабочие процессы, в том числе перезапущенные, порождает не основной процесс: fork из многопоточного
+// приложения не выполняется, пока другие потоки продолжают вызовы
+TEST_F(ProcessHashingTest, WorkersAreRestartedByForker)
+{
+    ProcessHashingOptions options;
+    options.workers = 2;
+    ProcessHashing pool(&hasher, options);
+
+    // Родитель процесса — четвертое поле /proc/<pid>/stat
+    auto parentOf = [](pid_t pid)
+    {
+        std::ifstream stat("/proc/" + std::to_string(pid) + "/stat");
+        std::string pidField, name, state;
+        pid_t parent = -1;
+        stat >> pidField >> name >> state >> parent;
+        return parent;
+    };
+
+    std::atomic<bool> running(true);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 3; ++i)
+    {
+        callers.emplace_back([&]
+                             {
+                                 std::string hashedPassword;
+                                 while (running)
+                                 {
+                                     if (pool.pwHashMake("password", hashedPassword) != ConfiguratorErrorCode::SUCCESS)
+                                     {
+                                         ++failures;
+                                     }
+                                 } });
+    }
+    std::string hashedPassword;
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(pool.pwHashMake("crash", hashedPassword), ConfiguratorErrorCode::HASHING_ERROR);
+    }
+    running = false;
+    for (std::thread &caller : callers)
+    {
+        caller.join();
+    }
+    EXPECT_EQ(failures, 0);
+    EXPECT_GE(pool.restartCount(), 10u);
+
+    std::vector<pid_t> pids = pool.workerPids();
+    ASSERT_EQ(pids.size(), 2u);
+    for (pid_t pid : pids)
+    {
+        pid_t parent = parentOf(pid);
+        EXPECT_GT(parent, 0);
+        EXPECT_NE(parent, getpid());
+        EXPECT_EQ(parentOf(parent), getpid());
+    }
+}
@@ -0,0 +1,173 @@
+// tests/test_RateLimiter.cpp
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <csignal>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "RateLimiter.hpp"
+
+static RateLimiterOptions smallOptions()
+{
+    RateLimiterOptions options;
+    options.capacity = 64;
+    options.shards = 4;
+    options.login = {1, 3};
+    options.source = {10, 5};
+    return options;
+}
+
+// После исчерпания запаса попытки разрешаются со скоростью пополнения
+TEST(RateLimiterTest, BurstThenRefill)
+{
+    RateLimiter limiter(smallOptions());
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(limiter.allow(RateLimitKind::LOGIN, "user", 1000)) << i;
+    }
+    EXPECT_FALSE(limiter.allow(RateLimitKind::LOGIN, "user", 1000));
+    EXPECT_FALSE(limiter.allow(RateLimitKind::LOGIN, "user", 1500));
+
+    // Отклоненные попытки не списывают токены: к 2000 мс накоплен ровно один
+    EXPECT_TRUE(limiter.allow(RateLimitKind::LOGIN, "user", 2000));
+    EXPECT_FALSE(limiter.allow(RateLimitKind::LOGIN, "user", 2000));
+
+    // Запас не превышает емкости корзины
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_TRUE(limiter.allow(RateLimitKind::LOGIN, "user", 100000)) << i;
+    }
+    EXPECT_FALSE(limiter.allow(RateLimitKind::LOGIN, "user", 100000));
+}
+
+// Логины и источники с одинаковой строкой учитываются отдельно, каждый по своей политике
+TEST(RateLimiterTest, KeysAndKindsAreIndependent)
+{
+    RateLimiter limiter(smallOptions());
+    for (int i = 0; i < 3; ++i)
+    {
+        limiter.allow(RateLimitKind::LOGIN, "alice", 0);
+    }
+    EXPECT_FALSE(limiter.allow(RateLimitKind::LOGIN, "alice", 0));
+    EXPECT_TRUE(limiter.allow(RateLimitKind::LOGIN, "bob", 0));
+
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_TRUE(limiter.allow(RateLimitKind::SOURCE, "alice", 0)) << i;
+    }
+    EXPECT_FALSE(limiter.allow(RateLimitKind::SOURCE, "alice", 0));
+    EXPECT_TRUE(limiter.allow(RateLimitKind::SOURCE, "alice", 100));
+
+    RateLimiterOptions unlimited = smallOptions();
+    unlimited.login.perSecond = 0;
+    RateLimiter open(unlimited);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(open.allow(RateLimitKind::LOGIN, "alice", 0));
+    }
+}
+
+// При переполнении таблицы вытесняются давно не использованные корзины, а активные сохраняются
+TEST(RateLimiterTest, EvictsLeastRecentlyUsed)
+{
+    RateLimiterOptions options = smallOptions();
+    options.login = {0.0001, 3};
+    RateLimiter limiter(options);
+    for (int i = 0; i < 3; ++i)
+    {
+        limiter.allow(RateLimitKind::LOGIN, "abuser", 0);
+    }
+
+    // Тысячи других ключей, а ключ abuser продолжает обращаться и остается в таблице
+    for (int i = 0; i < 5000; ++i)
+    {
+        limiter.allow(RateLimitKind::LOGIN, "key" + std::to_string(i), i);
+        if (i % 2 == 0)
+        {
+            EXPECT_FALSE(limiter.allow(RateLimitKind::LOGIN, "abuser", i)) << i;
+        }
+    }
+
+    // Без обращений корзина вытесняется и при следующем обращении начинается полной
+    for (int i = 0; i < 5000; ++i)
+    {
+        limiter.allow(RateLimitKind::LOGIN, "other" + std::to_string(i), 5000 + i);
+    }
+    EXPECT_TRUE(limiter.allow(RateLimitKind::LOGIN, "abuser", 10000));
+}
+
+// Ограничитель в разделяемой памяти, созданный до fork, списывает попытки всех процессов из одной корзины
+TEST(RateLimiterTest, SharedAcrossFork)
+{
+    RateLimiterOptions options = smallOptions();
+    options.shared = true;
+    RateLimiter limiter(options);
+    EXPECT_TRUE(limiter.allow(RateLimitKind::LOGIN, "user", 1000));
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        bool ok = limiter.allow(RateLimitKind::LOGIN, "user", 1000) && limiter.allow(RateLimitKind::LOGIN, "user", 1000);
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    EXPECT_FALSE(limiter.allow(RateLimitKind::LOGIN, "user", 1000));
+}
+
+// Процесс, убитый во время списания, не оставляет сегмент занятым: остальные процессы продолжают работу
+TEST(RateLimiterTest, SharedSurvivesKilledProcess)
+{
+    RateLimiterOptions options = smallOptions();
+    options.shared = true;
+    options.login = {1000000, 1000000};
+    RateLimiter limiter(options);
+
+    // Убийство в случайный момент цикла часто приходится на захваченную блокировку
+    for (int round = 0; round < 20; ++round)
+    {
+        pid_t busy = fork();
+        ASSERT_GE(busy, 0);
+        if (busy == 0)
+        {
+            for (;;)
+            {
+                limiter.allow(RateLimitKind::LOGIN, "user", 1000);
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2 + round % 5));
+        kill(busy, SIGKILL);
+        ASSERT_EQ(waitpid(busy, nullptr, 0), busy);
+
+        // Проверка в отдельном процессе: зависший вызов не останавливает тест. Запас, израсходованный
+        // убитым процессом, к этому моменту пополнен
+        pid_t checker = fork();
+        ASSERT_GE(checker, 0);
+        if (checker == 0)
+        {
+            _exit(limiter.allow(RateLimitKind::LOGIN, "user", 2000 + round) ? 0 : 1);
+        }
+        int status = 0;
+        pid_t done = 0;
+        for (int waited = 0; waited < 2000 && done == 0; ++waited)
+        {
+            done = waitpid(checker, &status, WNOHANG);
+            if (done == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        if (done == 0)
+        {
+            kill(checker, SIGKILL);
+            waitpid(checker, nullptr, 0);
+            FAIL() << "allow blocked after a process was killed in round " << round;
+        }
+        EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+}
@@ -0,0 +1,208 @@
+// tests/test_RequestArena.cpp
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "RequestArena.hpp"
+#include "SecurityConfig.hpp"
+
+// Счетчик обращений к общей куче во всем процессе; считаются только вызовы при включенном счете
+static std::atomic<bool> countingAllocations(false);
+static std::atomic<size_t> allocationCount(0);
+
+static void *allocate(size_t size, size_t alignment)
+{
+    if (countingAllocations.load(std::memory_order_relaxed))
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    size = size == 0 ? 1 : size;
+    void *memory = alignment <= alignof(std::max_align_t) ? std::malloc(size)
+                                                          : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void *operator new(size_t size)
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t, std::align_val_t) noexcept
+{
+    std::free(memory);
+}
+
+// Хеширование-заглушка, которое само не выделяет память
+class ComparingHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = "hash:" + password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return hashedPassword.size() == password.size() + 5 && hashedPassword.compare(0, 5, "hash:") == 0 &&
+                       hashedPassword.compare(5, std::string::npos, password) == 0
+                   ? ConfiguratorErrorCode::SUCCESS
+                   : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+class RequestArenaTest : public ::testing::Test
+{
+protected:
+    std::string testArchivePath = "./tests/files/arena_archive.txt";
+    std::string testActiveUsersPath = "./tests/files/arena_active_users.txt";
+    std::string testTmpPath = "./tests/files/arena_tmp";
+    std::string testConfigPath = "./tests/files/arena_config.txt";
+    static const int USERS = 2000;
+
+    ComparingHashing hasher;
+    ConfiguratorDatabase *db;
+    SecurityConfig *config;
+    Authenticator *authenticator;
+
+    void SetUp() override
+    {
+        // Таблица больше блока чтения: строки пересекают границы блоков, последняя строка без перевода строки
+        std::ofstream activeUsers(testActiveUsersPath);
+        for (int i = 0; i < USERS; ++i)
+        {
+            activeUsers << "user" << i << " hash:password" << i << " 01.01.2000 1,2\n";
+        }
+        activeUsers.close();
+        std::ofstream(testArchivePath) << "";
+        std::ofstream(testConfigPath) << "maxFailedAttempts 3\n"
+                                      << "passwordExpirationDays 30\n";
+
+        db = new ConfiguratorDatabase(testArchivePath, testActiveUsersPath, testTmpPath);
+        ASSERT_EQ(db->addUser("fresh", "hash:password", {UserRole::ROLE1}), ConfiguratorErrorCode::SUCCESS);
+        std::ofstream(testActiveUsersPath, std::ios::app) << "last hash:password 01.01.2000 1";
+        config = new SecurityConfig(testConfigPath);
+        authenticator = new Authenticator(db, config, &hasher);
+    }
+
+    void TearDown() override
+    {
+        delete authenticator;
+        delete config;
+        delete db;
+        std::remove(testArchivePath.c_str());
+        std::remove(testActiveUsersPath.c_str());
+        std::remove(testTmpPath.c_str());
+        std::remove(testConfigPath.c_str());
+    }
+
+    // Вход целиком: поиск, пароль, срок действия; возвращает число обращений к куче за rounds входов
+    size_t countLoginAllocations(const std::string &password, unsigned rounds)
+    {
+        RequestArena arena;
+        UserData userData;
+        const std::string logins[] = {"fresh", "user1500", "nobody"};
+
+        // Первые запросы заполняют пул арены и емкость полей userData
+        for (int warmUp = 0; warmUp < 2; ++warmUp)
+        {
+            for (const std::string &login : logins)
+            {
+                if (authenticator->findUser(login, userData, arena.resource()) == UserErrorCode::SUCCESS &&
+                    authenticator->verifyPassword(password, userData) == UserErrorCode::SUCCESS)
+                {
+                    authenticator->checkPasswordExpiration(userData);
+                }
+                arena.reset();
+            }
+        }
+
+        allocationCount = 0;
+        countingAllocations = true;
+        unsigned successes = 0;
+        for (unsigned i = 0; i < rounds; ++i)
+        {
+            for (const std::string &login : logins)
+            {
+                if (authenticator->findUser(login, userData, arena.resource()) == UserErrorCode::SUCCESS &&
+                    authenticator->verifyPassword(password, userData) == UserErrorCode::SUCCESS &&
+                    authenticator->checkPasswordExpiration(userData) == UserErrorCode::SUCCESS)
+                {
+                    ++successes;
+                }
+                arena.reset();
+            }
+        }
+        countingAllocations = false;
+        EXPECT_EQ(successes, password == "password" ? rounds : 0u);
+        return allocationCount;
+    }
+};
+
+// Поиск по индексу в памяти с проверкой пароля и срока не обращается к куче
+TEST_F(RequestArenaTest, IndexedLoginAllocatesNothing)
+{
+    db->enableActiveUsersIndex();
+    EXPECT_EQ(countLoginAllocations("password", 200), 0u);
+    EXPECT_EQ(countLoginAllocations("wrong password", 200), 0u);
+}
+
+// Поиск чтением файла таблицы тоже не обращается к куче
+TEST_F(RequestArenaTest, FileScanAllocatesNothing)
+{
+    EXPECT_EQ(countLoginAllocations("password", 20), 0u);
+}
+
+// Поиск в арене возвращает те же строки, что и поиск через std::string
+TEST_F(RequestArenaTest, RecordMatchesStringLookup)
+{
+    RequestArena arena;
+    const std::string logins[] = {"user0", "user1", "user777", "user1999", "last", "fresh", "nobody", "user"};
+    for (const std::string &login : logins)
+    {
+        std::string expected;
+        ConfiguratorErrorCode expectedCode = db->getActiveUserByLogin(login, expected);
+        std::pmr::string record(arena.resource());
+        EXPECT_EQ(db->getActiveUserRecord(login, record), expectedCode) << login;
+        EXPECT_EQ(std::string(record), expected) << login;
+    }
+
+    UserData userData;
+    ASSERT_EQ(authenticator->findUser("user42", userData, arena.resource()), UserErrorCode::SUCCESS);
+    EXPECT_EQ(userData.login, "user42");
+    EXPECT_EQ(userData.passwordHash, "hash:password42");
+    EXPECT_EQ(userData.date, "01.01.2000");
+    EXPECT_EQ(userData.roles.size(), 2u);
+    EXPECT_EQ(authenticator->checkPasswordExpiration(userData), UserErrorCode::PASSWORD_HAS_EXPIRED);
+}
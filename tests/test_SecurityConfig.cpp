@@ -1,8 +1,12 @@
 // tests/test_SecurityConfig
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 #include "SecurityConfig.hpp"
 //#include "configurator.hpp"
@@ -106,20 +110,294 @@ TEST_F(SecurityConfigTest, SetValueAndReload) {
     EXPECT_EQ(val, passwordHistoryDepth);
 }
 
-// Попытка получить конфигурационный параметр из пустого файла
+// Несколько параметров применяются одной записью, незаданные параметры не меняются
+TEST_F(SecurityConfigTest, ApplyChangesAndReload)
+{
+    SecurityConfigChanges changes;
+    changes.set(SecurityParam::MIN_PASSWORD_LENGTH, 12);
+    changes.set(SecurityParam::MAX_FAILED_ATTEMPTS, 7);
+    changes.set(SecurityParam::LOCKOUT_TIME_MIN, 45);
+    EXPECT_EQ(config->applyChanges(changes), ConfiguratorErrorCode::SUCCESS);
+
+    // Временный файл не остается после записи
+    EXPECT_FALSE(std::filesystem::exists(testConfigPath + ".tmp"));
+
+    SecurityConfig configReload(testConfigPath);
+    unsigned val;
+
+    EXPECT_EQ(configReload.get_minPasswordLength(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 12u);
+    EXPECT_EQ(configReload.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 7u);
+    EXPECT_EQ(configReload.get_lockoutTimeMin(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 45u);
+
+    EXPECT_EQ(configReload.get_passwordHistoryDepth(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, passwordHistoryDepth);
+    EXPECT_EQ(configReload.get_passwordExpirationDays(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, passwordExpirationDays);
+    EXPECT_EQ(configReload.get_maxInactiveTimeMin(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, maxInactiveTimeMin);
+}
+
+// Запись заменяет файл целиком (новый inode), поэтому открытый читателем файл остается прежним
+TEST_F(SecurityConfigTest, ApplyChangesReplacesFileAtomically)
+{
+    std::ifstream reader(testConfigPath);
+    ASSERT_TRUE(reader.is_open());
+
+    SecurityConfigChanges changes;
+    changes.set(SecurityParam::MIN_PASSWORD_LENGTH, 99);
+    EXPECT_EQ(config->applyChanges(changes), ConfiguratorErrorCode::SUCCESS);
+
+    // Ранее открытый файл содержит прежние значения целиком
+    std::string key;
+    unsigned value;
+    unsigned lines = 0;
+    while (reader >> key >> value)
+    {
+        ++lines;
+        if (key == "minPasswordLength")
+        {
+            EXPECT_EQ(value, minPasswordLength);
+        }
+    }
+    EXPECT_EQ(lines, 6u);
+}
+
+// При ошибке записи изменения не применяются и в памяти
+TEST_F(SecurityConfigTest, ApplyChangesFailureKeepsOldValues)
+{
+    SecurityConfig badConfig("./tests/files/missing_dir/config.txt");
+
+    SecurityConfigChanges changes;
+    changes.set(SecurityParam::MIN_PASSWORD_LENGTH, 15);
+    EXPECT_EQ(badConfig.applyChanges(changes), ConfiguratorErrorCode::DATABASE_ERROR);
+
+    unsigned val;
+    EXPECT_EQ(badConfig.get_minPasswordLength(val), ConfiguratorErrorCode::DATABASE_ERROR);
+}
+
+// Значение вне диапазона из схемы отклоняется, файл и текущие значения не меняются
+TEST_F(SecurityConfigTest, OutOfRangeValueRejected)
+{
+    EXPECT_EQ(config->set_maxFailedAttempts(0), ConfiguratorErrorCode::CONFIG_VALUE_OUT_OF_RANGE);
+
+    SecurityConfigChanges changes;
+    changes.set(SecurityParam::LOCKOUT_TIME_MIN, 60);
+    changes.set(SecurityParam::MIN_PASSWORD_LENGTH, securityParamInfo(SecurityParam::MIN_PASSWORD_LENGTH).maxValue + 1);
+    EXPECT_EQ(config->applyChanges(changes), ConfiguratorErrorCode::CONFIG_VALUE_OUT_OF_RANGE);
+
+    SecurityConfig configReload(testConfigPath);
+    unsigned val;
+    EXPECT_EQ(configReload.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, maxFailedAttempts);
+    EXPECT_EQ(config->get_lockoutTimeMin(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, lockoutTimeMin);
+}
+
+// Значение вне диапазона в файле не загружается, перезагрузка такого файла отклоняется
+TEST_F(SecurityConfigTest, OutOfRangeValueInFile)
+{
+    std::ofstream(testConfigPath) << "maxFailedAttempts 0\n"
+                                  << "lockoutTimeMin 15\n";
+
+    SecurityConfig loaded(testConfigPath);
+    unsigned val;
+    EXPECT_EQ(loaded.get_maxFailedAttempts(val), ConfiguratorErrorCode::DATABASE_ERROR);
+    EXPECT_EQ(loaded.get_lockoutTimeMin(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 15u);
+
+    EXPECT_EQ(config->reload(), ConfiguratorErrorCode::CONFIG_VALUE_OUT_OF_RANGE);
+    EXPECT_EQ(config->get_lockoutTimeMin(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, lockoutTimeMin);
+}
+
+// Ключи вне схемы сохраняются при записи
+TEST_F(SecurityConfigTest, UnknownKeysPreserved)
+{
+    std::ofstream(testConfigPath, std::ios::app) << "futureSetting 42\n";
+    ASSERT_EQ(config->reload(), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_EQ(config->set_minPasswordLength(10), ConfiguratorErrorCode::SUCCESS);
+
+    std::ifstream file(testConfigPath);
+    std::string key;
+    unsigned value;
+    bool found = false;
+    while (file >> key >> value)
+    {
+        found = found || (key == "futureSetting" && value == 42);
+    }
+    EXPECT_TRUE(found);
+}
+
+// Поиск параметров схемы по ключу
+TEST(SecurityConfigSchemaTest, FindByKey)
+{
+    static_assert(securityParamInfo(SecurityParam::MAX_FAILED_ATTEMPTS).defaultValue == 5);
+
+    SecurityParam param;
+    EXPECT_TRUE(findSecurityParam("lockoutTimeMin", param));
+    EXPECT_EQ(param, SecurityParam::LOCKOUT_TIME_MIN);
+    EXPECT_FALSE(findSecurityParam("lockoutTime", param));
+}
+
+// Ожидание публикации снимка с номером больше previous
+static bool waitForGeneration(const SecurityConfig &config, unsigned long previous)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (config.snapshotGeneration() <= previous)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// Изменение файла другим процессом (конфигуратором) подхватывается без перезапуска
+TEST_F(SecurityConfigTest, WatchPicksUpExternalChange)
+{
+    ASSERT_EQ(config->watch(), ConfiguratorErrorCode::SUCCESS);
+    unsigned long before = config->snapshotGeneration();
+
+    // Запись через rename, как у конфигуратора
+    SecurityConfig writer(testConfigPath);
+    EXPECT_EQ(writer.set_maxFailedAttempts(9), ConfiguratorErrorCode::SUCCESS);
+    ASSERT_TRUE(waitForGeneration(*config, before));
+
+    unsigned val;
+    EXPECT_EQ(config->get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 9u);
+
+    // Запись поверх существующего файла
+    before = config->snapshotGeneration();
+    std::ofstream(testConfigPath) << "maxFailedAttempts 11\n"
+                                  << "lockoutTimeMin " << lockoutTimeMin << "\n";
+    ASSERT_TRUE(waitForGeneration(*config, before));
+
+    EXPECT_EQ(config->get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 11u);
+    EXPECT_EQ(config->get_minPasswordLength(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, securityParamInfo(SecurityParam::MIN_PASSWORD_LENGTH).defaultValue);
+}
+
+// Некорректный файл не заменяет текущий снимок
+TEST_F(SecurityConfigTest, ReloadInvalidFileKeepsSnapshot)
+{
+    unsigned long before = config->snapshotGeneration();
+    std::ofstream(testConfigPath) << "minPasswordLength not_a_number\n";
+
+    EXPECT_EQ(config->reload(), ConfiguratorErrorCode::DATABASE_ERROR);
+    EXPECT_EQ(config->snapshotGeneration(), before);
+
+    unsigned val;
+    EXPECT_EQ(config->get_minPasswordLength(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, minPasswordLength);
+}
+
+// Перезагрузка без изменений не публикует новый снимок
+TEST_F(SecurityConfigTest, ReloadUnchangedFileKeepsGeneration)
+{
+    unsigned long before = config->snapshotGeneration();
+    EXPECT_EQ(config->reload(), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(config->snapshotGeneration(), before);
+}
+
+// Читатели во время записи всегда получают одно из записанных значений
+TEST_F(SecurityConfigTest, ConcurrentReadersDuringUpdates)
+{
+    std::atomic<bool> stop(false);
+    std::atomic<unsigned> errors(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([this, &stop, &errors]
+                             {
+                                 unsigned val;
+                                 while (!stop.load())
+                                 {
+                                     if (config->get_maxFailedAttempts(val) != ConfiguratorErrorCode::SUCCESS ||
+                                         (val != maxFailedAttempts && val != 100 && val != 200))
+                                     {
+                                         ++errors;
+                                     }
+                                 }
+                             });
+    }
+
+    for (unsigned i = 0; i < 50; ++i)
+    {
+        EXPECT_EQ(config->set_maxFailedAttempts(i % 2 == 0 ? 100 : 200), ConfiguratorErrorCode::SUCCESS);
+    }
+    stop.store(true);
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(errors.load(), 0u);
+}
+
+// Снимок, сохраненный потоком между вызовами, принадлежит своему объекту: чтение другого объекта
+// или объекта, созданного на месте уничтоженного, видит его собственные значения
+TEST_F(SecurityConfigTest, ThreadSnapshotBelongsToInstance)
+{
+    std::string otherPath = "./tests/files/config_other.txt";
+    std::ofstream(otherPath) << "maxFailedAttempts 7\n";
+    unsigned val;
+    {
+        SecurityConfig other(otherPath);
+        for (int i = 0; i < 2; ++i)
+        {
+            ASSERT_EQ(config->get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+            EXPECT_EQ(val, maxFailedAttempts);
+            ASSERT_EQ(other.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+            EXPECT_EQ(val, 7u);
+        }
+    }
+
+    // Новый объект с тем же номером снимка на месте старого
+    delete config;
+    std::ofstream(testConfigPath) << "maxFailedAttempts 9\n";
+    config = new SecurityConfig(testConfigPath);
+    ASSERT_EQ(config->get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 9u);
+    std::remove(otherPath.c_str());
+}
+
+// Параметры пустого файла имеют значения по умолчанию из схемы
 TEST_F(SecurityConfigTest, LoadFromEmptyFile)
 {
     std::ofstream(testConfigPath) << "";
 
     SecurityConfig emptyConfig(testConfigPath);
 
-    unsigned val;
-    EXPECT_NE(emptyConfig.get_minPasswordLength(val), ConfiguratorErrorCode::SUCCESS);
-    EXPECT_NE(emptyConfig.get_lockoutTimeMin(val), ConfiguratorErrorCode::SUCCESS);
-    EXPECT_NE(emptyConfig.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
-    EXPECT_NE(emptyConfig.get_maxInactiveTimeMin(val), ConfiguratorErrorCode::SUCCESS);
-    EXPECT_NE(emptyConfig.get_passwordHistoryDepth(val), ConfiguratorErrorCode::SUCCESS);
-    EXPECT_NE(emptyConfig.get_passwordExpirationDays(val), ConfiguratorErrorCode::SUCCESS);
+    for (const SecurityParamInfo &info : securitySchema)
+    {
+        unsigned val = 0;
+        EXPECT_EQ(emptyConfig.get(info.param, val), ConfiguratorErrorCode::SUCCESS) << info.key;
+        EXPECT_EQ(val, info.defaultValue) << info.key;
+    }
+}
+
+// Параметр, которого нет в файле, имеет значение по умолчанию; отклоненное значение в файле — нет
+TEST_F(SecurityConfigTest, MissingKeyUsesSchemaDefault)
+{
+    std::ofstream(testConfigPath) << "maxFailedAttempts 0\n"
+                                  << "lockoutTimeMin 15\n";
+
+    SecurityConfig loaded(testConfigPath);
+    unsigned val = 0;
+    EXPECT_EQ(loaded.get_passwordHistoryDepth(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, securityParamInfo(SecurityParam::PASSWORD_HISTORY_DEPTH).defaultValue);
+    EXPECT_EQ(loaded.get_maxFailedAttempts(val), ConfiguratorErrorCode::DATABASE_ERROR);
+
+    // Запись файла заменяет отклоненное значение: в файле параметра больше нет
+    ASSERT_EQ(loaded.set_lockoutTimeMin(20), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(loaded.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, securityParamInfo(SecurityParam::MAX_FAILED_ATTEMPTS).defaultValue);
 }
 
 // Обращение к несуществующему файлу должно вызывать ошибку
@@ -0,0 +1,103 @@
+// tests/test_SessionManager.cpp
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "SessionManager.hpp"
+
+// Токен проверяется и продлевает сессию; бездействие дольше допустимого завершает ее
+TEST(SessionManagerTest, IdleExpiry)
+{
+    SessionManager sessions(1000);
+    std::string token = sessions.create("user", 60, 1000);
+    ASSERT_EQ(token.size(), SessionManager::TOKEN_BYTES);
+    EXPECT_EQ(sessions.size(), 1u);
+
+    std::string login;
+    sessions.advance(1030);
+    ASSERT_TRUE(sessions.validate(token, 1030, login));
+    EXPECT_EQ(login, "user");
+
+    // Обращение в 1030 переносит срок на 1090
+    sessions.advance(1089);
+    EXPECT_EQ(sessions.size(), 1u);
+    EXPECT_TRUE(sessions.validate(token, 1089, login));
+    sessions.advance(1148);
+    EXPECT_EQ(sessions.size(), 1u);
+    sessions.advance(1149);
+    EXPECT_EQ(sessions.size(), 0u);
+    EXPECT_FALSE(sessions.validate(token, 1149, login));
+}
+
+// Сессия, истекшая между шагами колеса, не принимается
+TEST(SessionManagerTest, ExpiredBeforeAdvance)
+{
+    SessionManager sessions(0);
+    std::string token = sessions.create("user", 10, 0);
+    std::string login;
+    EXPECT_FALSE(sessions.validate(token, 10, login));
+    EXPECT_EQ(sessions.size(), 0u);
+    EXPECT_FALSE(sessions.validate(std::string(SessionManager::TOKEN_BYTES, 'x'), 0, login));
+    EXPECT_FALSE(sessions.validate("short", 0, login));
+}
+
+// Сроки на старших уровнях колеса соблюдаются с точностью до секунды
+TEST(SessionManagerTest, LongIdleCascadesThroughLevels)
+{
+    const int64_t start = 123457;
+    SessionManager sessions(start);
+    std::vector<int64_t> idle = {1, 63, 64, 65, 4095, 4096, 4097, 300000, 40000000};
+    std::vector<std::string> tokens;
+    for (int64_t seconds : idle)
+    {
+        tokens.push_back(sessions.create("user" + std::to_string(seconds), seconds, start));
+    }
+
+    std::string login;
+    for (size_t i = 0; i < idle.size(); ++i)
+    {
+        sessions.advance(start + idle[i] - 1);
+        EXPECT_EQ(sessions.size(), idle.size() - i) << "idle " << idle[i];
+        sessions.advance(start + idle[i]);
+        EXPECT_EQ(sessions.size(), idle.size() - i - 1) << "idle " << idle[i];
+    }
+}
+
+// Число сессий ограничено, освобожденные записи используются снова
+TEST(SessionManagerTest, LimitAndRevoke)
+{
+    SessionManager sessions(0, 2);
+    std::string first = sessions.create("a", 60, 0);
+    std::string second = sessions.create("b", 60, 0);
+    EXPECT_TRUE(sessions.create("c", 60, 0).empty());
+    EXPECT_TRUE(sessions.create("d", 0, 0).empty());
+    EXPECT_NE(first, second);
+
+    EXPECT_TRUE(sessions.revoke(first));
+    EXPECT_FALSE(sessions.revoke(first));
+    std::string login;
+    EXPECT_FALSE(sessions.validate(first, 1, login));
+    std::string third = sessions.create("c", 60, 1);
+    ASSERT_FALSE(third.empty());
+    EXPECT_TRUE(sessions.validate(third, 2, login));
+    EXPECT_EQ(login, "c");
+
+    sessions.advance(100);
+    EXPECT_EQ(sessions.size(), 0u);
+}
+
+// Шестнадцатеричная запись токена обратима
+TEST(SessionManagerTest, HexRoundTrip)
+{
+    SessionManager sessions(0);
+    std::string token = sessions.create("user", 60, 0);
+    std::string hex = SessionManager::tokenToHex(token);
+    EXPECT_EQ(hex.size(), 2 * SessionManager::TOKEN_BYTES);
+
+    std::string decoded;
+    ASSERT_TRUE(SessionManager::tokenFromHex(hex, decoded));
+    EXPECT_EQ(decoded, token);
+    EXPECT_FALSE(SessionManager::tokenFromHex(hex.substr(1), decoded));
+    EXPECT_FALSE(SessionManager::tokenFromHex(std::string(2 * SessionManager::TOKEN_BYTES, 'g'), decoded));
+}
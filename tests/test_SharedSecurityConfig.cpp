@@ -0,0 +1,201 @@
+// tests/test_SharedSecurityConfig.cpp
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "SecurityConfig.hpp"
+#include "SharedSecurityConfig.hpp"
+
+class SharedSecurityConfigTest : public ::testing::Test
+{
+protected:
+    std::string testConfigPath = "./tests/files/shared_config.txt";
+    std::string segmentName = "/authentication_system_test_" + std::to_string(getpid());
+
+    void SetUp() override
+    {
+        std::ofstream(testConfigPath) << "lockoutTimeMin 30\n"
+                                      << "maxFailedAttempts 5\n"
+                                      << "minPasswordLength 8\n";
+    }
+
+    void TearDown() override
+    {
+        shm_unlink(segmentName.c_str());
+        std::remove(testConfigPath.c_str());
+    }
+};
+
+// Политика, опубликованная конфигуратором, читается другим экземпляром без файла
+TEST_F(SharedSecurityConfigTest, PublishedPolicyIsReadable)
+{
+    SecurityConfig writer(testConfigPath);
+    ASSERT_EQ(writer.shareVia(segmentName), ConfiguratorErrorCode::SUCCESS);
+
+    SharedSecurityConfig reader;
+    ASSERT_EQ(reader.attach(segmentName, testConfigPath), ConfiguratorErrorCode::SUCCESS);
+
+    unsigned val;
+    EXPECT_EQ(reader.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 5u);
+    // Параметра нет в файле: читатель получает значение по умолчанию
+    EXPECT_EQ(reader.get_passwordHistoryDepth(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, securityParamInfo(SecurityParam::PASSWORD_HISTORY_DEPTH).defaultValue);
+
+    // Изменение видно сразу подключенным читателям
+    ASSERT_EQ(writer.set_maxFailedAttempts(7), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(reader.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 7u);
+
+    // Сегмент только для чтения
+    SecurityConfigChanges changes;
+    changes.set(SecurityParam::MAX_FAILED_ATTEMPTS, 3);
+    EXPECT_EQ(reader.applyChanges(changes), ConfiguratorErrorCode::DATABASE_ERROR);
+}
+
+// Без сегмента подключение не удается, и приложение читает файл
+TEST_F(SharedSecurityConfigTest, AttachFailsWithoutSegment)
+{
+    SharedSecurityConfig reader;
+    EXPECT_EQ(reader.attach(segmentName, testConfigPath), ConfiguratorErrorCode::DATABASE_ERROR);
+
+    unsigned val;
+    EXPECT_EQ(reader.get_maxFailedAttempts(val), ConfiguratorErrorCode::DATABASE_ERROR);
+}
+
+// Файл, измененный в обход конфигуратора, делает сегмент устаревшим
+TEST_F(SharedSecurityConfigTest, AttachFailsWhenFileChangedBehindWriter)
+{
+    {
+        SecurityConfig writer(testConfigPath);
+        ASSERT_EQ(writer.shareVia(segmentName), ConfiguratorErrorCode::SUCCESS);
+    }
+
+    std::ofstream(testConfigPath) << "lockoutTimeMin 30\n"
+                                  << "maxFailedAttempts 9\n"
+                                  << "minPasswordLength 8\n";
+
+    SharedSecurityConfig reader;
+    EXPECT_EQ(reader.attach(segmentName, testConfigPath), ConfiguratorErrorCode::DATABASE_ERROR);
+}
+
+// Читатели seqlock никогда не видят частично записанную политику
+TEST_F(SharedSecurityConfigTest, ReadersSeeConsistentPolicy)
+{
+    SharedPolicyWriter writer;
+    ASSERT_EQ(writer.open(segmentName), ConfiguratorErrorCode::SUCCESS);
+
+    SharedPolicy policy = {};
+    ASSERT_EQ(stat(testConfigPath.c_str(), &policy.fileStat), 0);
+    for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+    {
+        policy.present[i] = true;
+    }
+    ASSERT_EQ(writer.write(policy), ConfiguratorErrorCode::SUCCESS);
+
+    SharedSecurityConfig reader;
+    ASSERT_EQ(reader.attach(segmentName, testConfigPath), ConfiguratorErrorCode::SUCCESS);
+
+    std::atomic<bool> stop(false);
+    std::atomic<unsigned> torn(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t)
+    {
+        readers.emplace_back([&reader, &stop, &torn]
+                             {
+                                 SharedPolicy copy;
+                                 while (!stop.load())
+                                 {
+                                     ASSERT_EQ(reader.readPolicy(copy), ConfiguratorErrorCode::SUCCESS);
+                                     for (size_t i = 1; i < SECURITY_PARAM_COUNT; ++i)
+                                     {
+                                         if (copy.values[i] != copy.values[0])
+                                         {
+                                             ++torn;
+                                         }
+                                     }
+                                 }
+                             });
+    }
+
+    // Все параметры каждой версии политики равны номеру версии
+    for (unsigned version = 1; version <= 20000; ++version)
+    {
+        for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+        {
+            policy.values[i] = version;
+        }
+        writer.write(policy);
+    }
+    stop.store(true);
+    for (std::thread &thread : readers)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(torn.load(), 0u);
+}
+
+// Писатель, завершившийся посреди записи, оставляет счетчик нечетным: читатели не зависают,
+// а берут значения из файла, пока следующий писатель не восстановит сегмент
+TEST_F(SharedSecurityConfigTest, StuckWriterFallsBackToFile)
+{
+    SharedPolicyWriter writer;
+    ASSERT_EQ(writer.open(segmentName), ConfiguratorErrorCode::SUCCESS);
+    SharedPolicy policy = {};
+    ASSERT_EQ(stat(testConfigPath.c_str(), &policy.fileStat), 0);
+    for (size_t i = 0; i < SECURITY_PARAM_COUNT; ++i)
+    {
+        policy.values[i] = 42;
+        policy.present[i] = true;
+    }
+    ASSERT_EQ(writer.write(policy), ConfiguratorErrorCode::SUCCESS);
+
+    SharedSecurityConfig reader;
+    ASSERT_EQ(reader.attach(segmentName, testConfigPath), ConfiguratorErrorCode::SUCCESS);
+    unsigned val;
+    ASSERT_EQ(reader.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 42u);
+
+    // Запись начата и не завершена
+    int fd = shm_open(segmentName.c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    void *mapping = mmap(nullptr, sizeof(SharedPolicySegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ASSERT_NE(mapping, MAP_FAILED);
+    static_cast<SharedPolicySegment *>(mapping)->sequence.fetch_add(1);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(reader.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 5u);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    // Повторные чтения не ждут, пока счетчик тот же
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(reader.get_minPasswordLength(val), ConfiguratorErrorCode::SUCCESS);
+        EXPECT_EQ(val, 8u);
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(SHARED_POLICY_READ_TIMEOUT_MS));
+
+    SharedSecurityConfig late;
+    EXPECT_EQ(late.attach(segmentName, testConfigPath), ConfiguratorErrorCode::DATABASE_ERROR);
+
+    // Следующий писатель восстанавливает счетчик
+    ASSERT_EQ(writer.write(policy), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(static_cast<SharedPolicySegment *>(mapping)->sequence.load() % 2, 0u);
+    ASSERT_EQ(reader.get_maxFailedAttempts(val), ConfiguratorErrorCode::SUCCESS);
+    EXPECT_EQ(val, 42u);
+    SharedSecurityConfig recovered;
+    EXPECT_EQ(recovered.attach(segmentName, testConfigPath), ConfiguratorErrorCode::SUCCESS);
+
+    munmap(mapping, sizeof(SharedPolicySegment));
+    close(fd);
+}
@@ -0,0 +1,74 @@
+// tests/test_SharedSessionTable.cpp
+
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "SharedSessionTable.hpp"
+
+// Сессия продлевается при обращении, истекает после бездействия и завершается отзывом
+TEST(SharedSessionTableTest, ExpiresAndRevokes)
+{
+    SharedSessionTable table;
+    ASSERT_EQ(table.open(64), ConfiguratorErrorCode::SUCCESS);
+
+    std::string token = table.create("user", 10, 1000);
+    ASSERT_EQ(token.size(), SharedSessionTable::TOKEN_BYTES);
+    EXPECT_EQ(table.size(), 1u);
+    std::string login;
+    EXPECT_TRUE(table.validate(token, 1009, login));
+    EXPECT_EQ(login, "user");
+    EXPECT_TRUE(table.validate(token, 1018, login));
+    EXPECT_FALSE(table.validate(token, 1028, login));
+    EXPECT_EQ(table.size(), 0u);
+
+    token = table.create("user", 10, 2000);
+    EXPECT_TRUE(table.revoke(token));
+    EXPECT_FALSE(table.revoke(token));
+    EXPECT_FALSE(table.validate(token, 2000, login));
+
+    // Истекшие сессии освобождает проход advance
+    table.create("a", 5, 3000);
+    table.create("b", 50, 3000);
+    table.advance(3010);
+    EXPECT_EQ(table.size(), 1u);
+
+    EXPECT_TRUE(table.create("user", 0, 4000).empty());
+    EXPECT_TRUE(table.create(std::string(SharedSessionTable::MAX_LOGIN + 1, 'x'), 10, 4000).empty());
+    EXPECT_FALSE(table.validate("short", 4000, login));
+}
+
+// Токен, выданный одним процессом, принимается и отзывается другим
+TEST(SharedSessionTableTest, SharedAcrossFork)
+{
+    SharedSessionTable table;
+    ASSERT_EQ(table.open(), ConfiguratorErrorCode::SUCCESS);
+    std::string parentToken = table.create("parent", 60, 1000);
+
+    int pipeFds[2];
+    ASSERT_EQ(pipe(pipeFds), 0);
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        std::string login;
+        bool ok = table.validate(parentToken, 1001, login) && login == "parent" && table.revoke(parentToken);
+        std::string childToken = table.create("child", 60, 1001);
+        ok = ok && write(pipeFds[1], childToken.data(), childToken.size()) == static_cast<ssize_t>(childToken.size());
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    char buffer[SharedSessionTable::TOKEN_BYTES];
+    ASSERT_EQ(read(pipeFds[0], buffer, sizeof(buffer)), static_cast<ssize_t>(sizeof(buffer)));
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+    std::string login;
+    EXPECT_TRUE(table.validate(std::string(buffer, sizeof(buffer)), 1002, login));
+    EXPECT_EQ(login, "child");
+    EXPECT_FALSE(table.validate(parentToken, 1002, login));
+    EXPECT_EQ(table.size(), 1u);
+}
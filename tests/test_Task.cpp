@@ -0,0 +1,173 @@
+// tests/test_Task.cpp
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Authenticator.hpp"
+#include "ConfiguratorDatabase.hpp"
+#include "SecurityConfig.hpp"
+#include "Task.hpp"
+#include "WorkStealingExecutor.hpp"
+
+// Хеширование-заглушка без вычислений, допускает вызовы из нескольких потоков
+class PlainHashing : public HashingInterface
+{
+public:
+    ConfiguratorErrorCode pwHashMake(const std::string &password, std::string &hashedPassword) override
+    {
+        hashedPassword = "hash:" + password;
+        return ConfiguratorErrorCode::SUCCESS;
+    }
+
+    ConfiguratorErrorCode pwHashVerify(const std::string &password, const std::string &hashedPassword) override
+    {
+        return hashedPassword == "hash:" + password ? ConfiguratorErrorCode::SUCCESS
+                                                    : ConfiguratorErrorCode::PASSWORDS_DONT_MATCH;
+    }
+};
+
+static Task<long long> square(long long value)
+{
+    co_return value * value;
+}
+
+static Task<long long> sumOfSquares(long long count)
+{
+    long long sum = 0;
+    for (long long i = 1; i <= count; ++i)
+    {
+        sum += co_await square(i);
+    }
+    co_return sum;
+}
+
+// Без исполнителей задача и вложенные задачи выполняются целиком в вызывающем потоке
+TEST(TaskTest, SyncWaitRunsInlineWithoutExecutors)
+{
+    EXPECT_EQ(syncWait(square(7)), 49);
+    EXPECT_EQ(syncWait(sumOfSquares(1000)), 1000ll * 1001 * 2001 / 6);
+}
+
+static Task<std::thread::id> threadAfterResume(WorkStealingExecutor *executor)
+{
+    co_await ResumeOn(executor);
+    co_return std::this_thread::get_id();
+}
+
+// После ResumeOn сопрограмма продолжается в потоке исполнителя
+TEST(TaskTest, ResumeOnSwitchesToExecutorThread)
+{
+    WorkStealingOptions options;
+    options.workers = 1;
+    WorkStealingExecutor executor(options);
+    EXPECT_NE(syncWait(threadAfterResume(&executor)), std::this_thread::get_id());
+    EXPECT_EQ(syncWait(threadAfterResume(nullptr)), std::this_thread::get_id());
+}
+
+class AsyncAuthenticateTest : public ::testing::Test
+{
+protected:
+    std::string testArchivePath = "./tests/files/task_archive.txt";
+    std::string testActiveUsersPath = "./tests/files/task_active_users.txt";
+    std::string testTmpPath = "./tests/files/task_tmp";
+    std::string testConfigPath = "./tests/files/task_config.txt";
+
+    static constexpr unsigned users = 100;
+
+    PlainHashing hasher;
+    ConfiguratorDatabase *db;
+    SecurityConfig *config;
+    Authenticator *authenticator;
+
+    void SetUp() override
+    {
+        {
+            std::ofstream activeUsers(testActiveUsersPath);
+            for (unsigned i = 0; i < users; ++i)
+            {
+                activeUsers << "user" << i << " hash:password" << i << " 01.01.2000 1\n";
+            }
+        }
+        std::ofstream(testArchivePath) << "";
+        std::ofstream(testConfigPath) << "passwordExpirationDays 36500\nmaxFailedAttempts 1000\n";
+
+        db = new ConfiguratorDatabase(testArchivePath, testActiveUsersPath, testTmpPath);
+        db->enableActiveUsersIndex();
+        config = new SecurityConfig(testConfigPath);
+        authenticator = new Authenticator(db, config, &hasher);
+    }
+
+    void TearDown() override
+    {
+        delete authenticator;
+        delete config;
+        delete db;
+        std::remove(testArchivePath.c_str());
+        std::remove(testActiveUsersPath.c_str());
+        std::remove(testTmpPath.c_str());
+        std::remove(testConfigPath.c_str());
+    }
+};
+
+// Синхронная обертка возвращает те же коды, что и шаги входа по отдельности
+TEST_F(AsyncAuthenticateTest, BlockingWrapper)
+{
+    UserData userData;
+    EXPECT_EQ(authenticator->authenticate("user1", "password1", userData), UserErrorCode::SUCCESS);
+    EXPECT_EQ(userData.login, "user1");
+    EXPECT_EQ(authenticator->authenticate("user1", "wrong", userData), UserErrorCode::WRONG_PASSWORD);
+    EXPECT_EQ(authenticator->authenticate("nobody", "password1", userData), UserErrorCode::LOGIN_NOT_EXISTS);
+}
+
+// Тысячи одновременных входов на трех потоках: один поток базы и два потока хеширования
+TEST_F(AsyncAuthenticateTest, ThousandsInFlightOnFewThreads)
+{
+    const unsigned requests = 4000;
+    std::vector<UserData> results(requests);
+    std::atomic<unsigned> succeeded(0);
+    std::atomic<unsigned> wrong(0);
+    std::atomic<unsigned> done(0);
+    {
+        WorkStealingOptions databaseOptions;
+        databaseOptions.workers = 1;
+        WorkStealingExecutor database(databaseOptions);
+        WorkStealingOptions hashingOptions;
+        hashingOptions.workers = 2;
+        WorkStealingExecutor hashing(hashingOptions);
+        AsyncStages stages{&database, &hashing};
+
+        for (unsigned i = 0; i < requests; ++i)
+        {
+            unsigned user = i % users;
+            std::string password = i % 4 == 3 ? "wrong" : "password" + std::to_string(user);
+            startTask(authenticator->authenticateAsync("user" + std::to_string(user), password, results[i], stages),
+                      [&](UserErrorCode code)
+                      {
+                          if (code == UserErrorCode::SUCCESS)
+                          {
+                              ++succeeded;
+                          }
+                          else if (code == UserErrorCode::WRONG_PASSWORD)
+                          {
+                              ++wrong;
+                          }
+                          ++done;
+                      });
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (done.load() < requests && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    EXPECT_EQ(done.load(), requests);
+    EXPECT_EQ(succeeded.load(), requests / 4 * 3);
+    EXPECT_EQ(wrong.load(), requests / 4);
+    EXPECT_EQ(results[requests - 1].login, "user" + std::to_string((requests - 1) % users));
+}
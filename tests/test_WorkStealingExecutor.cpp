@@ -0,0 +1,113 @@
+// tests/test_WorkStealingExecutor.cpp
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "WorkStealingExecutor.hpp"
+
+// Все задачи, в том числе поставленные из задач, выполняются до завершения деструктора
+TEST(WorkStealingExecutorTest, RunsNestedTasksBeforeDestruction)
+{
+    std::atomic<int> done(0);
+    {
+        WorkStealingOptions options;
+        options.workers = 4;
+        WorkStealingExecutor executor(options);
+        EXPECT_EQ(executor.size(), 4u);
+        for (int i = 0; i < 1000; ++i)
+        {
+            executor.submit([&executor, &done]
+                            {
+                                for (int child = 0; child < 2; ++child)
+                                {
+                                    executor.submit([&done]
+                                                    { ++done; });
+                                }
+                                ++done;
+                            });
+        }
+    }
+    EXPECT_EQ(done.load(), 3000);
+}
+
+// Задачи из очереди занятого потока выполняет свободный поток
+TEST(WorkStealingExecutorTest, IdleWorkerStealsQueuedTasks)
+{
+    WorkStealingOptions options;
+    options.workers = 2;
+    WorkStealingExecutor executor(options);
+
+    std::atomic<int> children(0);
+    std::atomic<bool> finished(false);
+    executor.submit([&]
+                    {
+                        // Дочерние задачи попадают в очередь этого потока, а он ждет их завершения
+                        for (int i = 0; i < 10; ++i)
+                        {
+                            executor.submit([&children]
+                                            { ++children; });
+                        }
+                        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                        while (children.load() < 10 && std::chrono::steady_clock::now() < deadline)
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        }
+                        finished = true;
+                    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!finished.load() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(children.load(), 10);
+    WorkStealingStats stats = executor.stats();
+    EXPECT_GE(stats.stolen, 10u);
+}
+
+// Задачи извне выполняются в порядке постановки, даже если очередь не успевает опустеть
+TEST(WorkStealingExecutorTest, ExternalTasksRunInSubmissionOrder)
+{
+    std::vector<int> order;
+    {
+        WorkStealingOptions options;
+        options.workers = 1;
+        WorkStealingExecutor executor(options);
+        std::atomic<bool> released(false);
+        executor.submit([&released]
+                        {
+                            while (!released.load())
+                            {
+                                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                            }
+                        });
+        for (int i = 0; i < 100; ++i)
+        {
+            executor.submit([&order, i]
+                            { order.push_back(i); });
+        }
+        released = true;
+    }
+    ASSERT_EQ(order.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+// Исполнитель без задач не занимает процессор и завершается сразу
+TEST(WorkStealingExecutorTest, IdleExecutorStops)
+{
+    auto start = std::chrono::steady_clock::now();
+    {
+        WorkStealingOptions options;
+        options.workers = 3;
+        WorkStealingExecutor executor(options);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(executor.stats().executed, 0u);
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+}
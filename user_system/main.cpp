@@ -1,14 +1,30 @@
 // user_system/main.cpp
 
+#include <cstring>
 #include <iostream>
 
 #include "UserConsoleApp.hpp"
 
-int main()
+int main(int argc, char *argv[])
 {
+    // Пакетный режим: user_system --batch <файл|-> [--per-core]
+    if ((argc == 3 || (argc == 4 && std::strcmp(argv[3], "--per-core") == 0)) && std::strcmp(argv[1], "--batch") == 0)
+    {
+        UserConsoleApp app;
+        return app.runBatch(argv[2], argc == 4) ? 0 : 1;
+    }
+
+    // Повторный вход по токену сессии: user_system --session <токен>
+    if (argc == 3 && std::strcmp(argv[1], "--session") == 0)
+    {
+        UserConsoleApp app;
+        app.runSession(argv[2]);
+        return 0;
+    }
+
     std::cout << "Starting User Application...\n";
     UserConsoleApp app;
     app.run();
 
     return 0;
-}
\ No newline at end of file
+}